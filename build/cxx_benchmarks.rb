@@ -0,0 +1,130 @@
+#  Phusion Passenger - https://www.phusionpassenger.com/
+#  Copyright (c) 2021 Phusion Holding B.V.
+#
+#  "Passenger", "Phusion Passenger" and "Union Station" are registered
+#  trademarks of Phusion Holding B.V.
+#
+#  Permission is hereby granted, free of charge, to any person obtaining a copy
+#  of this software and associated documentation files (the "Software"), to deal
+#  in the Software without restriction, including without limitation the rights
+#  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#  copies of the Software, and to permit persons to whom the Software is
+#  furnished to do so, subject to the following conditions:
+#
+#  The above copyright notice and this permission notice shall be included in
+#  all copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#  THE SOFTWARE.
+
+### C++ components benchmarks ###
+
+BENCHMARK_CXX_OUTPUT_DIR = "#{TEST_OUTPUT_DIR}cxx_benchmark/"
+BENCHMARK_CXX_TARGETS = {
+  "#{BENCHMARK_CXX_OUTPUT_DIR}ComponentsBenchmark" =>
+    "test/cxx_benchmark/ComponentsBenchmark.cpp",
+  "#{BENCHMARK_CXX_OUTPUT_DIR}FileBufferedChannelBenchmark" =>
+    "test/cxx_benchmark/FileBufferedChannelBenchmark.cpp",
+  "#{BENCHMARK_CXX_OUTPUT_DIR}HttpHeaderParserBenchmark" =>
+    "test/cxx_benchmark/HttpHeaderParserBenchmark.cpp",
+  "#{BENCHMARK_CXX_OUTPUT_DIR}ProcessMetricsCollectorBenchmark" =>
+    "test/cxx_benchmark/ProcessMetricsCollectorBenchmark.cpp",
+  "#{BENCHMARK_CXX_OUTPUT_DIR}RoutingSimulationBenchmark" =>
+    "test/cxx_benchmark/RoutingSimulationBenchmark.cpp",
+  "#{BENCHMARK_CXX_OUTPUT_DIR}ScgiHeaderNamesBenchmark" =>
+    "test/cxx_benchmark/ScgiHeaderNamesBenchmark.cpp"
+}
+# Benchmarks that drive the Core itself also link against the agent objects
+# that implement it.
+BENCHMARK_CXX_AGENT_OBJECTS = {
+  "#{BENCHMARK_CXX_OUTPUT_DIR}ComponentsBenchmark" => [
+    "#{AGENT_OUTPUT_DIR}CoreController.o",
+    "#{AGENT_OUTPUT_DIR}CoreApplicationPool.o"
+  ],
+  "#{BENCHMARK_CXX_OUTPUT_DIR}RoutingSimulationBenchmark" => [
+    "#{AGENT_OUTPUT_DIR}CoreApplicationPool.o"
+  ]
+}
+
+let(:benchmark_cxx_ldflags) do
+  result = "#{TEST_COMMON_LIBRARY.link_objects_as_string} " <<
+    "#{TEST_BOOST_OXT_LIBRARY} #{libev_libs} #{libuv_libs} " <<
+    "#{PlatformInfo.curl_libs} " <<
+    "#{PlatformInfo.zlib_libs} " <<
+    "#{PlatformInfo.crypto_libs} " <<
+    "#{PlatformInfo.portability_cxx_ldflags}"
+  result.strip!
+  result
+end
+
+# Define compilation tasks for the benchmark executables.
+BENCHMARK_CXX_TARGETS.each_pair do |target, source|
+  object = "#{target}.o"
+  define_cxx_object_compilation_task(
+    object,
+    source,
+    lambda { {
+      :include_paths => ['src/agent', *CXX_SUPPORTLIB_INCLUDE_PATHS],
+      :flags => [libev_cflags, libuv_cflags, PlatformInfo.crypto_extra_cflags, "-O2"]
+    } }
+  )
+
+  agent_objects = BENCHMARK_CXX_AGENT_OBJECTS[target] || []
+  file(target => [object, agent_objects, LIBEV_TARGET, LIBUV_TARGET, TEST_BOOST_OXT_LIBRARY,
+      TEST_COMMON_LIBRARY.link_objects].flatten.compact) do
+    create_cxx_executable(target, [object, agent_objects], :flags => benchmark_cxx_ldflags)
+  end
+end
+
+# The options that every benchmark built on BenchmarkSupport.h accepts.
+def benchmark_cxx_suite_args(default_warmup = '20', default_iterations = '200')
+  args = ["--warmup #{string_option('WARMUP', default_warmup)}",
+    "--iterations #{string_option('ITERATIONS', default_iterations)}"]
+  args << "--filter #{shesc(string_option('FILTER'))}" if string_option('FILTER')
+  args << "--json #{shesc(string_option('JSON'))}" if string_option('JSON')
+  args << "--compare #{shesc(string_option('COMPARE'))}" if string_option('COMPARE')
+  args.join(' ')
+end
+
+desc "Run the C++ microbenchmark suite (pass JSON=file to save the results, COMPARE=file to compare)"
+task 'benchmark:cxx' => "#{BENCHMARK_CXX_OUTPUT_DIR}ComponentsBenchmark" do
+  sh "#{BENCHMARK_CXX_OUTPUT_DIR}ComponentsBenchmark #{benchmark_cxx_suite_args}"
+end
+
+desc "Compare the libuv and io_uring backends of FileBufferedChannel with many slow readers"
+task 'benchmark:file_buffered_channel' => "#{BENCHMARK_CXX_OUTPUT_DIR}FileBufferedChannelBenchmark" do
+  sh "#{BENCHMARK_CXX_OUTPUT_DIR}FileBufferedChannelBenchmark " \
+    "#{string_option('READERS', '300')} #{string_option('CHUNKS', '64')} " \
+    "#{string_option('CONSUME_DELAY', '5')}"
+end
+
+desc "Measure how long the HTTP header parser takes to parse realistic request headers"
+task 'benchmark:http_header_parser' => "#{BENCHMARK_CXX_OUTPUT_DIR}HttpHeaderParserBenchmark" do
+  sh "#{BENCHMARK_CXX_OUTPUT_DIR}HttpHeaderParserBenchmark #{benchmark_cxx_suite_args}"
+end
+
+desc "Compare the cost of collecting process metrics through 'ps' and through /proc"
+task 'benchmark:process_metrics' => "#{BENCHMARK_CXX_OUTPUT_DIR}ProcessMetricsCollectorBenchmark" do
+  sh "#{BENCHMARK_CXX_OUTPUT_DIR}ProcessMetricsCollectorBenchmark " \
+    "--processes #{string_option('PROCESSES', '200')} " \
+    "#{benchmark_cxx_suite_args('1', '50')}"
+end
+
+desc "Simulate the latency distribution of the 'least_busy' and 'latency' routing methods"
+task 'benchmark:routing' => "#{BENCHMARK_CXX_OUTPUT_DIR}RoutingSimulationBenchmark" do
+  sh "#{BENCHMARK_CXX_OUTPUT_DIR}RoutingSimulationBenchmark " \
+    "--processes #{string_option('PROCESSES', '8')} --concurrency #{string_option('CONCURRENCY', '4')} " \
+    "--requests #{string_option('REQUESTS', '1000000')} --load #{string_option('LOAD', '0.7')} " \
+    "--slow-phase #{string_option('SLOW_PHASE', '5')} --slowdown #{string_option('SLOWDOWN', '3')} " \
+    "#{benchmark_cxx_suite_args}"
+end
+
+desc "Compare the previous and the current way of converting header names to CGI variable names"
+task 'benchmark:scgi_header_names' => "#{BENCHMARK_CXX_OUTPUT_DIR}ScgiHeaderNamesBenchmark" do
+  sh "#{BENCHMARK_CXX_OUTPUT_DIR}ScgiHeaderNamesBenchmark #{benchmark_cxx_suite_args}"
+end
@@ -65,6 +65,9 @@
   "#{TEST_OUTPUT_DIR}cxx/SpawnEnvSetupperTest.o" =>
     "test/cxx/SpawnEnvSetupperTest.cpp",
 
+  "#{TEST_OUTPUT_DIR}cxx/Apache2Module/ResponseBodyTest.o" =>
+    "test/cxx/Apache2Module/ResponseBodyTest.cpp",
+
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/ChannelTest.o" =>
     "test/cxx/ServerKit/ChannelTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/FileBufferedChannelTest.o" =>
@@ -114,6 +117,8 @@
     "test/cxx/SystemTools/ProcessMetricsCollectorTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/SystemTools/SystemTimeTest.o" =>
     "test/cxx/SystemTools/SystemTimeTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Algorithms/LatencyHistogramTest.o" =>
+    "test/cxx/Algorithms/LatencyHistogramTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/CachedFileStatTest.o" =>
     "test/cxx/CachedFileStatTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/IOTools/BufferedIOTest.o" =>
@@ -0,0 +1,149 @@
+#!/usr/bin/env ruby
+# Measures how many new connections per second the Passenger core can accept,
+# with the default AcceptLoadBalancer and with per-thread SO_REUSEPORT server
+# sockets (`--reuse-port`). The core runs in `--benchmark after_accept` mode,
+# so that it responds immediately after accepting a client, and every client
+# connection sends a single request without keep-alive.
+
+require 'socket'
+require 'optparse'
+
+class AcceptBenchmark
+  REQUEST =
+    "GET / HTTP/1.0\r\n" <<
+    "Host: 127.0.0.1\r\n" <<
+    "\r\n"
+
+  MODES = {
+    'load balancer' => [],
+    'reuse port'    => ['--reuse-port']
+  }
+
+  def initialize(options = {})
+    @options = options
+    @options[:agent] ||= File.expand_path('../buildout/support-binaries/PassengerAgent',
+      File.dirname(__FILE__))
+    @options[:passenger_root] ||= File.expand_path('..', File.dirname(__FILE__))
+    @options[:port] ||= 3010
+    @options[:threads] ||= 4
+    @options[:clients] ||= 16
+    @options[:duration] ||= 10
+  end
+
+  def run
+    results = {}
+    MODES.each_pair do |name, extra_args|
+      puts "Benchmarking #{name} mode..."
+      pid = start_core(extra_args)
+      begin
+        results[name] = measure
+      ensure
+        Process.kill('TERM', pid)
+        Process.waitpid(pid)
+      end
+    end
+
+    puts
+    results.each_pair do |name, rate|
+      printf("%-15s %10.1f connections/sec\n", name, rate)
+    end
+  end
+
+private
+  def start_core(extra_args)
+    args = [@options[:agent], 'core',
+      '--passenger-root', @options[:passenger_root],
+      '--multi-app',
+      '--listen', "tcp://127.0.0.1:#{@options[:port]}",
+      '--threads', @options[:threads].to_s,
+      '--benchmark', 'after_accept',
+      '--disable-selfchecks',
+      '--log-level', '1'] + extra_args
+    pid = Process.spawn(*args)
+    wait_until_listening
+    pid
+  end
+
+  def wait_until_listening
+    50.times do
+      begin
+        TCPSocket.new('127.0.0.1', @options[:port]).close
+        return
+      rescue Errno::ECONNREFUSED
+        sleep 0.1
+      end
+    end
+    abort "The core did not start listening on port #{@options[:port]}"
+  end
+
+  def measure
+    readers = []
+    @options[:clients].times do
+      reader, writer = IO.pipe
+      fork do
+        reader.close
+        writer.write(run_client.to_s)
+        writer.close
+        exit!(0)
+      end
+      writer.close
+      readers << reader
+    end
+
+    total = 0
+    readers.each do |reader|
+      total += reader.read.to_i
+      reader.close
+    end
+    Process.waitall
+    total / @options[:duration].to_f
+  end
+
+  def run_client
+    count = 0
+    deadline = Time.now + @options[:duration]
+    while Time.now < deadline
+      socket = TCPSocket.new('127.0.0.1', @options[:port])
+      begin
+        socket.write(REQUEST)
+        socket.read
+      ensure
+        socket.close
+      end
+      count += 1
+    end
+    count
+  end
+end
+
+options = {}
+parser = OptionParser.new do |opts|
+  opts.banner = "Usage: ./accept_benchmark.rb [options]"
+  opts.separator ""
+
+  opts.separator "Options:"
+  opts.on("--agent PATH", String, "PassengerAgent binary to benchmark. Default: the one in buildout") do |val|
+    options[:agent] = val
+  end
+  opts.on("--port PORT", Integer, "Let the core listen on the given TCP port. Default: 3010") do |val|
+    options[:port] = val
+  end
+  opts.on("--threads N", Integer, "Number of core threads. Default: 4") do |val|
+    options[:threads] = val
+  end
+  opts.on("--clients N", Integer, "Number of concurrent client processes. Default: 16") do |val|
+    options[:clients] = val
+  end
+  opts.on("--duration SECONDS", Integer, "Duration of each benchmark run. Default: 10") do |val|
+    options[:duration] = val
+  end
+end
+begin
+  parser.parse!
+rescue OptionParser::ParseError => e
+  puts e
+  puts
+  puts "Please see '--help' for valid options."
+  exit 1
+end
+AcceptBenchmark.new(options).run
@@ -13,7 +13,8 @@
 SCAN_FILES = Dir[
   "src/**/*.{c,cpp,h,hpp}",
   "test/oxt/**/*.{c,cpp,h,hpp}",
-  "test/cxx/**/*.{c,cpp,h,hpp}"
+  "test/cxx/**/*.{c,cpp,h,hpp}",
+  "test/cxx_benchmark/**/*.{c,cpp,h,hpp}"
 ]
 EXCLUDE_FILES = Dir[
   "src/cxx_supportlib/vendor-copy/**/*",
@@ -28,9 +28,12 @@
 
 #include <boost/config.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/regex.hpp>
 #include <oxt/thread.hpp>
 #include <string>
+#include <sstream>
 #include <cstring>
 #include <exception>
 #include <sys/types.h>
@@ -117,6 +120,7 @@ public:
 	Authorization authorization;
 	unsigned int controllerStatesGathered;
 	vector<Json::Value> controllerStates;
+	boost::shared_ptr<RequestLatencySnapshot> latencySnapshot;
 
 	DEFINE_SERVER_KIT_BASE_HTTP_REQUEST_FOOTER(Passenger::Core::ApiServer::Request);
 };
@@ -163,6 +167,8 @@ private:
 			processPoolStatusXml(client, req);
 		} else if (path == P_STATIC_STRING("/pool.txt")) {
 			processPoolStatusTxt(client, req);
+		} else if (path == P_STATIC_STRING("/metrics")) {
+			processMetrics(client, req);
 		} else if (path == P_STATIC_STRING("/pool/restart_app_group.json")) {
 			processPoolRestartAppGroup(client, req);
 		} else if (path == P_STATIC_STRING("/pool/detach_process.json")) {
@@ -353,6 +359,264 @@ private:
 		}
 	}
 
+	static string escapeMetricLabelValue(const StaticString &value) {
+		string result;
+		const char *pos = value.data();
+		const char *end = value.data() + value.size();
+
+		result.reserve(value.size());
+		while (pos < end) {
+			switch (*pos) {
+			case '\\':
+				result.append("\\\\", 2);
+				break;
+			case '"':
+				result.append("\\\"", 2);
+				break;
+			case '\n':
+				result.append("\\n", 2);
+				break;
+			default:
+				result.append(1, *pos);
+				break;
+			}
+			pos++;
+		}
+		return result;
+	}
+
+	static void writeMetricHeader(stringstream &stream, const char *name,
+		const char *type, const char *help)
+	{
+		stream << "# TYPE " << name << " " << type << "\n";
+		stream << "# HELP " << name << " " << help << "\n";
+	}
+
+	void writeControllerMetrics(stringstream &stream) const {
+		const unsigned int count = controllers.size();
+		unsigned int i;
+
+		writeMetricHeader(stream, "passenger_core_requests", "counter",
+			"Requests that the Core has begun processing.");
+		for (i = 0; i < count; i++) {
+			stream << "passenger_core_requests_total{thread=\"" << (i + 1) << "\"} "
+				<< ControllerMetrics::get(controllers[i]->getMetrics().requestsBegun) << "\n";
+		}
+		writeMetricHeader(stream, "passenger_core_turbocache_hits", "counter",
+			"Requests that were served from the turbocache.");
+		for (i = 0; i < count; i++) {
+			stream << "passenger_core_turbocache_hits_total{thread=\"" << (i + 1) << "\"} "
+				<< ControllerMetrics::get(controllers[i]->getMetrics().turbocacheHits) << "\n";
+		}
+		writeMetricHeader(stream, "passenger_core_turbocache_misses", "counter",
+			"Cacheable requests that could not be served from the turbocache.");
+		for (i = 0; i < count; i++) {
+			stream << "passenger_core_turbocache_misses_total{thread=\"" << (i + 1) << "\"} "
+				<< ControllerMetrics::get(controllers[i]->getMetrics().turbocacheMisses) << "\n";
+		}
+		writeMetricHeader(stream, "passenger_core_turbocache_stores", "counter",
+			"Application responses that were stored in the turbocache.");
+		for (i = 0; i < count; i++) {
+			stream << "passenger_core_turbocache_stores_total{thread=\"" << (i + 1) << "\"} "
+				<< ControllerMetrics::get(controllers[i]->getMetrics().turbocacheStores) << "\n";
+		}
+		writeMetricHeader(stream, "passenger_core_compressed_responses", "counter",
+			"Application responses that were gzip-compressed by the Core.");
+		for (i = 0; i < count; i++) {
+			stream << "passenger_core_compressed_responses_total{thread=\"" << (i + 1) << "\"} "
+				<< ControllerMetrics::get(controllers[i]->getMetrics().compressedResponses) << "\n";
+		}
+		writeMetricHeader(stream, "passenger_core_spliced_bytes", "counter",
+			"Bytes of application response bodies that were relayed with splice().");
+		for (i = 0; i < count; i++) {
+			stream << "passenger_core_spliced_bytes_total{thread=\"" << (i + 1) << "\"} "
+				<< ControllerMetrics::get(controllers[i]->getMetrics().splicedBytes) << "\n";
+		}
+		writeMetricHeader(stream, "passenger_core_bytes_buffered_to_disk", "counter",
+			"Bytes of request and response bodies that were buffered to disk.");
+		for (i = 0; i < count; i++) {
+			stream << "passenger_core_bytes_buffered_to_disk_total{thread=\"" << (i + 1) << "\"} "
+				<< controllers[i]->getContext()->bytesBufferedToDisk.load(
+					boost::memory_order_relaxed) << "\n";
+		}
+	}
+
+	/**
+	 * Writes an OpenMetrics summary with the latency of every request
+	 * lifecycle phase. `labels` is either empty or ends with a comma.
+	 */
+	static void writeRequestLatencySummary(stringstream &stream, const char *name,
+		const string &labels, const RequestLatencyStats &stats)
+	{
+		static const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+		const unsigned int nquantiles = sizeof(quantiles) / sizeof(double);
+
+		for (unsigned int i = 0; i < RP_COUNT; i++) {
+			const LatencyHistogram &histogram = stats.get((RequestPhase) i);
+			string phaseLabels = labels + "phase=\""
+				+ RequestLatencyStats::getPhaseName((RequestPhase) i) + "\"";
+
+			for (unsigned int j = 0; j < nquantiles; j++) {
+				stream << name << "{" << phaseLabels << ",quantile=\"" << quantiles[j]
+					<< "\"} " << histogram.getPercentile(quantiles[j] * 100) / 1000000.0
+					<< "\n";
+			}
+			stream << name << "_sum{" << phaseLabels << "} "
+				<< histogram.getSum() / 1000000.0 << "\n";
+			stream << name << "_count{" << phaseLabels << "} "
+				<< histogram.getCount() << "\n";
+		}
+	}
+
+	static void writePoolMetrics(stringstream &stream,
+		const vector<ApplicationPool2::Pool::GroupMetricsSnapshot> &groups,
+		const RequestLatencySnapshot &latency)
+	{
+		typedef ApplicationPool2::Pool::GroupMetricsSnapshot GroupSnapshot;
+		typedef ApplicationPool2::Pool::ProcessMetricsSnapshot ProcessSnapshot;
+		vector<GroupSnapshot>::const_iterator g_it, g_end = groups.end();
+		vector<ProcessSnapshot>::const_iterator p_it, p_end;
+		vector<string> groupLabels;
+		vector<string>::const_iterator l_it;
+
+		groupLabels.reserve(groups.size());
+		for (g_it = groups.begin(); g_it != g_end; g_it++) {
+			groupLabels.push_back("group=\"" + escapeMetricLabelValue(g_it->name) + "\"");
+		}
+
+		writeMetricHeader(stream, "passenger_group_queue_length", "gauge",
+			"Requests waiting for a process to become available.");
+		for (g_it = groups.begin(), l_it = groupLabels.begin(); g_it != g_end; g_it++, l_it++) {
+			stream << "passenger_group_queue_length{" << *l_it << "} "
+				<< g_it->queueLength << "\n";
+		}
+		writeMetricHeader(stream, "passenger_group_processes_spawning", "gauge",
+			"Processes that are currently being spawned.");
+		for (g_it = groups.begin(), l_it = groupLabels.begin(); g_it != g_end; g_it++, l_it++) {
+			stream << "passenger_group_processes_spawning{" << *l_it << "} "
+				<< g_it->processesBeingSpawned << "\n";
+		}
+
+		#define FOREACH_PROCESS_METRIC(name, expr) \
+			for (g_it = groups.begin(), l_it = groupLabels.begin(); g_it != g_end; g_it++, l_it++) { \
+				p_end = g_it->processes.end(); \
+				for (p_it = g_it->processes.begin(); p_it != p_end; p_it++) { \
+					stream << name "{" << *l_it << ",pid=\"" << p_it->pid << "\"} " \
+						<< expr << "\n"; \
+				} \
+			}
+
+		writeMetricHeader(stream, "passenger_process_requests", "counter",
+			"Requests that the process has finished processing.");
+		FOREACH_PROCESS_METRIC("passenger_process_requests_total", p_it->processed);
+		writeMetricHeader(stream, "passenger_process_sessions", "gauge",
+			"Sessions that are currently open to the process.");
+		FOREACH_PROCESS_METRIC("passenger_process_sessions", p_it->sessions);
+		writeMetricHeader(stream, "passenger_process_busyness", "gauge",
+			"Busyness of the process, as used by the load balancer.");
+		FOREACH_PROCESS_METRIC("passenger_process_busyness", p_it->busyness);
+		writeMetricHeader(stream, "passenger_process_spawn_duration_seconds", "gauge",
+			"How long spawning the process took.");
+		FOREACH_PROCESS_METRIC("passenger_process_spawn_duration_seconds",
+			p_it->spawnDuration / 1000000.0);
+		writeMetricHeader(stream, "passenger_process_enabled", "gauge",
+			"Whether the process accepts new requests.");
+		FOREACH_PROCESS_METRIC("passenger_process_enabled", (int) p_it->enabled);
+
+		#undef FOREACH_PROCESS_METRIC
+
+		// Only report the latency of the groups that the client may see.
+		writeMetricHeader(stream, "passenger_group_request_phase_duration_seconds", "summary",
+			"How long the requests of the group spent in each lifecycle phase, in all threads.");
+		for (g_it = groups.begin(), l_it = groupLabels.begin(); g_it != g_end; g_it++, l_it++) {
+			map<string, RequestLatencyStats>::const_iterator it = latency.groups.find(g_it->name);
+			if (it != latency.groups.end()) {
+				writeRequestLatencySummary(stream, "passenger_group_request_phase_duration_seconds",
+					*l_it + ",", it->second);
+			}
+		}
+	}
+
+	void processMetrics(Client *client, Request *req) {
+		Authorization auth(authorize(this, client, req));
+		if (auth.canReadPool) {
+			req->authorization = auth;
+			req->latencySnapshot = boost::make_shared<RequestLatencySnapshot>();
+			if (controllers.empty()) {
+				respondWithMetrics(client, req);
+				return;
+			}
+
+			// The request latency statistics may only be read from the
+			// Controllers' own event loops. Continues in
+			// requestLatencyGathered().
+			for (unsigned int i = 0; i < controllers.size(); i++) {
+				refRequest(req, __FILE__, __LINE__);
+				controllers[i]->getContext()->libev->runLater(boost::bind(
+					&ApiServer::gatherRequestLatency, this,
+					client, req, controllers[i]));
+			}
+		} else {
+			apiServerRespondWith401(this, client, req);
+		}
+	}
+
+	void gatherRequestLatency(Client *client, Request *req, Controller *controller) {
+		boost::shared_ptr<RequestLatencySnapshot> snapshot =
+			boost::make_shared<RequestLatencySnapshot>();
+		controller->snapshotRequestLatency(*snapshot);
+		getContext()->libev->runLater(boost::bind(&ApiServer::requestLatencyGathered,
+			this, client, req, snapshot));
+	}
+
+	void requestLatencyGathered(Client *client, Request *req,
+		boost::shared_ptr<RequestLatencySnapshot> snapshot)
+	{
+		if (req->ended()) {
+			unrefRequest(req, __FILE__, __LINE__);
+			return;
+		}
+
+		// Merge the threads' histograms so that percentiles are reported
+		// over all requests.
+		req->controllerStatesGathered++;
+		req->latencySnapshot->merge(*snapshot);
+		if (req->controllerStatesGathered == controllers.size()) {
+			respondWithMetrics(client, req);
+		}
+
+		unrefRequest(req, __FILE__, __LINE__);
+	}
+
+	void respondWithMetrics(Client *client, Request *req) {
+		ApplicationPool2::Pool::AuthenticationOptions options;
+		options.uid = req->authorization.uid;
+		options.apiKey = req->authorization.apiKey;
+
+		// Copy the pool's numbers first so that no lock is held
+		// while formatting.
+		vector<ApplicationPool2::Pool::GroupMetricsSnapshot> groups(
+			appPool->snapshotMetrics(options));
+		stringstream stream;
+		writeControllerMetrics(stream);
+		writeMetricHeader(stream, "passenger_core_request_phase_duration_seconds", "summary",
+			"How long requests spent in each lifecycle phase, in all threads.");
+		writeRequestLatencySummary(stream, "passenger_core_request_phase_duration_seconds",
+			string(), req->latencySnapshot->all);
+		writePoolMetrics(stream, groups, *req->latencySnapshot);
+		stream << "# EOF\n";
+
+		HeaderTable headers;
+		headers.insert(req->pool, "Content-Type",
+			"application/openmetrics-text; version=1.0.0; charset=utf-8");
+		headers.insert(req->pool, "Cache-Control", "no-cache, no-store, must-revalidate");
+		writeSimpleResponse(client, 200, &headers,
+			psg_pstrdup(req->pool, stream.str()));
+		if (!req->ended()) {
+			endRequest(&client, &req);
+		}
+	}
+
 	void processPoolRestartAppGroup(Client *client, Request *req) {
 		Authorization auth(authorize(this, client, req));
 		if (!auth.canModifyPool) {
@@ -674,6 +938,7 @@ protected:
 		}
 		req->authorization = Authorization();
 		req->controllerStates.clear();
+		req->latencySnapshot.reset();
 		ParentClass::deinitializeRequest(client, req);
 	}
 
@@ -57,6 +57,32 @@ public:
 
 	virtual void initiate(bool blocking = true) = 0;
 
+	/**
+	 * Like `initiate(false)`, but does not block on connecting to the process.
+	 * Returns true if the session has been initiated. Returns false if the
+	 * connection is still being established, in which case one must wait
+	 * until fd() becomes writable, then call continueInitiate().
+	 */
+	virtual bool initiateNonBlocking() {
+		initiate(false);
+		return true;
+	}
+
+	/**
+	 * Continues an initiation for which initiateNonBlocking() returned false.
+	 * Returns whether the session is now initiated. Failures are handled in
+	 * the same way as with initiate().
+	 */
+	virtual bool continueInitiate() {
+		return true;
+	}
+
+	/**
+	 * Aborts an initiation for which initiateNonBlocking() returned false,
+	 * for example because it took too long. This counts as an initiation failure.
+	 */
+	virtual void abortInitiate() { /* Do nothing */ }
+
 	virtual void requestOOBW() { /* Do nothing */ }
 
 	/**
@@ -170,6 +170,30 @@ typedef StringKeyTable<GroupPtr> GroupMap;
 typedef boost::function<void (const ProcessPtr &process, DisableResult result)> DisableCallback;
 typedef boost::function<void ()> Callback;
 
+/**
+ * The type of `Pool::syncher`. Everything that changes the structure or
+ * the capacity of the pool (spawning, attaching, detaching, restarting,
+ * garbage collection, etc) locks it exclusively. The session checkout and
+ * session close fast paths only lock it in shared mode, and serialize on
+ * the Group's own `sessionSyncher` instead.
+ */
+typedef boost::shared_mutex PoolSyncher;
+typedef boost::lock_guard<PoolSyncher> PoolLockGuard;
+typedef boost::unique_lock<PoolSyncher> PoolScopedLock;
+typedef boost::shared_lock<PoolSyncher> PoolSharedLock;
+
+/** Nicer syntax for conditionally locking the pool exclusively during construction. */
+class DynamicPoolScopedLock: public PoolScopedLock {
+public:
+	DynamicPoolScopedLock(PoolSyncher &m, bool lockNow = true)
+		: PoolScopedLock(m, boost::defer_lock)
+	{
+		if (lockNow) {
+			lock();
+		}
+	}
+};
+
 struct GetCallback {
 	void (*func)(const AbstractSessionPtr &session, const ExceptionPtr &e, void *userData);
 	mutable void *userData;
@@ -30,6 +30,7 @@
 #include <map>
 #include <queue>
 #include <deque>
+#include <algorithm>
 #include <boost/thread.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/foreach.hpp>
@@ -101,6 +102,14 @@ public:
 			{ }
 	};
 
+	/** How requests are distributed over the enabled processes. See `Options::routingMethod`. */
+	enum RoutingMethod {
+		/** Route to the process with the lowest busyness. */
+		RM_LEAST_BUSY,
+		/** Power of two random choices, weighted by moving average latency. */
+		RM_LATENCY
+	};
+
 	enum LifeStatus {
 		/** Up and operational. */
 		ALIVE,
@@ -136,7 +145,9 @@ public:
 	 */
 	unsigned int restartsInitiated;
 	/**
-	 * The number of processes that are being spawned right now.
+	 * The number of processes that are being spawned right now. There is one
+	 * spawn loop thread per process being spawned, so this is at most
+	 * `options.spawnConcurrency`.
 	 *
 	 * Invariant:
 	 *     if processesBeingSpawned > 0: m_spawning
@@ -152,13 +163,23 @@ public:
 	 *       enabledCount == 0
 	 *       disablingCount == 0
 	 *       disabledCount == 0
+	 *       standbyCount == 0
 	 *       nEnabledProcessesTotallyBusy == 0
 	 */
 	boost::atomic<boost::uint8_t> lifeStatus;
 	/**
-	 * Whether the spawner thread is currently working. Note that even
-	 * if it's working, it doesn't necessarily mean that processes are
-	 * being spawned (i.e. that processesBeingSpawned > 0). After the
+	 * Serializes `getQuickly()` and the fast path of `onSessionClose()` on this
+	 * Group. These only lock `pool->syncher` in shared mode, so this lock is what
+	 * protects the session bookkeeping (process session counts, busyness levels,
+	 * etc) against concurrent checkouts and closes on the same Group. Must only
+	 * be locked while holding `pool->syncher` in shared mode. Code that holds
+	 * `pool->syncher` exclusively does not need to lock this.
+	 */
+	boost::mutex sessionSyncher;
+	/**
+	 * Whether any spawner threads are currently working. Note that even
+	 * if one is working, it doesn't necessarily mean that processes are
+	 * being spawned (i.e. that processesBeingSpawned > 0). After a
 	 * thread is done spawning a process, it will attempt to attach
 	 * the newly-spawned process to the group. During that time it's not
 	 * technically spawning anything.
@@ -188,7 +209,7 @@ public:
 	 * whether any of the Processes can be shut down.
 	 */
 	bool detachedProcessesCheckerActive;
-	boost::condition_variable detachedProcessesCheckerCond;
+	boost::condition_variable_any detachedProcessesCheckerCond;
 	Callback shutdownCallback;
 	GroupPtr selfPointer;
 
@@ -209,6 +230,7 @@ public:
 	static void _onSessionClose(Session *session);
 	OXT_FORCE_INLINE void onSessionInitiateFailure(Process *process, Session *session);
 	OXT_FORCE_INLINE void onSessionClose(Process *process, Session *session);
+	bool canCloseSessionQuickly(const Process *process) const;
 
 	/****** Spawning and restarting ******/
 
@@ -219,6 +241,9 @@ public:
 	void finalizeRestart(GroupPtr self, Options oldOptions, Options newOptions,
 		RestartMethod method, SpawningKit::FactoryPtr spawningKitFactory,
 		unsigned int restartsInitiated, boost::container::vector<Callback> postLockActions);
+	bool restartFileCheckDue(const Options &options) const;
+	bool needsAnotherConcurrentSpawn() const;
+	void startSpawnLoop();
 
 	/****** Process list management ******/
 
@@ -226,6 +251,8 @@ public:
 	Process *findProcessWithStickySessionIdOrLowestBusyness(unsigned int id) const;
 	Process *findProcessWithLowestBusyness(const ProcessList &processes) const;
 	Process *findEnabledProcessWithLowestBusyness() const;
+	Process *findEnabledProcessByLatency(unsigned long long now) const;
+	unsigned int nextRoutingRandomNumber() const;
 
 	void addProcessToList(const ProcessPtr &process, ProcessList &destination);
 	void removeProcessFromList(const ProcessPtr &process, ProcessList &source);
@@ -234,6 +261,12 @@ public:
 	void clearDisableWaitlist(DisableResult result,
 		boost::container::vector<Callback> &postLockActions);
 	void enableAllDisablingProcesses(boost::container::vector<Callback> &postLockActions);
+	bool shouldAttachAsStandby() const;
+	void promoteStandbyProcess();
+	unsigned int countProcessesRecyclingBecauseOfMaxMemory() const;
+	void lockAndFinishMaxMemoryRecycling(const ProcessPtr &process, DisableResult result, GroupPtr self);
+	void finishMaxMemoryRecycling(const ProcessPtr &process,
+		boost::container::vector<Callback> &postLockActions);
 
 	void startCheckingDetachedProcesses(bool immediately);
 	void detachedProcessesCheckerMain(GroupPtr self);
@@ -306,11 +339,16 @@ public:
 	 *   disabled as soon as they finish all their requests and there are
 	 *   enabled processes.
 	 * - Disabled processes never handle requests.
+	 * - Standby processes are spare processes that are fully spawned but
+	 *   never handle requests, until they are promoted to enabled processes
+	 *   because a request could not be routed to any of the enabled processes.
+	 *   See `options.standbyProcesses`.
 	 *
-	 * 'enabledProcesses', 'disablingProcesses' and 'disabledProcesses' contain
-	 * all enabled, disabling and disabling processes in this group, respectively.
-	 * 'enabledCount', 'disablingCount' and 'disabledCount' are used to maintain
-	 * their numbers.
+	 * 'enabledProcesses', 'disablingProcesses', 'disabledProcesses' and
+	 * 'standbyProcesses' contain all enabled, disabling, disabled and standby
+	 * processes in this group, respectively.
+	 * 'enabledCount', 'disablingCount', 'disabledCount' and 'standbyCount'
+	 * are used to maintain their numbers.
 	 * These lists do not intersect. A process is in exactly 1 list.
 	 *
 	 * `nEnabledProcessesTotallyBusy` counts the number of enabled processes for which
@@ -320,9 +358,11 @@ public:
 	 *    enabledCount >= 0
 	 *    disablingCount >= 0
 	 *    disabledCount >= 0
+	 *    standbyCount >= 0
 	 *    enabledProcesses.size() == enabledCount
 	 *    disablingProcesses.size() == disabingCount
 	 *    disabledProcesses.size() == disabledCount
+	 *    standbyProcesses.size() == standbyCount
 	 *    nEnabledProcessesTotallyBusy <= enabledCount
      *
 	 *    if (enabledCount == 0):
@@ -344,14 +384,20 @@ public:
 	 *       process.enabled == Process::DISABLED
 	 *       process.isAlive()
 	 *       process.oobwStatus == Process::OOBW_NOT_ACTIVE || process.oobwStatus == Process::OOBW_IN_PROGRESS
+	 *    for all process in standbyProcesses:
+	 *       process.enabled == Process::STANDBY
+	 *       process.isAlive()
+	 *       process.sessions == 0
 	 */
 	int enabledCount;
 	int disablingCount;
 	int disabledCount;
+	int standbyCount;
 	int nEnabledProcessesTotallyBusy;
 	ProcessList enabledProcesses;
 	ProcessList disablingProcesses;
 	ProcessList disabledProcesses;
+	ProcessList standbyProcesses;
 
 	/**
 	 * When a process is detached, it is stored here until we've confirmed
@@ -369,6 +415,14 @@ public:
 	 */
 	boost::container::vector<int> enabledProcessBusynessLevels;
 
+	/**
+	 * Parsed from `options.routingMethod` whenever the options are reset,
+	 * i.e. when the Group is created or restarted.
+	 */
+	RoutingMethod routingMethod;
+	/** State of the random number generator used by `findEnabledProcessByLatency()`. */
+	mutable boost::uint32_t routingRandomState;
+
 	/**
 	 * get() requests for this group that cannot be immediately satisfied are
 	 * put on this wait list, which must be processed as soon as the necessary
@@ -445,6 +499,7 @@ public:
 
 	SessionPtr get(const Options &newOptions, const GetCallback &callback,
 		boost::container::vector<Callback> &postLockActions);
+	SessionPtr getQuickly(const Options &newOptions);
 
 	/****** Spawning and restarting ******/
 
@@ -469,6 +524,8 @@ public:
 	void enable(const ProcessPtr &process,
 		boost::container::vector<Callback> &postLockActions);
 	DisableResult disable(const ProcessPtr &process, const DisableCallback &callback);
+	void putOnStandby(const ProcessPtr &process);
+	void recycleProcessesExceedingMaxMemory(boost::container::vector<Callback> &postLockActions);
 
 	/****** State inspection ******/
 
@@ -476,6 +533,7 @@ public:
 	bool processLowerLimitsSatisfied() const;
 	bool processUpperLimitsReached() const;
 	bool allEnabledProcessesAreTotallyBusy() const;
+	bool standbyProcessesSatisfied() const;
 
 	unsigned int capacityUsed() const;
 	bool isWaitingForCapacity() const;
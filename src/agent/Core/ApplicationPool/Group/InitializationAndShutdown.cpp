@@ -64,6 +64,7 @@ Group::shutdownCanFinish() const {
 		&& enabledCount == 0
 		&& disablingCount == 0
  		&& disabledCount == 0
+ 		&& standbyCount == 0
  		&& detachedProcesses.empty();
 }
 
@@ -104,10 +105,13 @@ Group::Group(Pool *_pool, const Options &_options)
 	info.group   = this;
 	info.name    = _options.getAppGroupName().toString();
 	info.apiKey  = generateApiKey(_pool);
+	// Any non-zero seed will do, as long as groups don't all route in lockstep.
+	routingRandomState = (boost::uint32_t) (uintptr_t) this | 1;
 	resetOptions(_options);
 	enabledCount   = 0;
 	disablingCount = 0;
 	disabledCount  = 0;
+	standbyCount   = 0;
 	nEnabledProcessesTotallyBusy = 0;
 	spawner        = getContext()->spawningKitFactory->create(options);
 	restartsInitiated = 0;
@@ -77,6 +77,18 @@ Group::resetOptions(const Options &newOptions, Options *destination) {
 	destination->clearPerRequestFields();
 	destination->apiKey    = getApiKey().toStaticString();
 	destination->groupUuid = uuid;
+
+	if (destination == &this->options) {
+		if (options.routingMethod == P_STATIC_STRING("latency")) {
+			routingMethod = RM_LATENCY;
+		} else {
+			if (options.routingMethod != P_STATIC_STRING("least_busy")) {
+				P_WARN("Unknown routing method '" << options.routingMethod
+					<< "' for group " << info.name << "; using 'least_busy' instead");
+			}
+			routingMethod = RM_LEAST_BUSY;
+		}
+	}
 }
 
 /**
@@ -88,6 +100,9 @@ Group::mergeOptions(const Options &other) {
 	options.minProcesses     = other.minProcesses;
 	options.statThrottleRate = other.statThrottleRate;
 	options.maxPreloaderIdleTime = other.maxPreloaderIdleTime;
+	options.spawnConcurrency = other.spawnConcurrency;
+	options.standbyProcesses = other.standbyProcesses;
+	options.maxMemory        = other.maxMemory;
 }
 
 /* Given a hook name like "queue_full_error", we return HookScriptOptions filled in with this name and a spec
@@ -126,8 +126,79 @@ Group::findEnabledProcessWithLowestBusyness() const {
 }
 
 /**
- * Adds a process to the given list (enabledProcess, disablingProcesses, disabledProcesses)
- * and sets the process->enabled flag accordingly.
+ * Picks an enabled process using the "power of two choices" algorithm, weighted
+ * by latency: two distinct processes are picked at random, and the one with the
+ * lowest cost is returned. A process's cost is its moving average latency
+ * multiplied by the number of sessions it would have after routing to it, so
+ * that processes that are slow (e.g. because of garbage collection pauses or
+ * noisy neighbors) receive less traffic than their free capacity suggests.
+ *
+ * If one of the two processes has no latency measurements yet, then the
+ * processes are compared by busyness. If neither process can be routed to,
+ * then the least busy enabled process is returned, so that just like
+ * `findEnabledProcessWithLowestBusyness()`, the result can only be totally
+ * busy if all enabled processes are.
+ *
+ * `now` is the current time in microseconds, or 0 if unknown.
+ */
+Process *
+Group::findEnabledProcessByLatency(unsigned long long now) const {
+	unsigned int size = enabledProcesses.size();
+	if (size < 2 || nEnabledProcessesTotallyBusy >= enabledCount) {
+		return findEnabledProcessWithLowestBusyness();
+	}
+
+	unsigned int i = nextRoutingRandomNumber() % size;
+	unsigned int j = (i + 1 + nextRoutingRandomNumber() % (size - 1)) % size;
+	Process *a = enabledProcesses[i].get();
+	Process *b = enabledProcesses[j].get();
+
+	if (!a->canBeRoutedTo()) {
+		if (b->canBeRoutedTo()) {
+			return b;
+		} else {
+			return findEnabledProcessWithLowestBusyness();
+		}
+	} else if (!b->canBeRoutedTo()) {
+		return a;
+	}
+
+	if (a->latency.available() && b->latency.available()) {
+		if (now == 0) {
+			now = SystemTime::getUsec();
+		}
+		double costA = a->latency.average(now) * (a->sessions + 1);
+		double costB = b->latency.average(now) * (b->sessions + 1);
+		if (costA != costB) {
+			return (costA < costB) ? a : b;
+		}
+	}
+
+	if (enabledProcessBusynessLevels[j] < enabledProcessBusynessLevels[i]) {
+		return b;
+	} else {
+		return a;
+	}
+}
+
+/**
+ * A xorshift pseudo-random number generator. Good enough for picking processes,
+ * and cheap enough to be used for every request. Must be called while holding
+ * the pool lock exclusively, or in shared mode together with `sessionSyncher`.
+ */
+unsigned int
+Group::nextRoutingRandomNumber() const {
+	boost::uint32_t x = routingRandomState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	routingRandomState = x;
+	return x;
+}
+
+/**
+ * Adds a process to the given list (enabledProcess, disablingProcesses, disabledProcesses,
+ * standbyProcesses) and sets the process->enabled flag accordingly.
  * The process must currently not be in any list. This function does not fix
  * getWaitlist invariants or other stuff.
  */
@@ -149,6 +220,10 @@ Group::addProcessToList(const ProcessPtr &process, ProcessList &destination) {
 		assert(process->sessions == 0);
 		process->enabled = Process::DISABLED;
 		disabledCount++;
+	} else if (&destination == &standbyProcesses) {
+		assert(process->sessions == 0);
+		process->enabled = Process::STANDBY;
+		standbyCount++;
 	} else if (&destination == &detachedProcesses) {
 		assert(process->isAlive());
 		process->enabled = Process::DETACHED;
@@ -166,7 +241,8 @@ Group::addProcessToList(const ProcessPtr &process, ProcessList &destination) {
 }
 
 /**
- * Removes a process to the given list (enabledProcess, disablingProcesses, disabledProcesses).
+ * Removes a process to the given list (enabledProcess, disablingProcesses, disabledProcesses,
+ * standbyProcesses).
  * This function does not fix getWaitlist invariants or other stuff.
  */
 void
@@ -192,6 +268,10 @@ Group::removeProcessFromList(const ProcessPtr &process, ProcessList &source) {
 		assert(&source == &disabledProcesses);
 		disabledCount--;
 		break;
+	case Process::STANDBY:
+		assert(&source == &standbyProcesses);
+		standbyCount--;
+		break;
 	case Process::DETACHED:
 		assert(&source == &detachedProcesses);
 		break;
@@ -270,6 +350,35 @@ Group::enableAllDisablingProcesses(boost::container::vector<Callback> &postLockA
 	clearDisableWaitlist(DR_ERROR, postLockActions);
 }
 
+/**
+ * Whether a newly spawned process should be put on standby instead of being
+ * enabled. That is only the case if the enabled processes can handle the
+ * current load by themselves: the lower process limits are satisfied by
+ * enabled processes, there are no get waiters and not all enabled processes
+ * are totally busy.
+ */
+bool
+Group::shouldAttachAsStandby() const {
+	return (unsigned int) standbyCount < options.standbyProcesses
+		&& getWaitlist.empty()
+		&& (unsigned int) enabledCount >= std::max(options.minProcesses, 1u)
+		&& !allEnabledProcessesAreTotallyBusy();
+}
+
+/**
+ * Moves the longest-waiting standby process to the enabled processes, so that
+ * it can be routed to right away. This function doesn't touch `getWaitlist`
+ * so be sure to fix its invariants afterwards if necessary.
+ */
+void
+Group::promoteStandbyProcess() {
+	assert(standbyCount > 0);
+	ProcessPtr process = standbyProcesses.front();
+	P_DEBUG("Promoting standby process " << process->inspect() << " to enabled");
+	removeProcessFromList(process, standbyProcesses);
+	addProcessToList(process, enabledProcesses);
+}
+
 /**
  * The `immediately` parameter only has effect if the detached processes checker
  * thread is active. It means that, if the thread is currently sleeping, it should
@@ -301,7 +410,7 @@ Group::detachedProcessesCheckerMain(GroupPtr self) {
 		debug->messages->recv("Proceed with starting detached processes checker");
 	}
 
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	while (true) {
 		assert(detachedProcessesCheckerActive);
 
@@ -396,7 +505,9 @@ Group::detachedProcessesCheckerMain(GroupPtr self) {
 
 
 /**
- * Attaches the given process to this Group and mark it as enabled. This
+ * Attaches the given process to this Group and mark it as enabled, or put it
+ * on standby if `options.standbyProcesses` asks for more standby processes
+ * and the enabled processes can handle the load by themselves. This
  * function doesn't touch `getWaitlist` so be sure to fix its invariants
  * afterwards if necessary, e.g. by calling `assignSessionsToGetWaiters()`.
  */
@@ -422,8 +533,13 @@ Group::attach(const ProcessPtr &process,
 		process->forceMaxConcurrency(options.forceMaxConcurrentRequestsPerProcess);
 	}
 
-	P_DEBUG("Attaching process " << process->inspect());
-	addProcessToList(process, enabledProcesses);
+	if (shouldAttachAsStandby()) {
+		P_DEBUG("Attaching process " << process->inspect() << " on standby");
+		addProcessToList(process, standbyProcesses);
+	} else {
+		P_DEBUG("Attaching process " << process->inspect());
+		addProcessToList(process, enabledProcesses);
+	}
 
 	/* Now that there are enough resources, relevant processes in
 	 * 'disableWaitlist' can be disabled.
@@ -490,6 +606,9 @@ Group::detach(const ProcessPtr &process, boost::container::vector<Callback> &pos
 			removeProcessFromList(process, disablingProcesses);
 			removeFromDisableWaitlist(process, DR_NOOP, postLockActions);
 		}
+	} else if (process->enabled == Process::STANDBY) {
+		assert(!standbyProcesses.empty());
+		removeProcessFromList(process, standbyProcesses);
 	} else {
 		assert(process->enabled == Process::DISABLED);
 		assert(!disabledProcesses.empty());
@@ -520,14 +639,19 @@ Group::detachAll(boost::container::vector<Callback> &postLockActions) {
 	foreach (ProcessPtr process, disabledProcesses) {
 		addProcessToList(process, detachedProcesses);
 	}
+	foreach (ProcessPtr process, standbyProcesses) {
+		addProcessToList(process, detachedProcesses);
+	}
 
 	enabledProcesses.clear();
 	disablingProcesses.clear();
 	disabledProcesses.clear();
+	standbyProcesses.clear();
 	enabledProcessBusynessLevels.clear();
 	enabledCount = 0;
 	disablingCount = 0;
 	disabledCount = 0;
+	standbyCount = 0;
 	nEnabledProcessesTotallyBusy = 0;
 	clearDisableWaitlist(DR_NOOP, postLockActions);
 	startCheckingDetachedProcesses(false);
@@ -552,6 +676,10 @@ Group::enable(const ProcessPtr &process, boost::container::vector<Callback> &pos
 		P_DEBUG("Enabling DISABLED process " << process->inspect());
 		removeProcessFromList(process, disabledProcesses);
 		addProcessToList(process, enabledProcesses);
+	} else if (process->enabled == Process::STANDBY) {
+		P_DEBUG("Enabling STANDBY process " << process->inspect());
+		removeProcessFromList(process, standbyProcesses);
+		addProcessToList(process, enabledProcesses);
 	} else {
 		P_DEBUG("Enabling ENABLED process " << process->inspect());
 	}
@@ -605,6 +733,13 @@ Group::disable(const ProcessPtr &process, const DisableCallback &callback) {
 		P_DEBUG("Disabling DISABLING process " << process->inspect() <<
 			info.name << "; command queued, deferring disable command completion");
 		return DR_DEFERRED;
+	} else if (process->enabled == Process::STANDBY) {
+		assert(standbyCount > 0);
+		P_DEBUG("Disabling STANDBY process " << process->inspect() <<
+			info.name << "; disable command succeeded immediately");
+		removeProcessFromList(process, standbyProcesses);
+		addProcessToList(process, disabledProcesses);
+		return DR_SUCCESS;
 	} else {
 		assert(disabledCount > 0);
 		P_DEBUG("Disabling DISABLED process " << process->inspect() <<
@@ -613,6 +748,190 @@ Group::disable(const ProcessPtr &process, const DisableCallback &callback) {
 	}
 }
 
+/**
+ * Puts the given enabled, idle process on standby, so that it is no longer
+ * routed to but remains available for promotion. Used by the garbage collector
+ * to keep an idle process around as a standby process instead of shutting it
+ * down, if the group is short on standby processes.
+ */
+void
+Group::putOnStandby(const ProcessPtr &process) {
+	assert(process->getGroup() == this);
+	assert(process->isAlive());
+	assert(isAlive());
+	assert(process->enabled == Process::ENABLED);
+	assert(process->sessions == 0);
+	assert(enabledCount > 1);
+
+	P_DEBUG("Putting idle process " << process->inspect() << " on standby");
+	removeProcessFromList(process, enabledProcesses);
+	addProcessToList(process, standbyProcesses);
+}
+
+static bool
+compareProcessesByRealMemoryDescending(const ProcessPtr &a, const ProcessPtr &b) {
+	return a->metrics.realMemory() > b->metrics.realMemory();
+}
+
+/**
+ * Gracefully replaces enabled processes that use more memory than
+ * `options.maxMemory` allows, according to the metrics last collected by
+ * Pool::collectAnalytics(). Such a process is disabled, so that it finishes
+ * its current requests but receives no new ones, and is then detached and
+ * replaced by a newly spawned process.
+ *
+ * To avoid a capacity drop when many processes grow at the same rate,
+ * at most a quarter of the group's processes (but at least 1) is recycled
+ * at the same time. A process counts as being recycled until it has shut
+ * down and its replacement has been spawned. The processes using the most
+ * memory go first; the rest are considered again the next time analytics
+ * are collected.
+ */
+void
+Group::recycleProcessesExceedingMaxMemory(boost::container::vector<Callback> &postLockActions) {
+	TRACE_POINT();
+	assert(isAlive());
+
+	if (options.maxMemory == 0 || restarting()) {
+		return;
+	}
+
+	size_t limit = (size_t) options.maxMemory * 1024;
+	// Processes that are being replaced are no longer part of
+	// getProcessCount(), but their replacements will be.
+	unsigned int maxRecycling = std::max(1u,
+		(getProcessCount() + processesBeingSpawned) / 4);
+	unsigned int recycling = countProcessesRecyclingBecauseOfMaxMemory();
+	if (recycling >= maxRecycling) {
+		return;
+	}
+
+	ProcessList candidates;
+	foreach (const ProcessPtr &process, enabledProcesses) {
+		if (process->metrics.isValid()
+		 && process->metrics.realMemory() > limit
+		 && !process->recyclingBecauseOfMaxMemory
+		 && process->oobwStatus == Process::OOBW_NOT_ACTIVE)
+		{
+			candidates.push_back(process);
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), compareProcessesByRealMemoryDescending);
+
+	foreach (const ProcessPtr &process, candidates) {
+		if (recycling >= maxRecycling) {
+			break;
+		}
+		if (process->enabled != Process::ENABLED) {
+			// Detached by finishMaxMemoryRecycling() of an earlier candidate.
+			continue;
+		}
+
+		P_NOTICE("Process " << process->inspect() << " uses "
+			<< process->metrics.realMemory() / 1024 << " MB of memory, which is more than "
+			<< "the limit of " << options.maxMemory << " MB; replacing it");
+		process->recyclingBecauseOfMaxMemory = true;
+		DisableResult result = disable(process,
+			boost::bind(&Group::lockAndFinishMaxMemoryRecycling, this,
+				boost::placeholders::_1, boost::placeholders::_2, shared_from_this()));
+		switch (result) {
+		case DR_SUCCESS:
+			finishMaxMemoryRecycling(process, postLockActions);
+			recycling++;
+			break;
+		case DR_DEFERRED:
+			// lockAndFinishMaxMemoryRecycling() will eventually be called.
+			recycling++;
+			break;
+		case DR_ERROR:
+		case DR_NOOP:
+			P_DEBUG("Not replacing process " << process->inspect()
+				<< " because it could not be disabled");
+			process->recyclingBecauseOfMaxMemory = false;
+			break;
+		default:
+			P_BUG("Unexpected disable() result " << result);
+		}
+	}
+}
+
+/**
+ * Returns the number of processes that are being replaced because they use
+ * too much memory. These are the processes that are being disabled for that
+ * reason, plus those that have already been detached but that are still
+ * shutting down or whose replacements are still being spawned.
+ */
+unsigned int
+Group::countProcessesRecyclingBecauseOfMaxMemory() const {
+	unsigned int result = 0;
+	unsigned int detached = 0;
+	foreach (const ProcessPtr &process, disablingProcesses) {
+		if (process->recyclingBecauseOfMaxMemory) {
+			result++;
+		}
+	}
+	foreach (const ProcessPtr &process, disabledProcesses) {
+		if (process->recyclingBecauseOfMaxMemory) {
+			result++;
+		}
+	}
+	foreach (const ProcessPtr &process, detachedProcesses) {
+		if (process->recyclingBecauseOfMaxMemory) {
+			detached++;
+		}
+	}
+	// Every detached process is replaced by a newly spawned one, so a
+	// process being spawned is most likely the replacement of a detached
+	// process. Count each replacement only once.
+	return result + std::max(detached, (unsigned int) processesBeingSpawned);
+}
+
+// The 'self' parameter is for keeping the current Group object alive
+void
+Group::lockAndFinishMaxMemoryRecycling(const ProcessPtr &process, DisableResult result,
+	GroupPtr self)
+{
+	TRACE_POINT();
+	Pool *pool = getPool();
+	boost::container::vector<Callback> actions;
+
+	{
+		PoolScopedLock lock(pool->syncher);
+		if (OXT_UNLIKELY(!process->isAlive() || !isAlive())) {
+			return;
+		}
+
+		if (result == DR_SUCCESS && process->enabled == Process::DISABLED
+		 && process->recyclingBecauseOfMaxMemory)
+		{
+			finishMaxMemoryRecycling(process, actions);
+		} else {
+			// We do not touch the process because it's likely that the
+			// administrator has explicitly changed the state.
+			P_DEBUG("Replacing process " << process->inspect() << " aborted "
+				"because the process could not be disabled");
+			process->recyclingBecauseOfMaxMemory = false;
+		}
+	}
+
+	runAllActions(actions);
+}
+
+void
+Group::finishMaxMemoryRecycling(const ProcessPtr &process,
+	boost::container::vector<Callback> &postLockActions)
+{
+	assert(process->enabled == Process::DISABLED);
+	assert(process->sessions == 0);
+
+	P_DEBUG("Process " << process->inspect() << " disabled; detaching it "
+		"because it uses too much memory");
+	getPool()->detachProcessUnlocked(process, postLockActions);
+	if (isAlive() && shouldSpawn()) {
+		spawn();
+	}
+}
+
 
 } // namespace ApplicationPool2
 } // namespace Passenger
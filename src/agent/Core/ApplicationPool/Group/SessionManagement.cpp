@@ -53,12 +53,20 @@ using namespace boost;
  * If there are no enabled process, then waiting for one to spawn is too
  * expensive. The next best thing is to route to disabling processes
  * until more processes have been spawned.
+ *
+ * Which enabled process is picked depends on the routing method, unless
+ * the request has a sticky session ID.
  */
 Group::RouteResult
 Group::route(const Options &options) const {
 	if (OXT_LIKELY(enabledCount > 0)) {
 		if (options.stickySessionId == 0) {
-			Process *process = findEnabledProcessWithLowestBusyness();
+			Process *process;
+			if (routingMethod == RM_LATENCY) {
+				process = findEnabledProcessByLatency(options.currentTime);
+			} else {
+				process = findEnabledProcessWithLowestBusyness();
+			}
 			if (process->canBeRoutedTo()) {
 				return RouteResult(process);
 			} else {
@@ -123,7 +131,7 @@ Group::onSessionInitiateFailure(Process *process, Session *session) {
 	TRACE_POINT();
 	// Standard resource management boilerplate stuff...
 	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	assert(process->isAlive());
 	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
 
@@ -141,9 +149,32 @@ Group::onSessionInitiateFailure(Process *process, Session *session) {
 OXT_FORCE_INLINE void
 Group::onSessionClose(Process *process, Session *session) {
 	TRACE_POINT();
-	// Standard resource management boilerplate stuff...
 	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+
+	{
+		/* Fast path: if closing this session cannot change the structure of
+		 * the pool, then we only need to update this Group's bookkeeping,
+		 * which doesn't require the pool lock to be held exclusively.
+		 */
+		PoolSharedLock sharedLock(pool->syncher);
+		boost::lock_guard<boost::mutex> groupLock(sessionSyncher);
+		if (OXT_LIKELY(canCloseSessionQuickly(process))) {
+			P_TRACE(2, "Session closed for process " << process->inspect());
+			bool wasTotallyBusy = process->isTotallyBusy();
+			process->sessionClosed(session);
+			enabledProcessBusynessLevels[process->getIndex()] = process->busyness();
+			if (wasTotallyBusy) {
+				assert(nEnabledProcessesTotallyBusy >= 1);
+				nEnabledProcessesTotallyBusy--;
+			}
+			verifyInvariants();
+			return;
+		}
+	}
+
+	// Standard resource management boilerplate stuff...
+	UPDATE_TRACE_POINT();
+	PoolScopedLock lock(pool->syncher);
 	assert(process->isAlive());
 	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
 
@@ -244,6 +275,25 @@ Group::onSessionClose(Process *process, Session *session) {
 	}
 }
 
+/* Whether onSessionClose() may close a session on the given process while only
+ * holding the pool lock in shared mode. That is the case if closing the session
+ * cannot cause the process to be detached or disabled, cannot initiate out-of-band
+ * work, and there are no get waiters (on this Group or on the pool) that could
+ * be assigned a session as a result. Must be called while holding the pool lock
+ * in shared mode and `sessionSyncher`, or while holding the pool lock exclusively.
+ */
+bool
+Group::canCloseSessionQuickly(const Process *process) const {
+	return isAlive()
+		&& process->enabled == Process::ENABLED
+		&& process->oobwStatus != Process::OOBW_REQUESTED
+		&& getWaitlist.empty()
+		&& (options.maxRequests == 0
+			|| process->processed + 1 < options.maxRequests)
+		&& (process->sessions > 1
+			|| (pool->getWaitlist.empty() && !anotherGroupIsWaitingForCapacity()));
+}
+
 
 /****************************
  *
@@ -264,6 +314,19 @@ Group::get(const Options &newOptions, const GetCallback &callback,
 		} else {
 			mergeOptions(newOptions);
 		}
+		if (OXT_UNLIKELY(standbyCount > 0 && !newOptions.noop)) {
+			// If this request cannot be routed to any of the enabled processes,
+			// then put a standby process to work instead of letting the request
+			// wait until a new process has been spawned. The spawn check below
+			// will then replenish the standby processes.
+			RouteResult result(NULL, true);
+			if (enabledCount > 0) {
+				result = route(newOptions);
+			}
+			if (result.process == NULL && result.finished) {
+				promoteStandbyProcess();
+			}
+		}
 		if (OXT_UNLIKELY(!newOptions.noop && shouldSpawnForGetAction())) {
 			// If we're trying to spawn the first process for this group, and
 			// spawning failed because the pool is at full capacity, then we
@@ -333,6 +396,41 @@ Group::get(const Options &newOptions, const GetCallback &callback,
 	}
 }
 
+/**
+ * Like get(), but for use while the caller only holds the pool lock in shared mode.
+ * Only handles the common case in which a session can be checked out from an enabled
+ * process right away, i.e. without restarting, spawning or putting the request on
+ * the wait list. Returns NULL if that's not possible, in which case the caller must
+ * call get() while holding the pool lock exclusively.
+ */
+SessionPtr
+Group::getQuickly(const Options &newOptions) {
+	boost::lock_guard<boost::mutex> l(sessionSyncher);
+
+	if (OXT_UNLIKELY(!isAlive()
+		|| restarting()
+		|| newOptions.noop
+		|| restartFileCheckDue(newOptions)))
+	{
+		return SessionPtr();
+	}
+
+	mergeOptions(newOptions);
+	if (OXT_UNLIKELY(shouldSpawnForGetAction())) {
+		return SessionPtr();
+	}
+
+	RouteResult result = route(newOptions);
+	if (result.process == NULL) {
+		return SessionPtr();
+	}
+
+	P_DEBUG("Session checked out from process " << result.process->inspect());
+	SessionPtr session = newSession(result.process, newOptions.currentTime);
+	verifyInvariants();
+	return session;
+}
+
 
 } // namespace ApplicationPool2
 } // namespace Passenger
@@ -119,7 +119,7 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 
 		UPDATE_TRACE_POINT();
 		ScopeGuard guard(boost::bind(Process::forceTriggerShutdownAndCleanup, process));
-		boost::unique_lock<boost::mutex> lock(pool->syncher);
+		PoolScopedLock lock(pool->syncher);
 
 		if (!isAlive()) {
 			if (process != NULL) {
@@ -151,8 +151,9 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 		assert(m_spawning);
 		assert(processesBeingSpawned > 0);
 
+		// Other spawn loops of this group may still be spawning
+		// processes concurrently with us.
 		processesBeingSpawned--;
-		assert(processesBeingSpawned == 0);
 
 		UPDATE_TRACE_POINT();
 		boost::container::vector<Callback> actions;
@@ -180,22 +181,28 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 			if (enabledCount == 0) {
 				enableAllDisablingProcesses(actions);
 			}
-			Pool::assignExceptionToGetWaiters(getWaitlist, exception, actions);
+			if (processesBeingSpawned == 0) {
+				Pool::assignExceptionToGetWaiters(getWaitlist, exception, actions);
+			} else {
+				// Other spawn loops may still spawn processes that can
+				// serve the get waiters. If they fail too, then the last
+				// one to finish fails the get waiters.
+				P_DEBUG("Spawn failed, but " << processesBeingSpawned <<
+					" other processes are still being spawned, so not"
+					" failing the get waiters yet");
+			}
 			pool->assignSessionsToGetWaiters(actions);
 			done = true;
 		}
 
-		done = done
-			|| (processLowerLimitsSatisfied() && getWaitlist.empty())
-			|| processUpperLimitsReached()
-			|| pool->atFullCapacityUnlocked();
-		m_spawning = !done;
+		done = done || !needsAnotherConcurrentSpawn();
 		if (done) {
 			P_DEBUG("Spawn loop done");
 		} else {
 			processesBeingSpawned++;
 			P_DEBUG("Continue spawning");
 		}
+		m_spawning = processesBeingSpawned > 0;
 
 		UPDATE_TRACE_POINT();
 		pool->fullVerifyInvariants();
@@ -245,7 +252,7 @@ Group::finalizeRestart(GroupPtr self,
 		debug->messages->recv("Finish restarting");
 	}
 
-	ScopedLock l(pool->syncher);
+	PoolScopedLock l(pool->syncher);
 	if (!isAlive()) {
 		P_DEBUG("Group " << getName() << " is shutting down, so aborting restart");
 		return;
@@ -294,6 +301,27 @@ Group::finalizeRestart(GroupPtr self,
 	}
 }
 
+/* Whether needsRestart() would have to check the restart files, i.e. whether it
+ * could possibly return true. Unlike needsRestart(), this has no side effects,
+ * so it may be called while only holding the pool lock in shared mode.
+ */
+bool
+Group::restartFileCheckDue(const Options &options) const {
+	if (m_restarting) {
+		return false;
+	} else if (lastRestartFileCheckTime == 0 || alwaysRestartFileExists) {
+		return true;
+	} else {
+		time_t now;
+		if (options.currentTime != 0) {
+			now = options.currentTime / 1000000;
+		} else {
+			now = SystemTime::get();
+		}
+		return lastRestartFileCheckTime <= now - (time_t) options.statThrottleRate;
+	}
+}
+
 
 /****************************
  *
@@ -415,16 +443,51 @@ Group::needsRestart(const Options &options) {
 	}
 }
 
+/**
+ * Whether a spawn loop should spawn another process on top of the ones that
+ * are already being spawned, i.e. whether the lower process limits are not yet
+ * satisfied or whether there are more get waiters and missing standby processes
+ * than processes being spawned, while respecting the group and pool upper limits.
+ */
+bool
+Group::needsAnotherConcurrentSpawn() const {
+	return !(processLowerLimitsSatisfied()
+			&& getWaitlist.size() + options.standbyProcesses
+				<= (unsigned int) (processesBeingSpawned + standbyCount))
+		&& !processUpperLimitsReached()
+		&& !pool->atFullCapacityUnlocked();
+}
+
+void
+Group::startSpawnLoop() {
+	interruptableThreads.create_thread(
+		boost::bind(&Group::spawnThreadMain,
+			this, shared_from_this(), spawner,
+			options.copyAndPersist().clearPerRequestFields(),
+			restartsInitiated),
+		"Group process spawner: " + info.name,
+		POOL_HELPER_THREAD_STACK_SIZE);
+	m_spawning = true;
+	processesBeingSpawned++;
+}
+
 /**
  * Attempts to increase the number of processes by one, while respecting the
  * resource limits. That is, this method will ensure that there are at least
  * `minProcesses` processes, but no more than `maxProcesses` processes, and no
  * more than `pool->max` processes in the entire pool.
+ *
+ * If `options.spawnConcurrency` is larger than 1, then this method may start
+ * up to that many spawn loops, as long as more processes are needed to satisfy
+ * the lower process limits or the get waiters.
  */
 SpawnResult
 Group::spawn() {
 	assert(isAlive());
-	if (m_spawning) {
+	unsigned int concurrency = std::max(options.spawnConcurrency, 1u);
+	if (m_spawning && ((unsigned int) processesBeingSpawned >= concurrency
+		|| !needsAnotherConcurrentSpawn()))
+	{
 		return SR_IN_PROGRESS;
 	} else if (restarting()) {
 		return SR_ERR_RESTARTING;
@@ -434,15 +497,10 @@ Group::spawn() {
 		return SR_ERR_POOL_AT_FULL_CAPACITY;
 	} else {
 		P_DEBUG("Requested spawning of new process for group " << info.name);
-		interruptableThreads.create_thread(
-			boost::bind(&Group::spawnThreadMain,
-				this, shared_from_this(), spawner,
-				options.copyAndPersist().clearPerRequestFields(),
-				restartsInitiated),
-			"Group process spawner: " + info.name,
-			POOL_HELPER_THREAD_STACK_SIZE);
-		m_spawning = true;
-		processesBeingSpawned++;
+		do {
+			startSpawnLoop();
+		} while ((unsigned int) processesBeingSpawned < concurrency
+			&& needsAnotherConcurrentSpawn());
 		return SR_OK;
 	}
 }
@@ -452,7 +510,11 @@ Group::spawning() const {
 	return m_spawning;
 }
 
-/** Whether a new process should be spawned for this group. */
+/** Whether a new process should be spawned for this group. Standby processes
+ * are only replenished while the group has enabled processes, so that a group
+ * that has been garbage collected down to zero processes stays that way until
+ * it receives a request.
+ */
 bool
 Group::shouldSpawn() const {
 	return allowSpawn()
@@ -460,6 +522,7 @@ Group::shouldSpawn() const {
 			!processLowerLimitsSatisfied()
 			|| allEnabledProcessesAreTotallyBusy()
 			|| !getWaitlist.empty()
+			|| (enabledCount > 0 && !standbyProcessesSatisfied())
 		);
 }
 
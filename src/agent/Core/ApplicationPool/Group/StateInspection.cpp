@@ -50,7 +50,7 @@ using namespace boost;
 
 unsigned int
 Group::getProcessCount() const {
-	return enabledCount + disablingCount + disabledCount;
+	return enabledCount + disablingCount + disabledCount + standbyCount;
 }
 
 /**
@@ -85,13 +85,24 @@ Group::allEnabledProcessesAreTotallyBusy() const {
 	return nEnabledProcessesTotallyBusy == enabledCount && enabledCount > 0;
 }
 
+/**
+ * Returns whether this group has as many standby processes as configured
+ * with `options.standbyProcesses`, counting the processes that are currently
+ * being spawned as future standby processes.
+ */
+bool
+Group::standbyProcessesSatisfied() const {
+	return (unsigned int) (standbyCount + processesBeingSpawned) >= options.standbyProcesses;
+}
+
 /**
  * Returns the number of processes in this group that should be part of the
  * ApplicationPool process limits calculations.
  */
 unsigned int
 Group::capacityUsed() const {
-	return enabledCount + disablingCount + disabledCount + processesBeingSpawned;
+	return enabledCount + disablingCount + disabledCount + standbyCount
+		+ processesBeingSpawned;
 }
 
 /**
@@ -133,6 +144,7 @@ Group::inspectXml(std::ostream &stream, bool includeSecrets) const {
 	stream << "<enabled_process_count>" << enabledCount << "</enabled_process_count>";
 	stream << "<disabling_process_count>" << disablingCount << "</disabling_process_count>";
 	stream << "<disabled_process_count>" << disabledCount << "</disabled_process_count>";
+	stream << "<standby_process_count>" << standbyCount << "</standby_process_count>";
 	stream << "<capacity_used>" << capacityUsed() << "</capacity_used>";
 	stream << "<get_wait_list_size>" << getWaitlist.size() << "</get_wait_list_size>";
 	stream << "<disable_wait_list_size>" << disableWaitlist.size() << "</disable_wait_list_size>";
@@ -190,6 +202,11 @@ Group::inspectXml(std::ostream &stream, bool includeSecrets) const {
 		(*it)->inspectXml(stream, includeSecrets);
 		stream << "</process>";
 	}
+	for (it = standbyProcesses.begin(); it != standbyProcesses.end(); it++) {
+		stream << "<process>";
+		(*it)->inspectXml(stream, includeSecrets);
+		stream << "</process>";
+	}
 	for (it = detachedProcesses.begin(); it != detachedProcesses.end(); it++) {
 		stream << "<process>";
 		(*it)->inspectXml(stream, includeSecrets);
@@ -237,12 +254,15 @@ Group::inspectConfigInAdminPanelFormat(Json::Value &result) const {
 		P_STATIC_STRING("\t"), P_STATIC_STRING(" ")));
 	result["ruby"] = SVAL(options.ruby, DEFAULT_RUBY);
 	result["python"] = SVAL(options.python, DEFAULT_PYTHON);
+	result["python_thread_count"] = VAL(options.pythonThreadCount, 1u);
+	result["python_smart_spawning"] = VAL(options.pythonSmartSpawning, false);
 	result["nodejs"] = SVAL(options.nodejs, DEFAULT_NODEJS);
 	result["meteor_app_settings"] = NON_EMPTY_SVAL(options.meteorAppSettings);
 	result["min_processes"] = VAL(options.minProcesses, 1u);
 	result["max_processes"] = VAL(options.maxProcesses, 0u);
 	result["environment"] = SVAL(options.environment); // TODO: default value depends on integration mode
 	result["spawn_method"] = SVAL(options.spawnMethod, DEFAULT_SPAWN_METHOD);
+	result["routing_method"] = SVAL(options.routingMethod, DEFAULT_ROUTING_METHOD);
 	result["bind_address"] = SVAL(options.bindAddress, DEFAULT_BIND_ADDRESS);
 	result["start_timeout"] = VAL(options.startTimeout / 1000.0, DEFAULT_START_TIMEOUT / 1000.0);
 	result["max_preloader_idle_time"] = VAL((Json::UInt) options.maxPreloaderIdleTime,
@@ -260,6 +280,9 @@ Group::inspectConfigInAdminPanelFormat(Json::Value &result) const {
 	result["max_requests"] = VAL((Json::UInt) options.maxRequests, 0u);
 	result["abort_websockets_on_process_shutdown"] = VAL(options.abortWebsocketsOnProcessShutdown);
 	result["force_max_concurrent_requests_per_process"] = VAL(options.forceMaxConcurrentRequestsPerProcess, -1);
+	result["spawn_concurrency"] = VAL(options.spawnConcurrency, 1u);
+	result["standby_processes"] = VAL(options.standbyProcesses, 0u);
+	result["max_memory"] = VAL(options.maxMemory, 0u);
 	result["restart_dir"] = NON_EMPTY_SVAL(options.restartDir);
 	result["sticky_sessions_cookie_attributes"] = SVAL(options.stickySessionsCookieAttributes, DEFAULT_STICKY_SESSIONS_COOKIE_ATTRIBUTES);
 
@@ -63,6 +63,7 @@ Group::verifyInvariants() const {
 	assert(enabledCount >= 0);
 	assert(disablingCount >= 0);
 	assert(disabledCount >= 0);
+	assert(standbyCount >= 0);
 	assert(nEnabledProcessesTotallyBusy >= 0);
 	assert(!( enabledCount == 0 && disablingCount > 0 ) || ( processesBeingSpawned > 0) );
 	assert(!( !m_spawning ) || ( enabledCount > 0 || disablingCount == 0 ));
@@ -86,6 +87,7 @@ Group::verifyInvariants() const {
 		assert(enabledCount == 0);
 		assert(disablingCount == 0);
 		assert(disabledCount == 0);
+		assert(standbyCount == 0);
 		assert(nEnabledProcessesTotallyBusy == 0);
 	}
 
@@ -93,6 +95,7 @@ Group::verifyInvariants() const {
 	assert((int) enabledProcesses.size() == enabledCount);
 	assert((int) disablingProcesses.size() == disablingCount);
 	assert((int) disabledProcesses.size() == disabledCount);
+	assert((int) standbyProcesses.size() == standbyCount);
 	assert(nEnabledProcessesTotallyBusy <= enabledCount);
 	#endif
 }
@@ -135,6 +138,14 @@ Group::verifyExpensiveInvariants() const {
 			|| process->oobwStatus == Process::OOBW_IN_PROGRESS);
 	}
 
+	end = standbyProcesses.end();
+	for (it = standbyProcesses.begin(); it != end; it++) {
+		const ProcessPtr &process = *it;
+		assert(process->enabled == Process::STANDBY);
+		assert(process->isAlive());
+		assert(process->sessions == 0);
+	}
+
 	foreach (const ProcessPtr &process, detachedProcesses) {
 		assert(process->enabled == Process::DETACHED);
 	}
@@ -117,6 +117,7 @@ private:
 		result.push_back(&options.uri);
 
 		result.push_back(&options.stickySessionsCookieAttributes);
+		result.push_back(&options.routingMethod);
 
 		return result;
 	}
@@ -295,6 +296,24 @@ public:
 
 	unsigned int fileDescriptorUlimit;
 
+	/**
+	 * The number of threads with which each process of a Python app handles
+	 * requests. The process advertises this as its concurrency, so that
+	 * up to this many requests are routed to it at the same time.
+	 * 1 means that requests are handled by a single thread, one at a time.
+	 */
+	unsigned int pythonThreadCount;
+
+	/**
+	 * Whether Python apps may be spawned through the WSGI preloader when
+	 * the spawn method is 'smart'. Smart spawning is the default spawn
+	 * method, but unlike Ruby apps, Python apps have always been spawned
+	 * directly, so switching them to the preloader must be opted into.
+	 * If false, Python apps are spawned directly regardless of the spawn
+	 * method.
+	 */
+	bool pythonSmartSpawning;
+
 	/**
 	 * If set to a value that isn't -1, makes Passenger ignore the application's
 	 * advertised socket concurrency, and believe that the concurrency should be
@@ -350,6 +369,34 @@ public:
 	 */
 	unsigned int maxOutOfBandWorkInstances;
 
+	/**
+	 * The maximum number of processes inside a group that may be spawned
+	 * at the same time. Values higher than 1 allow a group to scale up
+	 * faster, at the cost of putting more load on the preloader and the
+	 * system while spawning. The number of concurrent spawns is always
+	 * bounded by the group's and the pool's capacity.
+	 */
+	unsigned int spawnConcurrency;
+
+	/**
+	 * The number of spare processes that a group keeps spawned on standby.
+	 * Standby processes have been fully spawned, but are not routed to.
+	 * As soon as a request cannot be routed to one of the enabled processes,
+	 * a standby process is promoted to an enabled process, so that the
+	 * request does not have to wait for a process to be spawned.
+	 * Standby processes count towards the group's and the pool's capacity.
+	 */
+	unsigned int standbyProcesses;
+
+	/**
+	 * The maximum amount of real memory (private dirty RSS plus swap), in MB,
+	 * that a process may use. Processes that use more are gracefully replaced:
+	 * they are disabled, allowed to finish their requests, and then detached,
+	 * while a new process is spawned. The memory usage is checked whenever
+	 * Pool::collectAnalytics() runs. A value of 0 means unlimited.
+	 */
+	unsigned int maxMemory;
+
 	/**
 	 * The maximum number of requests that may live in the Group.getWaitlist queue.
 	 * A value of 0 means unlimited.
@@ -368,6 +415,18 @@ public:
 	 */
 	StaticString stickySessionsCookieAttributes;
 
+	/**
+	 * How requests are distributed over the group's processes, either
+	 * "least_busy" or "latency". "least_busy" routes to the process with
+	 * the fewest active sessions relative to its concurrency. "latency"
+	 * picks two random processes and routes to the one for which the
+	 * moving average response time multiplied by its number of active
+	 * sessions is lowest, so that processes that are temporarily slow
+	 * (e.g. because of garbage collection) receive less traffic.
+	 * Takes effect when the group is created or restarted.
+	 */
+	StaticString routingMethod;
+
 	/*-----------------*/
 
 
@@ -457,6 +516,8 @@ public:
 		  python(DEFAULT_PYTHON, sizeof(DEFAULT_PYTHON) - 1),
 		  nodejs(DEFAULT_NODEJS, sizeof(DEFAULT_NODEJS) - 1),
 		  fileDescriptorUlimit(0),
+		  pythonThreadCount(1),
+		  pythonSmartSpawning(false),
 		  forceMaxConcurrentRequestsPerProcess(-1),
 		  debugger(false),
 		  loadShellEnvvars(true),
@@ -467,9 +528,13 @@ public:
 		  maxProcesses(0),
 		  maxPreloaderIdleTime(-1),
 		  maxOutOfBandWorkInstances(1),
+		  spawnConcurrency(1),
+		  standbyProcesses(0),
+		  maxMemory(0),
 		  maxRequestQueueSize(DEFAULT_MAX_REQUEST_QUEUE_SIZE),
 		  abortWebsocketsOnProcessShutdown(true),
 		  stickySessionsCookieAttributes(DEFAULT_STICKY_SESSIONS_COOKIE_ATTRIBUTES, sizeof(DEFAULT_STICKY_SESSIONS_COOKIE_ATTRIBUTES) - 1),
+		  routingMethod(DEFAULT_ROUTING_METHOD, sizeof(DEFAULT_ROUTING_METHOD) - 1),
 
 		  stickySessionId(0),
 		  statThrottleRate(DEFAULT_STAT_THROTTLE_RATE),
@@ -588,6 +653,8 @@ public:
 			appendKeyValue (vec, "integration_mode",   integrationMode);
 			appendKeyValue (vec, "ruby",               ruby);
 			appendKeyValue (vec, "python",             python);
+			appendKeyValue3(vec, "python_thread_count", pythonThreadCount);
+			appendKeyValue4(vec, "python_smart_spawning", pythonSmartSpawning);
 			appendKeyValue (vec, "nodejs",             nodejs);
 			appendKeyValue (vec, "meteor_app_settings", meteorAppSettings);
 			appendKeyValue4(vec, "debugger",           debugger);
@@ -600,7 +667,11 @@ public:
 			appendKeyValue3(vec, "max_processes",       maxProcesses);
 			appendKeyValue2(vec, "max_preloader_idle_time", maxPreloaderIdleTime);
 			appendKeyValue3(vec, "max_out_of_band_work_instances", maxOutOfBandWorkInstances);
+			appendKeyValue3(vec, "spawn_concurrency", spawnConcurrency);
+			appendKeyValue3(vec, "standby_processes", standbyProcesses);
+			appendKeyValue3(vec, "max_memory", maxMemory);
 			appendKeyValue (vec, "sticky_sessions_cookie_attributes", stickySessionsCookieAttributes);
+			appendKeyValue (vec, "routing_method", routingMethod);
 		}
 
 		/*********************************/
@@ -198,6 +198,28 @@ public:
 		}
 	};
 
+	/**
+	 * Copies of the numbers that are reported by the ApiServer's /metrics
+	 * endpoint. They are taken by snapshotMetrics() so that the metrics can
+	 * be formatted without holding any locks.
+	 */
+	struct ProcessMetricsSnapshot {
+		pid_t pid;
+		int sessions;
+		int busyness;
+		unsigned int processed;
+		// In microseconds.
+		unsigned long long spawnDuration;
+		bool enabled;
+	};
+
+	struct GroupMetricsSnapshot {
+		string name;
+		unsigned int queueLength;
+		unsigned int processesBeingSpawned;
+		vector<ProcessMetricsSnapshot> processes;
+	};
+
 
 // Actually private, but marked public so that unit tests can access the fields.
 public:
@@ -205,7 +227,13 @@ public:
 	friend class Process;
 	friend struct tut::ApplicationPool2_PoolTest;
 
-	mutable boost::mutex syncher;
+	/**
+	 * Protects the pool and all Groups and Processes in it. Code that only
+	 * checks out a session from, or closes a session on, an already existing
+	 * Group may lock this in shared mode plus the Group's `sessionSyncher`;
+	 * everything else must lock this exclusively. See `PoolSyncher`.
+	 */
+	mutable PoolSyncher syncher;
 	unsigned int max;
 	unsigned long long maxIdleTime;
 	bool selfchecking;
@@ -314,6 +342,7 @@ public:
 
 	SystemMetricsCollector systemMetricsCollector;
 	SystemMetrics systemMetrics;
+	ProcessMetricsCollector processMetricsCollector;
 
 	void initializeAnalyticsCollection();
 	static void collectAnalytics(PoolPtr self);
@@ -332,7 +361,7 @@ public:
 		boost::container::vector<Callback> actions;
 	};
 
-	boost::condition_variable garbageCollectionCond;
+	boost::condition_variable_any garbageCollectionCond;
 
 	void initializeGarbageCollection();
 	static void garbageCollect(PoolPtr self);
@@ -341,6 +370,8 @@ public:
 		const GroupPtr &group, const ProcessPtr &process, ProcessList &output);
 	void garbageCollectProcessesInGroup(GarbageCollectorState &state,
 		const GroupPtr &group);
+	void garbageCollectStandbyProcessesInGroup(GarbageCollectorState &state,
+		const GroupPtr &group);
 	void maybeCleanPreloader(GarbageCollectorState &state, const GroupPtr &group);
 	unsigned long long realGarbageCollect();
 	void wakeupGarbageCollector();
@@ -383,6 +414,7 @@ public:
 	GroupPtr createGroup(const Options &options);
 	GroupPtr createGroupAndAsyncGetFromIt(const Options &options,
 		const GetCallback &callback, boost::container::vector<Callback> &postLockActions);
+	SessionPtr getFromExistingGroupQuickly(const Options &options);
 	void forceDetachGroup(const GroupPtr &group,
 		const Callback &callback,
 		boost::container::vector<Callback> &postLockActions);
@@ -426,10 +458,15 @@ public:
 	bool atFullCapacityUnlocked() const;
 	void inspectProcessList(const InspectOptions &options, stringstream &result,
 		const Group *group, const ProcessList &processes) const;
+	static void snapshotProcessMetrics(vector<ProcessMetricsSnapshot> &result,
+		const ProcessList &processes);
 
 public:
 	typedef void (*AbortLongRunningConnectionsCallback)(const ProcessPtr &process);
 	AbortLongRunningConnectionsCallback abortLongRunningConnectionsCallback;
+	/** Called, with the pool lock held, after a Group has been detached. */
+	typedef void (*GroupDetachedCallback)(const GroupPtr &group);
+	GroupDetachedCallback groupDetachedCallback;
 
 
 	/****** Initialization and shutdown ******/
@@ -485,6 +522,8 @@ public:
 	string toXml(const ToXmlOptions &options = ToXmlOptions::makeAuthorized(),
 		bool lock = true) const;
 	Json::Value inspectPropertiesInAdminPanelFormat(const ToJsonOptions &options = ToJsonOptions::makeAuthorized()) const;
+	vector<GroupMetricsSnapshot> snapshotMetrics(
+		const AuthenticationOptions &options = AuthenticationOptions::makeAuthorized()) const;
 	Json::Value inspectConfigInAdminPanelFormat(const ToJsonOptions &options = ToJsonOptions::makeAuthorized()) const;
 
 
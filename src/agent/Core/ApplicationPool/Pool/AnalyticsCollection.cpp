@@ -117,13 +117,13 @@ Pool::realCollectAnalytics() {
 	// Collect all the PIDs.
 	{
 		UPDATE_TRACE_POINT();
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		max = this->max;
 	}
 	pids.reserve(max);
 	{
 		UPDATE_TRACE_POINT();
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		GroupMap::ConstIterator g_it(groups);
 
 		while (*g_it != NULL) {
@@ -131,6 +131,7 @@ Pool::realCollectAnalytics() {
 			collectPids(group->enabledProcesses, pids);
 			collectPids(group->disablingProcesses, pids);
 			collectPids(group->disabledProcesses, pids);
+			collectPids(group->standbyProcesses, pids);
 			g_it.next();
 		}
 	}
@@ -141,7 +142,7 @@ Pool::realCollectAnalytics() {
 	try {
 		UPDATE_TRACE_POINT();
 		P_DEBUG("Collecting process metrics");
-		processMetrics = ProcessMetricsCollector().collect(pids);
+		processMetrics = processMetricsCollector.collect(pids);
 	} catch (const ParseException &) {
 		P_WARN("Unable to collect process metrics: cannot parse 'ps' output.");
 		return;
@@ -159,7 +160,7 @@ Pool::realCollectAnalytics() {
 		UPDATE_TRACE_POINT();
 		vector<ProcessPtr> processesToDetach;
 		boost::container::vector<Callback> actions;
-		ScopedLock l(syncher);
+		PoolScopedLock l(syncher);
 		GroupMap::ConstIterator g_it(groups);
 
 		UPDATE_TRACE_POINT();
@@ -168,6 +169,7 @@ Pool::realCollectAnalytics() {
 			updateProcessMetrics(group->enabledProcesses, processMetrics, processesToDetach);
 			updateProcessMetrics(group->disablingProcesses, processMetrics, processesToDetach);
 			updateProcessMetrics(group->disabledProcesses, processMetrics, processesToDetach);
+			updateProcessMetrics(group->standbyProcesses, processMetrics, processesToDetach);
 			g_it.next();
 		}
 
@@ -178,6 +180,14 @@ Pool::realCollectAnalytics() {
 		UPDATE_TRACE_POINT();
 		processesToDetach.clear();
 
+		UPDATE_TRACE_POINT();
+		GroupMap::ConstIterator g_it2(groups);
+		while (*g_it2 != NULL) {
+			const GroupPtr &group = g_it2.getValue();
+			group->recycleProcessesExceedingMaxMemory(actions);
+			g_it2.next();
+		}
+
 		l.unlock();
 
 		UPDATE_TRACE_POINT();
@@ -51,7 +51,7 @@ void
 Pool::garbageCollect(PoolPtr self) {
 	TRACE_POINT();
 	{
-		ScopedLock lock(self->syncher);
+		PoolScopedLock lock(self->syncher);
 		self->garbageCollectionCond.timed_wait(lock,
 			posix_time::seconds(5));
 	}
@@ -60,7 +60,7 @@ Pool::garbageCollect(PoolPtr self) {
 			UPDATE_TRACE_POINT();
 			unsigned long long sleepTime = self->realGarbageCollect();
 			UPDATE_TRACE_POINT();
-			ScopedLock lock(self->syncher);
+			PoolScopedLock lock(self->syncher);
 			self->garbageCollectionCond.timed_wait(lock,
 				posix_time::microseconds(sleepTime));
 		} catch (const thread_interrupted &) {
@@ -110,13 +110,63 @@ Pool::garbageCollectProcessesInGroup(GarbageCollectorState &state,
 			processesToGc);
 	}
 
+	// Standby processes don't count towards minProcesses here, otherwise
+	// they would cause the enabled processes to be garbage collected.
+	p_it  = processesToGc.begin();
+	p_end = processesToGc.end();
+	while (p_it != p_end
+	 && (unsigned long) (group->getProcessCount() - group->standbyCount)
+		> group->options.minProcesses)
+	{
+		ProcessPtr process = *p_it;
+		if (group->enabledCount > 1
+		 && !group->standbyProcessesSatisfied()
+		 && process->oobwStatus == Process::OOBW_NOT_ACTIVE)
+		{
+			// Keep the idle process around as a standby process instead
+			// of shutting it down and spawning a new one later.
+			group->putOnStandby(process);
+		} else {
+			P_DEBUG("Garbage collect idle process: " << process->inspect() <<
+				", group=" << group->getName());
+			group->detach(process, state.actions);
+		}
+		p_it++;
+	}
+
+	garbageCollectStandbyProcessesInGroup(state, group);
+}
+
+/**
+ * Standby processes are idle by design, so they are only garbage collected
+ * if the group has more of them than configured, or if the group has no
+ * enabled processes left, i.e. when the entire application has become idle.
+ */
+void
+Pool::garbageCollectStandbyProcessesInGroup(GarbageCollectorState &state,
+	const GroupPtr &group)
+{
+	ProcessList processesToGc;
+	ProcessList::iterator p_it, p_end;
+
+	if (group->enabledCount == 0) {
+		p_end = group->standbyProcesses.end();
+		for (p_it = group->standbyProcesses.begin(); p_it != p_end; p_it++) {
+			checkWhetherProcessCanBeGarbageCollected(state, group, *p_it,
+				processesToGc);
+		}
+	} else if ((unsigned int) group->standbyCount > group->options.standbyProcesses) {
+		processesToGc.assign(group->standbyProcesses.begin()
+			+ group->options.standbyProcesses, group->standbyProcesses.end());
+	}
+
 	p_it  = processesToGc.begin();
 	p_end = processesToGc.end();
 	while (p_it != p_end
 	 && (unsigned long) group->getProcessCount() > group->options.minProcesses)
 	{
 		ProcessPtr process = *p_it;
-		P_DEBUG("Garbage collect idle process: " << process->inspect() <<
+		P_DEBUG("Garbage collect standby process: " << process->inspect() <<
 			", group=" << group->getName());
 		group->detach(process, state.actions);
 		p_it++;
@@ -141,7 +191,7 @@ Pool::maybeCleanPreloader(GarbageCollectorState &state, const GroupPtr &group) {
 unsigned long long
 Pool::realGarbageCollect() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	GroupMap::ConstIterator g_it(groups);
 	GarbageCollectorState state;
 	state.now = SystemTime::getUsec();
@@ -47,7 +47,7 @@ using namespace boost;
 
 const pair<uid_t, gid_t>
 Pool::getGroupRunUidAndGids(const StaticString &appGroupName) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	GroupPtr *group;
 	if (!groups.lookup(appGroupName.c_str(), &group)) {
 		throw RuntimeException("Could not find group: " + appGroupName);
@@ -106,6 +106,25 @@ Pool::createGroupAndAsyncGetFromIt(const Options &options,
 	return group;
 }
 
+/**
+ * Tries to check out a session from an existing Group while only holding the
+ * pool lock in shared mode, so that checkouts from unrelated Groups don't
+ * serialize on each other. Returns NULL if that isn't possible without changing
+ * the structure of the pool (e.g. the Group doesn't exist yet, has to spawn a
+ * process, or all its processes are totally busy). The caller should then fall
+ * back to the code path that locks the pool exclusively.
+ */
+SessionPtr
+Pool::getFromExistingGroupQuickly(const Options &options) {
+	PoolSharedLock l(syncher);
+	GroupPtr *group;
+	if (groups.lookup(options.getAppGroupName(), &group)) {
+		return (*group)->getQuickly(options);
+	} else {
+		return SessionPtr();
+	}
+}
+
 /**
  * Forcefully destroys and detaches the given Group. After detaching
  * the Group may have a non-empty getWaitlist so be sure to do
@@ -125,6 +144,9 @@ Pool::forceDetachGroup(const GroupPtr &group,
 	assert(removed);
 	(void) removed; // Shut up compiler warning.
 	group->shutdown(callback, postLockActions);
+	if (groupDetachedCallback) {
+		groupDetachedCallback(group);
+	}
 }
 
 void
@@ -157,7 +179,7 @@ Pool::findOrCreateGroup(const Options &options) {
 
 	Ticket ticket;
 	{
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		GroupPtr *group;
 		if (!groups.lookup(options.getAppGroupName(), &group)) {
 			// Forcefully create Group, don't care whether resource limits
@@ -170,7 +192,7 @@ Pool::findOrCreateGroup(const Options &options) {
 
 GroupPtr
 Pool::findGroupByApiKey(const StaticString &value, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -185,7 +207,7 @@ Pool::findGroupByApiKey(const StaticString &value, bool lock) const {
 bool
 Pool::detachGroupByName(const HashedStaticString &name) {
 	TRACE_POINT();
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	GroupPtr group = groups.lookupCopy(name);
 
 	if (OXT_LIKELY(group != NULL)) {
@@ -228,7 +250,7 @@ Pool::detachGroupByName(const HashedStaticString &name) {
 
 bool
 Pool::detachGroupByApiKey(const StaticString &value) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	GroupPtr group = findGroupByApiKey(value, false);
 	if (group != NULL) {
 		string name = group->getName();
@@ -242,7 +264,7 @@ Pool::detachGroupByApiKey(const StaticString &value) {
 
 bool
 Pool::restartGroupByName(const StaticString &name, const RestartOptions &options) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -265,7 +287,7 @@ Pool::restartGroupByName(const StaticString &name, const RestartOptions &options
 
 unsigned int
 Pool::restartGroupsByAppRoot(const StaticString &appRoot, const RestartOptions &options) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	GroupMap::ConstIterator g_it(groups);
 	unsigned int result = 0;
 
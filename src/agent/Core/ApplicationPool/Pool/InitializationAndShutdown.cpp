@@ -40,7 +40,8 @@ using namespace boost;
 
 Pool::Pool(Context *_context)
 	: context(_context),
-	  abortLongRunningConnectionsCallback(NULL)
+	  abortLongRunningConnectionsCallback(NULL),
+	  groupDetachedCallback(NULL)
 {
 	try {
 		systemMetricsCollector.collect(systemMetrics);
@@ -71,14 +72,14 @@ Pool::~Pool() {
 /** Must be called right after construction. */
 void
 Pool::initialize() {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	initializeAnalyticsCollection();
 	initializeGarbageCollection();
 }
 
 void
 Pool::initDebugging() {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	debugSupport = boost::make_shared<DebugSupport>();
 }
 
@@ -92,7 +93,7 @@ Pool::initDebugging() {
 void
 Pool::prepareForShutdown() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	assert(lifeStatus == ALIVE);
 	lifeStatus = PREPARED_FOR_SHUTDOWN;
 	if (abortLongRunningConnectionsCallback) {
@@ -109,7 +110,7 @@ Pool::prepareForShutdown() {
 void
 Pool::destroy() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	assert(lifeStatus == ALIVE || lifeStatus == PREPARED_FOR_SHUTDOWN);
 
 	lifeStatus = SHUTTING_DOWN;
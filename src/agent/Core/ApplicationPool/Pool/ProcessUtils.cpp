@@ -49,7 +49,25 @@ ProcessPtr
 Pool::findOldestIdleProcess(const Group *exclude) const {
 	ProcessPtr oldestIdleProcess;
 
+	// Standby processes are the cheapest to give up, so prefer them.
 	GroupMap::ConstIterator g_it(groups);
+	while (*g_it != NULL) {
+		const GroupPtr &group = g_it.getValue();
+		if (group.get() != exclude && group->standbyCount > 0 && group->getWaitlist.empty()) {
+			const ProcessPtr &process = group->standbyProcesses.front();
+			if (oldestIdleProcess == NULL
+			 || process->lastUsed < oldestIdleProcess->lastUsed)
+			{
+				oldestIdleProcess = process;
+			}
+		}
+		g_it.next();
+	}
+	if (oldestIdleProcess != NULL) {
+		return oldestIdleProcess;
+	}
+
+	g_it = GroupMap::ConstIterator(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
 		if (group.get() == exclude) {
@@ -194,7 +212,7 @@ Pool::possiblySpawnMoreProcessesForExistingGroups() {
 
 vector<ProcessPtr>
 Pool::getProcesses(bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	vector<ProcessPtr> result;
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
@@ -210,6 +228,9 @@ Pool::getProcesses(bool lock) const {
 		for (p_it = group->disabledProcesses.begin(); p_it != group->disabledProcesses.end(); p_it++) {
 			result.push_back(*p_it);
 		}
+		for (p_it = group->standbyProcesses.begin(); p_it != group->standbyProcesses.end(); p_it++) {
+			result.push_back(*p_it);
+		}
 
 		g_it.next();
 	}
@@ -244,7 +265,7 @@ Pool::findProcessByPid(pid_t pid, bool lock) const {
 
 bool
 Pool::detachProcess(const ProcessPtr &process) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	boost::container::vector<Callback> actions;
 	bool result = detachProcessUnlocked(process, actions);
 	fullVerifyInvariants();
@@ -255,7 +276,7 @@ Pool::detachProcess(const ProcessPtr &process) {
 
 bool
 Pool::detachProcess(pid_t pid, const AuthenticationOptions &options) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	ProcessPtr process = findProcessByPid(pid, false);
 	if (process != NULL) {
 		const Group *group = process->getGroup();
@@ -278,7 +299,7 @@ Pool::detachProcess(pid_t pid, const AuthenticationOptions &options) {
 
 bool
 Pool::detachProcess(const string &gupid, const AuthenticationOptions &options) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	ProcessPtr process = findProcessByGupid(gupid, false);
 	if (process != NULL) {
 		const Group *group = process->getGroup();
@@ -301,7 +322,7 @@ Pool::detachProcess(const string &gupid, const AuthenticationOptions &options) {
 
 DisableResult
 Pool::disableProcess(const StaticString &gupid) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	ProcessPtr process = findProcessByGupid(gupid, false);
 	if (process != NULL) {
 		Group *group = process->getGroup();
@@ -68,6 +68,25 @@ Pool::atFullCapacityUnlocked() const {
 	return capacityUsedUnlocked() >= max;
 }
 
+void
+Pool::snapshotProcessMetrics(vector<ProcessMetricsSnapshot> &result,
+	const ProcessList &processes)
+{
+	ProcessList::const_iterator p_it, p_end = processes.end();
+	for (p_it = processes.begin(); p_it != p_end; p_it++) {
+		const ProcessPtr &process = *p_it;
+		ProcessMetricsSnapshot snapshot;
+
+		snapshot.pid = process->getPid();
+		snapshot.sessions = process->sessions;
+		snapshot.busyness = process->busyness();
+		snapshot.processed = process->processed;
+		snapshot.spawnDuration = process->getSpawnDuration();
+		snapshot.enabled = process->enabled == Process::ENABLED;
+		result.push_back(snapshot);
+	}
+}
+
 void
 Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
 	const Group *group, const ProcessList &processes) const
@@ -103,6 +122,8 @@ Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
 			result << "    Disabling..." << endl;
 		} else if (process->enabled == Process::DISABLED) {
 			result << "    DISABLED" << endl;
+		} else if (process->enabled == Process::STANDBY) {
+			result << "    Standby" << endl;
 		} else if (process->enabled == Process::DETACHED) {
 			result << "    Shutting down..." << endl;
 		}
@@ -125,7 +146,7 @@ Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
 
 string
 Pool::inspect(const InspectOptions &options, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	stringstream result;
 	const char *headerColor = maybeColorize(options, ANSI_COLOR_YELLOW ANSI_COLOR_BLUE_BG ANSI_COLOR_BOLD);
 	const char *resetColor  = maybeColorize(options, ANSI_COLOR_RESET);
@@ -181,6 +202,7 @@ Pool::inspect(const InspectOptions &options, bool lock) const {
 		inspectProcessList(options, result, group.get(), group->enabledProcesses);
 		inspectProcessList(options, result, group.get(), group->disablingProcesses);
 		inspectProcessList(options, result, group.get(), group->disabledProcesses);
+		inspectProcessList(options, result, group.get(), group->standbyProcesses);
 		inspectProcessList(options, result, group.get(), group->detachedProcesses);
 		result << endl;
 
@@ -191,7 +213,7 @@ Pool::inspect(const InspectOptions &options, bool lock) const {
 
 string
 Pool::toXml(const ToXmlOptions &options, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	stringstream result;
 	GroupMap::ConstIterator g_it(groups);
 	ProcessList::const_iterator p_it;
@@ -258,9 +280,57 @@ Pool::toXml(const ToXmlOptions &options, bool lock) const {
 	return result.str();
 }
 
+/**
+ * Takes a snapshot of the per-group and per-process numbers that the /metrics
+ * endpoint reports. Unlike toXml() and inspect(), this only locks the pool in
+ * shared mode, plus every Group's `sessionSyncher` while its numbers are being
+ * copied, so it doesn't block session checkouts and doesn't format anything
+ * while holding a lock.
+ */
+vector<Pool::GroupMetricsSnapshot>
+Pool::snapshotMetrics(const AuthenticationOptions &options) const {
+	PoolSharedLock l(syncher);
+	vector<GroupMetricsSnapshot> result;
+	GroupMap::ConstIterator g_it(groups);
+
+	if (!authorizeByUid(options.uid, false)
+	 && !authorizeByApiKey(options.apiKey, false))
+	{
+		throw SecurityException("Operation unauthorized");
+	}
+
+	result.reserve(groups.size());
+	while (*g_it != NULL) {
+		const GroupPtr &group = g_it.getValue();
+		if (!group->authorizeByUid(options.uid)
+		 && !group->authorizeByApiKey(options.apiKey))
+		{
+			g_it.next();
+			continue;
+		}
+
+		result.push_back(GroupMetricsSnapshot());
+		GroupMetricsSnapshot &groupSnapshot = result.back();
+		groupSnapshot.name = group->getName();
+
+		boost::lock_guard<boost::mutex> groupLock(group->sessionSyncher);
+		groupSnapshot.queueLength = group->getWaitlist.size();
+		groupSnapshot.processesBeingSpawned = group->processesBeingSpawned;
+		groupSnapshot.processes.reserve(group->getProcessCount());
+		snapshotProcessMetrics(groupSnapshot.processes, group->enabledProcesses);
+		snapshotProcessMetrics(groupSnapshot.processes, group->disablingProcesses);
+		snapshotProcessMetrics(groupSnapshot.processes, group->disabledProcesses);
+		snapshotProcessMetrics(groupSnapshot.processes, group->standbyProcesses);
+
+		g_it.next();
+	}
+
+	return result;
+}
+
 Json::Value
 Pool::inspectPropertiesInAdminPanelFormat(const ToJsonOptions &options) const {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	Json::Value result(Json::objectValue);
 	GroupMap::ConstIterator g_it(groups);
 	ProcessList::const_iterator p_it;
@@ -301,7 +371,7 @@ Pool::inspectPropertiesInAdminPanelFormat(const ToJsonOptions &options) const {
 
 Json::Value
 Pool::inspectConfigInAdminPanelFormat(const ToJsonOptions &options) const {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	Json::Value result(Json::objectValue);
 	GroupMap::ConstIterator g_it(groups);
 	ProcessList::const_iterator p_it;
@@ -390,13 +460,13 @@ Pool::makeSingleNonEmptyStrValueJsonConfigFormat(const StaticString &val) {
 
 unsigned int
 Pool::capacityUsed() const {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	return capacityUsedUnlocked();
 }
 
 bool
 Pool::atFullCapacity() const {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	return atFullCapacityUnlocked();
 }
 
@@ -407,7 +477,7 @@ Pool::atFullCapacity() const {
  */
 unsigned int
 Pool::getProcessCount(bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	unsigned int result = 0;
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
@@ -420,7 +490,7 @@ Pool::getProcessCount(bool lock) const {
 
 unsigned int
 Pool::getGroupCount() const {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	return groups.size();
 }
 
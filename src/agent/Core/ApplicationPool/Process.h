@@ -42,6 +42,7 @@
 #include <cstring>
 #include <Constants.h>
 #include <FileDescriptor.h>
+#include <Algorithms/MovingAverage.h>
 #include <LoggingKit/LoggingKit.h>
 #include <SystemTools/ProcessMetricsCollector.h>
 #include <SystemTools/SystemTime.h>
@@ -390,6 +391,11 @@ public:
 	int sessions;
 	/** Number of sessions opened so far. */
 	unsigned int processed;
+	/**
+	 * Peak-sensitive moving average of the time (in microseconds) between
+	 * opening and closing a session. Used by latency-aware routing.
+	 */
+	PeakExpMovingAverage<1000000> latency;
 	/** Do not access directly, always use `isAlive()`/`isDead()`/`getLifeStatus()` or
 	 * through `lifetimeSyncher`. */
 	enum LifeStatus {
@@ -419,6 +425,11 @@ public:
 		 * the Out-of-Band-Work trigger.
 		 */
 		DISABLED,
+		/** Process is fully spawned and idle, but is kept in reserve by
+		 * the containing Group. It is not routed to until the Group
+		 * promotes it to an enabled process.
+		 */
+		STANDBY,
 		/**
 		 * Process has been detached. It will be removed from the Group
 		 * as soon we have detected that the OS process has exited. Detached
@@ -441,6 +452,9 @@ public:
 	/** Caches whether or not the OS process still exists. */
 	mutable bool m_osProcessExists: 1;
 	bool longRunningConnectionsAborted: 1;
+	/** Whether this process is being replaced because it uses more memory
+	 * than `Options::maxMemory` allows. See `Group::recycleProcessesExceedingMaxMemory()`. */
+	bool recyclingBecauseOfMaxMemory: 1;
 	/** Time at which shutdown began. */
 	time_t shutdownStartTime;
 	/** Collected by Pool::collectAnalytics(). */
@@ -465,6 +479,7 @@ public:
 		  oobwStatus(OOBW_NOT_ACTIVE),
 		  m_osProcessExists(true),
 		  longRunningConnectionsAborted(false),
+		  recyclingBecauseOfMaxMemory(false),
 		  shutdownStartTime(0)
 	{
 		initializeSocketsAndStringFields(args);
@@ -490,6 +505,7 @@ public:
 		  oobwStatus(OOBW_NOT_ACTIVE),
 		  m_osProcessExists(true),
 		  longRunningConnectionsAborted(false),
+		  recyclingBecauseOfMaxMemory(false),
 		  shutdownStartTime(0)
 	{
 		initializeSocketsAndStringFields(skResult);
@@ -673,6 +689,15 @@ public:
 		return spawnerCreationTime;
 	}
 
+	/** How long spawning this process took, in microseconds, or 0 if unknown. */
+	unsigned long long getSpawnDuration() const {
+		if (spawnStartTime != 0 && spawnEndTime > spawnStartTime) {
+			return spawnEndTime - spawnStartTime;
+		} else {
+			return 0;
+		}
+	}
+
 	bool isDummy() const {
 		return type == SpawningKit::Result::DUMMY;
 	}
@@ -804,11 +829,11 @@ public:
 			} else {
 				lastUsed = SystemTime::getUsec();
 			}
-			return createSessionObject(socket);
+			return createSessionObject(socket, lastUsed);
 		}
 	}
 
-	SessionPtr createSessionObject(Socket *socket) {
+	SessionPtr createSessionObject(Socket *socket, unsigned long long now = 0) {
 		struct Guard {
 			Context *context;
 			Session *session;
@@ -833,7 +858,7 @@ public:
 		LockGuard l(context->memoryManagementSyncher);
 		Session *session = context->sessionObjectPool.malloc();
 		Guard guard(context, session);
-		session = new (session) Session(context, &info, socket);
+		session = new (session) Session(context, &info, socket, now);
 		guard.clear();
 		return SessionPtr(session, false);
 	}
@@ -848,6 +873,13 @@ public:
 		this->sessions--;
 		processed++;
 		assert(!isTotallyBusy());
+
+		if (session->getStartTime() != 0) {
+			unsigned long long now = SystemTime::getUsec();
+			if (now > session->getStartTime()) {
+				latency.update(now - session->getStartTime(), now);
+			}
+		}
 	}
 
 	/**
@@ -873,6 +905,9 @@ public:
 		stream << "<sessions>" << sessions << "</sessions>";
 		stream << "<busyness>" << busyness() << "</busyness>";
 		stream << "<processed>" << processed << "</processed>";
+		if (latency.available()) {
+			stream << "<latency>" << (unsigned long long) latency.average() << "</latency>";
+		}
 		stream << "<spawner_creation_time>" << spawnerCreationTime << "</spawner_creation_time>";
 		stream << "<spawn_start_time>" << spawnStartTime << "</spawn_start_time>";
 		stream << "<spawn_end_time>" << spawnEndTime << "</spawn_end_time>";
@@ -905,6 +940,9 @@ public:
 		case DISABLED:
 			stream << "<enabled>DISABLED</enabled>";
 			break;
+		case STANDBY:
+			stream << "<enabled>STANDBY</enabled>";
+			break;
 		case DETACHED:
 			stream << "<enabled>DETACHED</enabled>";
 			break;
@@ -87,6 +87,8 @@ private:
 	Connection connection;
 	mutable boost::atomic<int> refcount;
 	bool closed;
+	/** The time at which this session was checked out, in microseconds. 0 if unknown. */
+	unsigned long long startTime;
 
 	void deinitiate(bool success, bool wantKeepAlive) {
 		connection.fail = !success;
@@ -118,12 +120,14 @@ public:
 	Callback onInitiateFailure;
 	Callback onClose;
 
-	Session(Context *_context, const BasicProcessInfo *_processInfo, Socket *_socket)
+	Session(Context *_context, const BasicProcessInfo *_processInfo, Socket *_socket,
+		unsigned long long _startTime = 0)
 		: context(_context),
 		  processInfo(_processInfo),
 		  socket(_socket),
 		  refcount(1),
 		  closed(false),
+		  startTime(_startTime),
 		  onInitiateFailure(NULL),
 		  onClose(NULL)
 		{ }
@@ -176,6 +180,10 @@ public:
 		return socket;
 	}
 
+	unsigned long long getStartTime() const {
+		return startTime;
+	}
+
 	virtual StaticString getProtocol() const {
 		return getSocket()->protocol;
 	}
@@ -196,6 +204,39 @@ public:
 		this->connection = connection;
 	}
 
+	virtual bool initiateNonBlocking() {
+		assert(!closed);
+		ScopeGuard g(boost::bind(&Session::callOnInitiateFailure, this));
+		Connection connection = socket->checkoutConnectionNonBlocking();
+		connection.fail = true;
+		if (connection.blocking) {
+			FdGuard g2(connection.fd, NULL, 0);
+			setNonBlocking(connection.fd);
+			g2.clear();
+			connection.blocking = false;
+		}
+		g.clear();
+		this->connection = connection;
+		return !connection.connecting;
+	}
+
+	virtual bool continueInitiate() {
+		assert(!closed);
+		assert(connection.connecting);
+		ScopeGuard g(boost::bind(&Session::abortInitiate, this));
+		bool result = socket->continueConnecting(connection);
+		g.clear();
+		return result;
+	}
+
+	virtual void abortInitiate() {
+		assert(!closed);
+		if (initiated()) {
+			deinitiate(false, false);
+		}
+		callOnInitiateFailure();
+	}
+
 	bool initiated() const {
 		return connection.fd != -1;
 	}
@@ -52,12 +52,15 @@ struct Connection {
 	bool wantKeepAlive: 1;
 	bool fail: 1;
 	bool blocking: 1;
+	/** Whether a non-blocking connect on this connection is still in progress. */
+	bool connecting: 1;
 
 	Connection()
 		: fd(-1),
 		  wantKeepAlive(false),
 		  fail(false),
-		  blocking(true)
+		  blocking(true),
+		  connecting(false)
 		{ }
 
 	void close() {
@@ -96,6 +99,25 @@ private:
 		return connection;
 	}
 
+	Connection connectNonBlocking() const {
+		Connection connection;
+		NConnect_State state;
+		P_TRACE(3, "Connecting to " << address << " (non-blocking)");
+		setupNonBlockingSocket(state, address, __FILE__, __LINE__);
+		bool connected = connectToServer(state);
+		if (state.type == SAT_UNIX) {
+			connection.fd = state.s_unix.fd.detach();
+		} else {
+			connection.fd = state.s_tcp.fd.detach();
+		}
+		connection.fail = true;
+		connection.wantKeepAlive = false;
+		connection.blocking = false;
+		connection.connecting = !connected;
+		P_LOG_FILE_DESCRIPTOR_PURPOSE(connection.fd, "App " << pid << " connection");
+		return connection;
+	}
+
 public:
 	// Socket properties. Read-only.
 	StaticString address;
@@ -190,10 +212,59 @@ public:
 		}
 	}
 
+	/**
+	 * Like checkoutConnection(), but never blocks on connecting. If a new
+	 * connection has to be established, then the returned Connection is
+	 * non-blocking and may still be connecting (`connection.connecting`), in
+	 * which case one must call continueConnecting() until it returns true.
+	 *
+	 * Idle connections in the connection pool may be blocking.
+	 */
+	Connection checkoutConnectionNonBlocking() {
+		boost::unique_lock<boost::mutex> l(connectionPoolLock);
+
+		if (!idleConnections.empty()) {
+			P_TRACE(3, "Socket " << address << ": checking out connection from connection pool (" <<
+				idleConnections.size() << " -> " << (idleConnections.size() - 1) <<
+				" items). Current total number of connections: " << totalConnections);
+			Connection connection = idleConnections.back();
+			idleConnections.pop_back();
+			totalIdleConnections--;
+			return connection;
+		} else {
+			Connection connection = connectNonBlocking();
+			totalConnections++;
+			P_TRACE(3, "Socket " << address << ": there are now " <<
+				totalConnections << " total connections");
+			l.unlock();
+			return connection;
+		}
+	}
+
+	/**
+	 * Checks whether a connection returned by checkoutConnectionNonBlocking()
+	 * has finished connecting. Call this when the connection's file descriptor
+	 * has become writable. Returns whether the connection is now established.
+	 *
+	 * @throws SystemException Connecting failed. The connection must still
+	 *                         be checked in.
+	 */
+	bool continueConnecting(Connection &connection) const {
+		assert(connection.connecting);
+		if (finishConnectingToServer(connection.fd, address)) {
+			connection.connecting = false;
+			return true;
+		} else {
+			return false;
+		}
+	}
+
 	void checkinConnection(Connection &connection) {
 		boost::unique_lock<boost::mutex> l(connectionPoolLock);
 
-		if (connection.fail || !connection.wantKeepAlive || totalIdleConnections >= connectionPoolLimit()) {
+		if (connection.fail || !connection.wantKeepAlive || connection.connecting
+		 || totalIdleConnections >= connectionPoolLimit())
+		{
 			totalConnections--;
 			assert(totalConnections >= 0);
 			P_TRACE(3, "Socket " << address << ": connection not checked back into "
@@ -88,6 +88,7 @@ using namespace std;
  *   api_server_file_buffered_channel_auto_truncate_file             boolean            -          default(true)
  *   api_server_file_buffered_channel_buffer_dir                     string             -          default
  *   api_server_file_buffered_channel_delay_in_file_mode_switching   unsigned integer   -          default(0)
+ *   api_server_file_buffered_channel_io_uring                       boolean            -          default(false)
  *   api_server_file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -          default(0)
  *   api_server_file_buffered_channel_threshold                      unsigned integer   -          default(131072)
  *   api_server_mbuf_block_chunk_size                                unsigned integer   -          default(4096),read_only
@@ -105,11 +106,13 @@ using namespace std;
  *   controller_file_buffered_channel_auto_truncate_file             boolean            -          default(true)
  *   controller_file_buffered_channel_buffer_dir                     string             -          default
  *   controller_file_buffered_channel_delay_in_file_mode_switching   unsigned integer   -          default(0)
+ *   controller_file_buffered_channel_io_uring                       boolean            -          default(false)
  *   controller_file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -          default(0)
  *   controller_file_buffered_channel_threshold                      unsigned integer   -          default(131072)
  *   controller_mbuf_block_chunk_size                                unsigned integer   -          default(4096),read_only
  *   controller_min_spare_clients                                    unsigned integer   -          default(0)
  *   controller_request_freelist_limit                               unsigned integer   -          default(1024)
+ *   controller_reuse_port                                           boolean            -          default(false),read_only
  *   controller_secure_headers_password                              any                -          secret
  *   controller_socket_backlog                                       unsigned integer   -          default(2048),read_only
  *   controller_start_reading_after_accept                           boolean            -          default(true)
@@ -122,6 +125,7 @@ using namespace std;
  *   default_friendly_error_pages                                    string             -          default("auto")
  *   default_group                                                   string             -          default
  *   default_load_shell_envvars                                      boolean            -          default(false)
+ *   default_max_memory                                              unsigned integer   -          default(0)
  *   default_max_preloader_idle_time                                 unsigned integer   -          default(300)
  *   default_max_request_queue_size                                  unsigned integer   -          default(100)
  *   default_max_requests                                            unsigned integer   -          default(0)
@@ -129,10 +133,15 @@ using namespace std;
  *   default_min_instances                                           unsigned integer   -          default(1)
  *   default_nodejs                                                  string             -          default("node")
  *   default_python                                                  string             -          default("python")
+ *   default_python_smart_spawning                                   boolean            -          default(false)
+ *   default_python_thread_count                                     unsigned integer   -          default(1)
+ *   default_routing_method                                          string             -          default("least_busy")
  *   default_ruby                                                    string             -          default("ruby")
  *   default_server_name                                             string             -          default
  *   default_server_port                                             unsigned integer   -          default
+ *   default_spawn_concurrency                                       unsigned integer   -          default(1)
  *   default_spawn_method                                            string             -          default("smart")
+ *   default_standby_processes                                       unsigned integer   -          default(0)
  *   default_sticky_sessions                                         boolean            -          default(false)
  *   default_sticky_sessions_cookie_attributes                       string             -          default("SameSite=Lax; Secure;")
  *   default_sticky_sessions_cookie_name                             string             -          default("_passenger_route")
@@ -147,6 +156,7 @@ using namespace std;
  *   hook_spawn_failed                                               string             -          read_only
  *   instance_dir                                                    string             -          read_only
  *   integration_mode                                                string             -          default("standalone")
+ *   location_configs                                                array of strings   -          default("[FILTERED]"),secret,read_only
  *   log_level                                                       string             -          default("notice")
  *   log_target                                                      any                -          default({"stderr": true})
  *   max_instances_per_app                                           unsigned integer   -          read_only
@@ -159,11 +169,17 @@ using namespace std;
  *   pool_selfchecks                                                 boolean            -          default(false)
  *   prestart_urls                                                   array of strings   -          default([]),read_only
  *   response_buffer_high_watermark                                  unsigned integer   -          default(134217728)
+ *   response_compression                                            boolean            -          default(false)
+ *   response_compression_level                                      unsigned integer   -          default(6)
+ *   response_compression_min_size                                   unsigned integer   -          default(1024)
+ *   response_compression_types                                      array of strings   -          default(["text/html","text/css","text/plain","text/xml","text/javascript","application/javascript","application/json","application/xml","application/rss+xml","image/svg+xml"])
+ *   response_splice_min_size                                        unsigned integer   -          default(131072)
  *   security_update_checker_certificate_path                        string             -          -
  *   security_update_checker_disabled                                boolean            -          default(false)
  *   security_update_checker_interval                                unsigned integer   -          default(86400)
  *   security_update_checker_proxy_url                               string             -          -
  *   security_update_checker_url                                     string             -          default("https://securitycheck.phusionpassenger.com/v1/check.json")
+ *   sendfile_roots                                                  array of strings   -          default([])
  *   server_software                                                 string             -          default("Phusion_Passenger/6.0.10")
  *   show_version_in_header                                          boolean            -          default(true)
  *   single_app_mode_app_root                                        string             -          default,read_only
@@ -184,6 +200,8 @@ using namespace std;
  *   telemetry_collector_timeout                                     unsigned integer   -          default(180)
  *   telemetry_collector_url                                         string             -          default("https://anontelemetry.phusionpassenger.com/v1/collect.json")
  *   telemetry_collector_verify_server                               boolean            -          default(true)
+ *   turbocache_max_entries                                          unsigned integer   -          default(1024),read_only
+ *   turbocache_max_size                                             unsigned integer   -          default(16777216),read_only
  *   turbocaching                                                    boolean            -          default(true),read_only
  *   user_switching                                                  boolean            -          default(true)
  *   vary_turbocache_by_cookie                                       string             -          -
@@ -498,6 +516,7 @@ public:
 		add("controller_addresses", STRING_ARRAY_TYPE, OPTIONAL | READ_ONLY, getDefaultControllerAddresses());
 		add("api_server_addresses", STRING_ARRAY_TYPE, OPTIONAL | READ_ONLY, Json::arrayValue);
 		add("controller_cpu_affine", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
+		add("controller_reuse_port", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
 		add("file_descriptor_ulimit", UINT_TYPE, OPTIONAL | READ_ONLY, 0);
 
 		add("hook_attached_process", STRING_TYPE, OPTIONAL | READ_ONLY);
@@ -52,7 +52,12 @@
 #endif
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <sys/uio.h>
+#include <fcntl.h>
+#ifdef __linux__
+	#include <sys/sendfile.h>
+#endif
 #include <utility>
 #include <typeinfo>
 #include <cstdio>
@@ -83,6 +88,8 @@
 #include <Core/Controller/Client.h>
 #include <Core/Controller/AppResponse.h>
 #include <Core/Controller/TurboCaching.h>
+#include <Core/Controller/Metrics.h>
+#include <Core/Controller/ScgiHeaderNames.h>
 
 namespace Passenger {
 
@@ -112,6 +119,23 @@ private:
 	// If you change this value, make sure that Request::sessionCheckoutTry
 	// has enough bits.
 	static const unsigned int MAX_SESSION_CHECKOUT_TRY = 10;
+	// Maximum time, in seconds, that we wait for a connection to an
+	// application process to be established.
+	static const unsigned int APP_CONNECT_TIMEOUT = 30;
+	// If connecting to an application process hasn't finished yet, but we
+	// can't be notified of its completion (e.g. a Unix domain socket with a
+	// full backlog), then we try again after this many milliseconds.
+	static const unsigned int APP_CONNECT_RETRY_INTERVAL = 10;
+	// Maximum number of file bytes that we send to a client in one go when
+	// serving an X-Sendfile response, so that a fast client can't monopolize
+	// the event loop.
+	static const unsigned int SENDFILE_CHUNK_SIZE = 1024 * 1024;
+	// Maximum number of response body bytes that we relay with splice()
+	// in one go, for the same reason.
+	static const unsigned int SPLICE_CHUNK_SIZE = 1024 * 1024;
+	// Maximum number of app groups for which we keep separate request
+	// latency statistics.
+	static const unsigned int MAX_LATENCY_STATS_GROUPS = 256;
 
 	ControllerMainConfig mainConfig;
 	ControllerRequestConfigPtr requestConfig;
@@ -119,6 +143,7 @@ private:
 
 	HashedStaticString PASSENGER_APP_GROUP_NAME;
 	HashedStaticString PASSENGER_ENV_VARS;
+	HashedStaticString PASSENGER_LOCATION_CONFIG_ID;
 	HashedStaticString PASSENGER_MAX_REQUESTS;
 	HashedStaticString PASSENGER_SHOW_VERSION_IN_HEADER;
 	HashedStaticString PASSENGER_STICKY_SESSIONS;
@@ -131,10 +156,18 @@ private:
 	HashedStaticString FLAGS;
 	HashedStaticString HTTP_COOKIE;
 	HashedStaticString HTTP_DATE;
+	HashedStaticString HTTP_ACCEPT_ENCODING;
+	HashedStaticString HTTP_ACCEPT_RANGES;
+	HashedStaticString HTTP_CACHE_CONTROL;
+	HashedStaticString HTTP_CONTENT_ENCODING;
+	HashedStaticString HTTP_CONTENT_RANGE;
+	HashedStaticString HTTP_ETAG;
 	HashedStaticString HTTP_HOST;
 	HashedStaticString HTTP_CONTENT_LENGTH;
 	HashedStaticString HTTP_CONTENT_TYPE;
 	HashedStaticString HTTP_EXPECT;
+	HashedStaticString HTTP_IF_RANGE;
+	HashedStaticString HTTP_RANGE;
 	HashedStaticString HTTP_CONNECTION;
 	HashedStaticString HTTP_STATUS;
 	HashedStaticString HTTP_TRANSFER_ENCODING;
@@ -143,6 +176,10 @@ private:
 	friend class ResponseCache<Request>;
 	struct ev_check checkWatcher;
 	TurboCaching<Request> turboCaching;
+	ControllerMetrics metrics;
+	ScgiHeaderNames scgiHeaderNames;
+	RequestLatencyStats latencyStats;
+	StringKeyTable< boost::shared_ptr<RequestLatencyStats> > groupLatencyStats;
 	ConfigKit::Store *singleAppModeConfig;
 
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
@@ -160,6 +197,7 @@ private:
 
 	struct RequestAnalysis;
 
+	void initializeLocationConfig(Client *client, Request *req);
 	void initializeFlags(Client *client, Request *req, RequestAnalysis &analysis);
 	bool respondFromTurboCache(Client *client, Request *req);
 	void initializePoolOptions(Client *client, Request *req, RequestAnalysis &analysis);
@@ -183,6 +221,7 @@ private:
 		const HashedStaticString &appGroupName);
 	void setStickySessionId(Client *client, Request *req);
 	const LString *getStickySessionCookieName(Request *req);
+	bool clientAcceptsGzip(Request *req);
 
 
 	/****** Stage: buffering body ******/
@@ -204,6 +243,14 @@ private:
 		const AbstractSessionPtr &session, const ExceptionPtr &e);
 	void maybeSend100Continue(Client *client, Request *req);
 	void initiateSession(Client *client, Request *req);
+	void waitForAppConnection(Client *client, Request *req, bool pollWritability);
+	void stopWaitingForAppConnection(Request *req);
+	static void onAppConnectable(EV_P_ struct ev_io *io, int revents);
+	static void onAppConnectTimer(EV_P_ struct ev_timer *timer, int revents);
+	void continueInitiatingSession(Client *client, Request *req);
+	void sessionInitiated(Client *client, Request *req);
+	void handleSessionInitiationError(Client *client, Request *req,
+		const std::exception &e);
 	static void checkoutSessionLater(Request *req);
 	void reportSessionCheckoutError(Client *client, Request *req,
 		const ExceptionPtr &e);
@@ -291,6 +338,25 @@ private:
 	void handleAppResponseBodyEnd(Client *client, Request *req);
 	OXT_FORCE_INLINE void keepAliveAppConnection(Client *client, Request *req);
 	void storeAppResponseInTurboCache(Client *client, Request *req);
+	bool shouldCompressAppResponse(Request *req);
+	bool beginCompressingAppResponse(Request *req);
+	void compressAppResponseData(Client *client, Request *req,
+		const MemoryKit::mbuf &buffer, bool finish);
+	void finishCompressingAppResponse(Client *client, Request *req);
+	bool beginSendingFile(Client *client, Request *req, const LString *path);
+	const StaticString *findSendfileRoot(const StaticString &path) const;
+	int openFileInSendfileRoot(const StaticString &root, const string &path) const;
+	bool parseRangeHeader(Request *req, boost::uint64_t fileSize,
+		boost::uint64_t &offset, boost::uint64_t &length, bool &satisfiable);
+	void continueSendingFile(Client *client, Request *req);
+	void stopSendingFile(Request *req);
+	static void onClientWritableForSendfile(EV_P_ struct ev_io *io, int revents);
+	bool shouldSpliceAppResponse(Client *client, Request *req);
+	void beginSplicingAppResponse(Client *client, Request *req);
+	void continueSplicingAppResponse(Client *client, Request *req);
+	void stopSplicingAppResponse(Client *client, Request *req);
+	void stopSplicing(Request *req);
+	static void onAppReadableForSplice(EV_P_ struct ev_io *io, int revents);
 
 
 	/***** Hooks ******/
@@ -327,6 +393,7 @@ private:
 	static LString *resolveSymlink(const StaticString &path, psg_pool_t *pool);
 	void parseCookieHeader(psg_pool_t *pool, const LString *headerValue,
 		vector< pair<StaticString, StaticString> > &cookies) const;
+	void recordRequestLatency(Request *req);
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		void reportLargeTimeDiff(Client *client, const char *name,
 			ev_tstamp fromTime, ev_tstamp toTime);
@@ -362,6 +429,11 @@ protected:
 		ApplicationPool2::GetCallback callback);
 
 
+	/****** Also used by the benchmarks ******/
+
+	MemoryKit::mbuf constructSessionProtocolHeader(Request *req);
+
+
 public:
 	typedef ControllerConfigChangeRequest ConfigChangeRequest;
 
@@ -388,6 +460,7 @@ public:
 		  poolOptionsCache(4),
 
 		  turboCaching(),
+		  groupLatencyStats(4),
 		  singleAppModeConfig(NULL),
 		  resourceLocator(NULL)
 		  /**************************/
@@ -421,6 +494,8 @@ public:
 	/****** State and configuration ******/
 
 	unsigned int getThreadNumber() const; // Thread-safe
+	const ControllerMetrics &getMetrics() const; // Thread-safe
+	void snapshotRequestLatency(RequestLatencySnapshot &snapshot) const;
 	virtual Json::Value inspectStateAsJson() const;
 	virtual Json::Value inspectClientStateAsJson(const Client *client) const;
 	virtual Json::Value inspectRequestStateAsJson(const Request *req) const;
@@ -429,6 +504,7 @@ public:
 	/****** Miscellaneous *******/
 
 	void disconnectLongRunningConnections(const StaticString &gupid);
+	void forgetGroupLatencyStats(const HashedStaticString &groupName);
 };
 
 
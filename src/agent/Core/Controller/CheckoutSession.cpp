@@ -67,6 +67,11 @@ Controller::checkoutSession(Client *client, Request *req) {
 
 	options.currentTime = SystemTime::getUsec();
 
+	if (req->checkoutBegunAt == 0) {
+		// Retried checkouts are counted as part of the first one.
+		req->checkoutBegunAt = SystemTime::getMonotonicUsec();
+	}
+
 	refRequest(req, __FILE__, __LINE__);
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		req->timeBeforeAccessingApplicationPool = ev_now(getLoop());
@@ -135,6 +140,7 @@ Controller::sessionCheckedOutFromEventLoopThread(Client *client, Request *req,
 	#endif
 
 	if (e == NULL) {
+		req->checkedOutAt = SystemTime::getMonotonicUsec();
 		SKC_DEBUG(client, "Session checked out: pid=" << session->getPid() <<
 			", gupid=" << session->getGupid());
 		req->session = session;
@@ -177,26 +183,109 @@ Controller::initiateSession(Client *client, Request *req) {
 	TRACE_POINT();
 	req->sessionCheckoutTry++;
 	try {
-		req->session->initiate(false);
-	} catch (const SystemException &e2) {
-		if (req->sessionCheckoutTry < MAX_SESSION_CHECKOUT_TRY) {
-			SKC_DEBUG(client, "Error checking out session (" << e2.what() <<
-				"); retrying (attempt " << req->sessionCheckoutTry << ")");
-			refRequest(req, __FILE__, __LINE__);
-			getContext()->libev->runLater(boost::bind(checkoutSessionLater, req));
-		} else {
-			string message = "could not initiate a session (";
-			message.append(e2.what());
-			message.append(")");
-			disconnectWithError(&client, message);
+		if (!req->session->initiateNonBlocking()) {
+			// Connecting to the app may take a while, for example when its
+			// listen backlog is full. Don't block the event loop on that.
+			SKC_DEBUG(client, "Connecting to application process asynchronously");
+			req->state = Request::CONNECTING_TO_APP;
+			req->appConnectDeadline = ev_now(getLoop()) + APP_CONNECT_TIMEOUT;
+			waitForAppConnection(client, req, true);
+			return;
 		}
+	} catch (const std::exception &e2) {
+		handleSessionInitiationError(client, req, e2);
 		return;
 	}
 
 	UPDATE_TRACE_POINT();
+	sessionInitiated(client, req);
+}
 
-	UPDATE_TRACE_POINT();
+/**
+ * Waits until the connection to the application process may have been
+ * established, or until the connect deadline has passed, whichever comes
+ * first. If `pollWritability` is false, then we don't wait for the socket
+ * to become writable, but only until the retry interval has passed.
+ */
+void
+Controller::waitForAppConnection(Client *client, Request *req, bool pollWritability) {
+	ev_tstamp timeout = req->appConnectDeadline - ev_now(getLoop());
+
+	if (pollWritability) {
+		ev_io_set(&req->appConnectWatcher, req->session->fd(), EV_WRITE);
+		ev_io_start(getLoop(), &req->appConnectWatcher);
+	} else {
+		timeout = std::min<ev_tstamp>(timeout, APP_CONNECT_RETRY_INTERVAL / 1000.0);
+	}
+	ev_timer_set(&req->appConnectTimer, std::max<ev_tstamp>(timeout, 0), 0);
+	ev_timer_start(getLoop(), &req->appConnectTimer);
+}
+
+void
+Controller::stopWaitingForAppConnection(Request *req) {
+	ev_io_stop(getLoop(), &req->appConnectWatcher);
+	ev_timer_stop(getLoop(), &req->appConnectTimer);
+}
+
+void
+Controller::onAppConnectable(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppConnectable");
+
+	self->stopWaitingForAppConnection(req);
+	self->continueInitiatingSession(client, req);
+}
+
+void
+Controller::onAppConnectTimer(EV_P_ struct ev_timer *timer, int revents) {
+	Request *req = static_cast<Request *>(timer->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppConnectTimer");
+
+	self->stopWaitingForAppConnection(req);
+	self->continueInitiatingSession(client, req);
+}
+
+void
+Controller::continueInitiatingSession(Client *client, Request *req) {
+	if (req->ended()) {
+		return;
+	}
+
+	TRACE_POINT();
+	bool connected;
+	try {
+		connected = req->session->continueInitiate();
+	} catch (const std::exception &e) {
+		// We're called from an event loop watcher, so no exception may
+		// escape: the request would never be finished.
+		handleSessionInitiationError(client, req, e);
+		return;
+	}
+
+	if (connected) {
+		UPDATE_TRACE_POINT();
+		sessionInitiated(client, req);
+	} else if (ev_now(getLoop()) >= req->appConnectDeadline) {
+		UPDATE_TRACE_POINT();
+		req->session->abortInitiate();
+		handleSessionInitiationError(client, req,
+			SystemException("Timeout connecting to the application process",
+				ETIMEDOUT));
+	} else {
+		// Either a spurious wakeup, or a connect that we can't poll for.
+		waitForAppConnection(client, req, false);
+	}
+}
+
+void
+Controller::sessionInitiated(Client *client, Request *req) {
+	TRACE_POINT();
 	SKC_DEBUG(client, "Session initiated: fd=" << req->session->fd());
+	req->sessionInitiatedAt = SystemTime::getMonotonicUsec();
 	req->appSink.reinitialize(req->session->fd());
 	req->appSource.reinitialize(req->session->fd());
 	/***************/
@@ -205,6 +294,23 @@ Controller::initiateSession(Client *client, Request *req) {
 	sendHeaderToApp(client, req);
 }
 
+void
+Controller::handleSessionInitiationError(Client *client, Request *req,
+	const std::exception &e)
+{
+	if (req->sessionCheckoutTry < MAX_SESSION_CHECKOUT_TRY) {
+		SKC_DEBUG(client, "Error checking out session (" << e.what() <<
+			"); retrying (attempt " << req->sessionCheckoutTry << ")");
+		refRequest(req, __FILE__, __LINE__);
+		getContext()->libev->runLater(boost::bind(checkoutSessionLater, req));
+	} else {
+		string message = "could not initiate a session (";
+		message.append(e.what());
+		message.append(")");
+		disconnectWithError(&client, message);
+	}
+}
+
 void
 Controller::checkoutSessionLater(Request *req) {
 	Client *client = static_cast<Client *>(req->client);
@@ -247,7 +353,7 @@ Controller::writeRequestQueueFullExceptionErrorResponse(Client *client, Request
 	const boost::shared_ptr<RequestQueueFullException> &e)
 {
 	TRACE_POINT();
-	const LString *value = req->secureHeaders.lookup(
+	const LString *value = req->lookupSecureHeader(
 		"!~PASSENGER_REQUEST_QUEUE_OVERFLOW_STATUS_CODE");
 	int requestQueueOverflowStatusCode = 503;
 	if (value != NULL && value->size > 0) {
@@ -29,6 +29,7 @@
 #include <boost/bind/bind.hpp>
 #include <boost/intrusive_ptr.hpp>
 #include <boost/smart_ptr/intrusive_ref_counter.hpp>
+#include <vector>
 #include <string.h>
 #include <unistd.h>
 #include <sys/param.h>
@@ -36,8 +37,11 @@
 
 #include <ConfigKit/ConfigKit.h>
 #include <ConfigKit/SchemaUtils.h>
+#include <FileTools/PathManip.h>
 #include <MemoryKit/palloc.h>
 #include <ServerKit/HttpServer.h>
+#include <ServerKit/HeaderTable.h>
+#include <StrIntTools/StrIntUtils.h>
 #include <SystemTools/UserDatabase.h>
 #include <WrapperRegistry/Registry.h>
 #include <Constants.h>
@@ -93,6 +97,7 @@ parseControllerBenchmarkMode(const StaticString &mode) {
  *   default_friendly_error_pages                        string             -          default("auto")
  *   default_group                                       string             -          default
  *   default_load_shell_envvars                          boolean            -          default(false)
+ *   default_max_memory                                  unsigned integer   -          default(0)
  *   default_max_preloader_idle_time                     unsigned integer   -          default(300)
  *   default_max_request_queue_size                      unsigned integer   -          default(100)
  *   default_max_requests                                unsigned integer   -          default(0)
@@ -100,26 +105,40 @@ parseControllerBenchmarkMode(const StaticString &mode) {
  *   default_min_instances                               unsigned integer   -          default(1)
  *   default_nodejs                                      string             -          default("node")
  *   default_python                                      string             -          default("python")
+ *   default_python_smart_spawning                       boolean            -          default(false)
+ *   default_python_thread_count                         unsigned integer   -          default(1)
+ *   default_routing_method                              string             -          default("least_busy")
  *   default_ruby                                        string             -          default("ruby")
  *   default_server_name                                 string             required   -
  *   default_server_port                                 unsigned integer   required   -
+ *   default_spawn_concurrency                           unsigned integer   -          default(1)
  *   default_spawn_method                                string             -          default("smart")
+ *   default_standby_processes                           unsigned integer   -          default(0)
  *   default_sticky_sessions                             boolean            -          default(false)
  *   default_sticky_sessions_cookie_attributes           string             -          default("SameSite=Lax; Secure;")
  *   default_sticky_sessions_cookie_name                 string             -          default("_passenger_route")
  *   default_user                                        string             -          default("nobody")
  *   graceful_exit                                       boolean            -          default(true)
  *   integration_mode                                    string             -          default("standalone"),read_only
+ *   location_configs                                    array of strings   -          default("[FILTERED]"),secret,read_only
  *   max_instances_per_app                               unsigned integer   -          read_only
  *   min_spare_clients                                   unsigned integer   -          default(0)
  *   multi_app                                           boolean            -          default(true),read_only
  *   request_freelist_limit                              unsigned integer   -          default(1024)
  *   response_buffer_high_watermark                      unsigned integer   -          default(134217728)
+ *   response_compression                                boolean            -          default(false)
+ *   response_compression_level                          unsigned integer   -          default(6)
+ *   response_compression_min_size                       unsigned integer   -          default(1024)
+ *   response_compression_types                          array of strings   -          default(["text/html","text/css","text/plain","text/xml","text/javascript","application/javascript","application/json","application/xml","application/rss+xml","image/svg+xml"])
+ *   response_splice_min_size                            unsigned integer   -          default(131072)
+ *   sendfile_roots                                      array of strings   -          default([])
  *   server_software                                     string             -          default("Phusion_Passenger/6.0.10")
  *   show_version_in_header                              boolean            -          default(true)
  *   start_reading_after_accept                          boolean            -          default(true)
  *   stat_throttle_rate                                  unsigned integer   -          default(10)
  *   thread_number                                       unsigned integer   required   read_only
+ *   turbocache_max_entries                              unsigned integer   -          default(1024),read_only
+ *   turbocache_max_size                                 unsigned integer   -          default(16777216),read_only
  *   turbocaching                                        boolean            -          default(true),read_only
  *   user_switching                                      boolean            -          default(true)
  *   vary_turbocache_by_cookie                           string             -          -
@@ -136,7 +155,10 @@ private:
 		add("thread_number", UINT_TYPE, REQUIRED | READ_ONLY);
 		add("multi_app", BOOL_TYPE, OPTIONAL | READ_ONLY, true);
 		add("turbocaching", BOOL_TYPE, OPTIONAL | READ_ONLY, true);
+		add("turbocache_max_entries", UINT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_MAX_ENTRIES);
+		add("turbocache_max_size", UINT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_MAX_SIZE);
 		add("integration_mode", STRING_TYPE, OPTIONAL | READ_ONLY, DEFAULT_INTEGRATION_MODE);
+		add("location_configs", STRING_ARRAY_TYPE, OPTIONAL | READ_ONLY | SECRET, Json::arrayValue);
 
 		add("user_switching", BOOL_TYPE, OPTIONAL, true);
 		add("stat_throttle_rate", UINT_TYPE, OPTIONAL, DEFAULT_STAT_THROTTLE_RATE);
@@ -144,6 +166,12 @@ private:
 		add("response_buffer_high_watermark", UINT_TYPE, OPTIONAL, DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK);
 		add("graceful_exit", BOOL_TYPE, OPTIONAL, true);
 		add("benchmark_mode", STRING_TYPE, OPTIONAL);
+		add("response_compression", BOOL_TYPE, OPTIONAL, false);
+		add("response_compression_level", UINT_TYPE, OPTIONAL, DEFAULT_RESPONSE_COMPRESSION_LEVEL);
+		add("response_compression_min_size", UINT_TYPE, OPTIONAL, DEFAULT_RESPONSE_COMPRESSION_MIN_SIZE);
+		add("response_compression_types", STRING_ARRAY_TYPE, OPTIONAL, getDefaultResponseCompressionTypes());
+		add("response_splice_min_size", UINT_TYPE, OPTIONAL, DEFAULT_RESPONSE_SPLICE_MIN_SIZE);
+		add("sendfile_roots", STRING_ARRAY_TYPE, OPTIONAL, Json::arrayValue);
 
 		add("default_ruby", STRING_TYPE, OPTIONAL, DEFAULT_RUBY);
 		add("default_python", STRING_TYPE, OPTIONAL, DEFAULT_PYTHON);
@@ -163,8 +191,10 @@ private:
 		add("default_friendly_error_pages", STRING_TYPE, OPTIONAL, "auto");
 		add("default_environment", STRING_TYPE, OPTIONAL, DEFAULT_APP_ENV);
 		add("default_spawn_method", STRING_TYPE, OPTIONAL, DEFAULT_SPAWN_METHOD);
+		add("default_routing_method", STRING_TYPE, OPTIONAL, DEFAULT_ROUTING_METHOD);
 		add("default_bind_address", STRING_TYPE, OPTIONAL, DEFAULT_BIND_ADDRESS);
 		add("default_load_shell_envvars", BOOL_TYPE, OPTIONAL, false);
+		add("default_python_smart_spawning", BOOL_TYPE, OPTIONAL, false);
 		add("default_meteor_app_settings", STRING_TYPE, OPTIONAL);
 		add("default_app_file_descriptor_ulimit", UINT_TYPE, OPTIONAL);
 		add("default_min_instances", UINT_TYPE, OPTIONAL, 1);
@@ -173,6 +203,10 @@ private:
 		add("default_force_max_concurrent_requests_per_process", INT_TYPE, OPTIONAL, -1);
 		add("default_abort_websockets_on_process_shutdown", BOOL_TYPE, OPTIONAL, true);
 		add("default_max_requests", UINT_TYPE, OPTIONAL, 0);
+		add("default_spawn_concurrency", UINT_TYPE, OPTIONAL, 1);
+		add("default_standby_processes", UINT_TYPE, OPTIONAL, 0);
+		add("default_max_memory", UINT_TYPE, OPTIONAL, 0);
+		add("default_python_thread_count", UINT_TYPE, OPTIONAL, 1);
 
 
 		/*******************/
@@ -183,6 +217,21 @@ private:
 		addValidator(ConfigKit::validateIntegrationMode);
 	}
 
+	static Json::Value getDefaultResponseCompressionTypes() {
+		Json::Value doc(Json::arrayValue);
+		doc.append("text/html");
+		doc.append("text/css");
+		doc.append("text/plain");
+		doc.append("text/xml");
+		doc.append("text/javascript");
+		doc.append("application/javascript");
+		doc.append("application/json");
+		doc.append("application/xml");
+		doc.append("application/rss+xml");
+		doc.append("image/svg+xml");
+		return doc;
+	}
+
 	static Json::Value inferDefaultValueForDefaultGroup(const ConfigKit::Store &config) {
 		OsUser osUser;
 		if (!lookupSystemUserByName(config["default_user"].asString(), osUser)) {
@@ -204,6 +253,20 @@ private:
 			errors.push_back(Error("'{{benchmark_mode}}' is not set to a valid value"));
 		}
 
+		string routingMethod = config["default_routing_method"].asString();
+		if (routingMethod != "least_busy" && routingMethod != "latency") {
+			errors.push_back(Error("'{{default_routing_method}}' must be either 'least_busy' or 'latency'"));
+		}
+
+		if (config["turbocache_max_entries"].asUInt() == 0) {
+			errors.push_back(Error("'{{turbocache_max_entries}}' must be at least 1"));
+		}
+
+		unsigned int level = config["response_compression_level"].asUInt();
+		if (level < 1 || level > 9) {
+			errors.push_back(Error("'{{response_compression_level}}' must be between 1 and 9"));
+		}
+
 		/*******************/
 	}
 
@@ -331,6 +394,20 @@ private:
 		return psg_pstrdup(pool, name);
 	}
 
+	static string resolveSendfileRoot(const string &root) {
+		try {
+			return canonicalizePath(root);
+		} catch (const FileSystemException &) {
+			// The directory may not exist yet. Paths inside it are
+			// checked against the unresolved path then.
+			string result = absolutizePath(root);
+			if (result.size() > 1 && result[result.size() - 1] == '/') {
+				result.resize(result.size() - 1);
+			}
+			return result;
+		}
+	}
+
 public:
 	psg_pool_t *pool;
 
@@ -340,11 +417,23 @@ public:
 	StaticString integrationMode;
 	StaticString serverLogName;
 	unsigned int maxInstancesPerApp;
+	unsigned int responseCompressionLevel;
+	unsigned int responseCompressionMinSize;
+	// Lowercase MIME types, allocated in `pool`.
+	vector<StaticString> responseCompressionTypes;
+	// Response bodies with at least this many bytes left are relayed with
+	// splice() when possible. 0 disables splicing.
+	unsigned int responseSpliceMinSize;
+	// Directories from which X-Sendfile and X-Accel-Redirect responses may
+	// be served, with symlinks resolved. Allocated in `pool`. If empty, then
+	// such responses are forwarded as-is.
+	vector<StaticString> sendfileRoots;
 	ControllerBenchmarkMode benchmarkMode: 3;
 	bool singleAppMode: 1;
 	bool userSwitching: 1;
 	bool defaultStickySessions: 1;
 	bool gracefulExit: 1;
+	bool responseCompression: 1;
 
 	/*******************/
 	/*******************/
@@ -358,14 +447,33 @@ public:
 		  integrationMode(psg_pstrdup(pool, config["integration_mode"].asString())),
 		  serverLogName(createServerLogName()),
 		  maxInstancesPerApp(config["max_instances_per_app"].asUInt()),
+		  responseCompressionLevel(config["response_compression_level"].asUInt()),
+		  responseCompressionMinSize(config["response_compression_min_size"].asUInt()),
+		  responseSpliceMinSize(config["response_splice_min_size"].asUInt()),
 		  benchmarkMode(parseControllerBenchmarkMode(config["benchmark_mode"].asString())),
 		  singleAppMode(!config["multi_app"].asBool()),
 		  userSwitching(config["user_switching"].asBool()),
 		  defaultStickySessions(config["default_sticky_sessions"].asBool()),
-		  gracefulExit(config["graceful_exit"].asBool())
+		  gracefulExit(config["graceful_exit"].asBool()),
+		  responseCompression(config["response_compression"].asBool())
 
 		  /*******************/
 	{
+		Json::Value types = config["response_compression_types"];
+		Json::Value::const_iterator it, end = types.end();
+		for (it = types.begin(); it != end; it++) {
+			string type = it->asString();
+			convertLowerCase((const unsigned char *) type.data(),
+				(unsigned char *) &type[0], type.size());
+			responseCompressionTypes.push_back(psg_pstrdup(pool, type));
+		}
+
+		Json::Value roots = config["sendfile_roots"];
+		end = roots.end();
+		for (it = roots.begin(); it != end; it++) {
+			sendfileRoots.push_back(psg_pstrdup(pool, resolveSendfileRoot(it->asString())));
+		}
+
 		/*******************/
 	}
 
@@ -387,11 +495,18 @@ public:
 		std::swap(responseBufferHighWatermark, other.responseBufferHighWatermark);
 		std::swap(integrationMode, other.integrationMode);
 		std::swap(serverLogName, other.serverLogName);
+		std::swap(maxInstancesPerApp, other.maxInstancesPerApp);
+		std::swap(responseCompressionLevel, other.responseCompressionLevel);
+		std::swap(responseCompressionMinSize, other.responseCompressionMinSize);
+		responseCompressionTypes.swap(other.responseCompressionTypes);
+		std::swap(responseSpliceMinSize, other.responseSpliceMinSize);
+		sendfileRoots.swap(other.sendfileRoots);
 		SWAP_BITFIELD(ControllerBenchmarkMode, benchmarkMode);
 		SWAP_BITFIELD(bool, singleAppMode);
 		SWAP_BITFIELD(bool, userSwitching);
 		SWAP_BITFIELD(bool, defaultStickySessions);
 		SWAP_BITFIELD(bool, gracefulExit);
+		SWAP_BITFIELD(bool, responseCompression);
 
 		/*******************/
 
@@ -405,7 +520,9 @@ public:
  *
  * Note that this structure has got nothing to do with per-request config
  * options: options which may be configured by the web server on a
- * per-request basis. That is an orthogonal concept.
+ * per-request basis. That is an orthogonal concept. The only exception is
+ * `locationConfigs`: the per-location options that the web server registered
+ * at startup, so that it doesn't have to send them with every request.
  */
 class ControllerRequestConfig:
 	public boost::intrusive_ref_counter<ControllerRequestConfig,
@@ -429,6 +546,7 @@ public:
 	StaticString defaultFriendlyErrorPages;
 	StaticString defaultEnvironment;
 	StaticString defaultSpawnMethod;
+	StaticString defaultRoutingMethod;
 	StaticString defaultBindAddress;
 	StaticString defaultMeteorAppSettings;
 	unsigned int defaultAppFileDescriptorUlimit;
@@ -436,10 +554,21 @@ public:
 	unsigned int defaultMaxPreloaderIdleTime;
 	unsigned int defaultMaxRequestQueueSize;
 	unsigned int defaultMaxRequests;
+	unsigned int defaultSpawnConcurrency;
+	unsigned int defaultStandbyProcesses;
+	unsigned int defaultMaxMemory;
+	unsigned int defaultPythonThreadCount;
 	int defaultForceMaxConcurrentRequestsPerProcess;
 	bool showVersionInHeader: 1;
 	bool defaultAbortWebsocketsOnProcessShutdown;
 	bool defaultLoadShellEnvvars;
+	bool defaultPythonSmartSpawning;
+
+	// Secure headers (`!~PASSENGER_*`) of the locations that the web server
+	// registered through the `location_configs` option, indexed by the
+	// location config ID that requests refer to with the
+	// `!~PASSENGER_LOCATION_CONFIG_ID` header. Allocated in `pool`.
+	vector<ServerKit::HeaderTable *> locationConfigs;
 
 	/*******************/
 	/*******************/
@@ -463,6 +592,7 @@ public:
 		  defaultFriendlyErrorPages(psg_pstrdup(pool, config["default_friendly_error_pages"].asString())),
 		  defaultEnvironment(psg_pstrdup(pool, config["default_environment"].asString())),
 		  defaultSpawnMethod(psg_pstrdup(pool, config["default_spawn_method"].asString())),
+		  defaultRoutingMethod(psg_pstrdup(pool, config["default_routing_method"].asString())),
 		  defaultBindAddress(psg_pstrdup(pool, config["default_bind_address"].asString())),
 		  defaultMeteorAppSettings(psg_pstrdup(pool, config["default_meteor_app_settings"].asString())),
 		  defaultAppFileDescriptorUlimit(config["default_app_file_descriptor_ulimit"].asUInt()),
@@ -470,17 +600,81 @@ public:
 		  defaultMaxPreloaderIdleTime(config["default_max_preloader_idle_time"].asUInt()),
 		  defaultMaxRequestQueueSize(config["default_max_request_queue_size"].asUInt()),
 		  defaultMaxRequests(config["default_max_requests"].asUInt()),
+		  defaultSpawnConcurrency(config["default_spawn_concurrency"].asUInt()),
+		  defaultStandbyProcesses(config["default_standby_processes"].asUInt()),
+		  defaultMaxMemory(config["default_max_memory"].asUInt()),
+		  defaultPythonThreadCount(config["default_python_thread_count"].asUInt()),
 		  defaultForceMaxConcurrentRequestsPerProcess(config["default_force_max_concurrent_requests_per_process"].asInt()),
 		  showVersionInHeader(config["show_version_in_header"].asBool()),
 		  defaultAbortWebsocketsOnProcessShutdown(config["default_abort_websockets_on_process_shutdown"].asBool()),
-		  defaultLoadShellEnvvars(config["default_load_shell_envvars"].asBool())
+		  defaultLoadShellEnvvars(config["default_load_shell_envvars"].asBool()),
+		  defaultPythonSmartSpawning(config["default_python_smart_spawning"].asBool())
 
 		  /*******************/
-		{ }
+	{
+		Json::Value configs = config["location_configs"];
+		Json::Value::const_iterator it, end = configs.end();
+		for (it = configs.begin(); it != end; it++) {
+			locationConfigs.push_back(parseLocationConfig(it->asString()));
+		}
+	}
 
 	~ControllerRequestConfig() {
+		vector<ServerKit::HeaderTable *>::iterator it;
+		for (it = locationConfigs.begin(); it != locationConfigs.end(); it++) {
+			delete *it;
+		}
 		psg_destroy_pool(pool);
 	}
+
+private:
+	/**
+	 * Parses a location config, which consists of secure header lines
+	 * ("!~NAME: value\r\n") as the web server would otherwise have sent
+	 * them with every request. Other lines are ignored. Keys are inserted
+	 * as-is, because secure header lookups are case-sensitive.
+	 */
+	ServerKit::HeaderTable *parseLocationConfig(const string &data) {
+		ServerKit::HeaderTable *table = new ServerKit::HeaderTable(32);
+		const char *pos = data.data();
+		const char *end = data.data() + data.size();
+
+		while (pos < end) {
+			const char *lineEnd = (const char *) memchr(pos, '\n', end - pos);
+			if (lineEnd == NULL) {
+				lineEnd = end;
+			}
+			StaticString line(pos, lineEnd - pos);
+			if (!line.empty() && line[line.size() - 1] == '\r') {
+				line = line.substr(0, line.size() - 1);
+			}
+			pos = lineEnd + 1;
+
+			string::size_type sep = line.find(": ");
+			if (!startsWith(line, P_STATIC_STRING("!~")) || sep == string::npos
+			 || sep >= ServerKit::HeaderTable::MAX_KEY_LENGTH)
+			{
+				continue;
+			}
+
+			StaticString name = line.substr(0, sep);
+			StaticString value = line.substr(sep + 2);
+			ServerKit::Header *header = (ServerKit::Header *) psg_palloc(pool,
+				sizeof(ServerKit::Header));
+			const char *nameCopy = psg_pstrdup(pool, name).data();
+			psg_lstr_init(&header->key);
+			psg_lstr_append(&header->key, pool, nameCopy, name.size());
+			psg_lstr_init(&header->origKey);
+			psg_lstr_append(&header->origKey, pool, nameCopy, name.size());
+			psg_lstr_init(&header->val);
+			psg_lstr_append(&header->val, pool, psg_pstrdup(pool, value).data(),
+				value.size());
+			header->hash = HashedStaticString(nameCopy, name.size()).hash();
+			table->insert(&header, pool);
+		}
+
+		return table;
+	}
 };
 
 typedef boost::intrusive_ptr<ControllerRequestConfig> ControllerRequestConfigPtr;
@@ -165,6 +165,11 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 						SKC_TRACE(client, 2, "End of application response body reached");
 						handleAppResponseBodyEnd(client, req);
 						endRequest(&client, &req);
+					} else if (remaining == buffer.size() && shouldSpliceAppResponse(client, req)) {
+						// We've consumed everything that the channel has
+						// read, so we can read the rest of the body from
+						// the application socket ourselves.
+						beginSplicingAppResponse(client, req);
 					} else {
 						maybeThrottleAppSource(client, req);
 					}
@@ -208,7 +213,7 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 				.feed(buffer));
 			resp->bodyAlreadyRead += event.consumed;
 
-			if (req->dechunkResponse) {
+			if (req->dechunkResponse || req->compressResponse) {
 				UPDATE_TRACE_POINT();
 				switch (event.type) {
 				case ServerKit::HttpChunkedEvent::NONE:
@@ -298,7 +303,12 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 			SKC_TRACE(client, 2, "Application sent EOF");
 			SKC_TRACE(client, 2, "Not keep-aliving application session connection");
 			req->session->close(true, false);
-			endRequest(&client, &req);
+			if (req->compressor != NULL) {
+				finishCompressingAppResponse(client, req);
+			}
+			if (!req->ended()) {
+				endRequest(&client, &req);
+			}
 			return Channel::Result(0, false);
 		} else {
 			// Error
@@ -323,6 +333,7 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 	ssize_t bytesWritten;
 	bool oobw;
 
+	req->responseBegunAt = SystemTime::getMonotonicUsec();
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		req->timeOnRequestHeaderSent = ev_now(getLoop());
 		reportLargeTimeDiff(client,
@@ -350,6 +361,34 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 
 		resp->setCookie = copy;
 	}
+
+	if (OXT_UNLIKELY(oobw)) {
+		SKC_TRACE(client, 2, "Response with OOBW detected");
+		if (req->session != NULL) {
+			req->session->requestOOBW();
+		}
+	}
+
+	// The response body may only be replaced by a file if the application
+	// isn't still sending one. HttpHeaderParser normally marks X-Sendfile
+	// responses as complete.
+	if (!mainConfig.sendfileRoots.empty() && resp->httpState == AppResponse::COMPLETE) {
+		const LString *path = resp->headers.lookup(ServerKit::HTTP_X_SENDFILE);
+		if (path == NULL) {
+			path = resp->headers.lookup(ServerKit::HTTP_X_ACCEL_REDIRECT);
+		}
+		if (path != NULL && beginSendingFile(client, req, path)) {
+			return;
+		}
+	}
+
+	if (req->acceptsGzip && shouldCompressAppResponse(req)) {
+		req->compressResponse = beginCompressingAppResponse(req);
+		if (req->compressResponse) {
+			ControllerMetrics::increment(metrics.compressedResponses);
+			SKC_TRACE(client, 2, "Compressing application response body with gzip");
+		}
+	}
 	resp->headers.erase(HTTP_CONNECTION);
 	resp->headers.erase(HTTP_STATUS);
 	if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH) {
@@ -374,13 +413,6 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 
 	prepareAppResponseCaching(client, req);
 
-	if (OXT_UNLIKELY(oobw)) {
-		SKC_TRACE(client, 2, "Response with OOBW detected");
-		if (req->session != NULL) {
-			req->session->requestOOBW();
-		}
-	}
-
 	UPDATE_TRACE_POINT();
 	if (!sendResponseHeaderWithWritev(client, req, bytesWritten)) {
 		UPDATE_TRACE_POINT();
@@ -409,11 +441,14 @@ Controller::prepareAppResponseCaching(Client *client, Request *req) {
 		if (turboCaching.responseCache.requestAllowsStoring(req)
 		 && turboCaching.responseCache.prepareRequestForStoring(req))
 		{
+			// If the body is compressed then the compressed size is checked
+			// by markResponsePartForTurboCaching() instead.
 			if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH
-			 && resp->aux.bodyInfo.contentLength > ResponseCache<Request>::MAX_BODY_SIZE)
+			 && !req->compressResponse
+			 && resp->aux.bodyInfo.contentLength > turboCaching.responseCache.getMaxBodySize())
 			{
 				SKC_DEBUG(client, "Response body larger than " <<
-					ResponseCache<Request>::MAX_BODY_SIZE <<
+					turboCaching.responseCache.getMaxBodySize() <<
 					" bytes, so response is not eligible for turbocaching");
 				// Decrease store success ratio.
 				turboCaching.responseCache.incStores();
@@ -433,6 +468,124 @@ Controller::prepareAppResponseCaching(Client *client, Request *req) {
 	}
 }
 
+/**
+ * Decides whether the app response body should be gzip-compressed, based on
+ * the response status, body type, size, content type and the headers that
+ * indicate that the body has already been encoded or must not be transformed.
+ */
+bool
+Controller::shouldCompressAppResponse(Request *req) {
+	AppResponse *resp = &req->appResponse;
+	const LString *value;
+
+	if (req->method == HTTP_HEAD
+	 || resp->statusCode < 200
+	 || resp->statusCode == 204
+	 || resp->statusCode == 206
+	 || resp->statusCode == 304)
+	{
+		return false;
+	}
+
+	switch (resp->bodyType) {
+	case AppResponse::RBT_CONTENT_LENGTH:
+		if (resp->aux.bodyInfo.contentLength == 0
+		 || resp->aux.bodyInfo.contentLength < mainConfig.responseCompressionMinSize)
+		{
+			return false;
+		}
+		break;
+	case AppResponse::RBT_CHUNKED:
+	case AppResponse::RBT_UNTIL_EOF:
+		break;
+	default:
+		return false;
+	}
+
+	if (resp->headers.lookup(HTTP_CONTENT_ENCODING) != NULL
+	 || resp->headers.lookup(HTTP_CONTENT_RANGE) != NULL)
+	{
+		return false;
+	}
+
+	value = resp->headers.lookup(HTTP_CACHE_CONTROL);
+	if (value != NULL && value->size > 0) {
+		value = psg_lstr_make_contiguous(value, req->pool);
+		if (StaticString(value->start->data, value->size).find(
+			P_STATIC_STRING("no-transform")) != string::npos)
+		{
+			return false;
+		}
+	}
+
+	value = resp->headers.lookup(HTTP_CONTENT_TYPE);
+	if (value == NULL || value->size == 0) {
+		return false;
+	}
+	value = psg_lstr_make_contiguous(value, req->pool);
+	const char *type = value->start->data;
+	const char *typeEnd = (const char *) memchr(type, ';', value->size);
+	if (typeEnd == NULL) {
+		typeEnd = type + value->size;
+	}
+	while (typeEnd > type && (typeEnd[-1] == ' ' || typeEnd[-1] == '\t')) {
+		typeEnd--;
+	}
+
+	vector<StaticString>::const_iterator it, end = mainConfig.responseCompressionTypes.end();
+	for (it = mainConfig.responseCompressionTypes.begin(); it != end; it++) {
+		if (it->size() == (size_t) (typeEnd - type)
+		 && strncasecmp(it->data(), type, it->size()) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Initializes the gzip compressor for the response body and adjusts the
+ * response framing and headers accordingly. Returns false if the compressor
+ * could not be initialized, in which case the body is sent as-is.
+ */
+bool
+Controller::beginCompressingAppResponse(Request *req) {
+	AppResponse *resp = &req->appResponse;
+	z_stream *compressor = (z_stream *) psg_palloc(req->pool, sizeof(z_stream));
+
+	memset(compressor, 0, sizeof(z_stream));
+	// windowBits + 16 selects the gzip wrapper.
+	if (deflateInit2(compressor, mainConfig.responseCompressionLevel, Z_DEFLATED,
+		15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		return false;
+	}
+	req->compressor = compressor;
+
+	if (req->httpMajor * 1000 + req->httpMinor * 10 < 1010) {
+		// HTTP/1.0 clients don't understand chunked encoding, so the end
+		// of the body is signaled by closing the connection.
+		req->dechunkResponse = true;
+		req->wantKeepAlive = false;
+	}
+
+	// The compressed body is a different representation, so a strong
+	// entity tag no longer applies to it.
+	LString *etag = resp->headers.lookup(HTTP_ETAG);
+	if (etag != NULL && etag->size > 0 && psg_lstr_first_byte(etag) == '"') {
+		const LString *contiguous = psg_lstr_make_contiguous(etag, req->pool);
+		unsigned int size = contiguous->size + 2;
+		char *data = (char *) psg_pnalloc(req->pool, size);
+		memcpy(data, "W/", 2);
+		memcpy(data + 2, contiguous->start->data, contiguous->size);
+		psg_lstr_deinit(etag);
+		psg_lstr_init(etag);
+		psg_lstr_append(etag, req->pool, data, size);
+	}
+
+	return true;
+}
+
 void
 Controller::onAppResponse100Continue(Client *client, Request *req) {
 	TRACE_POINT();
@@ -676,9 +829,18 @@ Controller::constructHeaderBuffersForResponse(Request *req, struct iovec *buffer
 		PUSH_STATIC_BUFFER("\r\n");
 	}
 
+	if (req->compressResponse) {
+		PUSH_STATIC_BUFFER("Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n");
+	}
+
 	nCacheableBuffers = i;
 
-	if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH) {
+	if (req->compressResponse) {
+		// The compressed size is not known in advance.
+		if (!req->dechunkResponse) {
+			PUSH_STATIC_BUFFER("Transfer-Encoding: chunked\r\n");
+		}
+	} else if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH) {
 		PUSH_STATIC_BUFFER("Content-Length: ");
 		if (buffers != NULL) {
 			BEGIN_PUSH_NEXT_BUFFER();
@@ -973,6 +1135,10 @@ void
 Controller::writeResponseAndMarkForTurboCaching(Client *client, Request *req,
 	const MemoryKit::mbuf &buffer)
 {
+	if (req->compressor != NULL) {
+		compressAppResponseData(client, req, buffer, false);
+		return;
+	}
 	if (OXT_LIKELY(mainConfig.benchmarkMode != BM_RESPONSE_BEGIN)) {
 		writeResponse(client, buffer);
 	}
@@ -985,9 +1151,9 @@ Controller::markResponsePartForTurboCaching(Client *client, Request *req,
 {
 	if (!req->ended() && turboCaching.isEnabled() && !req->cacheKey.empty()) {
 		unsigned int totalSize = req->appResponse.bodyCacheBuffer.size + buffer.size();
-		if (totalSize > ResponseCache<Request>::MAX_BODY_SIZE) {
+		if (totalSize > turboCaching.responseCache.getMaxBodySize()) {
 			SKC_DEBUG(client, "Response body larger than " <<
-				ResponseCache<Request>::MAX_HEADER_SIZE <<
+				turboCaching.responseCache.getMaxBodySize() <<
 				" bytes, so response is not eligible for turbocaching");
 			// Decrease store success ratio.
 			turboCaching.responseCache.incStores();
@@ -1000,6 +1166,659 @@ Controller::markResponsePartForTurboCaching(Client *client, Request *req,
 	}
 }
 
+/**
+ * Feeds `buffer` to the gzip compressor and writes any compressed output to
+ * the client, framed as a chunk unless the response is being dechunked. Only
+ * the compressed bytes are marked for turbocaching, so that cache hits can
+ * be served without compressing again. If `finish` is true then the
+ * compressor is flushed and the final chunk is written.
+ */
+void
+Controller::compressAppResponseData(Client *client, Request *req,
+	const MemoryKit::mbuf &buffer, bool finish)
+{
+	// Room for the chunk size line (at most 8 hex digits + CRLF) before
+	// the data, and the CRLF after it.
+	const unsigned int CHUNK_HEADER_SPACE = 10;
+	const unsigned int CHUNK_TRAILER_SPACE = 2;
+	MemoryKit::mbuf_pool &mbuf_pool = getContext()->mbuf_pool;
+	z_stream *compressor = req->compressor;
+	int ret;
+
+	compressor->next_in = (Bytef *) buffer.start;
+	compressor->avail_in = buffer.size();
+
+	do {
+		MemoryKit::mbuf output(MemoryKit::mbuf_get(&mbuf_pool));
+		char *data = output.start + CHUNK_HEADER_SPACE;
+		unsigned int capacity = output.size() - CHUNK_HEADER_SPACE - CHUNK_TRAILER_SPACE;
+
+		compressor->next_out = (Bytef *) data;
+		compressor->avail_out = capacity;
+		ret = deflate(compressor, finish ? Z_FINISH : Z_NO_FLUSH);
+		if (OXT_UNLIKELY(ret == Z_STREAM_ERROR)) {
+			disconnectWithError(&client, "error compressing response body");
+			return;
+		}
+
+		unsigned int size = capacity - compressor->avail_out;
+		if (size == 0) {
+			continue;
+		}
+
+		markResponsePartForTurboCaching(client, req,
+			MemoryKit::mbuf(output, CHUNK_HEADER_SPACE, size));
+		if (req->dechunkResponse) {
+			writeResponse(client, MemoryKit::mbuf(output, CHUNK_HEADER_SPACE, size));
+		} else {
+			char sizeStr[sizeof(unsigned int) * 2 + 1];
+			unsigned int sizeStrLen = integerToHex(size, sizeStr);
+			unsigned int offset = CHUNK_HEADER_SPACE - sizeStrLen - 2;
+			memcpy(output.start + offset, sizeStr, sizeStrLen);
+			memcpy(output.start + offset + sizeStrLen, "\r\n", 2);
+			memcpy(data + size, "\r\n", 2);
+			writeResponse(client, MemoryKit::mbuf(output, offset,
+				sizeStrLen + 2 + size + CHUNK_TRAILER_SPACE));
+		}
+		if (req->ended()) {
+			return;
+		}
+	} while (finish ? ret != Z_STREAM_END : compressor->avail_out == 0);
+}
+
+void
+Controller::finishCompressingAppResponse(Client *client, Request *req) {
+	compressAppResponseData(client, req, MemoryKit::mbuf(), true);
+	if (req->ended()) {
+		return;
+	}
+	if (!req->dechunkResponse) {
+		writeResponse(client, P_STATIC_STRING("0\r\n\r\n"));
+	}
+	deflateEnd(req->compressor);
+	req->compressor = NULL;
+}
+
+/**
+ * Called when the application responded with an X-Sendfile or X-Accel-Redirect
+ * header and `sendfile_roots` is set. If `value` is an absolute path inside one
+ * of the sendfile roots, then we respond with the contents of that file
+ * instead, so that the application process does not have to read the file and
+ * send it to us. Single byte ranges are supported.
+ *
+ * Returns false if the path is not inside a sendfile root, in which case the
+ * application response should be forwarded as-is. A web server in front of us
+ * may still know what to do with it.
+ */
+bool
+Controller::beginSendingFile(Client *client, Request *req, const LString *value) {
+	TRACE_POINT();
+	AppResponse *resp = &req->appResponse;
+	assert(resp->httpState == AppResponse::COMPLETE);
+	assert(!req->appSource.isStarted());
+
+	if (value->size == 0) {
+		return false;
+	}
+	value = psg_lstr_make_contiguous(value, req->pool);
+	string path(value->start->data, value->size);
+	if (path[0] != '/' || path.find('\0') != string::npos) {
+		return false;
+	}
+
+	string resolvedPath;
+	int e = 0;
+	try {
+		resolvedPath = canonicalizePath(path);
+	} catch (const FileSystemException &ex) {
+		// Still respond with an error if the file would have
+		// been inside a sendfile root.
+		resolvedPath = absolutizePath(path);
+		e = ex.code();
+	}
+	const StaticString *root = findSendfileRoot(resolvedPath);
+	if (root == NULL) {
+		SKC_DEBUG(client, "Not sending " << path << " because it is not inside"
+			" a sendfile root. Forwarding application response as-is");
+		return false;
+	}
+
+	prepareAppResponseCaching(client, req);
+
+	UPDATE_TRACE_POINT();
+	struct stat buf;
+	int fd = -1;
+	if (e == 0) {
+		fd = openFileInSendfileRoot(*root, resolvedPath);
+		if (fd == -1) {
+			e = errno;
+		} else if (fstat(fd, &buf) == -1) {
+			e = errno;
+		} else if (!S_ISREG(buf.st_mode)) {
+			e = ENOENT;
+		}
+	}
+	if (e != 0) {
+		if (fd != -1) {
+			safelyClose(fd, true);
+		}
+		if (e == ENOENT || e == ENOTDIR) {
+			SKC_DEBUG(client, "Cannot send " << resolvedPath << ": file not found");
+			endRequestWithSimpleResponse(&client, &req, "<h1>Not Found</h1>", 404);
+		} else if (e == EACCES || e == EPERM || e == ELOOP) {
+			SKC_WARN(client, "Cannot send " << resolvedPath << ": " << strerror(e)
+				<< " (errno=" << e << ")");
+			endRequestWithSimpleResponse(&client, &req, "<h1>Forbidden</h1>", 403);
+		} else {
+			SKC_ERROR(client, "Cannot send " << resolvedPath << ": " << strerror(e)
+				<< " (errno=" << e << ")");
+			endRequestWithSimpleResponse(&client, &req,
+				"<h1>Internal Server Error</h1>", 500);
+		}
+		return true;
+	}
+	req->sendfileFd = fd;
+
+	boost::uint64_t fileSize = buf.st_size;
+	boost::uint64_t offset = 0;
+	boost::uint64_t length = fileSize;
+	bool satisfiable;
+	if (resp->statusCode == 200 && parseRangeHeader(req, fileSize, offset, length, satisfiable)) {
+		string contentRange;
+		if (satisfiable) {
+			contentRange = "bytes " + toString(offset) + "-" + toString(offset + length - 1)
+				+ "/" + toString(fileSize);
+			resp->statusCode = 206;
+			resp->headers.erase(HTTP_CONTENT_RANGE);
+			resp->headers.insert(req->pool, "Content-Range",
+				psg_pstrdup(req->pool, contentRange));
+		} else {
+			SKC_DEBUG(client, "Requested range not satisfiable for " << resolvedPath);
+			contentRange = "bytes */" + toString(fileSize);
+			ServerKit::HeaderTable headers;
+			headers.insert(req->pool, "Content-Range", psg_pstrdup(req->pool, contentRange));
+			writeSimpleResponse(client, 416, &headers, StaticString());
+			endRequest(&client, &req);
+			return true;
+		}
+	}
+
+	SKC_DEBUG(client, "Sending " << resolvedPath << " (offset=" << offset
+		<< ", length=" << length << ")");
+	resp->headers.erase(ServerKit::HTTP_X_SENDFILE);
+	resp->headers.erase(ServerKit::HTTP_X_ACCEL_REDIRECT);
+	resp->headers.erase(HTTP_CONNECTION);
+	resp->headers.erase(HTTP_STATUS);
+	resp->headers.erase(HTTP_CONTENT_LENGTH);
+	resp->headers.erase(HTTP_TRANSFER_ENCODING);
+	if (resp->statusCode == 200 || resp->statusCode == 206) {
+		if (resp->headers.lookup(HTTP_ACCEPT_RANGES) == NULL) {
+			resp->headers.insert(req->pool, "Accept-Ranges", "bytes");
+		}
+	}
+	// This makes constructHeaderBuffersForResponse() output a Content-Length
+	// header, even if the length is 0. Because of that, and unlike when
+	// forwarding X-Sendfile responses as-is, the client connection can be
+	// kept alive.
+	resp->bodyType = AppResponse::RBT_CONTENT_LENGTH;
+	resp->aux.bodyInfo.contentLength = length;
+	req->sendfileOffset = offset;
+	req->sendfileRemaining = length;
+
+	if (req->state == Request::WAITING_FOR_APP_OUTPUT) {
+		// The application is done with this request, so release the
+		// application process while we're sending the file. HttpHeaderParser
+		// discarded the framing of the body that the application may have
+		// sent along, so that body may still be unread on the socket. The
+		// connection must therefore not be reused.
+		SKC_TRACE(client, 2, "Not keep-aliving application session connection"
+			" because its X-Sendfile response body was not read");
+		req->session->close(true, false);
+	}
+
+	UPDATE_TRACE_POINT();
+	ssize_t bytesWritten;
+	if (!sendResponseHeaderWithWritev(client, req, bytesWritten)) {
+		UPDATE_TRACE_POINT();
+		if (bytesWritten >= 0 || errno == EAGAIN || errno == EWOULDBLOCK) {
+			sendResponseHeaderWithBuffering(client, req, bytesWritten);
+		} else {
+			int e = errno;
+			P_ASSERT_EQ(bytesWritten, -1);
+			disconnectWithClientSocketWriteError(&client, e);
+			return true;
+		}
+	}
+	if (req->ended()) {
+		return true;
+	}
+
+	if (req->method == HTTP_HEAD || length == 0) {
+		endRequest(&client, &req);
+	} else if (!client->output.isFlushed()) {
+		// We may only write to the client socket directly after
+		// the response headers have been written out.
+		SKC_TRACE(client, 2, "Waiting until response headers have been written out");
+		client->output.setDataFlushedCallback(_outputDataFlushed);
+	} else {
+		continueSendingFile(client, req);
+	}
+	return true;
+}
+
+const StaticString *
+Controller::findSendfileRoot(const StaticString &path) const {
+	vector<StaticString>::const_iterator it, end = mainConfig.sendfileRoots.end();
+
+	for (it = mainConfig.sendfileRoots.begin(); it != end; it++) {
+		const StaticString &root = *it;
+		if (root == P_STATIC_STRING("/")) {
+			return &root;
+		}
+		if (startsWith(path, root)
+		 && path.size() > root.size()
+		 && path[root.size()] == '/')
+		{
+			return &root;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Opens `path`, a canonical path inside the sendfile root `root`. The path was
+ * checked against the root after resolving its symlinks, but an application
+ * that can write inside the root could replace one of the directories with a
+ * symlink before we get to open it. So we open every path component relative
+ * to its parent directory with O_NOFOLLOW, starting at the root, so that the
+ * file that we open is guaranteed to be inside the root.
+ *
+ * Returns -1 and sets errno on failure. Encountering a symlink fails with
+ * ELOOP or ENOTDIR.
+ */
+int
+Controller::openFileInSendfileRoot(const StaticString &root, const string &path) const {
+	string::size_type pos = (root == P_STATIC_STRING("/")) ? 1 : root.size() + 1;
+	int dirfd, fd, e;
+
+	do {
+		dirfd = open(root.toString().c_str(), O_RDONLY | O_DIRECTORY);
+	} while (dirfd == -1 && errno == EINTR);
+	if (dirfd == -1) {
+		return -1;
+	}
+
+	while (true) {
+		string::size_type end = path.find('/', pos);
+		bool last = end == string::npos;
+		string component = path.substr(pos, last ? string::npos : end - pos);
+		int flags = O_RDONLY | O_NOFOLLOW | (last ? O_NONBLOCK : O_DIRECTORY);
+
+		do {
+			fd = openat(dirfd, component.c_str(), flags);
+		} while (fd == -1 && errno == EINTR);
+		e = errno;
+		safelyClose(dirfd, true);
+		if (fd == -1) {
+			errno = e;
+			return -1;
+		} else if (last) {
+			return fd;
+		}
+		dirfd = fd;
+		pos = end + 1;
+	}
+}
+
+/**
+ * Parses the Range request header for a file of `fileSize` bytes. Returns false
+ * if the entire file should be sent: when there is no Range header, when it is
+ * invalid or specifies multiple ranges (which we don't support), or when there
+ * is an If-Range header (which we can't evaluate). Otherwise returns true, and
+ * sets `satisfiable` to whether `offset` and `length` have been set to the
+ * requested part of the file.
+ */
+bool
+Controller::parseRangeHeader(Request *req, boost::uint64_t fileSize,
+	boost::uint64_t &offset, boost::uint64_t &length, bool &satisfiable)
+{
+	const LString *value = req->headers.lookup(HTTP_RANGE);
+	if (value == NULL || value->size == 0 || req->headers.lookup(HTTP_IF_RANGE) != NULL) {
+		return false;
+	}
+
+	value = psg_lstr_make_contiguous(value, req->pool);
+	StaticString spec(value->start->data, value->size);
+	if (!startsWith(spec, P_STATIC_STRING("bytes="))) {
+		return false;
+	}
+	spec = spec.substr(sizeof("bytes=") - 1);
+
+	string::size_type dash = spec.find('-');
+	if (dash == string::npos) {
+		return false;
+	}
+	StaticString first = spec.substr(0, dash);
+	StaticString last = spec.substr(dash + 1);
+	// The length limit prevents overflows.
+	if ((first.empty() && last.empty()) || first.size() > 18 || last.size() > 18) {
+		return false;
+	}
+	for (string::size_type i = 0; i < first.size(); i++) {
+		if (first[i] < '0' || first[i] > '9') {
+			return false;
+		}
+	}
+	for (string::size_type i = 0; i < last.size(); i++) {
+		if (last[i] < '0' || last[i] > '9') {
+			return false;
+		}
+	}
+
+	if (first.empty()) {
+		// Suffix range: the last N bytes.
+		boost::uint64_t suffixLength = stringToULL(last);
+		satisfiable = suffixLength > 0 && fileSize > 0;
+		if (satisfiable) {
+			length = std::min(suffixLength, fileSize);
+			offset = fileSize - length;
+		}
+	} else {
+		boost::uint64_t begin = stringToULL(first);
+		boost::uint64_t end = last.empty() ? fileSize - 1 : stringToULL(last);
+		if (!last.empty() && end < begin) {
+			return false;
+		}
+		satisfiable = begin < fileSize;
+		if (satisfiable) {
+			offset = begin;
+			length = std::min(end, fileSize - 1) - begin + 1;
+		}
+	}
+	return true;
+}
+
+void
+Controller::continueSendingFile(Client *client, Request *req) {
+	TRACE_POINT();
+	boost::uint64_t sent = 0;
+	ssize_t ret;
+
+	while (req->sendfileRemaining > 0 && sent < SENDFILE_CHUNK_SIZE) {
+		size_t size = (size_t) std::min<boost::uint64_t>(req->sendfileRemaining,
+			SENDFILE_CHUNK_SIZE - sent);
+		#ifdef __linux__
+			off_t offset = req->sendfileOffset;
+			ret = sendfile(client->getFd(), req->sendfileFd, &offset, size);
+		#else
+			char buf[1024 * 16];
+			ret = pread(req->sendfileFd, buf, std::min(size, sizeof(buf)),
+				req->sendfileOffset);
+			if (ret > 0) {
+				ret = write(client->getFd(), buf, ret);
+			}
+		#endif
+
+		if (ret > 0) {
+			req->sendfileOffset += ret;
+			req->sendfileRemaining -= ret;
+			sent += ret;
+		} else if (ret == 0) {
+			SKC_WARN(client, "File was truncated while sending it");
+			disconnectWithError(&client, "file truncated while sending it");
+			return;
+		} else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+			break;
+		} else if (errno != EINTR) {
+			int e = errno;
+			disconnectWithClientSocketWriteError(&client, e);
+			return;
+		}
+	}
+
+	if (req->sendfileRemaining > 0) {
+		// Either the client socket is full, or we've sent SENDFILE_CHUNK_SIZE
+		// bytes and should give other clients a chance.
+		ev_io_set(&req->sendfileWatcher, client->getFd(), EV_WRITE);
+		ev_io_start(getLoop(), &req->sendfileWatcher);
+	} else {
+		SKC_TRACE(client, 2, "File sent");
+		stopSendingFile(req);
+		endRequest(&client, &req);
+	}
+}
+
+void
+Controller::stopSendingFile(Request *req) {
+	if (req->sendfileFd != -1) {
+		ev_io_stop(getLoop(), &req->sendfileWatcher);
+		safelyClose(req->sendfileFd, true);
+		req->sendfileFd = -1;
+	}
+}
+
+void
+Controller::onClientWritableForSendfile(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onClientWritableForSendfile");
+
+	ev_io_stop(self->getLoop(), io);
+	self->continueSendingFile(client, req);
+}
+
+/**
+ * Decides whether the rest of the app response body should be relayed to the
+ * client with splice(), instead of through `appSource` and `client->output`.
+ * That avoids copying the body into mbufs, but it does not buffer the body,
+ * so we only do it while the client keeps up with the application. Bodies
+ * that must be compressed or turbocached are never spliced.
+ */
+bool
+Controller::shouldSpliceAppResponse(Client *client, Request *req) {
+	#ifdef __linux__
+		const AppResponse *resp = &req->appResponse;
+		return mainConfig.responseSpliceMinSize > 0
+			&& !req->spliceUnsupported
+			&& !req->compressResponse
+			&& req->cacheKey.empty()
+			&& resp->httpState == AppResponse::PARSING_BODY_WITH_LENGTH
+			&& resp->aux.bodyInfo.contentLength - resp->bodyAlreadyRead
+				>= mainConfig.responseSpliceMinSize
+			// Data that we write directly to the client socket must not
+			// overtake data that is still buffered.
+			&& client->output.isFlushed();
+	#else
+		return false;
+	#endif
+}
+
+/**
+ * Must be called from the `appSource` data callback, after all data that the
+ * channel has read has been consumed. Stops the channel and starts relaying
+ * the rest of the app response body with splice().
+ */
+void
+Controller::beginSplicingAppResponse(Client *client, Request *req) {
+	#ifdef __linux__
+		if (req->splicePipe[0] == -1 && pipe2(req->splicePipe, O_NONBLOCK | O_CLOEXEC) == -1) {
+			int e = errno;
+			SKC_WARN(client, "Cannot create a pipe for relaying the application response: "
+				<< strerror(e) << " (errno=" << e << ")");
+			req->splicePipe[0] = req->splicePipe[1] = -1;
+			req->spliceUnsupported = true;
+			maybeThrottleAppSource(client, req);
+			return;
+		}
+
+		SKC_TRACE(client, 2, "Relaying application response body with splice()");
+		req->appSource.stop();
+		ev_io_set(&req->spliceWatcher, req->appSource.getFd(), EV_READ);
+		ev_io_start(getLoop(), &req->spliceWatcher);
+	#else
+		P_BUG("splice() is not supported on this platform");
+	#endif
+}
+
+void
+Controller::continueSplicingAppResponse(Client *client, Request *req) {
+	#ifdef __linux__
+		TRACE_POINT();
+		AppResponse *resp = &req->appResponse;
+		int appFd = req->appSource.getFd();
+		unsigned int spliced = 0;
+		ssize_t ret;
+		int e;
+
+		while (true) {
+			if (req->splicePipeBytes == 0) {
+				boost::uint64_t appRemaining = resp->aux.bodyInfo.contentLength
+					- resp->bodyAlreadyRead;
+				if (appRemaining == 0 || spliced >= SPLICE_CHUNK_SIZE) {
+					break;
+				}
+
+				ret = splice(appFd, NULL, req->splicePipe[1], NULL,
+					(size_t) std::min<boost::uint64_t>(appRemaining, SPLICE_CHUNK_SIZE),
+					SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+				if (ret > 0) {
+					resp->bodyAlreadyRead += ret;
+					req->splicePipeBytes = ret;
+				} else if (ret == 0) {
+					SKC_WARN(client, "Application sent EOF before finishing response body: " <<
+						resp->bodyAlreadyRead << " bytes already read, " <<
+						resp->aux.bodyInfo.contentLength << " bytes expected");
+					endRequestWithAppSocketIncompleteResponse(&client, &req);
+					return;
+				} else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+					UPDATE_TRACE_POINT();
+					ev_io_start(getLoop(), &req->spliceWatcher);
+					return;
+				} else if (errno == EINVAL || errno == ENOSYS) {
+					UPDATE_TRACE_POINT();
+					SKC_DEBUG(client, "splice() is not supported for the application socket");
+					req->spliceUnsupported = true;
+					stopSplicingAppResponse(client, req);
+					return;
+				} else if (errno != EINTR) {
+					e = errno;
+					endRequestWithAppSocketReadError(&client, &req, e);
+					return;
+				}
+				continue;
+			}
+
+			ret = splice(req->splicePipe[0], NULL, client->getFd(), NULL,
+				req->splicePipeBytes, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			if (ret > 0) {
+				req->splicePipeBytes -= ret;
+				spliced += ret;
+				req->responseBegun = true;
+				req->lastDataSendTime = ev_now(getLoop());
+				ControllerMetrics::increment(metrics.splicedBytes, ret);
+			} else if (ret == -1 && errno == EINTR) {
+				continue;
+			} else if (ret == 0 || errno == EAGAIN || errno == EWOULDBLOCK) {
+				// The client doesn't keep up, so go back to buffering
+				// the response. That way the application doesn't have
+				// to wait for the client.
+				UPDATE_TRACE_POINT();
+				stopSplicingAppResponse(client, req);
+				return;
+			} else if (errno == EINVAL || errno == ENOSYS) {
+				UPDATE_TRACE_POINT();
+				SKC_DEBUG(client, "splice() is not supported for the client socket");
+				req->spliceUnsupported = true;
+				stopSplicingAppResponse(client, req);
+				return;
+			} else {
+				e = errno;
+				disconnectWithClientSocketWriteError(&client, e);
+				return;
+			}
+		}
+
+		if (resp->bodyFullyRead()) {
+			SKC_TRACE(client, 2, "End of application response body reached");
+			ev_io_stop(getLoop(), &req->spliceWatcher);
+			handleAppResponseBodyEnd(client, req);
+			endRequest(&client, &req);
+		} else {
+			// We've relayed SPLICE_CHUNK_SIZE bytes, so give other
+			// clients a chance.
+			ev_io_start(getLoop(), &req->spliceWatcher);
+		}
+	#else
+		P_BUG("splice() is not supported on this platform");
+	#endif
+}
+
+/**
+ * Stops relaying the app response body with splice(), and relays the rest
+ * of it through `appSource` and `client->output` again. Data that is still
+ * in the pipe is written to `client->output` first.
+ */
+void
+Controller::stopSplicingAppResponse(Client *client, Request *req) {
+	TRACE_POINT();
+	ev_io_stop(getLoop(), &req->spliceWatcher);
+
+	while (req->splicePipeBytes > 0) {
+		MemoryKit::mbuf buffer(MemoryKit::mbuf_get(&getContext()->mbuf_pool));
+		ssize_t ret;
+
+		do {
+			ret = read(req->splicePipe[0], buffer.start,
+				std::min<size_t>(buffer.size(), req->splicePipeBytes));
+		} while (ret == -1 && errno == EINTR);
+		if (ret <= 0) {
+			int e = errno;
+			SKC_ERROR(client, "Cannot read from the splice pipe: "
+				<< strerror(e) << " (errno=" << e << ")");
+			disconnectWithError(&client, "cannot read from the splice pipe");
+			return;
+		}
+		req->splicePipeBytes -= ret;
+		writeResponse(client, MemoryKit::mbuf(buffer, 0, ret));
+		if (req->ended()) {
+			return;
+		}
+	}
+
+	if (req->appResponse.bodyFullyRead()) {
+		SKC_TRACE(client, 2, "End of application response body reached");
+		handleAppResponseBodyEnd(client, req);
+		endRequest(&client, &req);
+	} else {
+		SKC_TRACE(client, 2, "Relaying application response body through buffers");
+		req->appSource.start();
+		maybeThrottleAppSource(client, req);
+	}
+}
+
+void
+Controller::stopSplicing(Request *req) {
+	ev_io_stop(getLoop(), &req->spliceWatcher);
+	if (req->splicePipe[0] != -1) {
+		safelyClose(req->splicePipe[0], true);
+		safelyClose(req->splicePipe[1], true);
+		req->splicePipe[0] = req->splicePipe[1] = -1;
+	}
+	req->splicePipeBytes = 0;
+}
+
+void
+Controller::onAppReadableForSplice(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppReadableForSplice");
+
+	ev_io_stop(self->getLoop(), io);
+	self->continueSplicingAppResponse(client, req);
+}
+
 void
 Controller::maybeThrottleAppSource(Client *client, Request *req) {
 	if (!req->ended()) {
@@ -1062,14 +1881,25 @@ void
 Controller::outputDataFlushed(Client *client, Request *req) {
 	if (!req->ended()) {
 		assert(!req->appSource.isStarted());
-		SKC_TRACE(client, 2, "The client is ready to receive more data. Resuming application socket");
 		client->output.setDataFlushedCallback(getClientOutputDataFlushedCallback());
-		req->appSource.start();
+		if (req->sendfileFd != -1) {
+			SKC_TRACE(client, 2, "Response headers have been written out. Sending file");
+			continueSendingFile(client, req);
+		} else {
+			SKC_TRACE(client, 2, "The client is ready to receive more data. Resuming application socket");
+			req->appSource.start();
+		}
 	}
 }
 
 void
 Controller::handleAppResponseBodyEnd(Client *client, Request *req) {
+	if (req->compressor != NULL) {
+		finishCompressingAppResponse(client, req);
+		if (req->ended()) {
+			return;
+		}
+	}
 	keepAliveAppConnection(client, req);
 	storeAppResponseInTurboCache(client, req);
 	assert(!req->ended());
@@ -1113,16 +1943,17 @@ Controller::storeAppResponseInTurboCache(Client *client, Request *req) {
 				headerSize, resp->bodyCacheBuffer.size));
 		if (entry.valid()) {
 			UPDATE_TRACE_POINT();
+			ControllerMetrics::increment(metrics.turbocacheStores);
 			SKC_DEBUG(client, "Storing app response in turbocache");
 			SKC_TRACE(client, 2, "Turbocache entries:\n" << turboCaching.responseCache.inspect());
 
 			gatherBuffers(entry.body->httpHeaderData,
-				ResponseCache<Request>::MAX_HEADER_SIZE,
+				entry.body->httpHeaderSize,
 				resp->headerCacheBuffers, resp->nHeaderCacheBuffers);
 
 			char *pos = entry.body->httpBodyData;
 			const char *end = entry.body->httpBodyData
-				+ ResponseCache<Request>::MAX_BODY_SIZE;
+				+ entry.body->httpBodySize;
 			const LString::Part *part = resp->bodyCacheBuffer.start;
 			while (part != NULL) {
 				pos = appendData(pos, end, part->data, part->size);
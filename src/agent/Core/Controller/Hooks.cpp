@@ -107,6 +107,15 @@ Controller::onRequestObjectCreated(Client *client, Request *req) {
 	req->bodyBuffer.setContext(getContext());
 	req->bodyBuffer.setHooks(&req->hooks);
 	req->bodyBuffer.setDataCallback(onBodyBufferData);
+
+	ev_io_init(&req->appConnectWatcher, onAppConnectable, -1, EV_WRITE);
+	req->appConnectWatcher.data = req;
+	ev_timer_init(&req->appConnectTimer, onAppConnectTimer, 0, 0);
+	req->appConnectTimer.data = req;
+	ev_io_init(&req->sendfileWatcher, onClientWritableForSendfile, -1, EV_WRITE);
+	req->sendfileWatcher.data = req;
+	ev_io_init(&req->spliceWatcher, onAppReadableForSplice, -1, EV_READ);
+	req->spliceWatcher.data = req;
 }
 
 void
@@ -124,6 +133,11 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 	// appSink and appSource are initialized in Controller::checkoutSession().
 
 	req->startedAt = 0;
+	req->headerParsedAt = 0;
+	req->checkoutBegunAt = 0;
+	req->checkedOutAt = 0;
+	req->sessionInitiatedAt = 0;
+	req->responseBegunAt = 0;
 	req->state = Request::ANALYZING_REQUEST;
 	req->dechunkResponse = false;
 	req->requestBodyBuffering = false;
@@ -134,8 +148,17 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 	req->appResponseInitialized = false;
 	req->strip100ContinueHeader = false;
 	req->hasPragmaHeader = false;
+	req->acceptsGzip = false;
+	req->compressResponse = false;
+	req->compressor = NULL;
+	req->sendfileFd = -1;
+	req->spliceUnsupported = false;
+	req->splicePipe[0] = -1;
+	req->splicePipe[1] = -1;
+	req->splicePipeBytes = 0;
 	req->host = NULL;
 	req->config = requestConfig;
+	req->locationConfig = NULL;
 	req->bodyBytesBuffered = 0;
 	req->cacheKey = HashedStaticString();
 	req->cacheControl = NULL;
@@ -154,7 +177,17 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 
 void
 Controller::deinitializeRequest(Client *client, Request *req) {
+	if (req->headerParsedAt != 0) {
+		recordRequestLatency(req);
+		// deinitializeRequest() may be called more than once.
+		req->headerParsedAt = 0;
+	}
+
+	// Must happen before the session (and thus its file descriptor) is destroyed.
+	stopWaitingForAppConnection(req);
+	stopSplicing(req);
 	req->session.reset();
+	req->locationConfig = NULL;
 	req->config.reset();
 
 	req->appSink.setConsumedCallback(NULL);
@@ -163,6 +196,12 @@ Controller::deinitializeRequest(Client *client, Request *req) {
 	req->bodyBuffer.clearBuffersFlushedCallback();
 	req->bodyBuffer.deinitialize();
 
+	if (req->compressor != NULL) {
+		deflateEnd(req->compressor);
+		req->compressor = NULL;
+	}
+	stopSendingFile(req);
+
 	/***************/
 	/***************/
 
@@ -53,6 +53,33 @@ struct Controller::RequestAnalysis {
 };
 
 
+/**
+ * Resolves the `!~PASSENGER_LOCATION_CONFIG_ID` header, with which the web
+ * server refers to a location config that it registered through the
+ * `location_configs` option, instead of sending all `!~PASSENGER_*`
+ * headers of that location with every request.
+ */
+void
+Controller::initializeLocationConfig(Client *client, Request *req) {
+	const LString *id = req->secureHeaders.lookup(PASSENGER_LOCATION_CONFIG_ID);
+	if (id == NULL) {
+		return;
+	}
+
+	id = psg_lstr_make_contiguous(id, req->pool);
+	StaticString idString(id->start->data, id->size);
+	unsigned int index = stringToUint(idString);
+	if (OXT_UNLIKELY(!looksLikePositiveNumber(idString)
+		|| index >= req->config->locationConfigs.size()))
+	{
+		disconnectWithError(&client, "the !~PASSENGER_LOCATION_CONFIG_ID header "
+			"refers to an unknown location config");
+		return;
+	}
+
+	req->locationConfig = req->config->locationConfigs[index];
+}
+
 void
 Controller::initializeFlags(Client *client, Request *req, RequestAnalysis &analysis) {
 	if (analysis.flags != NULL) {
@@ -113,6 +140,7 @@ Controller::respondFromTurboCache(Client *client, Request *req) {
 		ResponseCache<Request>::Entry entry(turboCaching.responseCache.fetch(req,
 			ev_now(getLoop())));
 		if (entry.valid()) {
+			ControllerMetrics::increment(metrics.turbocacheHits);
 			SKC_TRACE(client, 2, "Turbocaching: cache hit (key \"" <<
 				cEscapeString(req->cacheKey) << "\")");
 			turboCaching.writeResponse(this, client, req, entry);
@@ -121,6 +149,7 @@ Controller::respondFromTurboCache(Client *client, Request *req) {
 			}
 			return true;
 		} else {
+			ControllerMetrics::increment(metrics.turbocacheMisses);
 			SKC_TRACE(client, 2, "Turbocaching: cache miss: " <<
 				entry.getCacheMissReasonString() <<
 				" (key \"" << cEscapeString(req->cacheKey) << "\")");
@@ -165,7 +194,7 @@ Controller::initializePoolOptions(Client *client, Request *req, RequestAnalysis
 	if (!req->ended()) {
 		// See comment for req->envvars to learn how it is different
 		// from req->options.environmentVariables.
-		req->envvars = req->secureHeaders.lookup(PASSENGER_ENV_VARS);
+		req->envvars = req->lookupSecureHeader(PASSENGER_ENV_VARS);
 		if (req->envvars != NULL && req->envvars->size > 0) {
 			req->envvars = psg_lstr_make_contiguous(req->envvars, req->pool);
 			req->options.environmentVariables = StaticString(
@@ -200,10 +229,16 @@ Controller::fillPoolOptionsFromConfigCaches(Options &options,
 	options.forceMaxConcurrentRequestsPerProcess = requestConfig->defaultForceMaxConcurrentRequestsPerProcess;
 	options.environment = requestConfig->defaultEnvironment;
 	options.spawnMethod = requestConfig->defaultSpawnMethod;
+	options.routingMethod = requestConfig->defaultRoutingMethod;
 	options.bindAddress = requestConfig->defaultBindAddress;
 	options.loadShellEnvvars = requestConfig->defaultLoadShellEnvvars;
 	options.statThrottleRate = mainConfig.statThrottleRate;
 	options.maxRequests = requestConfig->defaultMaxRequests;
+	options.spawnConcurrency = requestConfig->defaultSpawnConcurrency;
+	options.standbyProcesses = requestConfig->defaultStandbyProcesses;
+	options.maxMemory = requestConfig->defaultMaxMemory;
+	options.pythonThreadCount = requestConfig->defaultPythonThreadCount;
+	options.pythonSmartSpawning = requestConfig->defaultPythonSmartSpawning;
 	options.stickySessionsCookieAttributes = requestConfig->defaultStickySessionsCookieAttributes;
 
 	/******************************/
@@ -213,7 +248,7 @@ void
 Controller::fillPoolOption(Request *req, StaticString &field,
 	const HashedStaticString &name)
 {
-	const LString *value = req->secureHeaders.lookup(name);
+	const LString *value = req->lookupSecureHeader(name);
 	if (value != NULL && value->size > 0) {
 		value = psg_lstr_make_contiguous(value, req->pool);
 		field = StaticString(value->start->data, value->size);
@@ -224,7 +259,7 @@ void
 Controller::fillPoolOption(Request *req, bool &field,
 	const HashedStaticString &name)
 {
-	const LString *value = req->secureHeaders.lookup(name);
+	const LString *value = req->lookupSecureHeader(name);
 	if (value != NULL && value->size > 0) {
 		field = psg_lstr_first_byte(value) == 't';
 	}
@@ -234,7 +269,7 @@ void
 Controller::fillPoolOption(Request *req, int &field,
 	const HashedStaticString &name)
 {
-	const LString *value = req->secureHeaders.lookup(name);
+	const LString *value = req->lookupSecureHeader(name);
 	if (value != NULL && value->size > 0) {
 		value = psg_lstr_make_contiguous(value, req->pool);
 		field = stringToInt(StaticString(value->start->data, value->size));
@@ -245,7 +280,7 @@ void
 Controller::fillPoolOption(Request *req, unsigned int &field,
 	const HashedStaticString &name)
 {
-	const LString *value = req->secureHeaders.lookup(name);
+	const LString *value = req->lookupSecureHeader(name);
 	if (value != NULL && value->size > 0) {
 		value = psg_lstr_make_contiguous(value, req->pool);
 		field = stringToUint(StaticString(value->start->data, value->size));
@@ -256,7 +291,7 @@ void
 Controller::fillPoolOption(Request *req, unsigned long &field,
 	const HashedStaticString &name)
 {
-	const LString *value = req->secureHeaders.lookup(name);
+	const LString *value = req->lookupSecureHeader(name);
 	if (value != NULL && value->size > 0) {
 		value = psg_lstr_make_contiguous(value, req->pool);
 		field = stringToUint(StaticString(value->start->data, value->size));
@@ -267,7 +302,7 @@ void
 Controller::fillPoolOption(Request *req, long &field,
 	const HashedStaticString &name)
 {
-	const LString *value = req->secureHeaders.lookup(name);
+	const LString *value = req->lookupSecureHeader(name);
 	if (value != NULL && value->size > 0) {
 		value = psg_lstr_make_contiguous(value, req->pool);
 		field = stringToInt(StaticString(value->start->data, value->size));
@@ -278,7 +313,7 @@ void
 Controller::fillPoolOptionSecToMsec(Request *req, unsigned int &field,
 	const HashedStaticString &name)
 {
-	const LString *value = req->secureHeaders.lookup(name);
+	const LString *value = req->lookupSecureHeader(name);
 	if (value != NULL && value->size > 0) {
 		value = psg_lstr_make_contiguous(value, req->pool);
 		field = stringToInt(StaticString(value->start->data, value->size)) * 1000;
@@ -289,18 +324,17 @@ void
 Controller::createNewPoolOptions(Client *client, Request *req,
 	const HashedStaticString &appGroupName)
 {
-	ServerKit::HeaderTable &secureHeaders = req->secureHeaders;
 	Options &options = req->options;
 
 	SKC_TRACE(client, 2, "Creating new pool options: app group name=" << appGroupName);
 
 	options = Options();
 
-	const LString *scriptName = secureHeaders.lookup("!~SCRIPT_NAME");
-	const LString *appRoot = secureHeaders.lookup("!~PASSENGER_APP_ROOT");
+	const LString *scriptName = req->lookupSecureHeader("!~SCRIPT_NAME");
+	const LString *appRoot = req->lookupSecureHeader("!~PASSENGER_APP_ROOT");
 	if (scriptName == NULL || scriptName->size == 0) {
 		if (appRoot == NULL || appRoot->size == 0) {
-			const LString *documentRoot = secureHeaders.lookup("!~DOCUMENT_ROOT");
+			const LString *documentRoot = req->lookupSecureHeader("!~DOCUMENT_ROOT");
 			if (OXT_UNLIKELY(documentRoot == NULL || documentRoot->size == 0)) {
 				disconnectWithError(&client, "client did not send a !~PASSENGER_APP_ROOT or a !~DOCUMENT_ROOT header");
 				return;
@@ -316,7 +350,7 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 		options.appRoot = HashedStaticString(appRoot->start->data, appRoot->size);
 	} else {
 		if (appRoot == NULL || appRoot->size == 0) {
-			const LString *documentRoot = secureHeaders.lookup("!~DOCUMENT_ROOT");
+			const LString *documentRoot = req->lookupSecureHeader("!~DOCUMENT_ROOT");
 			if (OXT_UNLIKELY(documentRoot == NULL || documentRoot->size == 0)) {
 				disconnectWithError(&client, "client did not send a !~DOCUMENT_ROOT header");
 				return;
@@ -338,9 +372,9 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 
 	fillPoolOptionsFromConfigCaches(options, req->pool, req->config);
 
-	const LString *appType = secureHeaders.lookup("!~PASSENGER_APP_TYPE");
+	const LString *appType = req->lookupSecureHeader("!~PASSENGER_APP_TYPE");
 	if (appType == NULL || appType->size == 0) {
-		const LString *appStartCommand = secureHeaders.lookup("!~PASSENGER_APP_START_COMMAND");
+		const LString *appStartCommand = req->lookupSecureHeader("!~PASSENGER_APP_START_COMMAND");
 		if (appStartCommand == NULL || appStartCommand->size == 0) {
 			AppTypeDetector::Detector detector(*wrapperRegistry);
 			AppTypeDetector::Detector::Result result = detector.checkAppRoot(options.appRoot);
@@ -362,12 +396,18 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 	fillPoolOption(req, options.environment, "!~PASSENGER_APP_ENV");
 	fillPoolOption(req, options.ruby, "!~PASSENGER_RUBY");
 	fillPoolOption(req, options.python, "!~PASSENGER_PYTHON");
+	fillPoolOption(req, options.pythonThreadCount, "!~PASSENGER_PYTHON_THREAD_COUNT");
+	fillPoolOption(req, options.pythonSmartSpawning, "!~PASSENGER_PYTHON_SMART_SPAWNING");
 	fillPoolOption(req, options.nodejs, "!~PASSENGER_NODEJS");
 	fillPoolOption(req, options.meteorAppSettings, "!~PASSENGER_METEOR_APP_SETTINGS");
 	fillPoolOption(req, options.user, "!~PASSENGER_USER");
 	fillPoolOption(req, options.group, "!~PASSENGER_GROUP");
 	fillPoolOption(req, options.minProcesses, "!~PASSENGER_MIN_PROCESSES");
 	fillPoolOption(req, options.spawnMethod, "!~PASSENGER_SPAWN_METHOD");
+	fillPoolOption(req, options.spawnConcurrency, "!~PASSENGER_SPAWN_CONCURRENCY");
+	fillPoolOption(req, options.standbyProcesses, "!~PASSENGER_STANDBY_PROCESSES");
+	fillPoolOption(req, options.maxMemory, "!~PASSENGER_MAX_MEMORY");
+	fillPoolOption(req, options.routingMethod, "!~PASSENGER_ROUTING_METHOD");
 	fillPoolOption(req, options.bindAddress, "!~PASSENGER_DIRECT_INSTANCE_REQUEST_ADDRESS");
 	fillPoolOption(req, options.appStartCommand, "!~PASSENGER_APP_START_COMMAND");
 	fillPoolOptionSecToMsec(req, options.startTimeout, "!~PASSENGER_START_TIMEOUT");
@@ -431,6 +471,63 @@ Controller::getStickySessionCookieName(Request *req) {
 	}
 }
 
+/**
+ * Checks whether the Accept-Encoding request header allows a gzip-encoded
+ * response. "gzip" and "*" are accepted unless their quality value is zero;
+ * an explicit "gzip" entry takes precedence over "*".
+ */
+bool
+Controller::clientAcceptsGzip(Request *req) {
+	const LString *value = req->headers.lookup(HTTP_ACCEPT_ENCODING);
+	if (value == NULL || value->size == 0) {
+		return false;
+	}
+
+	value = psg_lstr_make_contiguous(value, req->pool);
+	const char *pos = value->start->data;
+	const char *end = pos + value->size;
+	bool wildcardAccepted = false;
+
+	while (pos < end) {
+		const char *itemEnd = (const char *) memchr(pos, ',', end - pos);
+		if (itemEnd == NULL) {
+			itemEnd = end;
+		}
+
+		while (pos < itemEnd && (*pos == ' ' || *pos == '\t')) {
+			pos++;
+		}
+		const char *codingEnd = pos;
+		while (codingEnd < itemEnd && *codingEnd != ';' && *codingEnd != ' '
+			&& *codingEnd != '\t')
+		{
+			codingEnd++;
+		}
+
+		bool isGzip = codingEnd - pos == 4 && strncasecmp(pos, "gzip", 4) == 0;
+		bool isWildcard = codingEnd - pos == 1 && *pos == '*';
+		if (isGzip || isWildcard) {
+			// A quality value that consists of only zeroes means "not acceptable".
+			bool acceptable = true;
+			const char *q = (const char *) memchr(codingEnd, '=', itemEnd - codingEnd);
+			if (q != NULL) {
+				acceptable = false;
+				for (q++; q < itemEnd && !acceptable; q++) {
+					acceptable = *q >= '1' && *q <= '9';
+				}
+			}
+			if (isGzip) {
+				return acceptable;
+			}
+			wildcardAccepted = acceptable;
+		}
+
+		pos = itemEnd + 1;
+	}
+
+	return wildcardAccepted;
+}
+
 
 /****************************
  *
@@ -442,6 +539,7 @@ Controller::getStickySessionCookieName(Request *req) {
 void
 Controller::onRequestBegin(Client *client, Request *req) {
 	ParentClass::onRequestBegin(client, req);
+	ControllerMetrics::increment(metrics.requestsBegun);
 
 	CC_BENCHMARK_POINT(client, req, BM_AFTER_ACCEPT);
 
@@ -449,19 +547,27 @@ Controller::onRequestBegin(Client *client, Request *req) {
 		// Perform hash table operations as close to header parsing as possible,
 		// and localize them as much as possible, for better CPU caching.
 		RequestAnalysis analysis;
+		initializeLocationConfig(client, req);
+		if (req->ended()) {
+			return;
+		}
 		analysis.flags = req->secureHeaders.lookup(FLAGS);
 		analysis.appGroupNameCell = mainConfig.singleAppMode
 			? NULL
-			: req->secureHeaders.lookupCell(PASSENGER_APP_GROUP_NAME);
+			: req->lookupSecureHeaderCell(PASSENGER_APP_GROUP_NAME);
 		req->stickySession = getBoolOption(req, PASSENGER_STICKY_SESSIONS,
 			mainConfig.defaultStickySessions);
 		req->host = req->headers.lookup(HTTP_HOST);
+		if (mainConfig.responseCompression) {
+			req->acceptsGzip = clientAcceptsGzip(req);
+		}
 
 		/***************/
 		/***************/
 
 		SKC_TRACE(client, 2, "Initiating request");
 		req->startedAt = ev_now(getLoop());
+		req->headerParsedAt = SystemTime::getMonotonicUsec();
 		req->bodyChannel.stop();
 
 		initializeFlags(client, req, analysis);
@@ -66,6 +66,7 @@ Controller::preinitialize() {
 
 	PASSENGER_APP_GROUP_NAME = "!~PASSENGER_APP_GROUP_NAME";
 	PASSENGER_ENV_VARS = "!~PASSENGER_ENV_VARS";
+	PASSENGER_LOCATION_CONFIG_ID = "!~PASSENGER_LOCATION_CONFIG_ID";
 	PASSENGER_MAX_REQUESTS = "!~PASSENGER_MAX_REQUESTS";
 	PASSENGER_SHOW_VERSION_IN_HEADER = "!~PASSENGER_SHOW_VERSION_IN_HEADER";
 	PASSENGER_STICKY_SESSIONS = "!~PASSENGER_STICKY_SESSIONS";
@@ -78,10 +79,18 @@ Controller::preinitialize() {
 	FLAGS = "!~FLAGS";
 	HTTP_COOKIE = "cookie";
 	HTTP_DATE = "date";
+	HTTP_ACCEPT_ENCODING = "accept-encoding";
+	HTTP_ACCEPT_RANGES = "accept-ranges";
+	HTTP_CACHE_CONTROL = "cache-control";
+	HTTP_CONTENT_ENCODING = "content-encoding";
+	HTTP_CONTENT_RANGE = "content-range";
+	HTTP_ETAG = "etag";
 	HTTP_HOST = "host";
 	HTTP_CONTENT_LENGTH = "content-length";
 	HTTP_CONTENT_TYPE = "content-type";
 	HTTP_EXPECT = "expect";
+	HTTP_IF_RANGE = "if-range";
+	HTTP_RANGE = "range";
 	HTTP_CONNECTION = "connection";
 	HTTP_STATUS = "status";
 	HTTP_TRANSFER_ENCODING = "transfer-encoding";
@@ -103,7 +112,9 @@ Controller::initialize() {
 	}
 
 	ParentClass::initialize();
-	turboCaching.initialize(config["turbocaching"].asBool());
+	turboCaching.initialize(config["turbocaching"].asBool(),
+		config["turbocache_max_entries"].asUInt(),
+		config["turbocache_max_size"].asUInt());
 
 	if (mainConfig.singleAppMode) {
 		boost::shared_ptr<Options> options = boost::make_shared<Options>();
@@ -173,7 +173,7 @@ bool
 Controller::getBoolOption(Request *req, const HashedStaticString &name,
 	bool defaultValue)
 {
-	const LString *value = req->secureHeaders.lookup(name);
+	const LString *value = req->lookupSecureHeader(name);
 	if (value != NULL && value->size > 0) {
 		return psg_lstr_first_byte(value) == 't';
 	} else {
@@ -296,6 +296,40 @@ Controller::parseCookieHeader(psg_pool_t *pool, const LString *headerValue,
 	}
 }
 
+void
+Controller::recordRequestLatency(Request *req) {
+	RequestLatencyStats *stats[2] = { &latencyStats, NULL };
+	MonotonicTimeUsec now = SystemTime::getMonotonicUsec();
+
+	// Only requests that were routed to an app belong to a group.
+	if (req->checkoutBegunAt != 0) {
+		const HashedStaticString &groupName = req->options.getAppGroupName();
+		boost::shared_ptr<RequestLatencyStats> *groupStats;
+
+		if (groupLatencyStats.lookup(groupName, &groupStats)) {
+			stats[1] = groupStats->get();
+		} else if (groupName.size() <= StringKeyTable<int>::MAX_KEY_LENGTH
+			&& groupLatencyStats.size() < MAX_LATENCY_STATS_GROUPS)
+		{
+			// Entries are removed when their group is detached from the
+			// pool. The limit only guards against groups that are never
+			// detached, e.g. because their creation failed.
+			boost::shared_ptr<RequestLatencyStats> newStats =
+				boost::make_shared<RequestLatencyStats>();
+			groupLatencyStats.insert(groupName, newStats);
+			stats[1] = newStats.get();
+		}
+	}
+
+	for (unsigned int i = 0; i < 2 && stats[i] != NULL; i++) {
+		stats[i]->record(RP_HEADER, req->firstDataReceivedAt, req->headerParsedAt);
+		stats[i]->record(RP_QUEUE, req->checkoutBegunAt, req->checkedOutAt);
+		stats[i]->record(RP_CHECKOUT, req->checkedOutAt, req->sessionInitiatedAt);
+		stats[i]->record(RP_APP_TTFB, req->sessionInitiatedAt, req->responseBegunAt);
+		stats[i]->record(RP_RESPONSE, req->responseBegunAt, now);
+	}
+}
+
 #ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 	void
 	Controller::reportLargeTimeDiff(Client *client, const char *name,
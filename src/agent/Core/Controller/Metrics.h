@@ -0,0 +1,196 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CORE_CONTROLLER_METRICS_H_
+#define _PASSENGER_CORE_CONTROLLER_METRICS_H_
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <map>
+#include <string>
+#include <jsoncpp/json.h>
+#include <Algorithms/LatencyHistogram.h>
+#include <SystemTools/SystemTime.h>
+#include <JsonTools/JsonUtils.h>
+
+namespace Passenger {
+namespace Core {
+
+
+/**
+ * Monotonic counters that describe the work done by a single Controller.
+ * They are only modified by the Controller's own event loop thread, but
+ * may be read from any thread (e.g. by the ApiServer's /metrics endpoint)
+ * without synchronizing with that event loop.
+ */
+class ControllerMetrics {
+public:
+	typedef boost::atomic<boost::uint64_t> Counter;
+
+	Counter requestsBegun;
+	Counter turbocacheHits;
+	Counter turbocacheMisses;
+	Counter turbocacheStores;
+	Counter compressedResponses;
+	Counter splicedBytes;
+
+	ControllerMetrics()
+		: requestsBegun(0),
+		  turbocacheHits(0),
+		  turbocacheMisses(0),
+		  turbocacheStores(0),
+		  compressedResponses(0),
+		  splicedBytes(0)
+		{ }
+
+	/**
+	 * Increments a counter. Because there is only one writer, a relaxed
+	 * load and store suffice; this avoids a locked read-modify-write.
+	 */
+	static void increment(Counter &counter, boost::uint64_t n = 1) {
+		counter.store(counter.load(boost::memory_order_relaxed) + n,
+			boost::memory_order_relaxed);
+	}
+
+	static boost::uint64_t get(const Counter &counter) {
+		return counter.load(boost::memory_order_relaxed);
+	}
+};
+
+
+/**
+ * The phases of a request's lifecycle, for which RequestLatencyStats
+ * keeps separate histograms.
+ */
+enum RequestPhase {
+	/** From the first byte of the request until its header has been parsed. */
+	RP_HEADER,
+	/** From starting a session checkout until the pool has returned a session.
+	 * Includes time spent in the pool's wait lists and waiting for spawns. */
+	RP_QUEUE,
+	/** From obtaining a session until the connection to the app has been established. */
+	RP_CHECKOUT,
+	/** From establishing the connection to the app until the app's response begins.
+	 * Includes sending the request header and body. */
+	RP_APP_TTFB,
+	/** From the app's response beginning until the request has ended. */
+	RP_RESPONSE,
+
+	RP_COUNT
+};
+
+/**
+ * Latency histograms for every RequestPhase. Owned and modified by a
+ * single Controller, so it must only be accessed from that Controller's
+ * event loop thread. Other threads work on copies.
+ */
+class RequestLatencyStats {
+private:
+	LatencyHistogram phases[RP_COUNT];
+
+public:
+	static const char *getPhaseName(RequestPhase phase) {
+		switch (phase) {
+		case RP_HEADER:
+			return "header";
+		case RP_QUEUE:
+			return "queue";
+		case RP_CHECKOUT:
+			return "checkout";
+		case RP_APP_TTFB:
+			return "app_ttfb";
+		case RP_RESPONSE:
+			return "response";
+		default:
+			return "unknown";
+		}
+	}
+
+	/**
+	 * Records the time between two SystemTime::getMonotonicUsec() timestamps.
+	 * Does nothing if either timestamp is 0, i.e. the request never reached
+	 * that phase.
+	 */
+	void record(RequestPhase phase, MonotonicTimeUsec begin, MonotonicTimeUsec end) {
+		if (begin != 0 && end != 0) {
+			phases[phase].record((end > begin) ? end - begin : 0);
+		}
+	}
+
+	void merge(const RequestLatencyStats &other) {
+		for (unsigned int i = 0; i < RP_COUNT; i++) {
+			phases[i].merge(other.phases[i]);
+		}
+	}
+
+	const LatencyHistogram &get(RequestPhase phase) const {
+		return phases[phase];
+	}
+
+	Json::Value inspectAsJson() const {
+		Json::Value doc(Json::objectValue);
+
+		for (unsigned int i = 0; i < RP_COUNT; i++) {
+			const LatencyHistogram &histogram = phases[i];
+			Json::Value subdoc;
+
+			subdoc["count"] = (Json::UInt64) histogram.getCount();
+			subdoc["mean"] = durationToJson(histogram.getMean());
+			subdoc["p50"] = durationToJson(histogram.getPercentile(50));
+			subdoc["p90"] = durationToJson(histogram.getPercentile(90));
+			subdoc["p99"] = durationToJson(histogram.getPercentile(99));
+			subdoc["p999"] = durationToJson(histogram.getPercentile(99.9));
+			subdoc["max"] = durationToJson(histogram.getMax());
+			doc[getPhaseName((RequestPhase) i)] = subdoc;
+		}
+
+		return doc;
+	}
+};
+
+
+/**
+ * A copy of the RequestLatencyStats of one or more Controllers, for
+ * reporting them outside the Controllers' event loop threads.
+ */
+struct RequestLatencySnapshot {
+	RequestLatencyStats all;
+	std::map<std::string, RequestLatencyStats> groups;
+
+	void merge(const RequestLatencySnapshot &other) {
+		std::map<std::string, RequestLatencyStats>::const_iterator it;
+
+		all.merge(other.all);
+		for (it = other.groups.begin(); it != other.groups.end(); it++) {
+			groups[it->first].merge(it->second);
+		}
+	}
+};
+
+
+} // namespace Core
+} // namespace Passenger
+
+#endif /* _PASSENGER_CORE_CONTROLLER_METRICS_H_ */
@@ -94,6 +94,15 @@ Controller::disconnectLongRunningConnections(const StaticString &gupid) {
 	}
 }
 
+/**
+ * Called when the given group has been detached from the pool, so that
+ * the latency statistics of groups that no longer exist do not pile up.
+ */
+void
+Controller::forgetGroupLatencyStats(const HashedStaticString &groupName) {
+	groupLatencyStats.erase(groupName);
+}
+
 
 } // namespace Core
 } // namespace Passenger
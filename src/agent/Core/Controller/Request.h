@@ -29,6 +29,7 @@
 #include <ev++.h>
 #include <string>
 #include <cstring>
+#include <zlib.h>
 
 #include <ServerKit/HttpRequest.h>
 #include <ServerKit/FdSinkChannel.h>
@@ -52,6 +53,7 @@ public:
 		ANALYZING_REQUEST,
 		BUFFERING_REQUEST_BODY,
 		CHECKING_OUT_SESSION,
+		CONNECTING_TO_APP,
 		SENDING_HEADER_TO_APP,
 		FORWARDING_BODY_TO_APP,
 		WAITING_FOR_APP_OUTPUT
@@ -65,6 +67,13 @@ public:
 	};
 
 	ev_tstamp startedAt;
+	// When the request entered a lifecycle phase, for the latency histograms.
+	// Monotonic timestamps in microseconds; 0 if the phase was not reached.
+	MonotonicTimeUsec headerParsedAt;
+	MonotonicTimeUsec checkoutBegunAt;
+	MonotonicTimeUsec checkedOutAt;
+	MonotonicTimeUsec sessionInitiatedAt;
+	MonotonicTimeUsec responseBegunAt;
 
 	State state: 3;
 	bool dechunkResponse: 1;
@@ -78,15 +87,44 @@ public:
 	bool appResponseInitialized: 1;
 	bool strip100ContinueHeader: 1;
 	bool hasPragmaHeader: 1;
+	// Whether the client accepts gzip. Only set if response compression is enabled.
+	bool acceptsGzip: 1;
+	bool compressResponse: 1;
+	// Set when splice() turned out not to work for this request's sockets.
+	bool spliceUnsupported: 1;
 
 	Options options;
 	AbstractSessionPtr session;
 	const LString *host;
 	ControllerRequestConfigPtr config;
+	// The location config that the request refers to with the
+	// `!~PASSENGER_LOCATION_CONFIG_ID` header, or NULL. Owned by `config`.
+	ServerKit::HeaderTable *locationConfig;
 
 	ServerKit::FdSinkChannel appSink;
 	ServerKit::FdSourceChannel appSource;
 	AppResponse appResponse;
+	// Allocated in `pool`. Non-NULL while the response body is being compressed.
+	z_stream *compressor;
+
+	// Used while sending the file that the application referred to with
+	// X-Sendfile or X-Accel-Redirect. sendfileFd is -1 otherwise.
+	int sendfileFd;
+	boost::uint64_t sendfileOffset;
+	boost::uint64_t sendfileRemaining;
+	struct ev_io sendfileWatcher;
+
+	// Used while relaying the application response body to the client
+	// with splice(), through a pipe. splicePipe[0] is -1 if no pipe has
+	// been created. splicePipeBytes is the number of bytes in the pipe.
+	int splicePipe[2];
+	unsigned int splicePipeBytes;
+	struct ev_io spliceWatcher;
+
+	// Used while asynchronously connecting to the application process.
+	struct ev_io appConnectWatcher;
+	struct ev_timer appConnectTimer;
+	ev_tstamp appConnectDeadline;
 
 	ServerKit::FileBufferedChannel bodyBuffer;
 	boost::uint64_t bodyBytesBuffered; // After dechunking
@@ -114,6 +152,26 @@ public:
 		: BaseHttpRequest()
 		{ }
 
+	/**
+	 * Looks up a secure header (`!~...`). Headers sent with the request
+	 * take precedence over the ones in the request's location config.
+	 */
+	LString *lookupSecureHeader(const HashedStaticString &name) {
+		LString *result = secureHeaders.lookup(name);
+		if (result == NULL && locationConfig != NULL) {
+			result = locationConfig->lookup(name);
+		}
+		return result;
+	}
+
+	ServerKit::HeaderTable::Cell *lookupSecureHeaderCell(const HashedStaticString &name) {
+		ServerKit::HeaderTable::Cell *result = secureHeaders.lookupCell(name);
+		if (result == NULL && locationConfig != NULL) {
+			result = locationConfig->lookupCell(name);
+		}
+		return result;
+	}
+
 	const char *getStateString() const {
 		switch (state) {
 		case ANALYZING_REQUEST:
@@ -122,6 +180,8 @@ public:
 			return "BUFFERING_REQUEST_BODY";
 		case CHECKING_OUT_SESSION:
 			return "CHECKING_OUT_SESSION";
+		case CONNECTING_TO_APP:
+			return "CONNECTING_TO_APP";
 		case SENDING_HEADER_TO_APP:
 			return "SENDING_HEADER_TO_APP";
 		case FORWARDING_BODY_TO_APP:
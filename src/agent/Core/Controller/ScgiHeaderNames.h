@@ -0,0 +1,242 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CORE_CONTROLLER_SCGI_HEADER_NAMES_H_
+#define _PASSENGER_CORE_CONTROLLER_SCGI_HEADER_NAMES_H_
+
+#include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
+#include <cstring>
+#include <StaticString.h>
+#include <DataStructures/LString.h>
+#include <DataStructures/HashedStaticString.h>
+#include <ServerKit/HeaderTable.h>
+
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+	#include <emmintrin.h>
+	#define PASSENGER_SCGI_HEADER_NAMES_SSE2
+#endif
+
+namespace Passenger {
+namespace Core {
+
+
+/**
+ * Converts an HTTP header name to the name part of its CGI variable name,
+ * e.g. "accept-encoding" to "ACCEPT_ENCODING": letters are uppercased and
+ * dashes become underscores. Writes exactly `size` bytes to `output`.
+ *
+ * Returns false if the name contains anything other than ASCII letters,
+ * digits and dashes. Such headers must not be passed to the application,
+ * because different headers could map to the same CGI variable (e.g.
+ * "upp3r_cas3" and "upp3r-cas3"). This is the fix for CVE-2015-7519. The
+ * contents of `output` are undefined in that case.
+ */
+inline bool
+httpHeaderNameToScgi(const char *data, unsigned int size, char *output) {
+	const char *end = data + size;
+
+	#ifdef PASSENGER_SCGI_HEADER_NAMES_SSE2
+		const __m128i caseBit = _mm_set1_epi8(0x20);
+		const __m128i beforeA = _mm_set1_epi8('a' - 1);
+		const __m128i afterZ  = _mm_set1_epi8('z' + 1);
+		const __m128i before0 = _mm_set1_epi8('0' - 1);
+		const __m128i after9  = _mm_set1_epi8('9' + 1);
+		const __m128i dash    = _mm_set1_epi8('-');
+		const __m128i underscore = _mm_set1_epi8('_');
+
+		while (end - data >= 16) {
+			__m128i input = _mm_loadu_si128((const __m128i *) data);
+			__m128i lower = _mm_or_si128(input, caseBit);
+			__m128i isAlpha = _mm_and_si128(
+				_mm_cmpgt_epi8(lower, beforeA),
+				_mm_cmplt_epi8(lower, afterZ));
+			__m128i isDigit = _mm_and_si128(
+				_mm_cmpgt_epi8(input, before0),
+				_mm_cmplt_epi8(input, after9));
+			__m128i isDash = _mm_cmpeq_epi8(input, dash);
+
+			if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(isAlpha, isDigit), isDash))
+				!= 0xFFFF)
+			{
+				return false;
+			}
+
+			// Clear the case bit of letters, then replace dashes by underscores.
+			__m128i result = _mm_andnot_si128(_mm_and_si128(isAlpha, caseBit), input);
+			result = _mm_or_si128(_mm_andnot_si128(isDash, result),
+				_mm_and_si128(isDash, underscore));
+			_mm_storeu_si128((__m128i *) output, result);
+
+			data += 16;
+			output += 16;
+		}
+	#endif
+
+	while (data < end) {
+		char ch = *data;
+		char lower = ch | 0x20;
+		if (lower >= 'a' && lower <= 'z') {
+			*output = ch & ~0x20;
+		} else if (ch >= '0' && ch <= '9') {
+			*output = ch;
+		} else if (ch == '-') {
+			*output = '_';
+		} else {
+			return false;
+		}
+		data++;
+		output++;
+	}
+	return true;
+}
+
+/**
+ * Appends "HTTP_" plus the CGI version of the given header name, and a
+ * terminating NUL, to the buffer at `pos`. Returns the new position, or
+ * NULL if the name is not allowed to be passed to the application (see
+ * httpHeaderNameToScgi()) or if the buffer is too small. Nothing is
+ * considered written in that case.
+ */
+inline char *
+appendScgiHeaderName(char *pos, const char *end, const LString *name) {
+	if (OXT_UNLIKELY((size_t) (end - pos) < sizeof("HTTP_") + name->size)) {
+		return NULL;
+	}
+
+	memcpy(pos, "HTTP_", sizeof("HTTP_") - 1);
+	pos += sizeof("HTTP_") - 1;
+
+	const LString::Part *part = name->start;
+	while (part != NULL) {
+		if (!httpHeaderNameToScgi(part->data, part->size, pos)) {
+			return NULL;
+		}
+		pos += part->size;
+		part = part->next;
+	}
+
+	*pos = '\0';
+	return pos + 1;
+}
+
+
+/**
+ * A precomputed mapping from the most common HTTP request header names to
+ * their NUL-terminated CGI variable names, so that constructing the
+ * session protocol header doesn't have to convert these names for every
+ * request. Lookups use the hash that HttpHeaderParser already calculated
+ * for each header.
+ */
+class ScgiHeaderNames {
+private:
+	struct Entry {
+		HashedStaticString httpName;
+		StaticString scgiName;
+	};
+
+	// Must be a power of 2, and comfortably larger than the number of names.
+	static const unsigned int SIZE = 128;
+
+	Entry entries[SIZE];
+
+	void add(const char *httpName, const char *scgiName) {
+		HashedStaticString name(httpName);
+		unsigned int i = name.hash() & (SIZE - 1);
+
+		while (!entries[i].httpName.empty()) {
+			i = (i + 1) & (SIZE - 1);
+		}
+		entries[i].httpName = name;
+		// Include the terminating NUL.
+		entries[i].scgiName = StaticString(scgiName, strlen(scgiName) + 1);
+	}
+
+public:
+	ScgiHeaderNames() {
+		add("accept", "HTTP_ACCEPT");
+		add("accept-charset", "HTTP_ACCEPT_CHARSET");
+		add("accept-encoding", "HTTP_ACCEPT_ENCODING");
+		add("accept-language", "HTTP_ACCEPT_LANGUAGE");
+		add("authorization", "HTTP_AUTHORIZATION");
+		add("cache-control", "HTTP_CACHE_CONTROL");
+		add("cdn-loop", "HTTP_CDN_LOOP");
+		add("cookie", "HTTP_COOKIE");
+		add("dnt", "HTTP_DNT");
+		add("forwarded", "HTTP_FORWARDED");
+		add("host", "HTTP_HOST");
+		add("if-match", "HTTP_IF_MATCH");
+		add("if-modified-since", "HTTP_IF_MODIFIED_SINCE");
+		add("if-none-match", "HTTP_IF_NONE_MATCH");
+		add("if-unmodified-since", "HTTP_IF_UNMODIFIED_SINCE");
+		add("origin", "HTTP_ORIGIN");
+		add("pragma", "HTTP_PRAGMA");
+		add("range", "HTTP_RANGE");
+		add("referer", "HTTP_REFERER");
+		add("sec-fetch-dest", "HTTP_SEC_FETCH_DEST");
+		add("sec-fetch-mode", "HTTP_SEC_FETCH_MODE");
+		add("sec-fetch-site", "HTTP_SEC_FETCH_SITE");
+		add("sec-fetch-user", "HTTP_SEC_FETCH_USER");
+		add("te", "HTTP_TE");
+		add("upgrade", "HTTP_UPGRADE");
+		add("upgrade-insecure-requests", "HTTP_UPGRADE_INSECURE_REQUESTS");
+		add("user-agent", "HTTP_USER_AGENT");
+		add("via", "HTTP_VIA");
+		add("x-csrf-token", "HTTP_X_CSRF_TOKEN");
+		add("x-forwarded-for", "HTTP_X_FORWARDED_FOR");
+		add("x-forwarded-host", "HTTP_X_FORWARDED_HOST");
+		add("x-forwarded-port", "HTTP_X_FORWARDED_PORT");
+		add("x-forwarded-proto", "HTTP_X_FORWARDED_PROTO");
+		add("x-forwarded-ssl", "HTTP_X_FORWARDED_SSL");
+		add("x-real-ip", "HTTP_X_REAL_IP");
+		add("x-request-id", "HTTP_X_REQUEST_ID");
+		add("x-request-start", "HTTP_X_REQUEST_START");
+		add("x-requested-with", "HTTP_X_REQUESTED_WITH");
+	}
+
+	/**
+	 * Returns the NUL-terminated CGI variable name of the given header
+	 * (including the NUL), or NULL if it's not one of the common headers.
+	 */
+	const StaticString *lookup(const ServerKit::Header *header) const {
+		unsigned int i = header->hash & (SIZE - 1);
+
+		while (!entries[i].httpName.empty()) {
+			if (entries[i].httpName.hash() == header->hash
+			 && psg_lstr_cmp(&header->key, entries[i].httpName))
+			{
+				return &entries[i].scgiName;
+			}
+			i = (i + 1) & (SIZE - 1);
+		}
+		return NULL;
+	}
+};
+
+
+} // namespace Core
+} // namespace Passenger
+
+#endif /* _PASSENGER_CORE_CONTROLLER_SCGI_HEADER_NAMES_H_ */
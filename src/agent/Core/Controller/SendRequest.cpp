@@ -154,49 +154,10 @@ Controller::sendHeaderToApp(Client *client, Request *req) {
 void
 Controller::sendHeaderToAppWithSessionProtocol(Client *client, Request *req) {
 	TRACE_POINT();
-	SessionProtocolWorkingState state;
-
-	// Workaround for Ruby < 2.1 support.
-	std::string deltaMonotonic;
-	unsigned long long now = SystemTime::getUsec();
-	MonotonicTimeUsec monotonicNow = SystemTime::getMonotonicUsec();
-	if (now > monotonicNow) {
-		deltaMonotonic = boost::to_string(now - monotonicNow);
-	} else {
-		long long diff = monotonicNow - now;
-		deltaMonotonic = boost::to_string(-diff);
-	}
-
-	unsigned int bufferSize = determineMaxHeaderSizeForSessionProtocol(req,
-		state, deltaMonotonic);
-	MemoryKit::mbuf_pool &mbuf_pool = getContext()->mbuf_pool;
-	const unsigned int MBUF_MAX_SIZE = mbuf_pool_data_size(&mbuf_pool);
-	bool ok;
-
-	if (bufferSize <= MBUF_MAX_SIZE) {
-		MemoryKit::mbuf buffer(MemoryKit::mbuf_get(&mbuf_pool));
-		bufferSize = MBUF_MAX_SIZE;
-
-		ok = constructHeaderForSessionProtocol(req, buffer.start,
-			bufferSize, state, deltaMonotonic);
-		assert(ok);
-		buffer = MemoryKit::mbuf(buffer, 0, bufferSize);
-		SKC_TRACE(client, 3, "Header data: \"" << cEscapeString(
-			StaticString(buffer.start, bufferSize)) << "\"");
-		req->appSink.feedWithoutRefGuard(boost::move(buffer));
-	} else {
-		char *buffer = (char *) psg_pnalloc(req->pool, bufferSize);
-
-		ok = constructHeaderForSessionProtocol(req, buffer,
-			bufferSize, state, deltaMonotonic);
-		assert(ok);
-		SKC_TRACE(client, 3, "Header data: \"" << cEscapeString(
-			StaticString(buffer, bufferSize)) << "\"");
-		req->appSink.feedWithoutRefGuard(MemoryKit::mbuf(
-			buffer, bufferSize));
-	}
-
-	(void) ok; // Shut up compiler warning
+	MemoryKit::mbuf buffer(constructSessionProtocolHeader(req));
+	SKC_TRACE(client, 3, "Header data: \"" << cEscapeString(
+		StaticString(buffer.start, buffer.size())) << "\"");
+	req->appSink.feedWithoutRefGuard(boost::move(buffer));
 }
 
 void
@@ -229,93 +190,6 @@ Controller::sendBodyToAppWhenAppSinkIdle(Channel *_channel, unsigned int size) {
 	}
 }
 
-static bool
-isAlphaNum(char ch) {
-	return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
-}
-
-/**
- * For CGI, alphanum headers with optional dashes are mapped to UPP3R_CAS3. This
- * function can be used to reject non-alphanum/dash headers that would end up with
- * the same mapping (e.g. upp3r_cas3 and upp3r-cas3 would end up the same, and
- * potentially collide each other in the receiving application). This is
- * used to fix CVE-2015-7519.
- */
-static bool
-containsNonAlphaNumDash(const LString &s) {
-	const LString::Part *part = s.start;
-	while (part != NULL) {
-		for (unsigned int i = 0; i < part->size; i++) {
-			const char start = part->data[i];
-			if (start != '-' && !isAlphaNum(start)) {
-				return true;
-			}
-		}
-		part = part->next;
-	}
-	return false;
-}
-
-static void
-httpHeaderToScgiUpperCase(unsigned char *data, unsigned int size) {
-	static const boost::uint8_t toUpperMap[256] = {
-		'\0', 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, '\t',
-		'\n', 0x0b, 0x0c, '\r', 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13,
-		0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
-		0x1e, 0x1f,  ' ',  '!',  '"',  '#',  '$',  '%',  '&', '\'',
-		 '(',  ')',  '*',  '+',  ',',  '_',  '.',  '/',  '0',  '1',
-		 '2',  '3',  '4',  '5',  '6',  '7',  '8',  '9',  ':',  ';',
-		 '<',  '=',  '>',  '?',  '@',  'A',  'B',  'C',  'D',  'E',
-		 'F',  'G',  'H',  'I',  'J',  'K',  'L',  'M',  'N',  'O',
-		 'P',  'Q',  'R',  'S',  'T',  'U',  'V',  'W',  'X',  'Y',
-		 'Z',  '[', '\\',  ']',  '^',  '_',  '`',  'A',  'B',  'C',
-		 'D',  'E',  'F',  'G',  'H',  'I',  'J',  'K',  'L',  'M',
-		 'N',  'O',  'P',  'Q',  'R',  'S',  'T',  'U',  'V',  'W',
-		 'X',  'Y',  'Z',  '{',  '|',  '}',  '~', 0x7f, 0x80, 0x81,
-		0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b,
-		0x8c, 0x8d, 0x8e, 0x8f, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95,
-		0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
-		0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9,
-		0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf, 0xb0, 0xb1, 0xb2, 0xb3,
-		0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd,
-		0xbe, 0xbf, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
-		0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf, 0xd0, 0xd1,
-		0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xdb,
-		0xdc, 0xdd, 0xde, 0xdf, 0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5,
-		0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xeb, 0xec, 0xed, 0xee, 0xef,
-		0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9,
-		0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
-	};
-
-	const unsigned char *buf = data;
-	const size_t imax = size / 8;
-	const size_t leftover = size % 8;
-	size_t i;
-
-	for (i = 0; i < imax; i++, data += 8) {
-		data[0] = (unsigned char) toUpperMap[data[0]];
-		data[1] = (unsigned char) toUpperMap[data[1]];
-		data[2] = (unsigned char) toUpperMap[data[2]];
-		data[3] = (unsigned char) toUpperMap[data[3]];
-		data[4] = (unsigned char) toUpperMap[data[4]];
-		data[5] = (unsigned char) toUpperMap[data[5]];
-		data[6] = (unsigned char) toUpperMap[data[6]];
-		data[7] = (unsigned char) toUpperMap[data[7]];
-	}
-
-	i = imax * 8;
-	switch (leftover) {
-	case 7: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
-	case 6: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
-	case 5: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
-	case 4: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
-	case 3: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
-	case 2: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
-	case 1: *data++ = (unsigned char) toUpperMap[buf[i]]; /* Falls through. */
-	case 0: break;
-	}
-}
-
 unsigned int
 Controller::determineMaxHeaderSizeForSessionProtocol(Request *req,
 	SessionProtocolWorkingState &state, string delta_monotonic)
@@ -565,32 +439,33 @@ Controller::constructHeaderForSessionProtocol(Request *req, char * restrict buff
 	while (*it != NULL) {
 		// This header-skipping is not accounted for in determineMaxHeaderSizeForSessionProtocol(), but
 		// since we are only reducing the size it just wastes some mem bytes.
-		if ((
-				(it->header->hash == HTTP_CONTENT_LENGTH.hash()
-						|| it->header->hash == HTTP_CONTENT_TYPE.hash()
-						|| it->header->hash == HTTP_CONNECTION.hash()
-				) && (psg_lstr_cmp(&it->header->key, HTTP_CONTENT_TYPE)
-						|| psg_lstr_cmp(&it->header->key, HTTP_CONTENT_LENGTH)
-						|| psg_lstr_cmp(&it->header->key, HTTP_CONNECTION)
-				)
-			) || containsNonAlphaNumDash(it->header->key)
-		   )
+		if ((it->header->hash == HTTP_CONTENT_LENGTH.hash()
+				|| it->header->hash == HTTP_CONTENT_TYPE.hash()
+				|| it->header->hash == HTTP_CONNECTION.hash()
+			) && (psg_lstr_cmp(&it->header->key, HTTP_CONTENT_TYPE)
+				|| psg_lstr_cmp(&it->header->key, HTTP_CONTENT_LENGTH)
+				|| psg_lstr_cmp(&it->header->key, HTTP_CONNECTION)
+			))
 		{
 			it.next();
 			continue;
 		}
 
-		pos = appendData(pos, end, P_STATIC_STRING("HTTP_"));
-		const LString::Part *part = it->header->key.start;
-		while (part != NULL) {
-			char *start = pos;
-			pos = appendData(pos, end, part->data, part->size);
-			httpHeaderToScgiUpperCase((unsigned char *) start, pos - start);
-			part = part->next;
+		const StaticString *scgiName = scgiHeaderNames.lookup(it->header);
+		if (scgiName != NULL) {
+			pos = appendData(pos, end, *scgiName);
+		} else {
+			// Converts the name and rejects names that are not alphanumeric
+			// with optional dashes, in a single pass (CVE-2015-7519).
+			char *newPos = appendScgiHeaderName(pos, end, &it->header->key);
+			if (newPos == NULL) {
+				it.next();
+				continue;
+			}
+			pos = newPos;
 		}
-		pos = appendData(pos, end, "", 1);
 
-		part = it->header->val.start;
+		const LString::Part *part = it->header->val.start;
 		while (part != NULL) {
 			pos = appendData(pos, end, part->data, part->size);
 			part = part->next;
@@ -1075,5 +950,59 @@ Controller::logAppSocketWriteError(Client *client, int errcode) {
 }
 
 
+/****************************
+ *
+ * Protected methods
+ *
+ ****************************/
+
+
+/**
+ * Constructs the session protocol header for the given request, as it is sent
+ * to the application. The header is put in an mbuf if it fits, and in memory
+ * allocated from the request's pool otherwise. `req->session` must be set.
+ */
+MemoryKit::mbuf
+Controller::constructSessionProtocolHeader(Request *req) {
+	SessionProtocolWorkingState state;
+
+	// Workaround for Ruby < 2.1 support.
+	std::string deltaMonotonic;
+	unsigned long long now = SystemTime::getUsec();
+	MonotonicTimeUsec monotonicNow = SystemTime::getMonotonicUsec();
+	if (now > monotonicNow) {
+		deltaMonotonic = boost::to_string(now - monotonicNow);
+	} else {
+		long long diff = monotonicNow - now;
+		deltaMonotonic = boost::to_string(-diff);
+	}
+
+	unsigned int bufferSize = determineMaxHeaderSizeForSessionProtocol(req,
+		state, deltaMonotonic);
+	MemoryKit::mbuf_pool &mbuf_pool = getContext()->mbuf_pool;
+	const unsigned int MBUF_MAX_SIZE = mbuf_pool_data_size(&mbuf_pool);
+	bool ok;
+
+	if (bufferSize <= MBUF_MAX_SIZE) {
+		MemoryKit::mbuf buffer(MemoryKit::mbuf_get(&mbuf_pool));
+		bufferSize = MBUF_MAX_SIZE;
+
+		ok = constructHeaderForSessionProtocol(req, buffer.start,
+			bufferSize, state, deltaMonotonic);
+		assert(ok);
+		(void) ok; // Shut up compiler warning
+		return MemoryKit::mbuf(buffer, 0, bufferSize);
+	} else {
+		char *buffer = (char *) psg_pnalloc(req->pool, bufferSize);
+
+		ok = constructHeaderForSessionProtocol(req, buffer,
+			bufferSize, state, deltaMonotonic);
+		assert(ok);
+		(void) ok; // Shut up compiler warning
+		return MemoryKit::mbuf(buffer, bufferSize);
+	}
+}
+
+
 } // namespace Core
 } // namespace Passenger
@@ -51,6 +51,27 @@ Controller::getThreadNumber() const {
 	return mainConfig.threadNumber;
 }
 
+const ControllerMetrics &
+Controller::getMetrics() const {
+	return metrics;
+}
+
+/**
+ * Copies the request latency statistics into `snapshot`, so that they
+ * can be reported outside the event loop thread.
+ */
+void
+Controller::snapshotRequestLatency(RequestLatencySnapshot &snapshot) const {
+	StringKeyTable< boost::shared_ptr<RequestLatencyStats> >::ConstIterator
+		it(groupLatencyStats);
+
+	snapshot.all = latencyStats;
+	while (*it != NULL) {
+		snapshot.groups[it.getKey().toString()] = *it.getValue();
+		it.next();
+	}
+}
+
 Json::Value
 Controller::inspectStateAsJson() const {
 	Json::Value doc = ParentClass::inspectStateAsJson();
@@ -62,8 +83,26 @@ Controller::inspectStateAsJson() const {
 		subdoc["stores"] = turboCaching.responseCache.getStores();
 		subdoc["store_successes"] = turboCaching.responseCache.getStoreSuccesses();
 		subdoc["store_success_ratio"] = turboCaching.responseCache.getStoreSuccessRatio();
+		subdoc["evictions"] = turboCaching.responseCache.getEvictions();
+		subdoc["entries"] = turboCaching.responseCache.getEntryCount();
+		subdoc["max_entries"] = turboCaching.responseCache.getMaxEntries();
+		subdoc["size"] = byteSizeToJson(turboCaching.responseCache.getTotalSize());
+		subdoc["max_size"] = byteSizeToJson(turboCaching.responseCache.getMaxSize());
 		doc["turbocaching"] = subdoc;
 	}
+
+	Json::Value latencyDoc;
+	Json::Value groupsDoc(Json::objectValue);
+	StringKeyTable< boost::shared_ptr<RequestLatencyStats> >::ConstIterator
+		it(groupLatencyStats);
+	while (*it != NULL) {
+		groupsDoc[it.getKey().toString()] = it.getValue()->inspectAsJson();
+		it.next();
+	}
+	latencyDoc["all"] = latencyStats.inspectAsJson();
+	latencyDoc["groups"] = groupsDoc;
+	doc["request_latency"] = latencyDoc;
+
 	return doc;
 }
 
@@ -198,8 +198,9 @@ public:
 		  nextTimeout(0)
 		{ }
 
-	void initialize(bool initiallyEnabled) {
+	void initialize(bool initiallyEnabled, unsigned int maxEntries, size_t maxSize) {
 		state = initiallyEnabled ? ENABLED : DISABLED;
+		responseCache.configure(maxEntries, maxSize);
 		lastTimeout = (ev_tstamp) time(NULL);
 		nextTimeout = (ev_tstamp) time(NULL) + ENABLED_TIMEOUT;
 	}
@@ -243,11 +244,14 @@ public:
 				state = TEMPORARILY_DISABLED;
 				nextTimeout = now + TEMPORARY_DISABLE_TIMEOUT;
 			} else {
-				P_DEBUG("Clearing turbocache");
 				nextTimeout = now + ENABLED_TIMEOUT;
 			}
+			if (state == TEMPORARILY_DISABLED) {
+				// Release the memory held by the cache while we're not using it.
+				P_DEBUG("Clearing turbocache");
+				responseCache.clear();
+			}
 			responseCache.resetStatistics();
-			responseCache.clear();
 			break;
 		case TEMPORARILY_DISABLED:
 			P_INFO("Re-enabling turbocaching");
@@ -31,6 +31,7 @@
 	#define SUPPORTS_PER_THREAD_CPU_AFFINITY
 	#include <sched.h>
 	#include <pthread.h>
+	#include <linux/filter.h>
 #endif
 #ifdef USE_SELINUX
 	#include <selinux/selinux.h>
@@ -54,6 +55,15 @@
 #include <pwd.h>
 #include <grp.h>
 
+#if defined(__linux__) && defined(SO_REUSEPORT)
+	// Other platforms support SO_REUSEPORT, but don't load balance
+	// connections between the sockets.
+	#define SUPPORTS_REUSE_PORT_LOAD_BALANCING
+	#ifdef SO_ATTACH_REUSEPORT_CBPF
+		#define SUPPORTS_REUSE_PORT_CPU_STEERING
+	#endif
+#endif
+
 #include <set>
 #include <vector>
 #include <string>
@@ -139,6 +149,10 @@ namespace Core {
 
 	struct WorkingObjects {
 		int serverFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
+		// If `controller_reuse_port` is enabled, then for every TCP address
+		// this contains SO_REUSEPORT server sockets for threads 2..N. Thread 1
+		// listens on the corresponding `serverFds` entry.
+		vector<int> reusePortServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		int apiServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		string controllerSecureHeadersPassword;
 
@@ -230,6 +244,7 @@ static void waitForExitEvent();
 static void cleanup();
 static void deletePidFile();
 static void abortLongRunningConnections(const ApplicationPool2::ProcessPtr &process);
+static void groupDetached(const ApplicationPool2::GroupPtr &group);
 static void serverShutdownFinished();
 static void controllerShutdownFinished(Controller *controller);
 static void apiServerShutdownFinished(Core::ApiServer::ApiServer *server);
@@ -368,6 +383,101 @@ makeFileWorldReadableAndWritable(const string &path) {
 	} while (ret == -1 && errno == EINTR);
 }
 
+#ifdef SUPPORTS_PER_THREAD_CPU_AFFINITY
+	// Returns the number of CPUs that Core threads are pinned to, or 0 if
+	// per-thread CPU affinity is disabled or not possible.
+	static unsigned int
+	getCoreThreadAffinityCpuCount() {
+		unsigned int maxCpus = boost::thread::hardware_concurrency();
+		if (coreConfig->get("controller_cpu_affine").asBool()
+		 && maxCpus > 0 && maxCpus <= CPU_SETSIZE)
+		{
+			return maxCpus;
+		} else {
+			return 0;
+		}
+	}
+
+	// The CPU that Core thread `threadIndex` is pinned to.
+	static unsigned int
+	getCoreThreadCpu(unsigned int threadIndex, unsigned int maxCpus) {
+		return threadIndex % maxCpus;
+	}
+#endif
+
+#ifdef SUPPORTS_REUSE_PORT_CPU_STEERING
+	static struct sock_filter
+	makeSockFilter(unsigned short code, unsigned char jt, unsigned char jf, unsigned int k) {
+		struct sock_filter result = { code, jt, jf, k };
+		return result;
+	}
+
+	// Makes the kernel pick the SO_REUSEPORT server socket of a thread that
+	// getCoreThreadCpu() pinned to the CPU that received the connection.
+	// Thread N listens on the Nth socket in the group. If several threads
+	// are pinned to that CPU, then the connection's hash picks one of them.
+	// If none is, then we fall back to socket `(current CPU) % nthreads`.
+	static void
+	attachReusePortCpuSteeringProgram(int fd, unsigned int nthreads, unsigned int maxCpus) {
+		vector< vector<unsigned int> > threadsByCpu(maxCpus);
+		vector<struct sock_filter> code;
+		unsigned int i, j;
+
+		for (i = 0; i < nthreads; i++) {
+			threadsByCpu[getCoreThreadCpu(i, maxCpus)].push_back(i);
+		}
+
+		code.push_back(makeSockFilter(BPF_LD | BPF_W | BPF_ABS, 0, 0,
+			(__u32) (SKF_AD_OFF + SKF_AD_CPU)));
+		for (i = 0; i < maxCpus; i++) {
+			const vector<unsigned int> &threads = threadsByCpu[i];
+			// Number of instructions to skip if this isn't the current CPU.
+			unsigned int skip = (threads.size() <= 1) ? 1 : 2 * threads.size() + 1;
+
+			if (skip > 255) {
+				P_WARN("Too many threads per CPU to steer connections"
+					" to SO_REUSEPORT server sockets by CPU");
+				return;
+			}
+			code.push_back(makeSockFilter(BPF_JMP | BPF_JEQ | BPF_K, 0, skip, i));
+			if (threads.empty()) {
+				code.push_back(makeSockFilter(BPF_RET | BPF_K, 0, 0, i % nthreads));
+			} else if (threads.size() == 1) {
+				code.push_back(makeSockFilter(BPF_RET | BPF_K, 0, 0, threads[0]));
+			} else {
+				code.push_back(makeSockFilter(BPF_LD | BPF_W | BPF_ABS, 0, 0,
+					(__u32) (SKF_AD_OFF + SKF_AD_RXHASH)));
+				code.push_back(makeSockFilter(BPF_ALU | BPF_MOD | BPF_K, 0, 0,
+					threads.size()));
+				for (j = 0; j < threads.size() - 1; j++) {
+					code.push_back(makeSockFilter(BPF_JMP | BPF_JEQ | BPF_K, 0, 1, j));
+					code.push_back(makeSockFilter(BPF_RET | BPF_K, 0, 0, threads[j]));
+				}
+				code.push_back(makeSockFilter(BPF_RET | BPF_K, 0, 0, threads.back()));
+			}
+		}
+		// Only reached if the kernel reports a CPU number that
+		// hardware_concurrency() doesn't know about.
+		code.push_back(makeSockFilter(BPF_ALU | BPF_MOD | BPF_K, 0, 0, nthreads));
+		code.push_back(makeSockFilter(BPF_RET | BPF_A, 0, 0, 0));
+
+		if (code.size() > BPF_MAXINSNS) {
+			P_WARN("Too many CPUs to steer connections to SO_REUSEPORT"
+				" server sockets by CPU");
+			return;
+		}
+
+		struct sock_fprog prog;
+		prog.len = code.size();
+		prog.filter = &code[0];
+		if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) == -1) {
+			int e = errno;
+			P_WARN("Cannot attach CPU steering program to SO_REUSEPORT server socket: "
+				<< strerror(e) << " (errno=" << e << ")");
+		}
+	}
+#endif
+
 #ifdef USE_SELINUX
 	// Set next socket context to *:system_r:passenger_instance_httpd_socket_t.
 	// Note that this only sets the context of the socket file descriptor,
@@ -451,9 +561,19 @@ startListening() {
 	WorkingObjects *wo = workingObjects;
 	const Json::Value addresses = coreConfig->get("controller_addresses");
 	const Json::Value apiAddresses = coreConfig->get("api_server_addresses");
+	unsigned int nthreads = coreConfig->get("controller_threads").asUInt();
+	unsigned int backlog = coreConfig->get("controller_socket_backlog").asUInt();
+	bool reusePort = coreConfig->get("controller_reuse_port").asBool() && nthreads > 1;
 	Json::Value::const_iterator it;
 	unsigned int i;
 
+	#ifndef SUPPORTS_REUSE_PORT_LOAD_BALANCING
+		if (reusePort) {
+			P_WARN("controller_reuse_port is not supported on this platform; ignoring it");
+			reusePort = false;
+		}
+	#endif
+
 	#ifdef USE_SELINUX
 		// Set SELinux context on the first socket that we create
 		// so that the web server can access it.
@@ -461,9 +581,26 @@ startListening() {
 	#endif
 
 	for (it = addresses.begin(), i = 0; it != addresses.end(); it++, i++) {
-		wo->serverFds[i] = createServer(it->asString(),
-			coreConfig->get("controller_socket_backlog").asUInt(), true,
-			__FILE__, __LINE__);
+		if (reusePort && getSocketAddressType(it->asString()) == SAT_TCP) {
+			wo->serverFds[i] = createReusePortServer(it->asString(), backlog,
+				__FILE__, __LINE__);
+			for (unsigned int j = 1; j < nthreads; j++) {
+				int fd = createReusePortServer(it->asString(), backlog,
+					__FILE__, __LINE__);
+				wo->reusePortServerFds[i].push_back(fd);
+				P_LOG_FILE_DESCRIPTOR_PURPOSE(fd, "Server address: " << it->asString()
+					<< " (thread " << (j + 1) << ")");
+			}
+			#ifdef SUPPORTS_REUSE_PORT_CPU_STEERING
+				unsigned int maxCpus = getCoreThreadAffinityCpuCount();
+				if (maxCpus > 0) {
+					attachReusePortCpuSteeringProgram(wo->serverFds[i], nthreads, maxCpus);
+				}
+			#endif
+		} else {
+			wo->serverFds[i] = createServer(it->asString(), backlog, true,
+				__FILE__, __LINE__);
+		}
 		#ifdef USE_SELINUX
 			resetSelinuxSocketContext();
 			if (i == 0 && getSocketAddressType(it->asString()) == SAT_UNIX) {
@@ -733,6 +870,7 @@ initializeNonPrivilegedWorkingObjects() {
 	wo->appPool->setMaxIdleTime(coreConfig->get("pool_idle_time").asInt() * 1000000ULL);
 	wo->appPool->enableSelfChecking(coreConfig->get("pool_selfchecks").asBool());
 	wo->appPool->abortLongRunningConnectionsCallback = abortLongRunningConnections;
+	wo->appPool->groupDetachedCallback = groupDetached;
 
 	UPDATE_TRACE_POINT();
 	unsigned int nthreads = coreConfig->get("controller_threads").asUInt();
@@ -834,6 +972,12 @@ initializeNonPrivilegedWorkingObjects() {
 		if (nthreads == 1) {
 			ThreadWorkingObjects *two = &wo->threadWorkingObjects[0];
 			two->controller->listen(wo->serverFds[i]);
+		} else if (!wo->reusePortServerFds[i].empty()) {
+			wo->threadWorkingObjects[0].controller->listen(wo->serverFds[i]);
+			for (unsigned int j = 1; j < nthreads; j++) {
+				ThreadWorkingObjects *two = &wo->threadWorkingObjects[j];
+				two->controller->listen(wo->reusePortServerFds[i][j - 1]);
+			}
 		} else {
 			wo->loadBalancer.listen(wo->serverFds[i]);
 		}
@@ -1097,23 +1241,21 @@ mainLoop() {
 	TRACE_POINT();
 	WorkingObjects *wo = workingObjects;
 	#ifdef SUPPORTS_PER_THREAD_CPU_AFFINITY
-		unsigned int maxCpus = boost::thread::hardware_concurrency();
-		bool cpuAffine = coreConfig->get("controller_cpu_affine").asBool()
-			&& maxCpus <= CPU_SETSIZE;
+		unsigned int maxCpus = getCoreThreadAffinityCpuCount();
 	#endif
 
 	for (unsigned int i = 0; i < wo->threadWorkingObjects.size(); i++) {
 		ThreadWorkingObjects *two = &wo->threadWorkingObjects[i];
 		two->bgloop->start("Main event loop: thread " + toString(i + 1), 0);
 		#ifdef SUPPORTS_PER_THREAD_CPU_AFFINITY
-			if (cpuAffine) {
+			if (maxCpus > 0) {
 				cpu_set_t cpus;
 				int result;
 
 				CPU_ZERO(&cpus);
-				CPU_SET(i % maxCpus, &cpus);
+				CPU_SET(getCoreThreadCpu(i, maxCpus), &cpus);
 				P_DEBUG("Setting CPU affinity of core thread " << (i + 1)
-					<< " to CPU " << (i % maxCpus + 1));
+					<< " to CPU " << (getCoreThreadCpu(i, maxCpus) + 1));
 				result = pthread_setaffinity_np(two->bgloop->getNativeHandle(),
 					maxCpus, &cpus);
 				if (result != 0) {
@@ -1126,7 +1268,7 @@ mainLoop() {
 	if (wo->apiWorkingObjects.apiServer != NULL) {
 		wo->apiWorkingObjects.bgloop->start("API event loop", 0);
 	}
-	if (wo->threadWorkingObjects.size() > 1) {
+	if (wo->threadWorkingObjects.size() > 1 && wo->loadBalancer.hasEndpoints()) {
 		wo->loadBalancer.start();
 	}
 	waitForExitEvent();
@@ -1153,6 +1295,25 @@ abortLongRunningConnections(const ApplicationPool2::ProcessPtr &process) {
 	}
 }
 
+static void
+forgetGroupLatencyStatsOnController(Core::Controller *controller,
+	string groupName)
+{
+	controller->forgetGroupLatencyStats(groupName);
+}
+
+static void
+groupDetached(const ApplicationPool2::GroupPtr &group) {
+	// We are inside the ApplicationPool lock. Be very careful here.
+	WorkingObjects *wo = workingObjects;
+	for (unsigned int i = 0; i < wo->threadWorkingObjects.size(); i++) {
+		wo->threadWorkingObjects[i].bgloop->safe->runLater(
+			boost::bind(forgetGroupLatencyStatsOnController,
+				wo->threadWorkingObjects[i].controller,
+				group->getName().toString()));
+	}
+}
+
 static void
 shutdownController(ThreadWorkingObjects *two) {
 	two->controller->shutdown();
@@ -1315,6 +1476,9 @@ cleanup() {
 		if (wo->serverFds[i] != -1) {
 			close(wo->serverFds[i]);
 		}
+		foreach (int fd, wo->reusePortServerFds[i]) {
+			close(fd);
+		}
 		if (wo->apiServerFds[i] != -1) {
 			close(wo->apiServerFds[i]);
 		}
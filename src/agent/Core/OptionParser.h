@@ -132,6 +132,13 @@ coreUsage() {
 	printf("      --ruby PATH           Default Ruby interpreter to use.\n");
 	printf("      --nodejs PATH         Default NodeJs interpreter to use.\n");
 	printf("      --python PATH         Default Python interpreter to use.\n");
+	printf("      --python-thread-count N\n");
+	printf("                            Number of threads with which each Python\n");
+	printf("                            process handles requests. Default: 1\n");
+	printf("      --python-smart-spawning\n");
+	printf("                            Spawn Python apps through a preloader when the\n");
+	printf("                            spawn method is 'smart'. Default: spawn Python\n");
+	printf("                            apps directly\n");
 	printf("      --meteor-app-settings PATH\n");
 	printf("                            File with settings for a Meteor (non-bundled) app.\n");
 	printf("                            (passed to Meteor using --settings)\n");
@@ -158,6 +165,15 @@ coreUsage() {
 	printf("                            process can handle the given number of concurrent\n");
 	printf("                            requests per process\n");
 	printf("      --min-instances N     Minimum number of application processes. Default: 1\n");
+	printf("      --spawn-concurrency N Maximum number of processes per application that\n");
+	printf("                            may be spawned concurrently. Default: 1\n");
+	printf("      --standby-processes N Number of spare application processes to keep\n");
+	printf("                            spawned on standby. Default: 0\n");
+	printf("      --routing-method NAME How to distribute requests over application\n");
+	printf("                            processes. Can either be 'least_busy' or\n");
+	printf("                            'latency'. Default: %s\n", DEFAULT_ROUTING_METHOD);
+	printf("      --max-memory MB       Gracefully replace application processes that\n");
+	printf("                            use more memory than this. Default: 0 (unlimited)\n");
 	printf("      --memory-limit MB     Restart application processes that go over the\n");
 	printf("                            given memory limit (Enterprise only)\n");
 	printf("\n");
@@ -180,6 +196,35 @@ coreUsage() {
 	printf("                            Vary the turbocache by the cookie of the given name\n");
 	printf("      --disable-turbocaching\n");
 	printf("                            Disable turbocaching\n");
+	printf("      --turbocache-max-entries N\n");
+	printf("                            Maximum number of turbocache entries per thread.\n");
+	printf("                            Default: %d\n", DEFAULT_TURBOCACHE_MAX_ENTRIES);
+	printf("      --turbocache-max-size BYTES\n");
+	printf("                            Maximum turbocache size per thread, in bytes.\n");
+	printf("                            Default: %d\n", DEFAULT_TURBOCACHE_MAX_SIZE);
+	printf("      --response-compression\n");
+	printf("                            Gzip-compress application responses for clients\n");
+	printf("                            that accept it\n");
+	printf("      --response-compression-level N\n");
+	printf("                            Gzip compression level, 1-9. Default: %d\n",
+		DEFAULT_RESPONSE_COMPRESSION_LEVEL);
+	printf("      --response-compression-min-size BYTES\n");
+	printf("                            Do not compress responses with a smaller\n");
+	printf("                            Content-Length. Default: %d\n",
+		DEFAULT_RESPONSE_COMPRESSION_MIN_SIZE);
+	printf("      --response-compression-type MIME_TYPE\n");
+	printf("                            Compress responses with this content type. Can be\n");
+	printf("                            specified multiple times. Default: text/html and\n");
+	printf("                            other common text types\n");
+	printf("      --response-splice-min-size BYTES\n");
+	printf("                            Relay response bodies with at least this many\n");
+	printf("                            bytes left with splice() while the client keeps\n");
+	printf("                            up. 0 disables splicing. Default: %d\n",
+		DEFAULT_RESPONSE_SPLICE_MIN_SIZE);
+	printf("      --sendfile-root PATH  Serve files referenced by X-Sendfile and\n");
+	printf("                            X-Accel-Redirect response headers if they are\n");
+	printf("                            inside this directory. Can be specified\n");
+	printf("                            multiple times\n");
 	printf("      --no-abort-websockets-on-process-shutdown\n");
 	printf("                            Do not abort WebSocket connections on process\n");
 	printf("                            shutdown or restart\n");
@@ -197,6 +242,9 @@ coreUsage() {
 	printf("      --data-buffer-dir PATH\n");
 	printf("                            Directory to store data buffers in. Default:\n");
 	printf("                            %s\n", getSystemTempDir());
+	printf("      --data-buffer-io-uring\n");
+	printf("                            Use io_uring for reading and writing data buffer\n");
+	printf("                            files, if supported by the kernel\n");
 	printf("      --no-graceful-exit    When exiting, exit immediately instead of waiting\n");
 	printf("                            for all connections to terminate\n");
 	printf("      --benchmark MODE      Enable benchmark mode. Available modes:\n");
@@ -209,6 +257,9 @@ coreUsage() {
 	printf("                            Default: number of CPU cores (%d)\n",
 		boost::thread::hardware_concurrency());
 	printf("      --cpu-affine          Enable per-thread CPU affinity (Linux only)\n");
+	printf("      --reuse-port          Give each thread its own SO_REUSEPORT server socket\n");
+	printf("                            for TCP addresses, instead of distributing clients\n");
+	printf("                            through a single accept thread (Linux only)\n");
 	printf("      --core-file-descriptor-ulimit NUMBER\n");
 	printf("                            Set custom file descriptor ulimit for the core\n");
 	printf("      --admin-panel-url URL\n");
@@ -314,6 +365,18 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--min-instances")) {
 		updates["default_min_instances"] = atoi(argv[i + 1]);
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--spawn-concurrency")) {
+		updates["default_spawn_concurrency"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--standby-processes")) {
+		updates["default_standby_processes"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--max-memory")) {
+		updates["default_max_memory"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--routing-method")) {
+		updates["default_routing_method"] = argv[i + 1];
+		i += 2;
 	} else if (p.isValueFlag(argc, i, argv[i], 'e', "--environment")) {
 		updates["default_environment"] = argv[i + 1];
 		i += 2;
@@ -359,6 +422,30 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isFlag(argv[i], '\0', "--disable-turbocaching")) {
 		updates["turbocaching"] = false;
 		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-entries")) {
+		updates["turbocache_max_entries"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-size")) {
+		updates["turbocache_max_size"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--response-compression")) {
+		updates["response_compression"] = true;
+		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--response-compression-level")) {
+		updates["response_compression_level"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--response-compression-min-size")) {
+		updates["response_compression_min_size"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--response-compression-type")) {
+		updates["response_compression_types"].append(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--response-splice-min-size")) {
+		updates["response_splice_min_size"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--sendfile-root")) {
+		updates["sendfile_roots"].append(argv[i + 1]);
+		i += 2;
 	} else if (p.isFlag(argv[i], '\0', "--no-abort-websockets-on-process-shutdown")) {
 		updates["default_abort_websockets_on_process_shutdown"] = false;
 		i++;
@@ -371,6 +458,12 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--python")) {
 		updates["default_python"] = argv[i + 1];
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--python-thread-count")) {
+		updates["default_python_thread_count"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--python-smart-spawning")) {
+		updates["default_python_smart_spawning"] = true;
+		i++;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--meteor-app-settings")) {
 		updates["default_meteor_app_settings"] = argv[i + 1];
 		i += 2;
@@ -395,6 +488,9 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--data-buffer-dir")) {
 		updates["controller_file_buffered_channel_buffer_dir"] = atoi(argv[i + 1]);
 		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--data-buffer-io-uring")) {
+		updates["controller_file_buffered_channel_io_uring"] = true;
+		i++;
 	} else if (p.isFlag(argv[i], '\0', "--no-graceful-exit")) {
 		updates["graceful_exit"] = false;
 		i++;
@@ -410,6 +506,9 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isFlag(argv[i], '\0', "--cpu-affine")) {
 		updates["controller_cpu_affine"] = true;
 		i++;
+	} else if (p.isFlag(argv[i], '\0', "--reuse-port")) {
+		updates["controller_reuse_port"] = true;
+		i++;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--core-file-descriptor-ulimit")) {
 		updates["file_descriptor_ulimit"] = atoi(argv[i + 1]);
 		i += 2;
@@ -27,9 +27,14 @@
 #define _PASSENGER_RESPONSE_CACHE_H_
 
 #include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
 #include <time.h>
+#include <algorithm>
+#include <vector>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
+#include <Constants.h>
 #include <DataStructures/HashedStaticString.h>
 #include <ServerKit/http_parser.h>
 #include <ServerKit/CookieUtils.h>
@@ -40,6 +45,21 @@
 namespace Passenger {
 
 /**
+ * A per-thread HTTP response cache, used by TurboCaching.
+ *
+ * Entries are stored in a slot array and are indexed by an open addressing
+ * hash table (linear probing) that maps cache keys to slots. The cache is
+ * bounded by both a maximum number of entries and a maximum number of bytes,
+ * where the latter is the sum of all keys, response headers and response
+ * bodies. When either bound would be exceeded, entries are evicted according
+ * to the CLOCK algorithm: every successful fetch sets an entry's reference bit,
+ * and the clock hand gives referenced entries a second chance before evicting
+ * them. This approximates LRU without having to maintain a linked list on
+ * every fetch.
+ *
+ * Entry data is allocated on demand, so an empty or lightly used cache only
+ * costs as much memory as it actually stores.
+ *
  * Relevant RFCs:
  * https://tools.ietf.org/html/rfc7234    HTTP 1.1 Caching
  * https://tools.ietf.org/html/rfc2109    HTTP State Management Mechanism
@@ -47,21 +67,27 @@ namespace Passenger {
 template<typename Request>
 class ResponseCache {
 public:
-	static const unsigned int MAX_ENTRIES     = 8; // Fits in exactly 2 cache lines
+	static const unsigned int DEFAULT_MAX_ENTRIES = DEFAULT_TURBOCACHE_MAX_ENTRIES;
+	static const unsigned int DEFAULT_MAX_SIZE    = DEFAULT_TURBOCACHE_MAX_SIZE;
 	static const unsigned int MAX_KEY_LENGTH  = 256;
 	static const unsigned int MAX_HEADER_SIZE = 4096;
-	static const unsigned int MAX_BODY_SIZE   = 1024 * 32;
+	/** Upper bound for the body size limit. The actual limit is
+	 * getMaxBodySize(), which also takes the cache size into account. */
+	static const unsigned int MAX_BODY_SIZE   = 1024 * 1024;
 	static const unsigned int DEFAULT_HEURISTIC_FRESHNESS = 10;
 	static const unsigned int MIN_HEURISTIC_FRESHNESS = 1;
 
 	struct Header {
 		bool valid;
+		// CLOCK reference bit. Set on every cache hit.
+		bool referenced;
 		unsigned short keySize;
 		boost::uint32_t hash;
 		time_t date;
 
 		Header()
 			: valid(false),
+			  referenced(false),
 			  keySize(0),
 			  hash(0),
 			  date(0)
@@ -70,19 +96,25 @@ public:
 
 	struct Body {
 		unsigned short httpHeaderSize;
-		unsigned short httpBodySize;
+		unsigned int httpBodySize;
 		time_t expiryDate;
-		char key[MAX_KEY_LENGTH];
-		char httpHeaderData[MAX_HEADER_SIZE];
+		// These point into a single allocation owned by the cache.
+		char *key;
+		char *httpHeaderData;
 		// This data is dechunked.
-		char httpBodyData[MAX_BODY_SIZE];
+		char *httpBodyData;
 
 		Body()
 			: httpHeaderSize(0),
 			  httpBodySize(0),
-			  expiryDate(0)
-		{
-			key[0] = httpHeaderData[0] = httpBodyData[0] = '\0';
+			  expiryDate(0),
+			  key(NULL),
+			  httpHeaderData(NULL),
+			  httpBodyData(NULL)
+			{ }
+
+		size_t dataSize(const Header &header) const {
+			return header.keySize + httpHeaderSize + httpBodySize;
 		}
 	};
 
@@ -125,6 +157,9 @@ public:
 	};
 
 private:
+	static const boost::uint32_t EMPTY_CELL = 0xFFFFFFFF;
+	static const unsigned int MIN_INDEX_SIZE = 16;
+
 	HashedStaticString HOST;
 	HashedStaticString CACHE_CONTROL;
 	HashedStaticString PRAGMA_CONST;
@@ -140,10 +175,29 @@ private:
 	HashedStaticString COOKIE;
 	HashedStaticString PASSENGER_VARY_TURBOCACHE_BY_COOKIE;
 
-	unsigned int fetches, hits, stores, storeSuccesses;
+	unsigned int fetches, hits, stores, storeSuccesses, evictions;
+
+	unsigned int maxEntries;
+	size_t maxSize;
+	unsigned int entryCount;
+	size_t totalSize;
+	unsigned int clockHand;
+
+	/* Slot arrays. They grow on demand up to maxEntries. Slots of erased
+	 * entries are put in `freeSlots` for reuse.
+	 */
+	std::vector<Header> headers;
+	std::vector<Body> bodies;
+	std::vector<unsigned int> freeSlots;
+	/* Hash index. Each cell contains a slot number or EMPTY_CELL.
+	 * The number of cells is always a power of 2, and is kept at least
+	 * twice as large as the number of slots.
+	 */
+	std::vector<boost::uint32_t> indexCells;
 
-	Header headers[MAX_ENTRIES];
-	Body bodies[MAX_ENTRIES];
+	// Non-copyable: entries own their data.
+	ResponseCache(const ResponseCache &);
+	ResponseCache &operator=(const ResponseCache &);
 
 	unsigned int calculateKeyLength(const LString * restrict host,
 		const LString * restrict varyCookie,
@@ -151,6 +205,7 @@ private:
 	{
 		unsigned int size =
 			1  // protocol flag
+			+ 1  // content encoding flag
 			+ ((host != NULL) ? host->size : 0)
 			+ 1  // '\n'
 			+ path.size()
@@ -162,7 +217,7 @@ private:
 		}
 	}
 
-	void generateKey(bool https, const StaticString &path,
+	void generateKey(bool https, bool gzip, const StaticString &path,
 		const LString * restrict host,
 		const LString * restrict varyCookie,
 		char * restrict output,
@@ -177,6 +232,11 @@ private:
 		} else {
 			pos = appendData(pos, end, "H", 1);
 		}
+		if (gzip) {
+			pos = appendData(pos, end, "G", 1);
+		} else {
+			pos = appendData(pos, end, "I", 1);
+		}
 
 		if (host != NULL) {
 			part = host->start;
@@ -216,35 +276,134 @@ private:
 		}
 	}
 
-	Entry lookup(const HashedStaticString &cacheKey) {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (headers[i].valid
-			 && headers[i].hash == cacheKey.hash()
-			 && cacheKey == StaticString(bodies[i].key, headers[i].keySize))
+	OXT_FORCE_INLINE
+	boost::uint32_t indexMask() const {
+		return indexCells.size() - 1;
+	}
+
+	// Returns the index cell that points to the entry with the given key,
+	// or -1 if there is no such entry.
+	int findCell(const HashedStaticString &cacheKey) const {
+		if (entryCount == 0) {
+			return -1;
+		}
+
+		const boost::uint32_t mask = indexMask();
+		boost::uint32_t i = cacheKey.hash() & mask;
+		while (indexCells[i] != EMPTY_CELL) {
+			const boost::uint32_t slot = indexCells[i];
+			const Header &header = headers[slot];
+			if (header.hash == cacheKey.hash()
+			 && cacheKey == StaticString(bodies[slot].key, header.keySize))
 			{
-				return Entry(i, &headers[i], &bodies[i]);
+				return i;
 			}
+			i = (i + 1) & mask;
 		}
-		return Entry();
+		return -1;
 	}
 
-	Entry lookupInvalidOrOldest() {
-		int oldest = -1;
+	void insertIntoIndex(unsigned int slot) {
+		const boost::uint32_t mask = indexMask();
+		boost::uint32_t i = headers[slot].hash & mask;
+		while (indexCells[i] != EMPTY_CELL) {
+			i = (i + 1) & mask;
+		}
+		indexCells[i] = slot;
+	}
 
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (!headers[i].valid) {
-				return Entry(i, &headers[i], &bodies[i]);
-			} else if (oldest == -1 || headers[i].date < headers[oldest].date) {
-				oldest = i;
+	// Removes a cell from the index using backward shift deletion, so
+	// that no tombstones are necessary.
+	void eraseFromIndex(boost::uint32_t hole) {
+		const boost::uint32_t mask = indexMask();
+		boost::uint32_t i = (hole + 1) & mask;
+
+		while (indexCells[i] != EMPTY_CELL) {
+			boost::uint32_t ideal = headers[indexCells[i]].hash & mask;
+			// Move the cell into the hole if its ideal position
+			// does not lie cyclically within (hole, i].
+			if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+				indexCells[hole] = indexCells[i];
+				hole = i;
+			}
+			i = (i + 1) & mask;
+		}
+		indexCells[hole] = EMPTY_CELL;
+	}
+
+	void rebuildIndex(unsigned int size) {
+		indexCells.assign(size, EMPTY_CELL);
+		for (unsigned int i = 0; i < headers.size(); i++) {
+			if (headers[i].valid) {
+				insertIntoIndex(i);
 			}
 		}
+	}
+
+	Entry lookup(const HashedStaticString &cacheKey) {
+		int cell = findCell(cacheKey);
+		if (cell == -1) {
+			return Entry();
+		} else {
+			unsigned int slot = indexCells[cell];
+			return Entry(slot, &headers[slot], &bodies[slot]);
+		}
+	}
 
-		return Entry(oldest, &headers[oldest], &bodies[oldest]);
+	void erase(unsigned int slot) {
+		Header &header = headers[slot];
+		Body &body = bodies[slot];
+		assert(header.valid);
+
+		int cell = findCell(HashedStaticString(body.key, header.keySize, header.hash));
+		assert(cell != -1);
+		eraseFromIndex(cell);
+
+		totalSize -= body.dataSize(header);
+		entryCount--;
+		free(body.key);
+		body = Body();
+		header.valid = false;
+		freeSlots.push_back(slot);
 	}
 
-	OXT_FORCE_INLINE
-	void erase(unsigned int index) {
-		headers[index].valid = false;
+	// @pre entryCount > 0
+	void evictOne() {
+		assert(entryCount > 0);
+		while (true) {
+			if (clockHand >= headers.size()) {
+				clockHand = 0;
+			}
+
+			Header &header = headers[clockHand];
+			if (header.valid) {
+				if (header.referenced) {
+					header.referenced = false;
+				} else {
+					erase(clockHand);
+					clockHand++;
+					evictions++;
+					return;
+				}
+			}
+			clockHand++;
+		}
+	}
+
+	unsigned int allocateSlot() {
+		if (!freeSlots.empty()) {
+			unsigned int slot = freeSlots.back();
+			freeSlots.pop_back();
+			return slot;
+		}
+
+		assert(headers.size() < maxEntries);
+		headers.push_back(Header());
+		bodies.push_back(Body());
+		if (headers.size() * 2 > indexCells.size()) {
+			rebuildIndex(indexCells.size() * 2);
+		}
+		return headers.size() - 1;
 	}
 
 	time_t parseDate(psg_pool_t *pool, const LString *date, ev_tstamp now) const {
@@ -400,11 +559,24 @@ private:
 		}
 
 		char *key = (char *) psg_pnalloc(req->pool, keySize);
-		generateKey(https, path, req->host, req->varyCookie, key, keySize);
+		generateKey(https, false, path, req->host, req->varyCookie, key, keySize);
+		eraseAllEncodings(key, keySize);
+	}
 
+	/**
+	 * Erases the entries for the given key, for both the identity and
+	 * the gzip content encoding. `key` is modified.
+	 */
+	void eraseAllEncodings(char *key, unsigned int keySize) {
 		Entry entry(lookup(StaticString(key, keySize)));
 		if (entry.valid()) {
-			entry.header->valid = false;
+			erase(entry.index);
+		}
+
+		key[1] = (key[1] == 'G') ? 'I' : 'G';
+		entry = lookup(StaticString(key, keySize));
+		if (entry.valid()) {
+			erase(entry.index);
 		}
 	}
 
@@ -426,9 +598,70 @@ public:
 		  fetches(0),
 		  hits(0),
 		  stores(0),
-		  storeSuccesses(0)
+		  storeSuccesses(0),
+		  evictions(0),
+		  maxEntries(DEFAULT_MAX_ENTRIES),
+		  maxSize(DEFAULT_MAX_SIZE),
+		  entryCount(0),
+		  totalSize(0),
+		  clockHand(0),
+		  indexCells(MIN_INDEX_SIZE, EMPTY_CELL)
 		{ }
 
+	~ResponseCache() {
+		clear();
+	}
+
+	/**
+	 * Sets the maximum number of entries and the maximum number of bytes
+	 * that this cache may hold. Clears the cache.
+	 */
+	void configure(unsigned int _maxEntries, size_t _maxSize) {
+		assert(_maxEntries > 0);
+		clear();
+		headers.clear();
+		bodies.clear();
+		freeSlots.clear();
+		indexCells.assign(MIN_INDEX_SIZE, EMPTY_CELL);
+		maxEntries = _maxEntries;
+		maxSize = _maxSize;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getMaxEntries() const {
+		return maxEntries;
+	}
+
+	OXT_FORCE_INLINE
+	size_t getMaxSize() const {
+		return maxSize;
+	}
+
+	/**
+	 * The maximum size of a response body that may be stored. Bodies may
+	 * not take up more than a quarter of the cache, so that a single large
+	 * response cannot flush the entire cache.
+	 */
+	OXT_FORCE_INLINE
+	unsigned int getMaxBodySize() const {
+		return (unsigned int) std::min<size_t>(MAX_BODY_SIZE, maxSize / 4);
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getEntryCount() const {
+		return entryCount;
+	}
+
+	OXT_FORCE_INLINE
+	size_t getTotalSize() const {
+		return totalSize;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getEvictions() const {
+		return evictions;
+	}
+
 	OXT_FORCE_INLINE
 	unsigned int getFetches() const {
 		return fetches;
@@ -470,12 +703,22 @@ public:
 		hits = 0;
 		stores = 0;
 		storeSuccesses = 0;
+		evictions = 0;
 	}
 
 	void clear() {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			headers[i].valid = false;
+		for (unsigned int i = 0; i < headers.size(); i++) {
+			if (headers[i].valid) {
+				free(bodies[i].key);
+				bodies[i] = Body();
+				headers[i].valid = false;
+				freeSlots.push_back(i);
+			}
 		}
+		std::fill(indexCells.begin(), indexCells.end(), EMPTY_CELL);
+		entryCount = 0;
+		totalSize = 0;
+		clockHand = 0;
 	}
 
 
@@ -491,7 +734,7 @@ public:
 			return false;
 		}
 
-		LString *varyCookieName = req->secureHeaders.lookup(PASSENGER_VARY_TURBOCACHE_BY_COOKIE);
+		LString *varyCookieName = req->lookupSecureHeader(PASSENGER_VARY_TURBOCACHE_BY_COOKIE);
 		if (varyCookieName == NULL && !req->config->defaultVaryTurbocacheByCookie.empty()) {
 			varyCookieName = (LString *) psg_palloc(req->pool, sizeof(LString));
 			psg_lstr_init(varyCookieName);
@@ -523,7 +766,8 @@ public:
 		}
 
 		char *key = (char *) psg_pnalloc(req->pool, size);
-		generateKey(req->https, StaticString(req->path.start->data, req->path.size),
+		generateKey(req->https, req->acceptsGzip,
+			StaticString(req->path.start->data, req->path.size),
 			req->host, req->varyCookie, key, size);
 		req->cacheKey = HashedStaticString(key, size);
 		return true;
@@ -550,6 +794,7 @@ public:
 		if (entry.valid()) {
 			hits++;
 			if (isFresh(entry, now)) {
+				entry.header->referenced = true;
 				return entry;
 			} else {
 				erase(entry.index);
@@ -630,7 +875,13 @@ public:
 	Entry store(Request *req, ev_tstamp now, unsigned int headerSize, unsigned int bodySize) {
 		stores++;
 
-		if (headerSize > MAX_HEADER_SIZE || bodySize > MAX_BODY_SIZE) {
+		if (headerSize > MAX_HEADER_SIZE || bodySize > getMaxBodySize()) {
+			return Entry();
+		}
+
+		const HashedStaticString &cacheKey = req->cacheKey;
+		size_t dataSize = cacheKey.size() + headerSize + bodySize;
+		if (dataSize > maxSize) {
 			return Entry();
 		}
 
@@ -644,19 +895,38 @@ public:
 			return Entry();
 		}
 
-		const HashedStaticString &cacheKey = req->cacheKey;
+		char *data = (char *) malloc(dataSize);
+		if (OXT_UNLIKELY(data == NULL)) {
+			return Entry();
+		}
+
 		Entry entry(lookup(cacheKey));
-		if (!entry.valid()) {
-			entry = lookupInvalidOrOldest();
-			entry.header->valid   = true;
-			entry.header->hash    = cacheKey.hash();
-			entry.header->keySize = cacheKey.size();
-			memcpy(entry.body->key, cacheKey.data(), cacheKey.size());
-		}
-		entry.header->date     = responseDate;
-		entry.body->expiryDate = expiryDate;
+		if (entry.valid()) {
+			erase(entry.index);
+		}
+		while (entryCount > 0
+			&& (entryCount >= maxEntries || totalSize + dataSize > maxSize))
+		{
+			evictOne();
+		}
+
+		unsigned int slot = allocateSlot();
+		entry = Entry(slot, &headers[slot], &bodies[slot]);
+		entry.header->valid      = true;
+		entry.header->referenced = false;
+		entry.header->hash       = cacheKey.hash();
+		entry.header->keySize    = cacheKey.size();
+		entry.header->date       = responseDate;
+		entry.body->key            = data;
+		entry.body->httpHeaderData = data + cacheKey.size();
+		entry.body->httpBodyData   = data + cacheKey.size() + headerSize;
+		entry.body->expiryDate     = expiryDate;
 		entry.body->httpHeaderSize = headerSize;
 		entry.body->httpBodySize   = bodySize;
+		memcpy(entry.body->key, cacheKey.data(), cacheKey.size());
+		insertIntoIndex(slot);
+		entryCount++;
+		totalSize += dataSize;
 		storeSuccesses++;
 		return entry;
 	}
@@ -670,10 +940,9 @@ public:
 
 	// @pre requestAllowsInvalidating()
 	void invalidate(Request *req) {
-		Entry entry(lookup(req->cacheKey));
-		if (entry.valid()) {
-			entry.header->valid = false;
-		}
+		char *key = (char *) psg_pnalloc(req->pool, req->cacheKey.size());
+		memcpy(key, req->cacheKey.data(), req->cacheKey.size());
+		eraseAllEncodings(key, req->cacheKey.size());
 
 		invalidateLocation(req, LOCATION);
 		invalidateLocation(req, CONTENT_LOCATION);
@@ -682,10 +951,15 @@ public:
 
 	string inspect() const {
 		stringstream stream;
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
+		stream << " entries=" << entryCount << "/" << maxEntries
+			<< ", size=" << totalSize << "/" << maxSize << "\n";
+		for (unsigned int i = 0; i < headers.size(); i++) {
+			if (!headers[i].valid) {
+				continue;
+			}
 			time_t expiryDate = bodies[i].expiryDate;
-			stream << " #" << i << ": valid=" << headers[i].valid
-				<< ", hash=" << headers[i].hash
+			stream << " #" << i << ": hash=" << headers[i].hash
+				<< ", referenced=" << headers[i].referenced
 				<< ", expiryDate=" << expiryDate
 				<< ", keySize=" << headers[i].keySize << ", key=\""
 				<< cEscapeString(StaticString(bodies[i].key, headers[i].keySize)) << "\"\n";
@@ -694,6 +968,9 @@ public:
 	}
 };
 
+template<typename Request>
+const boost::uint32_t ResponseCache<Request>::EMPTY_CELL;
+
 
 } // namespace Passenger
 
@@ -51,6 +51,11 @@ private:
 		if (options.appType == "ruby" || options.appType == "rack") {
 			preloaderCommand.push_back(options.ruby);
 			preloaderCommand.push_back(dir + "/rack-preloader.rb");
+		} else if ((options.appType == "python" || options.appType == "wsgi")
+			&& options.pythonSmartSpawning)
+		{
+			preloaderCommand.push_back(options.python);
+			preloaderCommand.push_back(dir + "/wsgi-preloader.py");
 		} else {
 			return SpawnerPtr();
 		}
@@ -35,6 +35,7 @@
 #include <string>
 #include <vector>
 #include <stdexcept>
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <cerrno>
@@ -193,6 +194,11 @@ private:
 
 	void watchSocketPingability() {
 		TRACE_POINT();
+		// There is no way to get notified when a process starts listening on
+		// a port, so we poll. We start with a short interval so that apps
+		// that start quickly are detected quickly, and back off exponentially
+		// so that slow-starting apps aren't hammered with connection attempts.
+		useconds_t interval = 1000;
 
 		while (true) {
 			unsigned long long timeout = 100000;
@@ -204,7 +210,8 @@ private:
 				wakeupEventLoop();
 				break;
 			} else {
-				syscalls::usleep(50000);
+				syscalls::usleep(interval);
+				interval = std::min<useconds_t>(interval * 2, 50000);
 			}
 		}
 	}
@@ -38,11 +38,16 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
+#include <poll.h>
 #include <signal.h>
 #include <unistd.h>
 #include <cstring>
 #include <cassert>
 
+#ifdef __linux__
+	#include <sys/syscall.h>
+#endif
+
 #include <adhoc_lve.h>
 
 #include <LoggingKit/Logging.h>
@@ -83,9 +88,11 @@ private:
 	StringKeyTable<string> preloaderAnnotations;
 	AppPoolOptions options;
 
-	// Protects m_lastUsed and pid.
+	// Protects m_lastUsed and the preloader information fields.
 	mutable boost::mutex simpleFieldSyncher;
-	// Protects everything else.
+	// Serializes starting and stopping the preloader, and sending it commands.
+	// It is not held during handshakes, so that multiple processes can be
+	// spawned concurrently.
 	mutable boost::mutex syncher;
 
 	// Preloader information.
@@ -95,25 +102,6 @@ private:
 	unsigned long long m_lastUsed;
 
 
-	/**
-	 * Behaves like <tt>waitpid(pid, status, WNOHANG)</tt>, but waits at most
-	 * <em>timeout</em> miliseconds for the process to exit.
-	 */
-	static int timedWaitpid(pid_t pid, int *status, unsigned long long timeout) {
-		Timer<SystemTime::GRAN_10MSEC> timer;
-		int ret;
-
-		do {
-			ret = syscalls::waitpid(pid, status, WNOHANG);
-			if (ret > 0 || ret == -1) {
-				return ret;
-			} else {
-				syscalls::usleep(10000);
-			}
-		} while (timer.elapsed() < timeout);
-		return 0; // timed out
-	}
-
 	static bool osProcessExists(pid_t pid) {
 		if (syscalls::kill(pid, 0) == 0) {
 			/* On some environments, e.g. Heroku, the init process does
@@ -1220,6 +1208,7 @@ private:
 	}
 
 	void addPreloaderEnvDumps(SpawnException &e) const {
+		boost::lock_guard<boost::mutex> l(simpleFieldSyncher);
 		e.setPreloaderPid(pid);
 		e.setPreloaderEnvvars(preloaderEnvvars);
 		e.setPreloaderUserInfo(preloaderUserInfo);
@@ -1276,10 +1265,12 @@ public:
 			m_lastUsed = SystemTime::getUsec();
 		}
 		UPDATE_TRACE_POINT();
-		boost::lock_guard<boost::mutex> l(syncher);
-		if (!preloaderStarted()) {
-			UPDATE_TRACE_POINT();
-			startPreloader();
+		{
+			boost::lock_guard<boost::mutex> l(syncher);
+			if (!preloaderStarted()) {
+				UPDATE_TRACE_POINT();
+				startPreloader();
+			}
 		}
 
 		UPDATE_TRACE_POINT();
@@ -1309,7 +1300,16 @@ public:
 			session.journey.setStepPerformed(SPAWNING_KIT_PREPARATION, true);
 
 			UPDATE_TRACE_POINT();
-			ForkResult forkResult = invokeForkCommand(session, stepToMarkAsErrored);
+			ForkResult forkResult;
+			{
+				boost::lock_guard<boost::mutex> l(syncher);
+				if (!preloaderStarted()) {
+					// Another thread stopped it in the mean time.
+					UPDATE_TRACE_POINT();
+					startPreloader();
+				}
+				forkResult = invokeForkCommand(session, stepToMarkAsErrored);
+			}
 
 			UPDATE_TRACE_POINT();
 			ScopeGuard guard(boost::bind(nonInterruptableKillAndWaitpid, forkResult.pid));
@@ -1363,6 +1363,58 @@ public:
 		boost::lock_guard<boost::mutex> lock(simpleFieldSyncher);
 		return pid;
 	}
+
+	/**
+	 * Behaves like <tt>waitpid(pid, status, WNOHANG)</tt>, but waits at most
+	 * <em>timeout</em> miliseconds for the process to exit. This is used for
+	 * stopping the preloader. Processes that are being started, including the
+	 * preloader itself, are watched by HandshakePerform instead.
+	 *
+	 * On Linux >= 5.3 this waits on a pidfd, so that the exit is noticed
+	 * immediately. Elsewhere it falls back to pollingTimedWaitpid().
+	 */
+	static int timedWaitpid(pid_t pid, int *status, unsigned long long timeout) {
+		#ifdef SYS_pidfd_open
+			int pidfd = (int) syscall(SYS_pidfd_open, pid, 0);
+			if (pidfd != -1) {
+				FdGuard guard(pidfd, __FILE__, __LINE__);
+				struct pollfd pfd;
+				int ret;
+
+				pfd.fd = pidfd;
+				pfd.events = POLLIN;
+				pfd.revents = 0;
+				ret = syscalls::poll(&pfd, 1, (int) timeout);
+				if (ret == -1) {
+					return -1;
+				} else if (ret == 0) {
+					return 0; // timed out
+				} else {
+					return syscalls::waitpid(pid, status, WNOHANG);
+				}
+			}
+		#endif
+		return pollingTimedWaitpid(pid, status, timeout);
+	}
+
+	/**
+	 * Like timedWaitpid(), but checks whether the process has exited
+	 * every 10 msec.
+	 */
+	static int pollingTimedWaitpid(pid_t pid, int *status, unsigned long long timeout) {
+		Timer<SystemTime::GRAN_10MSEC> timer;
+		int ret;
+
+		do {
+			ret = syscalls::waitpid(pid, status, WNOHANG);
+			if (ret > 0 || ret == -1) {
+				return ret;
+			} else {
+				syscalls::usleep(10000);
+			}
+		} while (timer.elapsed() < timeout);
+		return 0; // timed out
+	}
 };
 
 
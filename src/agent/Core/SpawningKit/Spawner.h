@@ -135,6 +135,7 @@ protected:
 		config->group = info.groupname;
 
 		extraArgs["spawn_method"] = options.spawnMethod.toString();
+		extraArgs["python_thread_count"] = options.pythonThreadCount;
 		config->bindAddress = options.bindAddress;
 
 		/******************/
@@ -25,6 +25,9 @@
  */
 
 #include <boost/make_shared.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include "Bucket.h"
 
 namespace Passenger {
@@ -51,6 +54,9 @@ struct BucketData {
 	bool bufferResponse;
 };
 
+/** The largest buffer that PassengerBucketState::bufferSize grows to. */
+static const apr_size_t MAX_BUFFER_SIZE = 64 * 1024;
+
 static void
 bucket_destroy(void *data) {
 	BucketData *bucket_data = (BucketData *) data;
@@ -62,6 +68,7 @@ bucket_destroy(void *data) {
 static apr_status_t
 bucket_read(apr_bucket *bucket, const char **str, apr_size_t *len, apr_read_type_e block) {
 	char *buf;
+	apr_size_t bufferSize;
 	ssize_t ret;
 	BucketData *data;
 
@@ -89,19 +96,21 @@ bucket_read(apr_bucket *bucket, const char **str, apr_size_t *len, apr_read_type
 		return APR_EAGAIN;
 	}
 
-	buf = (char *) apr_bucket_alloc(APR_BUCKET_BUFF_SIZE, bucket->list);
+	bufferSize = data->state->bufferSize;
+	buf = (char *) apr_bucket_alloc(bufferSize, bucket->list);
 	if (buf == NULL) {
 		return APR_ENOMEM;
 	}
 
-	do {
-		ret = read(data->state->connection, buf, APR_BUCKET_BUFF_SIZE);
-	} while (ret == -1 && errno == EINTR);
+	ret = readResponseBody(*data->state, buf, bufferSize);
 
 	if (ret > 0) {
 		apr_bucket_heap *h;
 
 		data->state->bytesRead += ret;
+		if ((apr_size_t) ret == bufferSize && bufferSize < MAX_BUFFER_SIZE) {
+			data->state->bufferSize = std::min(bufferSize * 2, MAX_BUFFER_SIZE);
+		}
 
 		*str = buf;
 		*len = ret;
@@ -113,7 +122,7 @@ bucket_read(apr_bucket *bucket, const char **str, apr_size_t *len, apr_read_type
 		 */
 		bucket = apr_bucket_heap_make(bucket, buf, *len, apr_bucket_free);
 		h = (apr_bucket_heap *) bucket->data;
-		h->alloc_len = APR_BUCKET_BUFF_SIZE; /* note the real buffer size */
+		h->alloc_len = bufferSize; /* note the real buffer size */
 
 		/* And after this newly created bucket we insert a new Passenger Bucket
 		 * which can read the next chunk from the stream.
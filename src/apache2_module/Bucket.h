@@ -29,14 +29,16 @@
 #include <boost/shared_ptr.hpp>
 #include <apr_buckets.h>
 #include <FileDescriptor.h>
+#include "ResponseBody.h"
 
 namespace Passenger {
 namespace Apache2Module {
 
+using namespace std;
 using namespace boost;
 
 
-struct PassengerBucketState {
+struct PassengerBucketState: public ResponseBodyState {
 	/** The number of bytes that this PassengerBucket has read so far. */
 	unsigned long bytesRead;
 
@@ -54,14 +56,19 @@ struct PassengerBucketState {
 	 */
 	int errorCode;
 
-	/** Connection to the Passenger core. */
-	FileDescriptor connection;
+	/** Size of the next buffer to read into. Starts at APR_BUCKET_BUFF_SIZE
+	 * and grows while the response keeps filling entire buffers, so that
+	 * large responses are forwarded in fewer, larger buckets.
+	 */
+	apr_size_t bufferSize;
 
-	PassengerBucketState(const FileDescriptor &conn) {
+	PassengerBucketState(const FileDescriptor &conn)
+		: ResponseBodyState(conn)
+	{
 		bytesRead  = 0;
 		completed  = false;
 		errorCode  = 0;
-		connection = conn;
+		bufferSize = APR_BUCKET_BUFF_SIZE;
 	}
 };
 
@@ -84,6 +91,9 @@ typedef boost::shared_ptr<PassengerBucketState> PassengerBucketStatePtr;
  * - It ignores the APR_NONBLOCK_READ flag because that's known to cause
  *   strange I/O problems.
  * - It can store its current state in a PassengerBucketState data structure.
+ * - It stops at the end of the response body as framed by the Passenger core
+ *   (Content-Length or chunked encoding), so that the connection can be
+ *   reused. Chunked bodies are decoded.
  */
 apr_bucket *passenger_bucket_create(const PassengerBucketStatePtr &state,
                                     apr_bucket_alloc_t *list,
@@ -137,6 +137,11 @@ extern "C" const command_rec passenger_commands[] = {
 		NULL,
 		RSRC_CONF | ACCESS_CONF,
 		"The concurrency model that should be used for applications."),
+	AP_INIT_TAKE1("PassengerCoreKeepalive",
+		(Take1Func) cmd_passenger_core_keepalive,
+		NULL,
+		RSRC_CONF,
+		"The maximum number of idle connections to the Phusion Passenger(R) core that every Apache process keeps open for reuse."),
 	AP_INIT_TAKE2("PassengerCtl",
 		(Take2Func) cmd_passenger_ctl,
 		NULL,
@@ -272,6 +277,11 @@ extern "C" const command_rec passenger_commands[] = {
 		NULL,
 		RSRC_CONF,
 		"The maximum number of simultaneously alive application instances a single application may occupy."),
+	AP_INIT_TAKE1("PassengerMaxMemory",
+		(Take1Func) cmd_passenger_max_memory,
+		NULL,
+		RSRC_CONF | ACCESS_CONF,
+		"The amount of memory in MB above which an application process is gracefully replaced."),
 	AP_INIT_TAKE1("PassengerMaxPoolSize",
 		(Take1Func) cmd_passenger_max_pool_size,
 		NULL,
@@ -342,6 +352,11 @@ extern "C" const command_rec passenger_commands[] = {
 		NULL,
 		RSRC_CONF | ACCESS_CONF,
 		"The Python interpreter to use."),
+	AP_INIT_TAKE1("PassengerPythonThreadCount",
+		(Take1Func) cmd_passenger_python_thread_count,
+		NULL,
+		RSRC_CONF | ACCESS_CONF,
+		"The number of threads with which each Python process handles requests."),
 	AP_INIT_FLAG("PassengerResistDeploymentErrors",
 		(FlagFunc) cmd_passenger_enterprise_only,
 		NULL,
@@ -367,6 +382,11 @@ extern "C" const command_rec passenger_commands[] = {
 		NULL,
 		RSRC_CONF,
 		"The Phusion Passenger(R) root folder."),
+	AP_INIT_TAKE1("PassengerRoutingMethod",
+		(Take1Func) cmd_passenger_routing_method,
+		NULL,
+		RSRC_CONF | ACCESS_CONF,
+		"How to distribute requests over application processes: 'least_busy' or 'latency'."),
 	AP_INIT_TAKE1("PassengerRuby",
 		(Take1Func) cmd_passenger_ruby,
 		NULL,
@@ -387,6 +407,11 @@ extern "C" const command_rec passenger_commands[] = {
 		NULL,
 		RSRC_CONF,
 		"The Phusion Passenger(R) socket backlog."),
+	AP_INIT_TAKE1("PassengerSpawnConcurrency",
+		(Take1Func) cmd_passenger_spawn_concurrency,
+		NULL,
+		RSRC_CONF | ACCESS_CONF,
+		"The maximum number of processes per application that may be spawned concurrently."),
 	AP_INIT_TAKE1("PassengerSpawnDir",
 		(Take1Func) cmd_passenger_spawn_dir,
 		NULL,
@@ -397,6 +422,11 @@ extern "C" const command_rec passenger_commands[] = {
 		NULL,
 		RSRC_CONF | ACCESS_CONF,
 		"The spawn method to use."),
+	AP_INIT_TAKE1("PassengerStandbyProcesses",
+		(Take1Func) cmd_passenger_standby_processes,
+		NULL,
+		RSRC_CONF | ACCESS_CONF,
+		"The number of spare application processes to keep spawned on standby."),
 	AP_INIT_TAKE1("PassengerStartTimeout",
 		(Take1Func) cmd_passenger_start_timeout,
 		NULL,
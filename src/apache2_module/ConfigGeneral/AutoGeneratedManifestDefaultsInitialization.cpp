@@ -48,6 +48,11 @@ void
 ConfigManifestGenerator::autoGenerated_setGlobalConfigDefaults() {
 	Json::Value &globalConfigContainer = manifest["global_configuration"];
 
+	addOptionsContainerStaticDefaultInt(
+		globalConfigContainer,
+		"PassengerCoreKeepalive",
+		0);
+
 	addOptionsContainerDynamicDefault(
 		globalConfigContainer,
 		"PassengerDataBufferDir",
@@ -209,6 +214,11 @@ ConfigManifestGenerator::autoGenerated_setAppConfigDefaults() {
 		"PassengerLveMinUid",
 		DEFAULT_LVE_MIN_UID);
 
+	addOptionsContainerStaticDefaultInt(
+		defaultAppConfigContainer,
+		"PassengerMaxMemory",
+		0);
+
 	addOptionsContainerStaticDefaultInt(
 		defaultAppConfigContainer,
 		"PassengerMaxPreloaderIdleTime",
@@ -239,21 +249,41 @@ ConfigManifestGenerator::autoGenerated_setAppConfigDefaults() {
 		"PassengerPython",
 		DEFAULT_PYTHON);
 
+	addOptionsContainerStaticDefaultInt(
+		defaultAppConfigContainer,
+		"PassengerPythonThreadCount",
+		1);
+
 	addOptionsContainerStaticDefaultStr(
 		defaultAppConfigContainer,
 		"PassengerRestartDir",
 		P_STATIC_STRING("tmp"));
 
+	addOptionsContainerStaticDefaultStr(
+		defaultAppConfigContainer,
+		"PassengerRoutingMethod",
+		P_STATIC_STRING("least_busy"));
+
 	addOptionsContainerStaticDefaultStr(
 		defaultAppConfigContainer,
 		"PassengerRuby",
 		StaticString());
 
+	addOptionsContainerStaticDefaultInt(
+		defaultAppConfigContainer,
+		"PassengerSpawnConcurrency",
+		1);
+
 	addOptionsContainerDynamicDefault(
 		defaultAppConfigContainer,
 		"PassengerSpawnMethod",
 		P_STATIC_STRING("'smart' for Ruby apps, 'direct' for all other apps"));
 
+	addOptionsContainerStaticDefaultInt(
+		defaultAppConfigContainer,
+		"PassengerStandbyProcesses",
+		0);
+
 	addOptionsContainerStaticDefaultInt(
 		defaultAppConfigContainer,
 		"PassengerStartTimeout",
@@ -259,6 +259,20 @@ cmd_passenger_buffer_upload(cmd_parms *cmd, void *pcfg, const char *arg) {
 	return NULL;
 }
 
+static const char *
+cmd_passenger_core_keepalive(cmd_parms *cmd, void *pcfg, const char *arg) {
+	const char *err = ap_check_cmd_context(cmd, GLOBAL_ONLY);
+	if (err != NULL) {
+		ap_log_perror(APLOG_MARK, APLOG_STARTUP, 0, cmd->temp_pool,
+			"WARNING: %s", err);
+	}
+
+	serverConfig.coreKeepaliveSourceFile = cmd->directive->filename;
+	serverConfig.coreKeepaliveSourceLine = cmd->directive->line_num;
+	serverConfig.coreKeepaliveExplicitlySet = true;
+	return setIntConfig(cmd, arg, serverConfig.coreKeepalive, 0);
+}
+
 static const char *
 cmd_passenger_data_buffer_dir(cmd_parms *cmd, void *pcfg, const char *arg) {
 	const char *err = ap_check_cmd_context(cmd, GLOBAL_ONLY);
@@ -585,6 +599,20 @@ cmd_passenger_max_instances_per_app(cmd_parms *cmd, void *pcfg, const char *arg)
 	return setIntConfig(cmd, arg, serverConfig.maxInstancesPerApp, 0);
 }
 
+static const char *
+cmd_passenger_max_memory(cmd_parms *cmd, void *pcfg, const char *arg) {
+	const char *err = ap_check_cmd_context(cmd, NOT_IN_FILES);
+	if (err != NULL) {
+		return err;
+	}
+
+	DirConfig *config = (DirConfig *) pcfg;
+	config->mMaxMemorySourceFile = cmd->directive->filename;
+	config->mMaxMemorySourceLine = cmd->directive->line_num;
+	config->mMaxMemoryExplicitlySet = true;
+	return setIntConfig(cmd, arg, config->mMaxMemory, 0);
+}
+
 static const char *
 cmd_passenger_max_pool_size(cmd_parms *cmd, void *pcfg, const char *arg) {
 	const char *err = ap_check_cmd_context(cmd, GLOBAL_ONLY);
@@ -744,6 +772,20 @@ cmd_passenger_python(cmd_parms *cmd, void *pcfg, const char *arg) {
 	return NULL;
 }
 
+static const char *
+cmd_passenger_python_thread_count(cmd_parms *cmd, void *pcfg, const char *arg) {
+	const char *err = ap_check_cmd_context(cmd, NOT_IN_FILES);
+	if (err != NULL) {
+		return err;
+	}
+
+	DirConfig *config = (DirConfig *) pcfg;
+	config->mPythonThreadCountSourceFile = cmd->directive->filename;
+	config->mPythonThreadCountSourceLine = cmd->directive->line_num;
+	config->mPythonThreadCountExplicitlySet = true;
+	return setIntConfig(cmd, arg, config->mPythonThreadCount, 1);
+}
+
 static const char *
 cmd_passenger_response_buffer_high_watermark(cmd_parms *cmd, void *pcfg, const char *arg) {
 	const char *err = ap_check_cmd_context(cmd, GLOBAL_ONLY);
@@ -788,6 +830,21 @@ cmd_passenger_root(cmd_parms *cmd, void *pcfg, const char *arg) {
 	return NULL;
 }
 
+static const char *
+cmd_passenger_routing_method(cmd_parms *cmd, void *pcfg, const char *arg) {
+	const char *err = ap_check_cmd_context(cmd, NOT_IN_FILES);
+	if (err != NULL) {
+		return err;
+	}
+
+	DirConfig *config = (DirConfig *) pcfg;
+	config->mRoutingMethodSourceFile = cmd->directive->filename;
+	config->mRoutingMethodSourceLine = cmd->directive->line_num;
+	config->mRoutingMethodExplicitlySet = true;
+	config->mRoutingMethod = arg;
+	return NULL;
+}
+
 static const char *
 cmd_passenger_ruby(cmd_parms *cmd, void *pcfg, const char *arg) {
 	const char *err = ap_check_cmd_context(cmd, NOT_IN_FILES);
@@ -847,6 +904,20 @@ cmd_passenger_socket_backlog(cmd_parms *cmd, void *pcfg, const char *arg) {
 	return setIntConfig(cmd, arg, serverConfig.socketBacklog, 0);
 }
 
+static const char *
+cmd_passenger_spawn_concurrency(cmd_parms *cmd, void *pcfg, const char *arg) {
+	const char *err = ap_check_cmd_context(cmd, NOT_IN_FILES);
+	if (err != NULL) {
+		return err;
+	}
+
+	DirConfig *config = (DirConfig *) pcfg;
+	config->mSpawnConcurrencySourceFile = cmd->directive->filename;
+	config->mSpawnConcurrencySourceLine = cmd->directive->line_num;
+	config->mSpawnConcurrencyExplicitlySet = true;
+	return setIntConfig(cmd, arg, config->mSpawnConcurrency, 1);
+}
+
 static const char *
 cmd_passenger_spawn_dir(cmd_parms *cmd, void *pcfg, const char *arg) {
 	const char *err = ap_check_cmd_context(cmd, GLOBAL_ONLY);
@@ -862,6 +933,20 @@ cmd_passenger_spawn_dir(cmd_parms *cmd, void *pcfg, const char *arg) {
 	return NULL;
 }
 
+static const char *
+cmd_passenger_standby_processes(cmd_parms *cmd, void *pcfg, const char *arg) {
+	const char *err = ap_check_cmd_context(cmd, NOT_IN_FILES);
+	if (err != NULL) {
+		return err;
+	}
+
+	DirConfig *config = (DirConfig *) pcfg;
+	config->mStandbyProcessesSourceFile = cmd->directive->filename;
+	config->mStandbyProcessesSourceLine = cmd->directive->line_num;
+	config->mStandbyProcessesExplicitlySet = true;
+	return setIntConfig(cmd, arg, config->mStandbyProcesses, 0);
+}
+
 static const char *
 cmd_passenger_start_timeout(cmd_parms *cmd, void *pcfg, const char *arg) {
 	const char *err = ap_check_cmd_context(cmd, NOT_IN_FILES);
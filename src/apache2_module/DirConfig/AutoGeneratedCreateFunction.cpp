@@ -88,6 +88,7 @@ createDirConfig_autoGenerated(DirConfig *config) {
 	config->mHighPerformance = Apache2Module::UNSET;
 	config->mLoadShellEnvvars = Apache2Module::UNSET;
 	config->mLveMinUid = UNSET_INT_VALUE;
+	config->mMaxMemory = UNSET_INT_VALUE;
 	config->mMaxPreloaderIdleTime = UNSET_INT_VALUE;
 	config->mMaxRequestQueueSize = UNSET_INT_VALUE;
 	config->mMaxRequests = UNSET_INT_VALUE;
@@ -104,15 +105,21 @@ createDirConfig_autoGenerated(DirConfig *config) {
 	/*
 	 * config->mPython: default initialized
 	 */
+	config->mPythonThreadCount = UNSET_INT_VALUE;
 	/*
 	 * config->mRestartDir: default initialized
 	 */
+	/*
+	 * config->mRoutingMethod: default initialized
+	 */
 	/*
 	 * config->mRuby: default initialized
 	 */
+	config->mSpawnConcurrency = UNSET_INT_VALUE;
 	/*
 	 * config->mSpawnMethod: default initialized
 	 */
+	config->mStandbyProcesses = UNSET_INT_VALUE;
 	config->mStartTimeout = UNSET_INT_VALUE;
 	/*
 	 * config->mStartupFile: default initialized
@@ -147,6 +154,7 @@ createDirConfig_autoGenerated(DirConfig *config) {
 	config->mHighPerformanceSourceLine = 0;
 	config->mLoadShellEnvvarsSourceLine = 0;
 	config->mLveMinUidSourceLine = 0;
+	config->mMaxMemorySourceLine = 0;
 	config->mMaxPreloaderIdleTimeSourceLine = 0;
 	config->mMaxRequestQueueSizeSourceLine = 0;
 	config->mMaxRequestsSourceLine = 0;
@@ -155,9 +163,13 @@ createDirConfig_autoGenerated(DirConfig *config) {
 	config->mMonitorLogFileSourceLine = 0;
 	config->mNodejsSourceLine = 0;
 	config->mPythonSourceLine = 0;
+	config->mPythonThreadCountSourceLine = 0;
 	config->mRestartDirSourceLine = 0;
+	config->mRoutingMethodSourceLine = 0;
 	config->mRubySourceLine = 0;
+	config->mSpawnConcurrencySourceLine = 0;
 	config->mSpawnMethodSourceLine = 0;
+	config->mStandbyProcessesSourceLine = 0;
 	config->mStartTimeoutSourceLine = 0;
 	config->mStartupFileSourceLine = 0;
 	config->mStickySessionsSourceLine = 0;
@@ -184,6 +196,7 @@ createDirConfig_autoGenerated(DirConfig *config) {
 	config->mHighPerformanceExplicitlySet = false;
 	config->mLoadShellEnvvarsExplicitlySet = false;
 	config->mLveMinUidExplicitlySet = false;
+	config->mMaxMemoryExplicitlySet = false;
 	config->mMaxPreloaderIdleTimeExplicitlySet = false;
 	config->mMaxRequestQueueSizeExplicitlySet = false;
 	config->mMaxRequestsExplicitlySet = false;
@@ -192,9 +205,13 @@ createDirConfig_autoGenerated(DirConfig *config) {
 	config->mMonitorLogFileExplicitlySet = false;
 	config->mNodejsExplicitlySet = false;
 	config->mPythonExplicitlySet = false;
+	config->mPythonThreadCountExplicitlySet = false;
 	config->mRestartDirExplicitlySet = false;
+	config->mRoutingMethodExplicitlySet = false;
 	config->mRubyExplicitlySet = false;
+	config->mSpawnConcurrencyExplicitlySet = false;
 	config->mSpawnMethodExplicitlySet = false;
+	config->mStandbyProcessesExplicitlySet = false;
 	config->mStartTimeoutExplicitlySet = false;
 	config->mStartupFileExplicitlySet = false;
 	config->mStickySessionsExplicitlySet = false;
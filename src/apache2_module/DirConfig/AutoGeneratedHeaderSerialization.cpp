@@ -79,6 +79,9 @@ constructRequestHeaders_autoGenerated(request_rec *r, DirConfig *config, std::st
 	addHeader(r, result, StaticString("!~PASSENGER_LVE_MIN_UID",
 			sizeof("!~PASSENGER_LVE_MIN_UID") - 1),
 		config->mLveMinUid);
+	addHeader(r, result, StaticString("!~PASSENGER_MAX_MEMORY",
+			sizeof("!~PASSENGER_MAX_MEMORY") - 1),
+		config->mMaxMemory);
 	addHeader(r, result, StaticString("!~PASSENGER_MAX_PRELOADER_IDLE_TIME",
 			sizeof("!~PASSENGER_MAX_PRELOADER_IDLE_TIME") - 1),
 		config->mMaxPreloaderIdleTime);
@@ -100,15 +103,27 @@ constructRequestHeaders_autoGenerated(request_rec *r, DirConfig *config, std::st
 	addHeader(result, StaticString("!~PASSENGER_PYTHON",
 			sizeof("!~PASSENGER_PYTHON") - 1),
 		config->mPython);
+	addHeader(r, result, StaticString("!~PASSENGER_PYTHON_THREAD_COUNT",
+			sizeof("!~PASSENGER_PYTHON_THREAD_COUNT") - 1),
+		config->mPythonThreadCount);
 	addHeader(result, StaticString("!~PASSENGER_RESTART_DIR",
 			sizeof("!~PASSENGER_RESTART_DIR") - 1),
 		config->mRestartDir);
+	addHeader(result, StaticString("!~PASSENGER_ROUTING_METHOD",
+			sizeof("!~PASSENGER_ROUTING_METHOD") - 1),
+		config->mRoutingMethod);
 	addHeader(result, StaticString("!~PASSENGER_RUBY",
 			sizeof("!~PASSENGER_RUBY") - 1),
 		config->mRuby.empty() ? serverConfig.defaultRuby : config->mRuby);
+	addHeader(r, result, StaticString("!~PASSENGER_SPAWN_CONCURRENCY",
+			sizeof("!~PASSENGER_SPAWN_CONCURRENCY") - 1),
+		config->mSpawnConcurrency);
 	addHeader(result, StaticString("!~PASSENGER_SPAWN_METHOD",
 			sizeof("!~PASSENGER_SPAWN_METHOD") - 1),
 		config->mSpawnMethod);
+	addHeader(r, result, StaticString("!~PASSENGER_STANDBY_PROCESSES",
+			sizeof("!~PASSENGER_STANDBY_PROCESSES") - 1),
+		config->mStandbyProcesses);
 	addHeader(r, result, StaticString("!~PASSENGER_START_TIMEOUT",
 			sizeof("!~PASSENGER_START_TIMEOUT") - 1),
 		config->mStartTimeout);
@@ -279,6 +279,17 @@ ConfigManifestGenerator::autoGenerated_generateConfigManifestForDirConfig(server
 			pdconf->mLveMinUidSourceLine);
 		hierarchyMember["value"] = pdconf->mLveMinUid;
 	}
+	if (pdconf->mMaxMemoryExplicitlySet) {
+		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
+			pdconf, context, &appOptionsContainer, &locOptionsContainer);
+		Json::Value &optionContainer = findOrCreateOptionContainer(*appOptionsContainer,
+			"PassengerMaxMemory",
+			sizeof("PassengerMaxMemory") - 1);
+		Json::Value &hierarchyMember = addOptionContainerHierarchyMember(optionContainer,
+			pdconf->mMaxMemorySourceFile,
+			pdconf->mMaxMemorySourceLine);
+		hierarchyMember["value"] = pdconf->mMaxMemory;
+	}
 	if (pdconf->mMaxPreloaderIdleTimeExplicitlySet) {
 		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
 			pdconf, context, &appOptionsContainer, &locOptionsContainer);
@@ -374,6 +385,17 @@ ConfigManifestGenerator::autoGenerated_generateConfigManifestForDirConfig(server
 			pdconf->mPython.data(),
 			pdconf->mPython.data() + pdconf->mPython.size());
 	}
+	if (pdconf->mPythonThreadCountExplicitlySet) {
+		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
+			pdconf, context, &appOptionsContainer, &locOptionsContainer);
+		Json::Value &optionContainer = findOrCreateOptionContainer(*appOptionsContainer,
+			"PassengerPythonThreadCount",
+			sizeof("PassengerPythonThreadCount") - 1);
+		Json::Value &hierarchyMember = addOptionContainerHierarchyMember(optionContainer,
+			pdconf->mPythonThreadCountSourceFile,
+			pdconf->mPythonThreadCountSourceLine);
+		hierarchyMember["value"] = pdconf->mPythonThreadCount;
+	}
 	if (pdconf->mRestartDirExplicitlySet) {
 		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
 			pdconf, context, &appOptionsContainer, &locOptionsContainer);
@@ -387,6 +409,19 @@ ConfigManifestGenerator::autoGenerated_generateConfigManifestForDirConfig(server
 			pdconf->mRestartDir.data(),
 			pdconf->mRestartDir.data() + pdconf->mRestartDir.size());
 	}
+	if (pdconf->mRoutingMethodExplicitlySet) {
+		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
+			pdconf, context, &appOptionsContainer, &locOptionsContainer);
+		Json::Value &optionContainer = findOrCreateOptionContainer(*appOptionsContainer,
+			"PassengerRoutingMethod",
+			sizeof("PassengerRoutingMethod") - 1);
+		Json::Value &hierarchyMember = addOptionContainerHierarchyMember(optionContainer,
+			pdconf->mRoutingMethodSourceFile,
+			pdconf->mRoutingMethodSourceLine);
+		hierarchyMember["value"] = Json::Value(
+			pdconf->mRoutingMethod.data(),
+			pdconf->mRoutingMethod.data() + pdconf->mRoutingMethod.size());
+	}
 	if (pdconf->mRubyExplicitlySet) {
 		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
 			pdconf, context, &appOptionsContainer, &locOptionsContainer);
@@ -400,6 +435,17 @@ ConfigManifestGenerator::autoGenerated_generateConfigManifestForDirConfig(server
 			pdconf->mRuby.data(),
 			pdconf->mRuby.data() + pdconf->mRuby.size());
 	}
+	if (pdconf->mSpawnConcurrencyExplicitlySet) {
+		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
+			pdconf, context, &appOptionsContainer, &locOptionsContainer);
+		Json::Value &optionContainer = findOrCreateOptionContainer(*appOptionsContainer,
+			"PassengerSpawnConcurrency",
+			sizeof("PassengerSpawnConcurrency") - 1);
+		Json::Value &hierarchyMember = addOptionContainerHierarchyMember(optionContainer,
+			pdconf->mSpawnConcurrencySourceFile,
+			pdconf->mSpawnConcurrencySourceLine);
+		hierarchyMember["value"] = pdconf->mSpawnConcurrency;
+	}
 	if (pdconf->mSpawnMethodExplicitlySet) {
 		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
 			pdconf, context, &appOptionsContainer, &locOptionsContainer);
@@ -413,6 +459,17 @@ ConfigManifestGenerator::autoGenerated_generateConfigManifestForDirConfig(server
 			pdconf->mSpawnMethod.data(),
 			pdconf->mSpawnMethod.data() + pdconf->mSpawnMethod.size());
 	}
+	if (pdconf->mStandbyProcessesExplicitlySet) {
+		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
+			pdconf, context, &appOptionsContainer, &locOptionsContainer);
+		Json::Value &optionContainer = findOrCreateOptionContainer(*appOptionsContainer,
+			"PassengerStandbyProcesses",
+			sizeof("PassengerStandbyProcesses") - 1);
+		Json::Value &hierarchyMember = addOptionContainerHierarchyMember(optionContainer,
+			pdconf->mStandbyProcessesSourceFile,
+			pdconf->mStandbyProcessesSourceLine);
+		hierarchyMember["value"] = pdconf->mStandbyProcesses;
+	}
 	if (pdconf->mStartTimeoutExplicitlySet) {
 		findOrCreateAppAndLocOptionsContainers(serverRec, csconf, cdconf,
 			pdconf, context, &appOptionsContainer, &locOptionsContainer);
@@ -124,6 +124,10 @@ mergeDirConfig_autoGenerated(DirConfig *config, DirConfig *base, DirConfig *add)
 		(add->mLveMinUid != UNSET_INT_VALUE)
 		? add->mLveMinUid
 		: base->mLveMinUid;
+	config->mMaxMemory =
+		(add->mMaxMemory != UNSET_INT_VALUE)
+		? add->mMaxMemory
+		: base->mMaxMemory;
 	config->mMaxPreloaderIdleTime =
 		(add->mMaxPreloaderIdleTime != UNSET_INT_VALUE)
 		? add->mMaxPreloaderIdleTime
@@ -156,18 +160,34 @@ mergeDirConfig_autoGenerated(DirConfig *config, DirConfig *base, DirConfig *add)
 		(!add->mPython.empty())
 		? add->mPython
 		: base->mPython;
+	config->mPythonThreadCount =
+		(add->mPythonThreadCount != UNSET_INT_VALUE)
+		? add->mPythonThreadCount
+		: base->mPythonThreadCount;
 	config->mRestartDir =
 		(!add->mRestartDir.empty())
 		? add->mRestartDir
 		: base->mRestartDir;
+	config->mRoutingMethod =
+		(!add->mRoutingMethod.empty())
+		? add->mRoutingMethod
+		: base->mRoutingMethod;
 	config->mRuby =
 		(!add->mRuby.empty())
 		? add->mRuby
 		: base->mRuby;
+	config->mSpawnConcurrency =
+		(add->mSpawnConcurrency != UNSET_INT_VALUE)
+		? add->mSpawnConcurrency
+		: base->mSpawnConcurrency;
 	config->mSpawnMethod =
 		(!add->mSpawnMethod.empty())
 		? add->mSpawnMethod
 		: base->mSpawnMethod;
+	config->mStandbyProcesses =
+		(add->mStandbyProcesses != UNSET_INT_VALUE)
+		? add->mStandbyProcesses
+		: base->mStandbyProcesses;
 	config->mStartTimeout =
 		(add->mStartTimeout != UNSET_INT_VALUE)
 		? add->mStartTimeout
@@ -212,6 +232,7 @@ mergeDirConfig_autoGenerated(DirConfig *config, DirConfig *base, DirConfig *add)
 	config->mHighPerformanceSourceFile = add->mHighPerformanceSourceFile;
 	config->mLoadShellEnvvarsSourceFile = add->mLoadShellEnvvarsSourceFile;
 	config->mLveMinUidSourceFile = add->mLveMinUidSourceFile;
+	config->mMaxMemorySourceFile = add->mMaxMemorySourceFile;
 	config->mMaxPreloaderIdleTimeSourceFile = add->mMaxPreloaderIdleTimeSourceFile;
 	config->mMaxRequestQueueSizeSourceFile = add->mMaxRequestQueueSizeSourceFile;
 	config->mMaxRequestsSourceFile = add->mMaxRequestsSourceFile;
@@ -220,9 +241,13 @@ mergeDirConfig_autoGenerated(DirConfig *config, DirConfig *base, DirConfig *add)
 	config->mMonitorLogFileSourceFile = add->mMonitorLogFileSourceFile;
 	config->mNodejsSourceFile = add->mNodejsSourceFile;
 	config->mPythonSourceFile = add->mPythonSourceFile;
+	config->mPythonThreadCountSourceFile = add->mPythonThreadCountSourceFile;
 	config->mRestartDirSourceFile = add->mRestartDirSourceFile;
+	config->mRoutingMethodSourceFile = add->mRoutingMethodSourceFile;
 	config->mRubySourceFile = add->mRubySourceFile;
+	config->mSpawnConcurrencySourceFile = add->mSpawnConcurrencySourceFile;
 	config->mSpawnMethodSourceFile = add->mSpawnMethodSourceFile;
+	config->mStandbyProcessesSourceFile = add->mStandbyProcessesSourceFile;
 	config->mStartTimeoutSourceFile = add->mStartTimeoutSourceFile;
 	config->mStartupFileSourceFile = add->mStartupFileSourceFile;
 	config->mStickySessionsSourceFile = add->mStickySessionsSourceFile;
@@ -249,6 +274,7 @@ mergeDirConfig_autoGenerated(DirConfig *config, DirConfig *base, DirConfig *add)
 	config->mHighPerformanceSourceLine = add->mHighPerformanceSourceLine;
 	config->mLoadShellEnvvarsSourceLine = add->mLoadShellEnvvarsSourceLine;
 	config->mLveMinUidSourceLine = add->mLveMinUidSourceLine;
+	config->mMaxMemorySourceLine = add->mMaxMemorySourceLine;
 	config->mMaxPreloaderIdleTimeSourceLine = add->mMaxPreloaderIdleTimeSourceLine;
 	config->mMaxRequestQueueSizeSourceLine = add->mMaxRequestQueueSizeSourceLine;
 	config->mMaxRequestsSourceLine = add->mMaxRequestsSourceLine;
@@ -257,9 +283,13 @@ mergeDirConfig_autoGenerated(DirConfig *config, DirConfig *base, DirConfig *add)
 	config->mMonitorLogFileSourceLine = add->mMonitorLogFileSourceLine;
 	config->mNodejsSourceLine = add->mNodejsSourceLine;
 	config->mPythonSourceLine = add->mPythonSourceLine;
+	config->mPythonThreadCountSourceLine = add->mPythonThreadCountSourceLine;
 	config->mRestartDirSourceLine = add->mRestartDirSourceLine;
+	config->mRoutingMethodSourceLine = add->mRoutingMethodSourceLine;
 	config->mRubySourceLine = add->mRubySourceLine;
+	config->mSpawnConcurrencySourceLine = add->mSpawnConcurrencySourceLine;
 	config->mSpawnMethodSourceLine = add->mSpawnMethodSourceLine;
+	config->mStandbyProcessesSourceLine = add->mStandbyProcessesSourceLine;
 	config->mStartTimeoutSourceLine = add->mStartTimeoutSourceLine;
 	config->mStartupFileSourceLine = add->mStartupFileSourceLine;
 	config->mStickySessionsSourceLine = add->mStickySessionsSourceLine;
@@ -286,6 +316,7 @@ mergeDirConfig_autoGenerated(DirConfig *config, DirConfig *base, DirConfig *add)
 	config->mHighPerformanceExplicitlySet = add->mHighPerformanceExplicitlySet;
 	config->mLoadShellEnvvarsExplicitlySet = add->mLoadShellEnvvarsExplicitlySet;
 	config->mLveMinUidExplicitlySet = add->mLveMinUidExplicitlySet;
+	config->mMaxMemoryExplicitlySet = add->mMaxMemoryExplicitlySet;
 	config->mMaxPreloaderIdleTimeExplicitlySet = add->mMaxPreloaderIdleTimeExplicitlySet;
 	config->mMaxRequestQueueSizeExplicitlySet = add->mMaxRequestQueueSizeExplicitlySet;
 	config->mMaxRequestsExplicitlySet = add->mMaxRequestsExplicitlySet;
@@ -294,9 +325,13 @@ mergeDirConfig_autoGenerated(DirConfig *config, DirConfig *base, DirConfig *add)
 	config->mMonitorLogFileExplicitlySet = add->mMonitorLogFileExplicitlySet;
 	config->mNodejsExplicitlySet = add->mNodejsExplicitlySet;
 	config->mPythonExplicitlySet = add->mPythonExplicitlySet;
+	config->mPythonThreadCountExplicitlySet = add->mPythonThreadCountExplicitlySet;
 	config->mRestartDirExplicitlySet = add->mRestartDirExplicitlySet;
+	config->mRoutingMethodExplicitlySet = add->mRoutingMethodExplicitlySet;
 	config->mRubyExplicitlySet = add->mRubyExplicitlySet;
+	config->mSpawnConcurrencyExplicitlySet = add->mSpawnConcurrencyExplicitlySet;
 	config->mSpawnMethodExplicitlySet = add->mSpawnMethodExplicitlySet;
+	config->mStandbyProcessesExplicitlySet = add->mStandbyProcessesExplicitlySet;
 	config->mStartTimeoutExplicitlySet = add->mStartTimeoutExplicitlySet;
 	config->mStartupFileExplicitlySet = add->mStartupFileExplicitlySet;
 	config->mStickySessionsExplicitlySet = add->mStickySessionsExplicitlySet;
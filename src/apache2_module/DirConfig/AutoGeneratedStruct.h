@@ -111,6 +111,11 @@ struct AutoGeneratedDirConfig {
 	 */
 	int mLveMinUid;
 
+	/*
+	 * The amount of memory in MB above which an application process is gracefully replaced.
+	 */
+	int mMaxMemory;
+
 	/*
 	 * The maximum number of seconds that a preloader process may be idle before it is shutdown.
 	 */
@@ -131,6 +136,21 @@ struct AutoGeneratedDirConfig {
 	 */
 	int mMinInstances;
 
+	/*
+	 * The number of threads with which each Python process handles requests.
+	 */
+	int mPythonThreadCount;
+
+	/*
+	 * The maximum number of processes per application that may be spawned concurrently.
+	 */
+	int mSpawnConcurrency;
+
+	/*
+	 * The number of spare application processes to keep spawned on standby.
+	 */
+	int mStandbyProcesses;
+
 	/*
 	 * A timeout for application startup.
 	 */
@@ -196,6 +216,11 @@ struct AutoGeneratedDirConfig {
 	 */
 	StaticString mRestartDir;
 
+	/*
+	 * How to distribute requests over application processes: 'least_busy' or 'latency'.
+	 */
+	StaticString mRoutingMethod;
+
 	/*
 	 * The Ruby interpreter to use.
 	 */
@@ -248,10 +273,14 @@ struct AutoGeneratedDirConfig {
 	StaticString mStickySessionsSourceFile;
 	StaticString mForceMaxConcurrentRequestsPerProcessSourceFile;
 	StaticString mLveMinUidSourceFile;
+	StaticString mMaxMemorySourceFile;
 	StaticString mMaxPreloaderIdleTimeSourceFile;
 	StaticString mMaxRequestQueueSizeSourceFile;
 	StaticString mMaxRequestsSourceFile;
 	StaticString mMinInstancesSourceFile;
+	StaticString mPythonThreadCountSourceFile;
+	StaticString mSpawnConcurrencySourceFile;
+	StaticString mStandbyProcessesSourceFile;
 	StaticString mStartTimeoutSourceFile;
 	StaticString mAppEnvSourceFile;
 	StaticString mAppGroupNameSourceFile;
@@ -265,6 +294,7 @@ struct AutoGeneratedDirConfig {
 	StaticString mNodejsSourceFile;
 	StaticString mPythonSourceFile;
 	StaticString mRestartDirSourceFile;
+	StaticString mRoutingMethodSourceFile;
 	StaticString mRubySourceFile;
 	StaticString mSpawnMethodSourceFile;
 	StaticString mStartupFileSourceFile;
@@ -285,10 +315,14 @@ struct AutoGeneratedDirConfig {
 	unsigned int mStickySessionsSourceLine;
 	unsigned int mForceMaxConcurrentRequestsPerProcessSourceLine;
 	unsigned int mLveMinUidSourceLine;
+	unsigned int mMaxMemorySourceLine;
 	unsigned int mMaxPreloaderIdleTimeSourceLine;
 	unsigned int mMaxRequestQueueSizeSourceLine;
 	unsigned int mMaxRequestsSourceLine;
 	unsigned int mMinInstancesSourceLine;
+	unsigned int mPythonThreadCountSourceLine;
+	unsigned int mSpawnConcurrencySourceLine;
+	unsigned int mStandbyProcessesSourceLine;
 	unsigned int mStartTimeoutSourceLine;
 	unsigned int mAppEnvSourceLine;
 	unsigned int mAppGroupNameSourceLine;
@@ -302,6 +336,7 @@ struct AutoGeneratedDirConfig {
 	unsigned int mNodejsSourceLine;
 	unsigned int mPythonSourceLine;
 	unsigned int mRestartDirSourceLine;
+	unsigned int mRoutingMethodSourceLine;
 	unsigned int mRubySourceLine;
 	unsigned int mSpawnMethodSourceLine;
 	unsigned int mStartupFileSourceLine;
@@ -322,10 +357,14 @@ struct AutoGeneratedDirConfig {
 	bool mStickySessionsExplicitlySet: 1;
 	bool mForceMaxConcurrentRequestsPerProcessExplicitlySet: 1;
 	bool mLveMinUidExplicitlySet: 1;
+	bool mMaxMemoryExplicitlySet: 1;
 	bool mMaxPreloaderIdleTimeExplicitlySet: 1;
 	bool mMaxRequestQueueSizeExplicitlySet: 1;
 	bool mMaxRequestsExplicitlySet: 1;
 	bool mMinInstancesExplicitlySet: 1;
+	bool mPythonThreadCountExplicitlySet: 1;
+	bool mSpawnConcurrencyExplicitlySet: 1;
+	bool mStandbyProcessesExplicitlySet: 1;
 	bool mStartTimeoutExplicitlySet: 1;
 	bool mAppEnvExplicitlySet: 1;
 	bool mAppGroupNameExplicitlySet: 1;
@@ -339,6 +378,7 @@ struct AutoGeneratedDirConfig {
 	bool mNodejsExplicitlySet: 1;
 	bool mPythonExplicitlySet: 1;
 	bool mRestartDirExplicitlySet: 1;
+	bool mRoutingMethodExplicitlySet: 1;
 	bool mRubyExplicitlySet: 1;
 	bool mSpawnMethodExplicitlySet: 1;
 	bool mStartupFileExplicitlySet: 1;
@@ -444,6 +484,15 @@ struct AutoGeneratedDirConfig {
 		}
 	}
 
+	int
+	getMaxMemory() const {
+		if (mMaxMemory == UNSET_INT_VALUE) {
+			return 0;
+		} else {
+			return mMaxMemory;
+		}
+	}
+
 	int
 	getMaxPreloaderIdleTime() const {
 		if (mMaxPreloaderIdleTime == UNSET_INT_VALUE) {
@@ -480,6 +529,33 @@ struct AutoGeneratedDirConfig {
 		}
 	}
 
+	int
+	getPythonThreadCount() const {
+		if (mPythonThreadCount == UNSET_INT_VALUE) {
+			return 1;
+		} else {
+			return mPythonThreadCount;
+		}
+	}
+
+	int
+	getSpawnConcurrency() const {
+		if (mSpawnConcurrency == UNSET_INT_VALUE) {
+			return 1;
+		} else {
+			return mSpawnConcurrency;
+		}
+	}
+
+	int
+	getStandbyProcesses() const {
+		if (mStandbyProcesses == UNSET_INT_VALUE) {
+			return 0;
+		} else {
+			return mStandbyProcesses;
+		}
+	}
+
 	int
 	getStartTimeout() const {
 		if (mStartTimeout == UNSET_INT_VALUE) {
@@ -569,6 +645,15 @@ struct AutoGeneratedDirConfig {
 		}
 	}
 
+	StaticString
+	getRoutingMethod() const {
+		if (mRoutingMethod.empty()) {
+			return P_STATIC_STRING("least_busy");
+		} else {
+			return mRoutingMethod;
+		}
+	}
+
 	StaticString
 	getRuby() const {
 		if (mRuby.empty()) {
@@ -48,6 +48,8 @@
 #include <sys/stat.h>
 #include <exception>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -55,6 +57,7 @@
 #include <oxt/macros.hpp>
 #include <oxt/backtrace.hpp>
 #include <oxt/detail/context.hpp>
+#include <oxt/system_calls.hpp>
 #include "Bucket.h"
 #include "Config.h"
 #include "DirectoryMapper.h"
@@ -239,6 +242,12 @@ private:
 	boost::mutex cstatMutex;
 	boost::mutex configMutex;
 
+	/** Idle connections to the Passenger core that can be reused, most
+	 * recently used last. Only used when PassengerCoreKeepalive is set.
+	 */
+	vector<FileDescriptor> idleCoreConnections;
+	boost::mutex idleCoreConnectionsMutex;
+
 	static Json::Value strsetToJson(const set<string> &input) {
 		Json::Value result(Json::arrayValue);
 		set<string>::const_iterator it, end = input.end();
@@ -351,6 +360,149 @@ private:
 		return conn;
 	}
 
+	bool coreKeepaliveEnabled() const {
+		return serverConfig.coreKeepalive > 0;
+	}
+
+	static bool coreConnectionIsAlive(const FileDescriptor &conn) {
+		char buf;
+		ssize_t ret = recv(conn, &buf, 1, MSG_PEEK | MSG_DONTWAIT);
+		// The Passenger core never sends anything on an idle connection,
+		// so anything but EAGAIN means that it was closed.
+		return ret == -1 && (errno == EAGAIN || errno == EWOULDBLOCK);
+	}
+
+	/**
+	 * Returns an idle connection to the Passenger core if there is one,
+	 * or a new connection otherwise.
+	 */
+	FileDescriptor checkoutCoreConnection(bool &reused) {
+		TRACE_POINT();
+		if (coreKeepaliveEnabled()) {
+			boost::lock_guard<boost::mutex> l(idleCoreConnectionsMutex);
+			while (!idleCoreConnections.empty()) {
+				FileDescriptor conn = idleCoreConnections.back();
+				idleCoreConnections.pop_back();
+				if (coreConnectionIsAlive(conn)) {
+					reused = true;
+					return conn;
+				}
+			}
+		}
+		reused = false;
+		return connectToCore();
+	}
+
+	void checkinCoreConnection(const FileDescriptor &conn) {
+		boost::lock_guard<boost::mutex> l(idleCoreConnectionsMutex);
+		if (idleCoreConnections.size() < (unsigned int) serverConfig.coreKeepalive) {
+			idleCoreConnections.push_back(conn);
+		}
+	}
+
+	/**
+	 * Reads the response header sent by the Passenger core into `header`.
+	 * Body data that was read along with it is stored in `state`, which
+	 * will return it first. `header` is empty if the connection was closed
+	 * before anything was received. If reading fails, then `header` contains
+	 * the data that was received before the error.
+	 */
+	void readResponseHeader(PassengerBucketState &state, string &header) {
+		TRACE_POINT();
+		const string::size_type MAX_HEADER_SIZE = 128 * 1024;
+		char buf[1024 * 16];
+		string data;
+		string::size_type end;
+		ssize_t ret;
+
+		while (true) {
+			ret = oxt::syscalls::read(state.connection, buf, sizeof(buf));
+			if (ret == -1) {
+				int e = errno;
+				header = data;
+				throw SystemException("Cannot read the response from the "
+					"Passenger core", e);
+			} else if (ret == 0) {
+				// Let the header scanner deal with the incomplete header.
+				header = data;
+				return;
+			}
+
+			end = data.size() < 3 ? 0 : data.size() - 3;
+			data.append(buf, ret);
+			end = data.find("\r\n\r\n", end);
+			if (end != string::npos) {
+				header.assign(data, 0, end + 4);
+				state.pendingData.assign(data, end + 4, string::npos);
+				return;
+			} else if (data.size() > MAX_HEADER_SIZE) {
+				throw IOException("The Passenger core sent a response header "
+					"that is too large");
+			}
+		}
+	}
+
+	/**
+	 * Whether the request may be sent to the Passenger core a second time
+	 * without side effects, according to RFC 7231 section 4.2.2. Apache
+	 * reports HEAD requests as M_GET.
+	 */
+	static bool requestIsIdempotent(request_rec *r) {
+		switch (r->method_number) {
+		case M_GET:
+		case M_OPTIONS:
+		case M_TRACE:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/**
+	 * Forwards the request to the Passenger core over a kept-alive connection
+	 * and reads the response header. If a reused connection turns out to be
+	 * closed by the Passenger core before anything of the response was
+	 * received, and the request can safely be resent (it is idempotent and
+	 * has no body), then it is resent over a new connection.
+	 */
+	PassengerBucketStatePtr forwardRequestOverKeptAliveConnection(request_rec *r,
+		const string &headers, bool expectingBody, bool bodyIsChunked,
+		string &responseHeader)
+	{
+		TRACE_POINT();
+		bool reused;
+		FileDescriptor conn = checkoutCoreConnection(reused);
+		PassengerBucketStatePtr state;
+		bool resendable = !expectingBody && requestIsIdempotent(r);
+
+		while (true) {
+			responseHeader.clear();
+			try {
+				writeExact(conn, headers);
+				if (expectingBody) {
+					sendRequestBody(conn, r, bodyIsChunked);
+				}
+				state = boost::make_shared<PassengerBucketState>(conn);
+				readResponseHeader(*state, responseHeader);
+				if (!responseHeader.empty() || !reused || !resendable) {
+					return state;
+				}
+			} catch (const SystemException &e) {
+				if (!reused || !resendable || !responseHeader.empty()
+				 || (e.code() != EPIPE && e.code() != ECONNRESET))
+				{
+					throw;
+				}
+			}
+
+			UPDATE_TRACE_POINT();
+			P_DEBUG("Reused connection to the Passenger core was closed; "
+				"resending the request over a new connection");
+			conn = connectToCore();
+			reused = false;
+		}
+	}
+
 	bool hasModRewrite() {
 		if (m_hasModRewrite == UNKNOWN) {
 			if (ap_find_linked_module("mod_rewrite.c")) {
@@ -642,12 +794,22 @@ private:
 			bool bodyIsChunked = false;
 
 			string headers = constructRequestHeaders(r, mapper, bodyIsChunked);
-			FileDescriptor conn = connectToCore();
-			writeExact(conn, headers);
-			headers.clear();
-			if (expectingBody) {
-				sendRequestBody(conn, r, bodyIsChunked);
+			string responseHeader;
+			PassengerBucketStatePtr bucketState;
+
+			if (coreKeepaliveEnabled()) {
+				bucketState = forwardRequestOverKeptAliveConnection(r, headers,
+					expectingBody, bodyIsChunked, responseHeader);
+				determineResponseFraming(responseHeader, r->header_only, *bucketState);
+			} else {
+				FileDescriptor conn = connectToCore();
+				writeExact(conn, headers);
+				if (expectingBody) {
+					sendRequestBody(conn, r, bodyIsChunked);
+				}
+				bucketState = boost::make_shared<PassengerBucketState>(conn);
 			}
+			headers.clear();
 
 
 			/********** Step 4: forwarding the response from the Passenger core
@@ -656,12 +818,17 @@ private:
 			UPDATE_TRACE_POINT();
 			apr_bucket_brigade *bb;
 			apr_bucket *b;
-			PassengerBucketStatePtr bucketState;
 
 			/* Setup the bucket brigade. */
 			bb = apr_brigade_create(r->connection->pool, r->connection->bucket_alloc);
 
-			bucketState = boost::make_shared<PassengerBucketState>(conn);
+			if (!responseHeader.empty()) {
+				/* Already read by forwardRequestOverKeptAliveConnection(). */
+				b = apr_bucket_heap_create(responseHeader.data(), responseHeader.size(),
+					NULL, r->connection->bucket_alloc);
+				APR_BRIGADE_INSERT_TAIL(bb, b);
+			}
+
 			b = passenger_bucket_create(bucketState, r->connection->bucket_alloc,
 				config->getBufferResponse());
 			APR_BRIGADE_INSERT_TAIL(bb, b);
@@ -692,6 +859,12 @@ private:
 			apr_table_unset(r->err_headers_out, "Connection");
 			// It's undefined in which of the tables it ends up in, so unset on both.
 			apr_table_unset(r->headers_out, "Connection");
+			if (bucketState->bodyType == PassengerBucketState::BODY_CHUNKED) {
+				// The PassengerBucket decodes the chunked body, and Apache
+				// applies its own transfer encoding to the response.
+				apr_table_unset(r->err_headers_out, "Transfer-Encoding");
+				apr_table_unset(r->headers_out, "Transfer-Encoding");
+			}
 
 			if (ret == OK) {
 				// The API documentation for ap_scan_script_err_brigade() says it
@@ -731,6 +904,9 @@ private:
 					return originalStatus;
 				} else if (ap_pass_brigade(r->output_filters, bb) == APR_SUCCESS) {
 					apr_brigade_cleanup(bb);
+					if (bucketState->keepAlive) {
+						checkinCoreConnection(bucketState->connection);
+					}
 				}
 				return OK;
 			} else {
@@ -936,7 +1112,7 @@ private:
 
 		if (connectionHeader != NULL && connectionUpgradeFlagSet(connectionHeader->val)) {
 			result.append("Connection: upgrade\r\n", sizeof("Connection: upgrade\r\n") - 1);
-		} else {
+		} else if (!coreKeepaliveEnabled()) {
 			result.append("Connection: close\r\n", sizeof("Connection: close\r\n") - 1);
 		}
 
@@ -1053,11 +1229,16 @@ private:
 
 		// Add flags.
 		// C = Strip 100 Continue header
-		// D = Dechunk
+		// D = Dechunk (not needed when keeping the connection alive, because
+		//     the PassengerBucket decodes chunked responses)
 		// B = Buffer request body
 		// S = SSL
 
-		result.append("!~FLAGS: CD", sizeof("!~FLAGS: CD") - 1);
+		if (coreKeepaliveEnabled()) {
+			result.append("!~FLAGS: C", sizeof("!~FLAGS: C") - 1);
+		} else {
+			result.append("!~FLAGS: CD", sizeof("!~FLAGS: CD") - 1);
+		}
 		if (config->getBufferUpload()) {
 			result.append("B", 1);
 		}
@@ -0,0 +1,399 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_APACHE2_MODULE_RESPONSE_BODY_H_
+#define _PASSENGER_APACHE2_MODULE_RESPONSE_BODY_H_
+
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <string>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <unistd.h>
+#include <FileDescriptor.h>
+#include <StaticString.h>
+#include <StrIntTools/StrIntUtils.h>
+
+namespace Passenger {
+namespace Apache2Module {
+
+using namespace std;
+
+
+/**
+ * Keeps track of where the body of a response from the Passenger core ends,
+ * so that the connection can be reused for another request afterwards.
+ *
+ * This does not depend on APR, so that it can be unit tested.
+ */
+struct ResponseBodyState {
+	/** How the end of the response body is determined. */
+	enum BodyType {
+		/** The body ends when the Passenger core closes the connection. */
+		BODY_UNTIL_EOF,
+		/** The body size is given by `remaining`. */
+		BODY_CONTENT_LENGTH,
+		/** The body is in chunked transfer encoding, which is decoded. */
+		BODY_CHUNKED
+	};
+
+	enum ChunkState {
+		CHUNK_SIZE,
+		CHUNK_EXTENSION,
+		CHUNK_DATA,
+		CHUNK_DATA_CR,
+		CHUNK_DATA_LF,
+		CHUNK_TRAILER,
+		CHUNK_DONE
+	};
+
+	/** Connection to the Passenger core. */
+	FileDescriptor connection;
+
+	BodyType bodyType;
+
+	/** For BODY_CONTENT_LENGTH: the number of body bytes left to read.
+	 * For BODY_CHUNKED: the number of bytes left in the current chunk,
+	 * or the chunk size being parsed.
+	 */
+	boost::uint64_t remaining;
+
+	ChunkState chunkState;
+	unsigned int chunkSizeDigits;
+	bool trailerLineEmpty;
+
+	/** Whether the Passenger core allows the connection to be reused
+	 * after this response.
+	 */
+	bool connectionReusable;
+
+	/** Set when the entire response body has been read and the connection
+	 * can be reused for another request.
+	 */
+	bool keepAlive;
+
+	/** Response data that was read along with the response header.
+	 * It is returned before anything else is read from `connection`.
+	 */
+	string pendingData;
+	string::size_type pendingOffset;
+
+	ResponseBodyState(const FileDescriptor &conn) {
+		connection = conn;
+		bodyType   = BODY_UNTIL_EOF;
+		remaining  = 0;
+		chunkState = CHUNK_SIZE;
+		chunkSizeDigits  = 0;
+		trailerLineEmpty = true;
+		connectionReusable = false;
+		keepAlive     = false;
+		pendingOffset = 0;
+	}
+};
+
+
+inline bool
+containsIgnoringCase(const StaticString &str, const char *substr) {
+	size_t len = strlen(substr);
+	for (string::size_type i = 0; i + len <= str.size(); i++) {
+		if (strncasecmp(str.data() + i, substr, len) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Determines from the response header where the response body ends, and
+ * whether the connection to the Passenger core can be reused afterwards.
+ * `headerOnly` is whether the request was a HEAD request.
+ */
+inline void
+determineResponseFraming(const StaticString &header, bool headerOnly,
+	ResponseBodyState &state)
+{
+	const char *pos = header.data();
+	const char *end = header.data() + header.size();
+	const char *lineEnd, *colon;
+	int status = 0;
+	bool chunked = false;
+	bool hasContentLength = false;
+	boost::uint64_t contentLength = 0;
+
+	state.connectionReusable = true;
+
+	while (pos < end) {
+		lineEnd = (const char *) memchr(pos, '\n', end - pos);
+		if (lineEnd == NULL) {
+			lineEnd = end;
+		}
+
+		if (pos == header.data()) {
+			// Status line, e.g. "HTTP/1.1 200 OK".
+			const char *space = (const char *) memchr(pos, ' ', lineEnd - pos);
+			if (space != NULL) {
+				status = atoi(string(space + 1, lineEnd).c_str());
+			}
+		} else if ((colon = (const char *) memchr(pos, ':', lineEnd - pos)) != NULL) {
+			StaticString name(pos, colon - pos);
+			string value = strip(StaticString(colon + 1, lineEnd - colon - 1));
+			if (name.size() == sizeof("content-length") - 1
+			 && strncasecmp(name.data(), "content-length", name.size()) == 0)
+			{
+				hasContentLength = true;
+				contentLength = stringToULL(value);
+			} else if (name.size() == sizeof("transfer-encoding") - 1
+			 && strncasecmp(name.data(), "transfer-encoding", name.size()) == 0)
+			{
+				chunked = chunked || containsIgnoringCase(value, "chunked");
+			} else if (name.size() == sizeof("connection") - 1
+			 && strncasecmp(name.data(), "connection", name.size()) == 0)
+			{
+				if (containsIgnoringCase(value, "close")
+				 || containsIgnoringCase(value, "upgrade"))
+				{
+					state.connectionReusable = false;
+				}
+			}
+		}
+
+		pos = lineEnd + 1;
+	}
+
+	if (status == 101) {
+		state.bodyType = ResponseBodyState::BODY_UNTIL_EOF;
+		state.connectionReusable = false;
+	} else if (headerOnly || status == 204 || status == 304) {
+		state.bodyType = ResponseBodyState::BODY_CONTENT_LENGTH;
+		state.remaining = 0;
+	} else if (chunked) {
+		state.bodyType = ResponseBodyState::BODY_CHUNKED;
+	} else if (hasContentLength) {
+		state.bodyType = ResponseBodyState::BODY_CONTENT_LENGTH;
+		state.remaining = contentLength;
+	} else {
+		state.bodyType = ResponseBodyState::BODY_UNTIL_EOF;
+		state.connectionReusable = false;
+	}
+}
+
+/**
+ * Reads raw response data: first the data that was read along with the
+ * response header, then data from the connection.
+ */
+inline ssize_t
+readRawResponseData(ResponseBodyState &state, char *buf, size_t size) {
+	ssize_t ret;
+
+	if (state.pendingOffset < state.pendingData.size()) {
+		size_t n = std::min<size_t>(size,
+			state.pendingData.size() - state.pendingOffset);
+		memcpy(buf, state.pendingData.data() + state.pendingOffset, n);
+		state.pendingOffset += n;
+		if (state.pendingOffset == state.pendingData.size()) {
+			state.pendingData.clear();
+			state.pendingOffset = 0;
+		}
+		return n;
+	}
+
+	do {
+		ret = read(state.connection, buf, size);
+	} while (ret == -1 && errno == EINTR);
+	return ret;
+}
+
+inline int
+parseChunkSizeHexDigit(char ch) {
+	if (ch >= '0' && ch <= '9') {
+		return ch - '0';
+	} else if (ch >= 'a' && ch <= 'f') {
+		return 10 + ch - 'a';
+	} else if (ch >= 'A' && ch <= 'F') {
+		return 10 + ch - 'A';
+	} else {
+		return -1;
+	}
+}
+
+/**
+ * Decodes `size` bytes of chunked data in `buf`, in place. Returns the
+ * number of body bytes that are now at the start of `buf`, or -1 if the
+ * data is not valid chunked encoding. The chunked encoding may be split
+ * across calls at any point.
+ */
+inline ssize_t
+dechunkResponseBody(ResponseBodyState &state, char *buf, size_t size) {
+	const char *pos = buf;
+	const char *end = buf + size;
+	char *out = buf;
+	int digit;
+	size_t n;
+
+	while (pos < end && state.chunkState != ResponseBodyState::CHUNK_DONE) {
+		switch (state.chunkState) {
+		case ResponseBodyState::CHUNK_SIZE:
+			digit = parseChunkSizeHexDigit(*pos);
+			if (digit != -1) {
+				if (state.chunkSizeDigits == 15) {
+					// Chunk too large.
+					return -1;
+				}
+				state.remaining = state.remaining * 16 + digit;
+				state.chunkSizeDigits++;
+				pos++;
+				break;
+			} else if (state.chunkSizeDigits == 0) {
+				return -1;
+			}
+			state.chunkState = ResponseBodyState::CHUNK_EXTENSION;
+			// Fall through.
+		case ResponseBodyState::CHUNK_EXTENSION:
+			// Skip chunk extensions until the end of the line.
+			if (*pos == '\n') {
+				if (state.remaining == 0) {
+					state.chunkState = ResponseBodyState::CHUNK_TRAILER;
+					state.trailerLineEmpty = true;
+				} else {
+					state.chunkState = ResponseBodyState::CHUNK_DATA;
+				}
+			}
+			pos++;
+			break;
+		case ResponseBodyState::CHUNK_DATA:
+			n = (size_t) std::min<boost::uint64_t>(state.remaining, end - pos);
+			memmove(out, pos, n);
+			out += n;
+			pos += n;
+			state.remaining -= n;
+			if (state.remaining == 0) {
+				state.chunkState = ResponseBodyState::CHUNK_DATA_CR;
+			}
+			break;
+		case ResponseBodyState::CHUNK_DATA_CR:
+			if (*pos != '\r') {
+				return -1;
+			}
+			state.chunkState = ResponseBodyState::CHUNK_DATA_LF;
+			pos++;
+			break;
+		case ResponseBodyState::CHUNK_DATA_LF:
+			if (*pos != '\n') {
+				return -1;
+			}
+			state.chunkState = ResponseBodyState::CHUNK_SIZE;
+			state.chunkSizeDigits = 0;
+			pos++;
+			break;
+		case ResponseBodyState::CHUNK_TRAILER:
+			// Skip trailer header lines until an empty line.
+			if (*pos == '\n') {
+				if (state.trailerLineEmpty) {
+					state.chunkState = ResponseBodyState::CHUNK_DONE;
+				} else {
+					state.trailerLineEmpty = true;
+				}
+			} else if (*pos != '\r') {
+				state.trailerLineEmpty = false;
+			}
+			pos++;
+			break;
+		default:
+			return -1;
+		}
+	}
+
+	if (pos < end) {
+		// Data after the final chunk.
+		state.connectionReusable = false;
+	}
+	return out - buf;
+}
+
+inline void
+responseBodyDone(ResponseBodyState &state) {
+	// Data after the end of the body means that the connection is not
+	// in a reusable state.
+	state.keepAlive = state.connectionReusable
+		&& state.pendingOffset == state.pendingData.size();
+}
+
+/**
+ * Reads the next part of the response body into `buf`, decoding chunked
+ * encoding. Returns 0 at the end of the body and -1 on errors, with errno
+ * set. When the body is framed and the connection is closed before its
+ * end, that is an error (ECONNRESET). When it returns 0, `state.keepAlive`
+ * tells whether the connection can be reused.
+ */
+inline ssize_t
+readResponseBody(ResponseBodyState &state, char *buf, size_t size) {
+	ssize_t ret;
+
+	switch (state.bodyType) {
+	case ResponseBodyState::BODY_CONTENT_LENGTH:
+		if (state.remaining == 0) {
+			responseBodyDone(state);
+			return 0;
+		}
+		ret = readRawResponseData(state, buf, (size_t) std::min<boost::uint64_t>(size,
+			state.remaining));
+		if (ret > 0) {
+			state.remaining -= ret;
+		} else if (ret == 0) {
+			errno = ECONNRESET;
+			return -1;
+		}
+		return ret;
+	case ResponseBodyState::BODY_CHUNKED:
+		while (state.chunkState != ResponseBodyState::CHUNK_DONE) {
+			ret = readRawResponseData(state, buf, size);
+			if (ret == 0) {
+				errno = ECONNRESET;
+				return -1;
+			} else if (ret == -1) {
+				return -1;
+			}
+			ret = dechunkResponseBody(state, buf, ret);
+			if (ret == -1) {
+				errno = EBADMSG;
+				return -1;
+			} else if (ret > 0) {
+				return ret;
+			}
+		}
+		responseBodyDone(state);
+		return 0;
+	default:
+		return readRawResponseData(state, buf, size);
+	}
+}
+
+
+} // namespace Apache2Module
+} // namespace Passenger
+
+#endif /* _PASSENGER_APACHE2_MODULE_RESPONSE_BODY_H_ */
@@ -102,6 +102,15 @@ ConfigManifestGenerator::autoGenerated_generateConfigManifestForServerConfig() {
 			serverConfig.anonymousTelemetryProxy.data(),
 			serverConfig.anonymousTelemetryProxy.data() + serverConfig.anonymousTelemetryProxy.size());
 	}
+	if (serverConfig.coreKeepaliveExplicitlySet) {
+		Json::Value &optionContainer = findOrCreateOptionContainer(globalOptionsContainer,
+			"PassengerCoreKeepalive",
+			sizeof("PassengerCoreKeepalive") - 1);
+		Json::Value &hierarchyMember = addOptionContainerHierarchyMember(optionContainer,
+			serverConfig.coreKeepaliveSourceFile,
+			serverConfig.coreKeepaliveSourceLine);
+		hierarchyMember["value"] = serverConfig.coreKeepalive;
+	}
 	if (serverConfig.dataBufferDirExplicitlySet) {
 		Json::Value &optionContainer = findOrCreateOptionContainer(globalOptionsContainer,
 			"PassengerDataBufferDir",
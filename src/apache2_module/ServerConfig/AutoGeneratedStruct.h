@@ -87,6 +87,11 @@ struct AutoGeneratedServerConfig {
 	 */
 	bool userSwitching;
 
+	/*
+	 * The maximum number of idle connections to the Phusion Passenger(R) core that every Apache process keeps open for reuse.
+	 */
+	int coreKeepalive;
+
 	/*
 	 * The Phusion Passenger(R) log verbosity.
 	 */
@@ -214,6 +219,7 @@ struct AutoGeneratedServerConfig {
 	StaticString showVersionInHeaderSourceFile;
 	StaticString turbocachingSourceFile;
 	StaticString userSwitchingSourceFile;
+	StaticString coreKeepaliveSourceFile;
 	StaticString logLevelSourceFile;
 	StaticString maxInstancesPerAppSourceFile;
 	StaticString maxPoolSizeSourceFile;
@@ -245,6 +251,7 @@ struct AutoGeneratedServerConfig {
 	unsigned int showVersionInHeaderSourceLine;
 	unsigned int turbocachingSourceLine;
 	unsigned int userSwitchingSourceLine;
+	unsigned int coreKeepaliveSourceLine;
 	unsigned int logLevelSourceLine;
 	unsigned int maxInstancesPerAppSourceLine;
 	unsigned int maxPoolSizeSourceLine;
@@ -276,6 +283,7 @@ struct AutoGeneratedServerConfig {
 	bool showVersionInHeaderExplicitlySet: 1;
 	bool turbocachingExplicitlySet: 1;
 	bool userSwitchingExplicitlySet: 1;
+	bool coreKeepaliveExplicitlySet: 1;
 	bool logLevelExplicitlySet: 1;
 	bool maxInstancesPerAppExplicitlySet: 1;
 	bool maxPoolSizeExplicitlySet: 1;
@@ -309,6 +317,7 @@ struct AutoGeneratedServerConfig {
 		showVersionInHeader = true;
 		turbocaching = true;
 		userSwitching = true;
+		coreKeepalive = 0;
 		logLevel = DEFAULT_LOG_LEVEL;
 		maxInstancesPerApp = 0;
 		maxPoolSize = DEFAULT_MAX_POOL_SIZE;
@@ -370,6 +379,7 @@ struct AutoGeneratedServerConfig {
 		showVersionInHeaderSourceLine = 0;
 		turbocachingSourceLine = 0;
 		userSwitchingSourceLine = 0;
+		coreKeepaliveSourceLine = 0;
 		logLevelSourceLine = 0;
 		maxInstancesPerAppSourceLine = 0;
 		maxPoolSizeSourceLine = 0;
@@ -401,6 +411,7 @@ struct AutoGeneratedServerConfig {
 		showVersionInHeaderExplicitlySet = false;
 		turbocachingExplicitlySet = false;
 		userSwitchingExplicitlySet = false;
+		coreKeepaliveExplicitlySet = false;
 		logLevelExplicitlySet = false;
 		maxInstancesPerAppExplicitlySet = false;
 		maxPoolSizeExplicitlySet = false;
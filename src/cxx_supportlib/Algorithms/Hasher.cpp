@@ -42,6 +42,22 @@ JenkinsHash::update(const char *data, unsigned int size) {
 	}
 }
 
+void
+JenkinsHash::updateLowerCase(const char *data, char *output, unsigned int size) {
+	const char *end = data + size;
+
+	while (data < end) {
+		// Sets the 0x20 bit if and only if the character is in 'A'..'Z'.
+		char ch = *data | (char) (((unsigned char) (*data - 'A') < 26) << 5);
+		*output = ch;
+		hash += ch;
+		hash += (hash << 10);
+		hash ^= (hash >> 6);
+		data++;
+		output++;
+	}
+}
+
 boost::uint32_t
 JenkinsHash::finalize() {
 	hash += (hash << 3);
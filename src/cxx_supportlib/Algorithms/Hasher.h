@@ -44,6 +44,12 @@ struct JenkinsHash {
 		{ }
 
 	void update(const char *data, unsigned int size);
+	/**
+	 * Writes the ASCII-lowercased version of `data` to `output` and
+	 * updates the hash with it, in a single pass. Equivalent to
+	 * convertLowerCase() followed by update() on the output.
+	 */
+	void updateLowerCase(const char *data, char *output, unsigned int size);
 	boost::uint32_t finalize();
 
 	void reset() {
@@ -0,0 +1,182 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_ALGORITHMS_LATENCY_HISTOGRAM_H_
+#define _PASSENGER_ALGORITHMS_LATENCY_HISTOGRAM_H_
+
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * A fixed-size histogram of durations in microseconds, in the style of
+ * HdrHistogram: every power of two is split into 2^SUB_BUCKET_BITS linear
+ * sub-buckets, so that percentiles are reported with a relative error of
+ * at most 1 / 2^SUB_BUCKET_BITS (12.5%) regardless of magnitude. Values
+ * smaller than 2^SUB_BUCKET_BITS are counted exactly.
+ *
+ * Recording is a couple of shifts and an increment, and never allocates,
+ * so that it is cheap enough to do for every request. This class is not
+ * thread-safe.
+ */
+class LatencyHistogram {
+public:
+	static const unsigned int SUB_BUCKET_BITS = 3;
+	static const unsigned int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+	/** Values of 2^MAX_EXPONENT usec (about 19 hours) and up share the last bucket. */
+	static const unsigned int MAX_EXPONENT = 36;
+	static const unsigned int BUCKET_COUNT =
+		(MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+private:
+	boost::uint32_t buckets[BUCKET_COUNT];
+	boost::uint64_t count;
+	boost::uint64_t sum;
+	boost::uint64_t max;
+
+	static unsigned int log2(boost::uint64_t value) {
+		#if defined(__GNUC__) || defined(__clang__)
+			return 63 - __builtin_clzll(value);
+		#else
+			unsigned int result = 0;
+			while (value >>= 1) {
+				result++;
+			}
+			return result;
+		#endif
+	}
+
+public:
+	LatencyHistogram() {
+		reset();
+	}
+
+	static unsigned int bucketIndex(boost::uint64_t value) {
+		if (value < SUB_BUCKET_COUNT) {
+			return value;
+		}
+
+		unsigned int exponent = log2(value);
+		if (exponent >= MAX_EXPONENT) {
+			return BUCKET_COUNT - 1;
+		}
+		unsigned int shift = exponent - SUB_BUCKET_BITS;
+		return (shift + 1) * SUB_BUCKET_COUNT
+			+ ((value >> shift) & (SUB_BUCKET_COUNT - 1));
+	}
+
+	/** The largest value that is counted in the given bucket. */
+	static boost::uint64_t bucketUpperBound(unsigned int index) {
+		if (index < SUB_BUCKET_COUNT) {
+			return index;
+		}
+
+		unsigned int shift = index / SUB_BUCKET_COUNT - 1;
+		boost::uint64_t lowerBound = (boost::uint64_t)
+			(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+		return lowerBound + ((boost::uint64_t) 1 << shift) - 1;
+	}
+
+	void record(boost::uint64_t value) {
+		buckets[bucketIndex(value)]++;
+		count++;
+		sum += value;
+		max = std::max(max, value);
+	}
+
+	void merge(const LatencyHistogram &other) {
+		for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+			buckets[i] += other.buckets[i];
+		}
+		count += other.count;
+		sum += other.sum;
+		max = std::max(max, other.max);
+	}
+
+	void reset() {
+		memset(buckets, 0, sizeof(buckets));
+		count = 0;
+		sum = 0;
+		max = 0;
+	}
+
+	boost::uint64_t getCount() const {
+		return count;
+	}
+
+	boost::uint64_t getMax() const {
+		return max;
+	}
+
+	boost::uint64_t getSum() const {
+		return sum;
+	}
+
+	boost::uint64_t getMean() const {
+		if (count == 0) {
+			return 0;
+		} else {
+			return sum / count;
+		}
+	}
+
+	/**
+	 * Returns the value below which `percentile` percent (0..100) of the
+	 * recorded values fall, rounded up to the upper bound of its bucket.
+	 * Returns 0 if nothing has been recorded.
+	 */
+	boost::uint64_t getPercentile(double percentile) const {
+		if (count == 0) {
+			return 0;
+		}
+
+		boost::uint64_t rank = (boost::uint64_t) (percentile / 100 * count + 0.5);
+		boost::uint64_t seen = 0;
+
+		rank = std::max<boost::uint64_t>(rank, 1);
+		for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+			seen += buckets[i];
+			if (seen >= rank) {
+				if (i == BUCKET_COUNT - 1) {
+					// The last bucket has no meaningful upper bound.
+					return max;
+				} else {
+					return std::min(bucketUpperBound(i), max);
+				}
+			}
+		}
+		return max;
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_ALGORITHMS_LATENCY_HISTOGRAM_H_ */
@@ -195,6 +195,62 @@ public:
 };
 
 
+/**
+ * A peak-sensitive exponential moving average, as used by "peak EWMA" load
+ * balancers. A value that is larger than the current average replaces the
+ * average immediately, so that a sudden slowdown is noticed right away. Smaller
+ * values are averaged in with a weight that depends on the time elapsed since
+ * the previous value, so that the average approaches them with a time constant
+ * of `decayTime` microseconds.
+ *
+ * When no new values arrive, `average(now)` decays towards 0 with the same time
+ * constant. This prevents a load balancer from avoiding a data source forever
+ * after it has been slow once, because it would never get a new value.
+ */
+template<unsigned long long decayTime = 1000000>
+class PeakExpMovingAverage {
+private:
+	double value;
+	unsigned long long prevTime;
+
+	static double decayFactor(unsigned long long from, unsigned long long to) {
+		if (to > from) {
+			return exp(-((double) (to - from)) / decayTime);
+		} else {
+			return 1;
+		}
+	}
+
+public:
+	PeakExpMovingAverage()
+		: value(0),
+		  prevTime(0)
+		{ }
+
+	void update(double newValue, unsigned long long now) {
+		if (OXT_UNLIKELY(prevTime == 0) || newValue >= value) {
+			value = newValue;
+		} else {
+			double weight = decayFactor(prevTime, now);
+			value = weight * value + (1 - weight) * newValue;
+		}
+		prevTime = std::max(prevTime, now);
+	}
+
+	bool available() const {
+		return prevTime != 0;
+	}
+
+	double average() const {
+		return value;
+	}
+
+	double average(unsigned long long now) const {
+		return value * decayFactor(prevTime, now);
+	}
+};
+
+
 /**
  * Calculates an exponential moving average. `alpha` determines how much weight the
  * current value has compared to the previous average. Higher values of `alpha`
@@ -64,6 +64,10 @@
 #define DEFAULT_POOL_IDLE_TIME 300
 #define DEFAULT_PYTHON "python"
 #define DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK 134217728
+#define DEFAULT_RESPONSE_COMPRESSION_LEVEL 6
+#define DEFAULT_RESPONSE_COMPRESSION_MIN_SIZE 1024
+#define DEFAULT_RESPONSE_SPLICE_MIN_SIZE 131072
+#define DEFAULT_ROUTING_METHOD "least_busy"
 #define DEFAULT_RUBY "ruby"
 #define DEFAULT_SOCKET_BACKLOG 2048
 #define DEFAULT_SPAWN_METHOD "smart"
@@ -71,6 +75,8 @@
 #define DEFAULT_STAT_THROTTLE_RATE 10
 #define DEFAULT_STICKY_SESSIONS_COOKIE_ATTRIBUTES "SameSite=Lax; Secure;"
 #define DEFAULT_STICKY_SESSIONS_COOKIE_NAME "_passenger_route"
+#define DEFAULT_TURBOCACHE_MAX_ENTRIES 1024
+#define DEFAULT_TURBOCACHE_MAX_SIZE 16777216
 #define DEFAULT_WEB_APP_USER "nobody"
 #define ENTERPRISE_URL "https://www.phusionpassenger.com/features#premium-features"
 #define FEEDBACK_FD 3
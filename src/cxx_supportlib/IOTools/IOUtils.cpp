@@ -368,9 +368,9 @@ createUnixServer(const StaticString &filename, unsigned int backlogSize, bool au
 	return fd;
 }
 
-int
-createTcpServer(const char *address, unsigned short port, unsigned int backlogSize,
-	const char *file, unsigned int line)
+static int
+realCreateTcpServer(const char *address, unsigned short port, unsigned int backlogSize,
+	bool reusePort, const char *file, unsigned int line)
 {
 	union {
 		struct sockaddr_in v4;
@@ -423,6 +423,19 @@ createTcpServer(const char *address, unsigned short port, unsigned int backlogSi
 	// Ignore SO_REUSEADDR error, it's not fatal.
 
 	FdGuard guard(fd, file, line, true);
+	if (reusePort) {
+		#ifdef SO_REUSEPORT
+			optval = 1;
+			if (syscalls::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT,
+				&optval, sizeof(optval)) == -1)
+			{
+				int e = errno;
+				throw SystemException("Cannot set SO_REUSEPORT on a TCP socket", e);
+			}
+		#else
+			throw SystemException("Cannot set SO_REUSEPORT on a TCP socket", ENOPROTOOPT);
+		#endif
+	}
 	if (family == AF_INET) {
 		ret = syscalls::bind(fd, (const struct sockaddr *) &addr.v4, sizeof(struct sockaddr_in));
 	} else {
@@ -454,6 +467,29 @@ createTcpServer(const char *address, unsigned short port, unsigned int backlogSi
 	return fd;
 }
 
+int
+createReusePortServer(const StaticString &address, unsigned int backlogSize,
+	const char *file, unsigned int line)
+{
+	TRACE_POINT();
+	if (getSocketAddressType(address) != SAT_TCP) {
+		throw ArgumentException(string("SO_REUSEPORT is only supported on TCP addresses, but '")
+			+ address + "' is not a TCP address");
+	}
+
+	string host;
+	unsigned short port;
+	parseTcpSocketAddress(address, host, port);
+	return realCreateTcpServer(host.c_str(), port, backlogSize, true, file, line);
+}
+
+int
+createTcpServer(const char *address, unsigned short port, unsigned int backlogSize,
+	const char *file, unsigned int line)
+{
+	return realCreateTcpServer(address, port, backlogSize, false, file, line);
+}
+
 int
 connectToServer(const StaticString &address, const char *file, unsigned int line) {
 	TRACE_POINT();
@@ -733,6 +769,50 @@ connectToServer(NConnect_State &state) {
 	}
 }
 
+bool
+finishConnectingToServer(int fd, const StaticString &address) {
+	switch (getSocketAddressType(address)) {
+	case SAT_UNIX: {
+		// A Unix domain socket connect never stays in progress. If it
+		// didn't succeed immediately then we have to try again.
+		NUnix_State state;
+		state.fd = FileDescriptor(fd, NULL, 0, false);
+		state.filename = parseUnixSocketAddress(address);
+		return connectToUnixServer(state);
+	}
+	case SAT_TCP: {
+		int error;
+		socklen_t len = sizeof(error);
+
+		if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len) == -1) {
+			int e = errno;
+			throw SystemException("Cannot query the status of a TCP socket", e);
+		}
+		if (error == 0) {
+			// Guard against spurious writability notifications.
+			struct sockaddr_storage addr;
+			len = sizeof(addr);
+			if (getpeername(fd, (struct sockaddr *) &addr, &len) == -1) {
+				if (errno == ENOTCONN) {
+					return false;
+				} else {
+					int e = errno;
+					throw SystemException("Cannot query the status of a TCP socket", e);
+				}
+			}
+			return true;
+		} else if (error == EINPROGRESS || error == EALREADY) {
+			return false;
+		} else {
+			throw SystemException(string("Cannot connect to TCP socket '")
+				+ address + "'", error);
+		}
+	}
+	default:
+		throw ArgumentException(string("Unknown address type for '") + address + "'");
+	}
+}
+
 bool
 pingTcpServer(const StaticString &host, unsigned int port, unsigned long long *timeout) {
 	TRACE_POINT();
@@ -209,6 +209,30 @@ int createTcpServer(const char *address = "0.0.0.0",
 	const char *file = __FILE__,
 	unsigned int line = __LINE__);
 
+/**
+ * Like createServer(), but sets SO_REUSEPORT on the socket before binding it,
+ * so that multiple server sockets can be bound to the same address. On Linux,
+ * the kernel then distributes incoming connections over all those sockets.
+ * Only TCP addresses are supported.
+ *
+ * @param address The TCP address to bind the socket to.
+ * @param backlogSize The size of the socket's backlog. Specify 0 to use the
+ *                    platform's maximum allowed backlog size.
+ * @param file The name of the source file that called this function,
+ *             for file descriptor logging purposes.
+ * @param line The line in the source file that called this function.
+ * @return The file descriptor of the newly created server socket.
+ * @throws ArgumentException The given address is not a TCP address.
+ * @throws SystemException Something went wrong while creating the server socket,
+ *                         or the platform does not support SO_REUSEPORT.
+ * @throws boost::thread_interrupted A system call has been interrupted.
+ * @ingroup Support
+ */
+int createReusePortServer(const StaticString &address,
+	unsigned int backlogSize = 0,
+	const char *file = __FILE__,
+	unsigned int line = __LINE__);
+
 /**
  * Connect to a server at the given address in a blocking manner.
  *
@@ -385,6 +409,26 @@ void setupNonBlockingSocket(NConnect_State & restrict_ref state,
  */
 bool connectToServer(NConnect_State &state);
 
+/**
+ * Checks whether a non-blocking connect, for which connectToServer(NConnect_State &)
+ * returned false, has completed. Call this when the socket has become writable.
+ *
+ * On Unix domain sockets, connectToServer() returns false when the server's
+ * backlog is full. Such sockets are writable immediately, so in that case the
+ * caller should call this function again after a short delay instead of
+ * waiting for writability.
+ *
+ * @param fd The socket that is being connected.
+ * @param address The address that was passed to setupNonBlockingSocket().
+ * @return True if the socket is now connected, false if it isn't ready yet.
+ * @throws ArgumentException Unknown address type.
+ * @throws RuntimeException Something went wrong.
+ * @throws SystemException Connecting to the server failed.
+ * @throws boost::thread_interrupted A system call has been interrupted.
+ * @ingroup Support
+ */
+bool finishConnectingToServer(int fd, const StaticString &address);
+
 /**
  * Checks whether the given TCP server is connectable. Because this check
  * can take (in theory) an arbitrary amount of time, you must also supply
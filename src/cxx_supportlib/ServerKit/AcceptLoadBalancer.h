@@ -77,7 +77,10 @@ using namespace boost;
  *
  * Inside the "PassengerAgent core", we activate AcceptLoadBalancer
  * only if `core_threads > 1`, which is often the case because
- * `core_threads` defaults to the number of CPU cores.
+ * `core_threads` defaults to the number of CPU cores. If
+ * `controller_reuse_port` is enabled, then TCP endpoints bypass the
+ * AcceptLoadBalancer: every thread gets its own SO_REUSEPORT server
+ * socket, and the kernel distributes clients over them.
  */
 template<typename Server>
 class AcceptLoadBalancer {
@@ -300,6 +303,10 @@ public:
 		#undef EXTENSION_EOPNOTSUPP
 	}
 
+	bool hasEndpoints() const {
+		return nEndpoints > 0;
+	}
+
 	void start() {
 		boost::function<void ()> func = boost::bind(&AcceptLoadBalancer<Server>::mainLoop, this);
 		thread = new oxt::thread(boost::bind(runAndPrintExceptions, func, true),
@@ -56,6 +56,7 @@ using namespace std;
  *   file_buffered_channel_auto_truncate_file             boolean            -   default(true)
  *   file_buffered_channel_buffer_dir                     string             -   default
  *   file_buffered_channel_delay_in_file_mode_switching   unsigned integer   -   default(0)
+ *   file_buffered_channel_io_uring                       boolean            -   default(false)
  *   file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -   default(0)
  *   file_buffered_channel_threshold                      unsigned integer   -   default(131072)
  *   mbuf_block_chunk_size                                unsigned integer   -   default(4096),read_only
@@ -89,6 +90,7 @@ public:
 		add("file_buffered_channel_delay_in_file_mode_switching", UINT_TYPE, OPTIONAL, 0);
 		add("file_buffered_channel_max_disk_chunk_read_size", UINT_TYPE, OPTIONAL, 0);
 		add("file_buffered_channel_auto_truncate_file", BOOL_TYPE, OPTIONAL, true);
+		add("file_buffered_channel_io_uring", BOOL_TYPE, OPTIONAL, false);
 		// For unit testing purposes
 		add("file_buffered_channel_auto_start_mover", BOOL_TYPE, OPTIONAL, true);
 
@@ -109,6 +111,7 @@ struct FileBufferedChannelConfig {
 	unsigned int maxDiskChunkReadSize;
 	bool autoTruncateFile;
 	bool autoStartMover;
+	bool ioUring;
 
 	FileBufferedChannelConfig(const ConfigKit::Store &config)
 		: bufferDir(config["file_buffered_channel_buffer_dir"].asString()),
@@ -116,7 +119,8 @@ struct FileBufferedChannelConfig {
 		  delayInFileModeSwitching(config["file_buffered_channel_delay_in_file_mode_switching"].asUInt()),
 		  maxDiskChunkReadSize(config["file_buffered_channel_max_disk_chunk_read_size"].asUInt()),
 		  autoTruncateFile(config["file_buffered_channel_auto_truncate_file"].asBool()),
-		  autoStartMover(config["file_buffered_channel_auto_start_mover"].asBool())
+		  autoStartMover(config["file_buffered_channel_auto_start_mover"].asBool()),
+		  ioUring(config["file_buffered_channel_io_uring"].asBool())
 		{ }
 
 	void swap(FileBufferedChannelConfig &other) BOOST_NOEXCEPT_OR_NOTHROW {
@@ -126,6 +130,7 @@ struct FileBufferedChannelConfig {
 		std::swap(maxDiskChunkReadSize, other.maxDiskChunkReadSize);
 		std::swap(autoTruncateFile, other.autoTruncateFile);
 		std::swap(autoStartMover, other.autoStartMover);
+		std::swap(ioUring, other.ioUring);
 	}
 };
 
@@ -28,10 +28,14 @@
 
 #include <string>
 #include <boost/config.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 
 #include <ServerKit/Config.h>
+#include <ServerKit/IoUring.h>
 #include <ConfigKit/ConfigKit.h>
 #include <MemoryKit/mbuf.h>
+#include <LoggingKit/LoggingKit.h>
 #include <LoggingKit/Assert.h>
 #include <SafeLibev.h>
 #include <Exceptions.h>
@@ -51,6 +55,8 @@ using namespace std;
 class Context {
 private:
 	ConfigKit::Store configStore;
+	IoUring *ioUring;
+	bool ioUringUnavailable;
 
 public:
 	typedef ServerKit::ConfigChangeRequest ConfigChangeRequest;
@@ -63,14 +69,25 @@ public:
 	Config config;
 	struct MemoryKit::mbuf_pool mbuf_pool;
 
+	/**
+	 * Total number of bytes that FileBufferedChannels have written to
+	 * their buffer files. Only modified by the event loop thread, but may
+	 * be read from any thread.
+	 */
+	boost::atomic<boost::uint64_t> bytesBufferedToDisk;
+
 	Context(const Schema &schema, const Json::Value &initialConfig = Json::Value(),
 		const ConfigKit::Translator &translator = ConfigKit::DummyTranslator())
 		: configStore(schema, initialConfig, translator),
+		  ioUring(NULL),
+		  ioUringUnavailable(false),
 		  libuv(NULL),
-		  config(configStore)
+		  config(configStore),
+		  bytesBufferedToDisk(0)
 		{ }
 
 	~Context() {
+		delete ioUring;
 		MemoryKit::mbuf_pool_deinit(&mbuf_pool);
 	}
 
@@ -86,6 +103,24 @@ public:
 		MemoryKit::mbuf_pool_init(&mbuf_pool);
 	}
 
+	/**
+	 * Returns the io_uring instance that belongs to this context's event loop,
+	 * creating it on first use. Returns NULL if io_uring is not available
+	 * on this system. Must be called from the event loop thread.
+	 */
+	IoUring *getIoUring() {
+		if (ioUring == NULL && !ioUringUnavailable) {
+			try {
+				ioUring = new IoUring(libev->getLoop());
+			} catch (const SystemException &e) {
+				P_WARN("io_uring is not available, falling back to the libuv "
+					"thread pool for file I/O: " << e.what());
+				ioUringUnavailable = true;
+			}
+		}
+		return ioUring;
+	}
+
 	bool configure(const Json::Value &updates, vector<ConfigKit::Error> &errors) {
 		ConfigChangeRequest req;
 		bool result = prepareConfigChange(updates, errors, req);
@@ -148,6 +183,8 @@ public:
 		#endif
 
 		doc["mbuf_pool"] = mbufDoc;
+		doc["bytes_buffered_to_disk"] = byteSizeToJson(
+			bytesBufferedToDisk.load(boost::memory_order_relaxed));
 
 		return doc;
 	}
@@ -43,6 +43,7 @@
 #include <deque>
 #include <LoggingKit/LoggingKit.h>
 #include <ServerKit/Context.h>
+#include <ServerKit/IoUring.h>
 #include <ServerKit/Config.h>
 #include <ServerKit/Errors.h>
 #include <ServerKit/Channel.h>
@@ -206,8 +207,8 @@ public:
 
 private:
 	/**
-	 * A structure containing the details of a libuv asynchronous
-	 * filesystem I/O request.
+	 * A structure containing the details of a libuv (or io_uring)
+	 * asynchronous filesystem I/O request.
 	 *
 	 * The I/O callback is responsible for destroying its corresponding
 	 * FileIOContext object.
@@ -238,6 +239,12 @@ private:
 		uv_loop_t *libuv;
 		/* req.data always refers back to the FileIOContext object itself. */
 		uv_fs_t req;
+		/**
+		 * Used instead of `req` if the operation was submitted through io_uring.
+		 * In that case, `req` is not passed to libuv, but its `result` field
+		 * is still set to the result of the operation when it completes.
+		 */
+		IoUring::Operation ioOperation;
 
 		/**
 		 * Also a pointer to the FileBufferedChannel, but this is used for
@@ -256,6 +263,7 @@ private:
 			req.type = UV_UNKNOWN_REQ;
 			req.result = -1;
 			req.data = this;
+			ioOperation.data = this;
 		}
 
 		virtual ~FileIOContext() { }
@@ -737,9 +745,17 @@ private:
 		readerState = RS_READING_FROM_FILE;
 		inFileMode->readRequest = readContext;
 
-		uv_fs_read(ctx->libuv, &readContext->req, inFileMode->fd,
-			&readContext->uvBuffer, 1, inFileMode->readOffset,
-			_nextChunkDoneReading);
+		IoUring *ioUring = getIoUring();
+		readContext->ioOperation.callback = _nextChunkDoneReadingFromIoUring;
+		if (ioUring != NULL && ioUring->prepareRead(&readContext->ioOperation,
+			inFileMode->fd, readContext->buffer.start, size, inFileMode->readOffset))
+		{
+			FBC_DEBUG("Reader: read submitted through io_uring");
+		} else {
+			uv_fs_read(ctx->libuv, &readContext->req, inFileMode->fd,
+				&readContext->uvBuffer, 1, inFileMode->readOffset,
+				_nextChunkDoneReading);
+		}
 		verifyInvariants();
 	}
 
@@ -754,6 +770,17 @@ private:
 		readContext->self->nextChunkDoneReading(readContext);
 	}
 
+	static void _nextChunkDoneReadingFromIoUring(void *data, int result) {
+		ReadContext *readContext = static_cast<ReadContext *>(data);
+		readContext->req.result = result;
+		if (readContext->isCanceled()) {
+			delete readContext;
+			return;
+		}
+
+		readContext->self->nextChunkDoneReading(readContext);
+	}
+
 	void nextChunkDoneReading(ReadContext *readContext) {
 		RefGuard guard(hooks, this, __FILE__, __LINE__);
 
@@ -1091,21 +1118,40 @@ private:
 		moveContext->inFileMode = inFileMode;
 		moveContext->buffer = peekBuffer();
 		moveContext->written = 0;
-		moveContext->uvBuffer = uv_buf_init(moveContext->buffer.start,
-			moveContext->buffer.size());
+		moveContext->ioOperation.callback = _bufferWrittenToFileFromIoUring;
 
 		inFileMode->writerState = WS_MOVING;
 		inFileMode->writerRequest = moveContext;
+		writeRestOfBufferToFile(moveContext);
+		verifyInvariants();
+	}
+
+	/**
+	 * Writes the part of `moveContext->buffer` that hasn't been written yet
+	 * to the end of the file.
+	 */
+	void writeRestOfBufferToFile(MoveContext *moveContext) {
+		const char *data = moveContext->buffer.start + moveContext->written;
+		size_t size = moveContext->buffer.size() - moveContext->written;
+		off_t offset = inFileMode->readOffset + inFileMode->written
+			+ moveContext->written;
+		IoUring *ioUring = getIoUring();
+
+		if (ioUring != NULL && ioUring->prepareWrite(&moveContext->ioOperation,
+			inFileMode->fd, data, size, offset))
+		{
+			FBC_DEBUG("Writer: write submitted through io_uring");
+			return;
+		}
+
+		moveContext->uvBuffer = uv_buf_init(const_cast<char *>(data), size);
 		int result = uv_fs_write(ctx->libuv, &moveContext->req, inFileMode->fd,
-			&moveContext->uvBuffer, 1,
-			inFileMode->readOffset + inFileMode->written,
-			_bufferWrittenToFile);
+			&moveContext->uvBuffer, 1, offset, _bufferWrittenToFile);
 		if (result != 0) {
 			moveContext->req.result = result;
 			ctx->libev->runLater(boost::bind(_bufferWrittenToFile,
 				&moveContext->req));
 		}
-		verifyInvariants();
 	}
 
 	static void _bufferWrittenToFile(uv_fs_t *req) {
@@ -1119,6 +1165,17 @@ private:
 		moveContext->self->bufferWrittenToFile(moveContext);
 	}
 
+	static void _bufferWrittenToFileFromIoUring(void *data, int result) {
+		MoveContext *moveContext = static_cast<MoveContext *>(data);
+		moveContext->req.result = result;
+		if (moveContext->isCanceled()) {
+			delete moveContext;
+			return;
+		}
+
+		moveContext->self->bufferWrittenToFile(moveContext);
+	}
+
 	void bufferWrittenToFile(MoveContext *moveContext) {
 		P_ASSERT_EQ(mode, IN_FILE_MODE);
 		P_ASSERT_EQ(inFileMode->writerState, WS_MOVING);
@@ -1137,6 +1194,10 @@ private:
 				FBC_DEBUG("Writer: move complete");
 				assert(peekBuffer().size() == moveContext->buffer.size());
 				inFileMode->written += moveContext->buffer.size();
+				ctx->bytesBufferedToDisk.store(
+					ctx->bytesBufferedToDisk.load(boost::memory_order_relaxed)
+						+ moveContext->buffer.size(),
+					boost::memory_order_relaxed);
 
 				popBuffer();
 				if (generation != this->generation || mode >= ERROR) {
@@ -1152,18 +1213,7 @@ private:
 			} else {
 				FBC_DEBUG("Writer: move incomplete, proceeding " <<
 					"with writing rest of buffer");
-				moveContext->uvBuffer = uv_buf_init(
-					moveContext->buffer.start + moveContext->written,
-					moveContext->buffer.size() - moveContext->written);
-				int result = uv_fs_write(ctx->libuv, &moveContext->req,
-					inFileMode->fd, &moveContext->uvBuffer, 1,
-					inFileMode->readOffset + inFileMode->written,
-					_bufferWrittenToFile);
-				if (result != 0) {
-					moveContext->req.result = result;
-					ctx->libev->runLater(boost::bind(_bufferWrittenToFile,
-						&moveContext->req));
-				}
+				writeRestOfBufferToFile(moveContext);
 				verifyInvariants();
 			}
 		} else {
@@ -1179,6 +1229,20 @@ private:
 
 	/***** Misc *****/
 
+	/**
+	 * Returns the io_uring instance to use for reading from and writing to
+	 * the buffer file, or NULL if file I/O should go through libuv.
+	 * File creation, unlinking and closing always go through libuv because
+	 * they only happen once per file.
+	 */
+	IoUring *getIoUring() {
+		if (config->ioUring) {
+			return ctx->getIoUring();
+		} else {
+			return NULL;
+		}
+	}
+
 	void setError(int errcode, const char *file, unsigned int line) {
 		if (mode >= ERROR) {
 			return;
@@ -1530,6 +1594,15 @@ public:
 		return bytesBuffered + getBytesBufferedOnDisk();
 	}
 
+	/**
+	 * Returns whether all data fed so far has been consumed by the data
+	 * callback. Unlike `getTotalBytesBuffered() == 0`, this also takes into
+	 * account the buffer that the data callback is currently processing.
+	 */
+	bool isFlushed() const {
+		return readerState == RS_INACTIVE;
+	}
+
 	bool ended() const {
 		return (hasBuffers() && peekLastBuffer().empty())
 			|| mode >= ERROR || Channel::ended();
@@ -214,6 +214,11 @@ public:
 		return FileBufferedChannel::getTotalBytesBuffered();
 	}
 
+	OXT_FORCE_INLINE
+	bool isFlushed() const {
+		return FileBufferedChannel::isFlushed();
+	}
+
 	OXT_FORCE_INLINE
 	bool ended() const {
 		return FileBufferedChannel::ended();
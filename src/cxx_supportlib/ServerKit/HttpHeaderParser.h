@@ -207,11 +207,9 @@ private:
 			self->state->hasher.update(data, len);
 		} else {
 			char *downcasedData = (char *) psg_pnalloc(self->pool, len);
-			convertLowerCase((const unsigned char *) data,
-				(unsigned char *) downcasedData, len);
+			self->state->hasher.updateLowerCase(data, downcasedData, len);
 			psg_lstr_append(&self->state->currentHeader->key, self->pool,
 				downcasedData, len);
-			self->state->hasher.update(downcasedData, len);
 		}
 
 		return 0;
@@ -235,7 +233,6 @@ private:
 
 		psg_lstr_append(&self->state->currentHeader->val, self->pool,
 			*self->currentBuffer, data, len);
-		self->state->hasher.update(data, len);
 
 		return 0;
 	}
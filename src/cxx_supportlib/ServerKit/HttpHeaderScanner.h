@@ -0,0 +1,134 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_HTTP_HEADER_SCANNER_H_
+#define _PASSENGER_SERVER_KIT_HTTP_HEADER_SCANNER_H_
+
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+	#include <emmintrin.h>
+	#define PASSENGER_HTTP_HEADER_SCANNER_SSE2
+#endif
+
+namespace Passenger {
+namespace ServerKit {
+
+
+/**
+ * Helpers for http_parser that skip over the uninteresting parts of a
+ * header (the bulk of header names and values) 16 bytes at a time, instead
+ * of feeding every byte through the parser's state machine.
+ *
+ * Both functions look at [begin, end) only; they never read outside that
+ * range, so they are safe to use on the end of an mbuf. On platforms without
+ * SSE2, they fall back to a plain loop.
+ */
+
+
+/**
+ * Returns a pointer to the first CR or LF in [begin, end), or `end`
+ * if there is none.
+ */
+inline const char *
+scanHttpHeaderLineEnd(const char *begin, const char *end) {
+	const char *pos = begin;
+
+	#ifdef PASSENGER_HTTP_HEADER_SCANNER_SSE2
+		const __m128i cr = _mm_set1_epi8('\r');
+		const __m128i lf = _mm_set1_epi8('\n');
+
+		while (end - pos >= 16) {
+			__m128i data = _mm_loadu_si128((const __m128i *) pos);
+			int mask = _mm_movemask_epi8(_mm_or_si128(
+				_mm_cmpeq_epi8(data, cr),
+				_mm_cmpeq_epi8(data, lf)));
+			if (mask != 0) {
+				return pos + __builtin_ctz(mask);
+			}
+			pos += 16;
+		}
+	#endif
+
+	while (pos < end && *pos != '\r' && *pos != '\n') {
+		pos++;
+	}
+	return pos;
+}
+
+/**
+ * Returns a pointer to the first byte in [begin, end) that is not an
+ * ASCII letter, digit or '-', or `end` if there is none. These are the
+ * characters that virtually all header names consist of. Other token
+ * characters are rare, so they are left to http_parser's token table.
+ */
+inline const char *
+scanHttpHeaderNameChars(const char *begin, const char *end) {
+	const char *pos = begin;
+
+	#ifdef PASSENGER_HTTP_HEADER_SCANNER_SSE2
+		const __m128i caseBit = _mm_set1_epi8(0x20);
+		const __m128i beforeA = _mm_set1_epi8('a' - 1);
+		const __m128i afterZ  = _mm_set1_epi8('z' + 1);
+		const __m128i before0 = _mm_set1_epi8('0' - 1);
+		const __m128i after9  = _mm_set1_epi8('9' + 1);
+		const __m128i dash    = _mm_set1_epi8('-');
+
+		while (end - pos >= 16) {
+			// Bytes >= 0x80 are negative in these signed comparisons,
+			// so they never match.
+			__m128i data = _mm_loadu_si128((const __m128i *) pos);
+			__m128i lower = _mm_or_si128(data, caseBit);
+			__m128i alpha = _mm_and_si128(
+				_mm_cmpgt_epi8(lower, beforeA),
+				_mm_cmplt_epi8(lower, afterZ));
+			__m128i digit = _mm_and_si128(
+				_mm_cmpgt_epi8(data, before0),
+				_mm_cmplt_epi8(data, after9));
+			int mask = _mm_movemask_epi8(_mm_or_si128(
+				_mm_or_si128(alpha, digit),
+				_mm_cmpeq_epi8(data, dash)));
+			if (mask != 0xFFFF) {
+				return pos + __builtin_ctz(~mask);
+			}
+			pos += 16;
+		}
+	#endif
+
+	while (pos < end) {
+		char ch = *pos;
+		char lower = ch | 0x20;
+		if ((lower >= 'a' && lower <= 'z') || (ch >= '0' && ch <= '9') || ch == '-') {
+			pos++;
+		} else {
+			break;
+		}
+	}
+	return pos;
+}
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_HTTP_HEADER_SCANNER_H_ */
@@ -38,6 +38,7 @@
 #include <ServerKit/HttpChunkedBodyParserState.h>
 #include <MemoryKit/palloc.h>
 #include <DataStructures/LString.h>
+#include <SystemTools/SystemTime.h>
 
 namespace Passenger {
 namespace ServerKit {
@@ -141,6 +142,8 @@ public:
 	} aux;
 	boost::uint64_t bodyAlreadyRead;
 
+	// Monotonic timestamp in microseconds.
+	MonotonicTimeUsec firstDataReceivedAt;
 	ev_tstamp lastDataReceiveTime;
 	ev_tstamp lastDataSendTime;
 
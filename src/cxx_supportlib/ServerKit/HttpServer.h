@@ -788,6 +788,9 @@ protected:
 
 		if (!ended) {
 			req->lastDataReceiveTime = ev_now(this->getLoop());
+			if (req->firstDataReceivedAt == 0 && buffer.size() > 0) {
+				req->firstDataReceivedAt = SystemTime::getMonotonicUsec();
+			}
 		}
 		if (detectNextRequestEarlyReadError(client, req, buffer, errcode)) {
 			return Channel::Result(0, false);
@@ -947,6 +950,7 @@ protected:
 		req->bodyChannel.reinitialize();
 		req->aux.bodyInfo.contentLength = 0; // Sets the entire union to 0.
 		req->bodyAlreadyRead = 0;
+		req->firstDataReceivedAt = 0;
 		req->lastDataReceiveTime = 0;
 		req->lastDataSendTime = 0;
 		req->queryStringIndex = -1;
@@ -0,0 +1,408 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_IO_URING_H_
+#define _PASSENGER_SERVER_KIT_IO_URING_H_
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <stdint.h>
+#include <cstddef>
+#include <cerrno>
+
+#ifdef __linux__
+	#include <sys/syscall.h>
+	#if defined(__has_include) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+		#if __has_include(<linux/io_uring.h>)
+			#define PASSENGER_HAVE_IO_URING
+		#endif
+	#endif
+#endif
+
+#ifdef PASSENGER_HAVE_IO_URING
+	#include <sys/mman.h>
+	#include <unistd.h>
+	#include <linux/io_uring.h>
+	#include <cstring>
+	#include <vector>
+#endif
+
+#include <boost/cstdint.hpp>
+#include <ev.h>
+#include <LoggingKit/LoggingKit.h>
+#include <Exceptions.h>
+#include <ServerKit/Errors.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+
+/**
+ * A minimal io_uring instance that is integrated into a libev event loop.
+ * It is used for performing regular file I/O without going through the
+ * libuv thread pool, which costs a few context switches and a thread wakeup
+ * per operation.
+ *
+ * Operations are queued with `prepareRead()` or `prepareWrite()`. They are not
+ * submitted to the kernel immediately: all operations prepared during an event
+ * loop iteration are submitted with a single `io_uring_enter()` system call,
+ * just before the event loop blocks. Completions are reaped when the ring file
+ * descriptor becomes readable, and each operation's callback is then invoked
+ * with the result of the operation: the number of bytes transferred, or a
+ * negative errno value.
+ *
+ * `prepareRead()` and `prepareWrite()` return false when the ring is full,
+ * in which case the caller should fall back to another I/O mechanism. The
+ * Operation object, and the buffer it refers to, must stay alive until the
+ * callback has been called.
+ *
+ * We talk to the kernel with raw system calls so that we do not depend on
+ * liburing. On systems without io_uring support, or where io_uring is
+ * disabled (e.g. by a seccomp policy), the constructor throws a
+ * SystemException.
+ *
+ * This class is not thread-safe: it must only be used from the event loop thread.
+ */
+class IoUring {
+public:
+	typedef void (*Callback)(void *data, int result);
+
+	struct Operation {
+		Callback callback;
+		void *data;
+		struct iovec iov;
+
+		Operation()
+			: callback(NULL),
+			  data(NULL)
+		{
+			iov.iov_base = NULL;
+			iov.iov_len = 0;
+		}
+	};
+
+	static const unsigned int DEFAULT_ENTRIES = 256;
+
+#ifdef PASSENGER_HAVE_IO_URING
+private:
+	struct ev_loop *loop;
+	int fd;
+	unsigned int sqEntries;
+	unsigned int cqEntries;
+	void *sqRing;
+	size_t sqRingSize;
+	void *cqRing;
+	size_t cqRingSize;
+	struct io_uring_sqe *sqes;
+	size_t sqesSize;
+
+	unsigned int *sqHead;
+	unsigned int *sqTail;
+	unsigned int *sqMask;
+	unsigned int *sqArray;
+	unsigned int *cqHead;
+	unsigned int *cqTail;
+	unsigned int *cqMask;
+	struct io_uring_cqe *cqes;
+
+	/** Number of prepared operations not yet submitted to the kernel. */
+	unsigned int unsubmitted;
+	/** Number of prepared operations whose completions haven't been reaped yet. */
+	unsigned int outstanding;
+
+	struct ev_prepare prepareWatcher;
+	struct ev_io completionWatcher;
+
+	static int sysSetup(unsigned int entries, struct io_uring_params *params) {
+		return (int) syscall(__NR_io_uring_setup, entries, params);
+	}
+
+	static int sysEnter(int fd, unsigned int toSubmit, unsigned int minComplete,
+		unsigned int flags)
+	{
+		return (int) syscall(__NR_io_uring_enter, fd, toSubmit, minComplete,
+			flags, NULL, 0);
+	}
+
+	template<typename T>
+	T *ringPointer(void *ring, unsigned int offset) {
+		return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+	}
+
+	void unmapRings() {
+		if (sqes != NULL) {
+			munmap(sqes, sqesSize);
+		}
+		if (cqRing != NULL) {
+			munmap(cqRing, cqRingSize);
+		}
+		if (sqRing != NULL) {
+			munmap(sqRing, sqRingSize);
+		}
+	}
+
+	void *mapRing(size_t size, off_t offset, const char *what) {
+		void *result = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, offset);
+		if (result == MAP_FAILED) {
+			int e = errno;
+			unmapRings();
+			close(fd);
+			throw SystemException(std::string("Cannot map the io_uring ") + what, e);
+		}
+		return result;
+	}
+
+	bool prepare(boost::uint8_t opcode, Operation *op, int fd, void *buf,
+		size_t size, off_t offset)
+	{
+		if (outstanding >= cqEntries || unsubmitted >= sqEntries) {
+			return false;
+		}
+
+		unsigned int tail = *sqTail;
+		unsigned int index = tail & *sqMask;
+		struct io_uring_sqe *sqe = &sqes[index];
+
+		// READV/WRITEV instead of READ/WRITE, for compatibility with Linux < 5.6.
+		op->iov.iov_base = buf;
+		op->iov.iov_len = size;
+		memset(sqe, 0, sizeof(*sqe));
+		sqe->opcode = opcode;
+		sqe->fd = fd;
+		sqe->off = offset;
+		sqe->addr = (boost::uint64_t) (uintptr_t) &op->iov;
+		sqe->len = 1;
+		sqe->user_data = (boost::uint64_t) (uintptr_t) op;
+		sqArray[index] = index;
+		__atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+		unsubmitted++;
+		outstanding++;
+		if (!ev_is_active(&prepareWatcher)) {
+			ev_prepare_start(loop, &prepareWatcher);
+		}
+		return true;
+	}
+
+	void reapCompletions() {
+		unsigned int head = *cqHead;
+
+		while (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+			struct io_uring_cqe *cqe = &cqes[head & *cqMask];
+			Operation *op = reinterpret_cast<Operation *>((uintptr_t) cqe->user_data);
+			int result = cqe->res;
+
+			// Release the CQE before calling the callback, because the
+			// callback may prepare new operations.
+			head++;
+			__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+			outstanding--;
+			op->callback(op->data, result);
+		}
+	}
+
+	/**
+	 * Takes the operations that the kernel hasn't consumed back out of the
+	 * submission queue, and completes them with the given error.
+	 * Without SQPOLL the kernel only consumes entries during io_uring_enter(),
+	 * so it is safe to move the tail back here.
+	 */
+	void failUnsubmitted(int e) {
+		unsigned int tail = *sqTail;
+		unsigned int count = unsubmitted;
+		std::vector<Operation *> ops;
+
+		ops.reserve(count);
+		for (unsigned int i = 0; i < count; i++) {
+			unsigned int index = (tail - count + i) & *sqMask;
+			ops.push_back(reinterpret_cast<Operation *>(
+				(uintptr_t) sqes[index].user_data));
+		}
+		__atomic_store_n(sqTail, tail - count, __ATOMIC_RELEASE);
+		unsubmitted = 0;
+		outstanding -= count;
+
+		// The callbacks may prepare new operations, so only call them once
+		// the queue is consistent again.
+		for (unsigned int i = 0; i < count; i++) {
+			ops[i]->callback(ops[i]->data, -e);
+		}
+	}
+
+	static void onPrepare(struct ev_loop *loop, struct ev_prepare *watcher, int revents) {
+		IoUring *self = static_cast<IoUring *>(watcher->data);
+		self->submit();
+	}
+
+	static void onCompletion(struct ev_loop *loop, struct ev_io *watcher, int revents) {
+		IoUring *self = static_cast<IoUring *>(watcher->data);
+		self->reapCompletions();
+	}
+
+public:
+	IoUring(struct ev_loop *_loop, unsigned int entries = DEFAULT_ENTRIES)
+		: loop(_loop),
+		  sqRing(NULL),
+		  cqRing(NULL),
+		  sqes(NULL),
+		  unsubmitted(0),
+		  outstanding(0)
+	{
+		struct io_uring_params params;
+
+		memset(&params, 0, sizeof(params));
+		fd = sysSetup(entries, &params);
+		if (fd == -1) {
+			int e = errno;
+			throw SystemException("Cannot create an io_uring instance", e);
+		}
+
+		sqEntries = params.sq_entries;
+		cqEntries = params.cq_entries;
+		sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+		cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+		sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+		sqRing = mapRing(sqRingSize, IORING_OFF_SQ_RING, "submission queue");
+		cqRing = mapRing(cqRingSize, IORING_OFF_CQ_RING, "completion queue");
+		sqes = (struct io_uring_sqe *) mapRing(sqesSize, IORING_OFF_SQES,
+			"submission queue entries");
+
+		sqHead  = ringPointer<unsigned int>(sqRing, params.sq_off.head);
+		sqTail  = ringPointer<unsigned int>(sqRing, params.sq_off.tail);
+		sqMask  = ringPointer<unsigned int>(sqRing, params.sq_off.ring_mask);
+		sqArray = ringPointer<unsigned int>(sqRing, params.sq_off.array);
+		cqHead  = ringPointer<unsigned int>(cqRing, params.cq_off.head);
+		cqTail  = ringPointer<unsigned int>(cqRing, params.cq_off.tail);
+		cqMask  = ringPointer<unsigned int>(cqRing, params.cq_off.ring_mask);
+		cqes    = ringPointer<struct io_uring_cqe>(cqRing, params.cq_off.cqes);
+
+		ev_prepare_init(&prepareWatcher, onPrepare);
+		prepareWatcher.data = this;
+		ev_io_init(&completionWatcher, onCompletion, fd, EV_READ);
+		completionWatcher.data = this;
+		ev_io_start(loop, &completionWatcher);
+		// The completion watcher alone should not keep the event loop alive.
+		ev_unref(loop);
+	}
+
+	/**
+	 * Waits until all outstanding operations have completed (calling their
+	 * callbacks), then destroys the ring. The event loop must not be
+	 * running in another thread at this point.
+	 */
+	~IoUring() {
+		submit();
+		while (outstanding > 0) {
+			if (sysEnter(fd, 0, 1, IORING_ENTER_GETEVENTS) == -1 && errno != EINTR) {
+				break;
+			}
+			reapCompletions();
+		}
+
+		if (ev_is_active(&prepareWatcher)) {
+			ev_prepare_stop(loop, &prepareWatcher);
+		}
+		ev_ref(loop);
+		ev_io_stop(loop, &completionWatcher);
+		unmapRings();
+		close(fd);
+	}
+
+	bool prepareRead(Operation *op, int fd, void *buf, size_t size, off_t offset) {
+		return prepare(IORING_OP_READV, op, fd, buf, size, offset);
+	}
+
+	bool prepareWrite(Operation *op, int fd, const void *buf, size_t size, off_t offset) {
+		return prepare(IORING_OP_WRITEV, op, fd, const_cast<void *>(buf), size, offset);
+	}
+
+	/**
+	 * Submits all prepared operations to the kernel. This is called automatically
+	 * once per event loop iteration, so you normally don't have to call this.
+	 */
+	void submit() {
+		while (unsubmitted > 0) {
+			int ret = sysEnter(fd, unsubmitted, 0, 0);
+			int e = errno;
+			if (ret > 0) {
+				unsubmitted -= ret;
+			} else if (ret == -1 && e == EINTR) {
+				continue;
+			} else if (ret == 0 || e == EAGAIN || e == EBUSY) {
+				// The kernel is short on resources or the completion queue
+				// is full. Try again in the next iteration.
+				return;
+			} else {
+				P_ERROR("Cannot submit operations to io_uring: " <<
+					getErrorDesc(e) << " (errno=" << e << ")");
+				failUnsubmitted(e);
+			}
+		}
+		if (ev_is_active(&prepareWatcher)) {
+			ev_prepare_stop(loop, &prepareWatcher);
+		}
+	}
+
+	unsigned int getOutstanding() const {
+		return outstanding;
+	}
+
+	static bool isSupported() {
+		return true;
+	}
+
+#else
+public:
+	IoUring(struct ev_loop *loop, unsigned int entries = DEFAULT_ENTRIES) {
+		throw SystemException("Cannot create an io_uring instance", ENOSYS);
+	}
+
+	bool prepareRead(Operation *op, int fd, void *buf, size_t size, off_t offset) {
+		return false;
+	}
+
+	bool prepareWrite(Operation *op, int fd, const void *buf, size_t size, off_t offset) {
+		return false;
+	}
+
+	void submit() { }
+
+	unsigned int getOutstanding() const {
+		return 0;
+	}
+
+	static bool isSupported() {
+		return false;
+	}
+#endif
+};
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_IO_URING_H_ */
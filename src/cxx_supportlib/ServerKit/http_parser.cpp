@@ -22,6 +22,7 @@
  * IN THE SOFTWARE.
  */
 #include <ServerKit/http_parser.h>
+#include <ServerKit/HttpHeaderScanner.h>
 #include <assert.h>
 #include <stddef.h>
 #include <ctype.h>
@@ -1283,7 +1284,19 @@ size_t http_parser_execute (http_parser *parser,
         if (c) {
           switch (parser->header_state) {
             case h_general:
+            {
+              /* Skip over the rest of an ordinary header name in one go.
+               * Any other character is handled by the next iteration. */
+              const char *q = Passenger::ServerKit::scanHttpHeaderNameChars(
+                p + 1, data + len);
+              parser->nread += q - (p + 1);
+              if (parser->nread > (HTTP_MAX_HEADER_SIZE)) {
+                SET_ERRNO(HPE_HEADER_OVERFLOW);
+                goto error;
+              }
+              p = q - 1;
               break;
+            }
 
             case h_C:
               parser->index++;
@@ -1492,7 +1505,19 @@ size_t http_parser_execute (http_parser *parser,
 
         switch (parser->header_state) {
           case h_general:
+          {
+            /* Nothing in this value is interesting except for the line end,
+             * so skip straight to it. */
+            const char *q = Passenger::ServerKit::scanHttpHeaderLineEnd(
+              p + 1, data + len);
+            parser->nread += q - (p + 1);
+            if (parser->nread > (HTTP_MAX_HEADER_SIZE)) {
+              SET_ERRNO(HPE_HEADER_OVERFLOW);
+              goto error;
+            }
+            p = q - 1;
             break;
+          }
 
           case h_connection:
           case h_transfer_encoding:
@@ -29,10 +29,12 @@
 #include <boost/cstdint.hpp>
 #include <boost/thread.hpp>
 #include <boost/bind/bind.hpp>
+#include <boost/noncopyable.hpp>
 #include <oxt/system_calls.hpp>
 #include <string>
 #include <vector>
 #include <map>
+#include <algorithm>
 
 #ifdef __APPLE__
 	#include <mach/mach_traps.h>
@@ -49,11 +51,14 @@
 #endif
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <signal.h>
+#include <cstdio>
 #include <cstdlib>
 #include <cerrno>
 #include <cstring>
@@ -190,12 +195,363 @@ public:
 /**
  * Utility class for collection metrics on processes, such as CPU usage, memory usage,
  * command name, etc.
+ *
+ * On Linux, metrics are read directly from /proc instead of by running 'ps'.
+ * The /proc directory file descriptor and the read buffer are kept open
+ * between collect() calls, so it pays off to reuse a single collector object.
+ * A collector object is not thread-safe.
  */
-class ProcessMetricsCollector {
+class ProcessMetricsCollector: public boost::noncopyable {
 private:
+	/**
+	 * Accumulates the memory fields of a /proc/<pid>/smaps or
+	 * /proc/<pid>/smaps_rollup file. All values are in KB.
+	 */
+	struct SmapsTotals {
+		ssize_t pss;
+		ssize_t privateDirty;
+		ssize_t swap;
+		bool hasPss;
+		bool hasPrivateDirty;
+		bool hasSwap;
+
+		SmapsTotals()
+			: pss(0),
+			  privateDirty(0),
+			  swap(0),
+			  hasPss(false),
+			  hasPrivateDirty(false),
+			  hasSwap(false)
+			{ }
+
+		/**
+		 * Parses a single line and adds its value to the corresponding total.
+		 * Returns false if the line is malformed.
+		 */
+		bool addLine(const char *line) {
+			const char *buf = line;
+			try {
+				if (startsWith(line, "Pss:")) {
+					/* Linux supports Proportional Set Size since kernel 2.6.25.
+					 * See kernel commit ec4dd3eb35759f9fbeb5c1abb01403b2fde64cc9.
+					 */
+					hasPss = true;
+					readNextWord(&buf);
+					pss += readNextWordAsLongLong(&buf);
+					return readNextWord(&buf) == "kB";
+				} else if (startsWith(line, "Private_Dirty:")) {
+					hasPrivateDirty = true;
+					readNextWord(&buf);
+					privateDirty += readNextWordAsLongLong(&buf);
+					return readNextWord(&buf) == "kB";
+				} else if (startsWith(line, "Swap:")) {
+					hasSwap = true;
+					readNextWord(&buf);
+					swap += readNextWordAsLongLong(&buf);
+					return readNextWord(&buf) == "kB";
+				} else {
+					return true;
+				}
+			} catch (const ParseException &) {
+				return false;
+			}
+		}
+
+		void get(ssize_t &pss, ssize_t &privateDirty, ssize_t &swap) const {
+			pss = hasPss ? this->pss : -1;
+			privateDirty = hasPrivateDirty ? this->privateDirty : -1;
+			swap = hasSwap ? this->swap : -1;
+		}
+	};
+
 	bool canMeasureRealMemory;
+	bool nativeCollectionEnabled;
 	string psOutput;
 
+	#ifdef __linux__
+		/** File descriptor of /proc. -1 if not yet opened, -2 if /proc is unusable. */
+		mutable int procFd;
+		/** Buffer that /proc files are read into. Reused across reads. */
+		mutable vector<char> procBuffer;
+		long clockTicksPerSecond;
+		long pageSizeKb;
+
+		bool openProcDir() const {
+			if (procFd == -1) {
+				procFd = syscalls::open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+				if (procFd == -1) {
+					procFd = -2;
+				} else {
+					P_LOG_FILE_DESCRIPTOR_OPEN4(procFd, __FILE__, __LINE__,
+						"ProcessMetricsCollector /proc");
+					struct stat buf;
+					if (fstatat(procFd, "self/stat", &buf, 0) == -1) {
+						// /proc exists but procfs is not mounted on it.
+						safelyClose(procFd, true);
+						P_LOG_FILE_DESCRIPTOR_CLOSE(procFd);
+						procFd = -2;
+					}
+				}
+			}
+			return procFd >= 0;
+		}
+
+		/**
+		 * Reads the file at the given path, relative to `dirfd`, into
+		 * `procBuffer` and NUL-terminates it. Returns the file size,
+		 * or -1 (with errno set) if the file cannot be read.
+		 */
+		ssize_t readProcFile(int dirfd, const char *path) const {
+			int fd = syscalls::openat(dirfd, path, O_RDONLY | O_CLOEXEC);
+			if (fd == -1) {
+				return -1;
+			}
+
+			FdGuard guard(fd, __FILE__, __LINE__);
+			size_t size = 0;
+
+			if (procBuffer.empty()) {
+				procBuffer.resize(1024 * 4);
+			}
+			while (true) {
+				if (procBuffer.size() - size < 2) {
+					if (procBuffer.size() >= 1024 * 1024) {
+						// Truncate absurdly long files (e.g. a huge cmdline).
+						break;
+					}
+					procBuffer.resize(procBuffer.size() * 2);
+				}
+
+				ssize_t ret = syscalls::read(fd, &procBuffer[size],
+					procBuffer.size() - size - 1);
+				if (ret == -1) {
+					int e = errno;
+					guard.runNow();
+					errno = e;
+					return -1;
+				} else if (ret == 0) {
+					break;
+				} else {
+					size += ret;
+				}
+			}
+
+			procBuffer[size] = '\0';
+			return size;
+		}
+
+		/**
+		 * Parses /proc/<pid>/stat, which yields the PPID, the process group ID,
+		 * the CPU usage and the command name (used when the command line is empty).
+		 */
+		bool readProcStat(int pidFd, double uptime, ProcessMetrics &metrics) const {
+			if (readProcFile(pidFd, "stat") <= 0) {
+				return false;
+			}
+
+			// The command name may contain spaces and parentheses,
+			// so the last ')' marks the end of it.
+			const char *data = &procBuffer[0];
+			const char *commStart = strchr(data, '(');
+			const char *commEnd = strrchr(data, ')');
+			if (commStart == NULL || commEnd == NULL || commEnd < commStart) {
+				return false;
+			}
+			metrics.command.assign("[");
+			metrics.command.append(commStart + 1, commEnd - commStart - 1);
+			metrics.command.append("]");
+
+			// Field 3 (the process state) starts after ") ".
+			const char *pos = commEnd + 1;
+			unsigned long long utime = 0, stime = 0, startTime = 0;
+			for (unsigned int field = 3; field <= 22; field++) {
+				while (*pos == ' ') {
+					pos++;
+				}
+				if (*pos == '\0' || *pos == '\n') {
+					return false;
+				}
+
+				switch (field) {
+				case 4:
+					metrics.ppid = (pid_t) strtoll(pos, NULL, 10);
+					break;
+				case 5:
+					metrics.processGroupId = (pid_t) strtoll(pos, NULL, 10);
+					break;
+				case 14:
+					utime = strtoull(pos, NULL, 10);
+					break;
+				case 15:
+					stime = strtoull(pos, NULL, 10);
+					break;
+				case 22:
+					startTime = strtoull(pos, NULL, 10);
+					break;
+				default:
+					break;
+				}
+
+				while (*pos != ' ' && *pos != '\0') {
+					pos++;
+				}
+			}
+
+			// Like 'ps', report the CPU time used over the process's entire
+			// lifetime as a percentage of the wall clock time it has existed.
+			metrics.cpu = 0;
+			if (uptime > 0 && clockTicksPerSecond > 0) {
+				double elapsed = uptime - (double) startTime / clockTicksPerSecond;
+				if (elapsed > 0) {
+					double usage = 100.0 * (utime + stime) / clockTicksPerSecond / elapsed;
+					metrics.cpu = (boost::uint8_t) std::min<double>(usage, 255);
+				}
+			}
+			return true;
+		}
+
+		/** Parses /proc/<pid>/statm, which yields the VM size and the RSS. */
+		bool readProcStatm(int pidFd, ProcessMetrics &metrics) const {
+			if (readProcFile(pidFd, "statm") <= 0) {
+				return false;
+			}
+
+			char *pos;
+			unsigned long long vmsize = strtoull(&procBuffer[0], &pos, 10);
+			unsigned long long rss = strtoull(pos, NULL, 10);
+			metrics.vmsize = vmsize * pageSizeKb;
+			metrics.rss = rss * pageSizeKb;
+			return true;
+		}
+
+		/**
+		 * Parses the effective UID from /proc/<pid>/status. We cannot use the
+		 * owner of /proc/<pid> for this: it is root for processes that have
+		 * switched users, because those are not dumpable.
+		 */
+		bool readProcStatus(int pidFd, ProcessMetrics &metrics) const {
+			if (readProcFile(pidFd, "status") <= 0) {
+				return false;
+			}
+
+			const char *pos = strstr(&procBuffer[0], "\nUid:");
+			if (pos == NULL) {
+				return false;
+			}
+			pos += sizeof("\nUid:") - 1;
+
+			// The real UID, followed by the effective UID, separated by tabs.
+			char *end;
+			strtoll(pos, &end, 10);
+			if (end == pos) {
+				return false;
+			}
+			pos = end;
+			long long uid = strtoll(pos, &end, 10);
+			if (end == pos) {
+				return false;
+			}
+			metrics.uid = (uid_t) uid;
+			return true;
+		}
+
+		/**
+		 * Reads /proc/<pid>/cmdline, in which arguments are separated by NULs.
+		 * Kernel threads and zombies have an empty command line, in which case
+		 * `metrics.command` keeps the "[name]" from readProcStat(), just like 'ps'.
+		 */
+		void readProcCmdline(int pidFd, ProcessMetrics &metrics) const {
+			ssize_t size = readProcFile(pidFd, "cmdline");
+			while (size > 0 && procBuffer[size - 1] == '\0') {
+				size--;
+			}
+			if (size <= 0) {
+				return;
+			}
+
+			for (ssize_t i = 0; i < size; i++) {
+				if (procBuffer[i] == '\0') {
+					procBuffer[i] = ' ';
+				}
+			}
+			metrics.command.assign(&procBuffer[0], size);
+		}
+
+		/**
+		 * Reads the PSS, private dirty RSS and swap from /proc/<pid>/smaps_rollup,
+		 * which the kernel sums up for us. This is a lot cheaper than reading
+		 * /proc/<pid>/smaps, which can be megabytes for large processes.
+		 */
+		void readProcRealMemory(int pidFd, ProcessMetrics &metrics) const {
+			ssize_t size = readProcFile(pidFd, "smaps_rollup");
+			if (size == -1) {
+				if (errno == ENOENT) {
+					// smaps_rollup is only available since Linux 4.14.
+					measureRealMemory(metrics.pid, metrics.pss,
+						metrics.privateDirty, metrics.swap);
+				}
+				return;
+			}
+
+			SmapsTotals totals;
+			const char *line = &procBuffer[0];
+			while (line != NULL && *line != '\0') {
+				if (!totals.addLine(line)) {
+					return;
+				}
+				line = strchr(line, '\n');
+				if (line != NULL) {
+					line++;
+				}
+			}
+			totals.get(metrics.pss, metrics.privateDirty, metrics.swap);
+		}
+
+		template<typename Collection, typename ConstIterator>
+		ProcessMetricMap collectFromProc(const Collection &pids) const {
+			ProcessMetricMap result;
+			ConstIterator it;
+			double uptime = -1;
+			char pidStr[sizeof(long long) * 3 + 1];
+
+			if (readProcFile(procFd, "uptime") > 0) {
+				uptime = strtod(&procBuffer[0], NULL);
+			}
+
+			for (it = pids.begin(); it != pids.end(); it++) {
+				snprintf(pidStr, sizeof(pidStr), "%lld", (long long) *it);
+
+				// Reading all files relative to the /proc/<pid> directory
+				// guarantees that they all describe the same process, even
+				// if the PID is reused in the meantime.
+				int pidFd = syscalls::openat(procFd, pidStr,
+					O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+				if (pidFd == -1) {
+					// The process does not exist (anymore).
+					continue;
+				}
+
+				FdGuard guard(pidFd, __FILE__, __LINE__);
+				ProcessMetrics metrics;
+				metrics.pid = *it;
+				if (!readProcStat(pidFd, uptime, metrics)
+				 || !readProcStatm(pidFd, metrics)
+				 || !readProcStatus(pidFd, metrics))
+				{
+					// The process exited while we were reading its information.
+					continue;
+				}
+				readProcCmdline(pidFd, metrics);
+				if (canMeasureRealMemory) {
+					readProcRealMemory(pidFd, metrics);
+				}
+				result[metrics.pid] = metrics;
+			}
+
+			return result;
+		}
+	#endif
+
 	template<typename Collection, typename ConstIterator>
 	ProcessMetricMap parsePsOutput(const string &output, const Collection &allowedPids) const {
 		ProcessMetricMap result;
@@ -268,6 +624,21 @@ public:
 		#else
 			canMeasureRealMemory = fileExists("/proc/self/smaps");
 		#endif
+		nativeCollectionEnabled = true;
+		#ifdef __linux__
+			procFd = -1;
+			clockTicksPerSecond = sysconf(_SC_CLK_TCK);
+			pageSizeKb = sysconf(_SC_PAGESIZE) / 1024;
+		#endif
+	}
+
+	~ProcessMetricsCollector() {
+		#ifdef __linux__
+			if (procFd >= 0) {
+				safelyClose(procFd, true);
+				P_LOG_FILE_DESCRIPTOR_CLOSE(procFd);
+			}
+		#endif
 	}
 
 	/** Mock 'ps' output, used by unit tests. */
@@ -275,6 +646,27 @@ public:
 		this->psOutput = data;
 	}
 
+	/**
+	 * Whether to read metrics directly from /proc where supported, instead of
+	 * running 'ps'. Enabled by default; unit tests and benchmarks disable this
+	 * in order to exercise the 'ps' code path.
+	 */
+	void setNativeCollectionEnabled(bool enabled) {
+		nativeCollectionEnabled = enabled;
+	}
+
+	/**
+	 * Whether collect() reads metrics directly from /proc instead of
+	 * running 'ps'.
+	 */
+	bool usesNativeCollection() const {
+		#ifdef __linux__
+			return nativeCollectionEnabled && psOutput.empty() && openProcDir();
+		#else
+			return false;
+		#endif
+	}
+
 	/**
 	 * Collect metrics for the given process IDs. Nonexistant PIDs are not
 	 * included in the result.
@@ -290,6 +682,12 @@ public:
 			return ProcessMetricMap();
 		}
 
+		#ifdef __linux__
+			if (usesNativeCollection()) {
+				return collectFromProc<Collection, ConstIterator>(pids);
+			}
+		#endif
+
 		ConstIterator it;
 		// The list of PIDs must follow -p without a space.
 		// https://groups.google.com/forum/#!topic/phusion-passenger/WKXy61nJBMA
@@ -438,14 +836,7 @@ public:
 			}
 
 			StdioGuard guard(f, NULL, 0);
-			bool hasPss = false;
-			bool hasPrivateDirty = false;
-			bool hasSwap = false;
-
-			// In KB.
-			pss = 0;
-			privateDirty = 0;
-			swap = 0;
+			SmapsTotals totals;
 
 			while (!feof(f)) {
 				char line[1024 * 4];
@@ -459,46 +850,12 @@ public:
 						break;
 					}
 				}
-				try {
-					if (startsWith(line, "Pss:")) {
-						/* Linux supports Proportional Set Size since kernel 2.6.25.
-						 * See kernel commit ec4dd3eb35759f9fbeb5c1abb01403b2fde64cc9.
-						 */
-						hasPss = true;
-						readNextWord(&buf);
-						pss += readNextWordAsLongLong(&buf);
-						if (readNextWord(&buf) != "kB") {
-							goto error;
-						}
-					} else if (startsWith(line, "Private_Dirty:")) {
-						hasPrivateDirty = true;
-						readNextWord(&buf);
-						privateDirty += readNextWordAsLongLong(&buf);
-						if (readNextWord(&buf) != "kB") {
-							goto error;
-						}
-					} else if (startsWith(line, "Swap:")) {
-						hasSwap = true;
-						readNextWord(&buf);
-						swap += readNextWordAsLongLong(&buf);
-						if (readNextWord(&buf) != "kB") {
-							goto error;
-						}
-					}
-				} catch (const ParseException &) {
+				if (!totals.addLine(line)) {
 					goto error;
 				}
 			}
 
-			if (!hasPss) {
-				pss = -1;
-			}
-			if (!hasPrivateDirty) {
-				privateDirty = -1;
-			}
-			if (!hasSwap) {
-				swap = -1;
-			}
+			totals.get(pss, privateDirty, swap);
 		#endif
 	}
 };
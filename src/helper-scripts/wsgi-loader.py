@@ -37,7 +37,7 @@ def try_write_file(path, contents):
 		with open(path, 'w') as f:
 			f.write(contents)
 	except IOError as e:
-		logging.warn('Warning: unable to write to ' + path + ': ' + e.message)
+		logging.warn('Warning: unable to write to ' + path + ': ' + str(e))
 
 def initialize_logging():
 	logging.basicConfig(
@@ -54,14 +54,14 @@ def read_startup_arguments():
 	with open(path, 'r') as f:
 		options = json.load(f)
 
-def record_journey_step_begin(step, state):
-	work_dir = os.getenv('PASSENGER_SPAWN_WORK_DIR')
+def record_journey_step_begin(step, state, work_dir = None):
+	work_dir = work_dir or os.getenv('PASSENGER_SPAWN_WORK_DIR')
 	step_dir = work_dir + '/response/steps/' + step.lower()
 	try_write_file(step_dir + '/state', state)
 	try_write_file(step_dir + '/begin_time', str(time.time()))
 
-def record_journey_step_end(step, state):
-	work_dir = os.getenv('PASSENGER_SPAWN_WORK_DIR')
+def record_journey_step_end(step, state, work_dir = None):
+	work_dir = work_dir or os.getenv('PASSENGER_SPAWN_WORK_DIR')
 	step_dir = work_dir + '/response/steps/' + step.lower()
 	try_write_file(step_dir + '/state', state)
 	if not os.path.exists(step_dir + '/begin_time') and not os.path.exists(step_dir + '/begin_time_monotonic'):
@@ -75,16 +75,15 @@ def load_app():
 	startup_file = options.get('startup_file', 'passenger_wsgi.py')
 	return imp.load_source('passenger_wsgi', startup_file)
 
-def create_server_socket():
+def create_server_socket(socket_prefix = 'wsgi', tmp_socket_prefix = 'PsgWsgiApp'):
 	global options
 
 	UNIX_PATH_MAX = int(options.get('UNIX_PATH_MAX', 100))
 	if 'socket_dir' in options:
 		socket_dir = options['socket_dir']
-		socket_prefix = 'wsgi'
 	else:
 		socket_dir = tempfile.gettempdir()
-		socket_prefix = 'PsgWsgiApp'
+		socket_prefix = tmp_socket_prefix
 
 	i = 0
 	while i < 128:
@@ -128,7 +127,7 @@ def debug_and_exit(sig, frame):
 	# handler and no SIGQUIT handler.
 	signal.signal(signal.SIGABRT, debug_and_exit)
 
-def advertise_sockets(socket_filename):
+def advertise_sockets(socket_filename, handler):
 	work_dir = os.getenv('PASSENGER_SPAWN_WORK_DIR')
 	path = work_dir + '/response/properties.json'
 	doc = {
@@ -137,7 +136,7 @@ def advertise_sockets(socket_filename):
 				'name': 'main',
 				'address': 'unix:' + socket_filename,
 				'protocol': 'session',
-				'concurrency': 1,
+				'concurrency': handler.concurrency,
 				'accept_http_requests': True
 			}
 		]
@@ -174,7 +173,20 @@ def str_to_bytes(s):
 		return s
 
 
+def create_request_handler(server_socket, owner_pipe, app):
+	global options
+
+	thread_count = int(options.get('python_thread_count', 1))
+	if thread_count > 1:
+		return ThreadedRequestHandler(server_socket, owner_pipe, app, thread_count)
+	else:
+		return RequestHandler(server_socket, owner_pipe, app)
+
+
 class RequestHandler:
+	concurrency = 1
+	multithread = False
+
 	def __init__(self, server_socket, owner_pipe, app):
 		self.server = server_socket
 		self.owner_pipe = owner_pipe
@@ -188,38 +200,45 @@ def main_loop(self):
 				if not client:
 					done = True
 					break
-				socket_hijacked = False
-				try:
-					try:
-						env, input_stream = self.parse_request(client)
-						if env:
-							if env['REQUEST_METHOD'] == 'ping':
-								self.process_ping(env, input_stream, client)
-							else:
-								socket_hijacked = self.process_request(env, input_stream, client)
-					except KeyboardInterrupt:
-						done = True
-					except IOError:
-						e = sys.exc_info()[1]
-						if not getattr(e, 'passenger', False) or e.errno != errno.EPIPE:
-							logging.exception("WSGI application raised an I/O exception!")
-					except Exception:
-						logging.exception("WSGI application raised an exception!")
-				finally:
-					if not socket_hijacked:
-						try:
-							# Shutdown the socket like this just in case the app
-							# spawned a child process that keeps it open.
-							client.shutdown(socket.SHUT_WR)
-						except:
-							pass
-						try:
-							client.close()
-						except:
-							pass
+				done = self.handle_connection(client)
 		except KeyboardInterrupt:
 			pass
 
+	# Handles the request on the given client connection, then closes it.
+	# Returns whether the main loop should stop.
+	def handle_connection(self, client):
+		done = False
+		socket_hijacked = False
+		try:
+			try:
+				env, input_stream = self.parse_request(client)
+				if env:
+					if env['REQUEST_METHOD'] == 'ping':
+						self.process_ping(env, input_stream, client)
+					else:
+						socket_hijacked = self.process_request(env, input_stream, client)
+			except KeyboardInterrupt:
+				done = True
+			except IOError:
+				e = sys.exc_info()[1]
+				if not getattr(e, 'passenger', False) or e.errno != errno.EPIPE:
+					logging.exception("WSGI application raised an I/O exception!")
+			except Exception:
+				logging.exception("WSGI application raised an exception!")
+		finally:
+			if not socket_hijacked:
+				try:
+					# Shutdown the socket like this just in case the app
+					# spawned a child process that keeps it open.
+					client.shutdown(socket.SHUT_WR)
+				except:
+					pass
+				try:
+					client.close()
+				except:
+					pass
+		return done
+
 	def accept_connection(self):
 		result = select.select([self.owner_pipe, self.server.fileno()], [], [])[0]
 		if self.server.fileno() in result:
@@ -271,7 +290,7 @@ def process_request(self, env, input_stream, output_stream):
 		env['wsgi.input']        = self.wrap_input_socket(input_stream)
 		env['wsgi.errors']       = sys.stderr
 		env['wsgi.version']      = (1, 0)
-		env['wsgi.multithread']  = False
+		env['wsgi.multithread']  = self.multithread
 		env['wsgi.multiprocess'] = True
 		env['wsgi.run_once']	 = False
 		if env.get('HTTPS','off') in ('on', '1', 'true', 'yes'):
@@ -351,6 +370,85 @@ def process_ping(self, env, input_stream, output_stream):
 		output_stream.sendall(b"pong")
 
 
+# Handles requests concurrently with a fixed number of worker threads, which
+# all accept connections on the same server socket. The main thread only waits
+# for the owner pipe to close. The process advertises the number of threads
+# as its concurrency, so that Passenger routes that many requests to it at
+# the same time.
+class ThreadedRequestHandler(RequestHandler):
+	multithread = True
+	ACCEPT_ERROR_BACKOFF_TIME = 0.5
+
+	def __init__(self, server_socket, owner_pipe, app, thread_count):
+		RequestHandler.__init__(self, server_socket, owner_pipe, app)
+		self.concurrency = thread_count
+		self.shutdown_pipe = os.pipe()
+		self.failure_pipe = os.pipe()
+
+	def main_loop(self):
+		# Multiple threads wait for the server socket to become readable,
+		# but only one of them gets the connection. The others must not
+		# block in accept().
+		self.server.setblocking(False)
+
+		threads = []
+		for i in range(self.concurrency):
+			thread = threading.Thread(target = self.worker_loop,
+				name = 'Worker ' + str(i + 1))
+			thread.daemon = True
+			thread.start()
+			threads.append(thread)
+
+		try:
+			try:
+				result = select.select([self.owner_pipe, self.failure_pipe[0]], [], [])[0]
+				if self.failure_pipe[0] in result:
+					# We advertised a concurrency that we can no longer
+					# provide, so exit and let Passenger replace us.
+					logging.error('A worker thread cannot accept connections anymore; shutting down')
+			except KeyboardInterrupt:
+				pass
+		finally:
+			# Closing the write end wakes up all worker threads. They stop
+			# after finishing the request that they're handling.
+			os.close(self.shutdown_pipe[1])
+			for thread in threads:
+				thread.join()
+			os.close(self.shutdown_pipe[0])
+			os.close(self.failure_pipe[0])
+			os.close(self.failure_pipe[1])
+
+	def worker_loop(self):
+		while True:
+			result = select.select([self.shutdown_pipe[0], self.server.fileno()], [], [])[0]
+			if self.shutdown_pipe[0] in result:
+				break
+			try:
+				client, address = self.server.accept()
+			except socket.error:
+				e = sys.exc_info()[1]
+				if e.errno in (errno.EAGAIN, errno.EWOULDBLOCK, errno.EINTR):
+					# Another worker thread got the connection.
+					continue
+				elif e.errno == errno.ECONNABORTED:
+					# The client went away before we accepted the connection.
+					continue
+				elif e.errno in (errno.EMFILE, errno.ENFILE, errno.ENOBUFS, errno.ENOMEM):
+					# Resources may become available again once other worker
+					# threads finish their requests. Back off instead of
+					# spinning on the readable server socket.
+					logging.warning('Cannot accept a connection (%s); retrying in %s seconds',
+						e, self.ACCEPT_ERROR_BACKOFF_TIME)
+					select.select([self.shutdown_pipe[0]], [], [], self.ACCEPT_ERROR_BACKOFF_TIME)
+					continue
+				else:
+					logging.exception('Cannot accept a connection')
+					os.write(self.failure_pipe[1], b'x')
+					break
+			client.setblocking(True)
+			self.handle_connection(client)
+
+
 if __name__ == "__main__":
 	initialize_logging()
 	record_journey_step_end('SUBPROCESS_EXEC_WRAPPER', 'STEP_PERFORMED')
@@ -378,8 +476,8 @@ def process_ping(self, env, input_stream, output_stream):
 	try:
 		socket_filename, server_socket = create_server_socket()
 		install_signal_handlers()
-		handler = RequestHandler(server_socket, sys.stdin, app_module.application)
-		advertise_sockets(socket_filename)
+		handler = create_request_handler(server_socket, sys.stdin, app_module.application)
+		advertise_sockets(socket_filename, handler)
 	except Exception:
 		record_journey_step_end('SUBPROCESS_LISTEN', 'STEP_ERRORED')
 		raise
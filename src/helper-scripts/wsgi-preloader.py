@@ -0,0 +1,238 @@
+#!/usr/bin/env python
+#  Phusion Passenger - https://www.phusionpassenger.com/
+#  Copyright (c) 2021 Phusion Holding B.V.
+#
+#  "Passenger", "Phusion Passenger" and "Union Station" are registered
+#  trademarks of Phusion Holding B.V.
+#
+#  Permission is hereby granted, free of charge, to any person obtaining a copy
+#  of this software and associated documentation files (the "Software"), to deal
+#  in the Software without restriction, including without limitation the rights
+#  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#  copies of the Software, and to permit persons to whom the Software is
+#  furnished to do so, subject to the following conditions:
+#
+#  The above copyright notice and this permission notice shall be included in
+#  all copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#  THE SOFTWARE.
+
+# Preloader for WSGI apps, used by the smart spawn method. It loads the app
+# once, then forks a new app process for every 'spawn' command that it
+# receives on its command socket. This speaks the same protocol as
+# rack-preloader.rb; the forked processes are handled by wsgi-loader.py's
+# request handler.
+
+import sys, os, imp, gc, signal, traceback, socket, select, json
+
+loader = imp.load_source('passenger_wsgi_loader',
+	os.path.join(os.path.dirname(os.path.abspath(__file__)), 'wsgi-loader.py'))
+
+def advertise_sockets(socket_filename):
+	work_dir = os.getenv('PASSENGER_SPAWN_WORK_DIR')
+	path = work_dir + '/response/properties.json'
+	doc = {
+		'sockets': [
+			{
+				'name': 'main',
+				'address': 'unix:' + socket_filename,
+				'protocol': 'preloader',
+				'concurrency': 1
+			}
+		]
+	}
+	with open(path, 'w') as f:
+		json.dump(doc, f)
+
+def write_response(client, doc):
+	client.sendall(loader.str_to_bytes(json.dumps(doc) + "\n"))
+
+def accept_and_process_next_client(server_socket):
+	client, address = server_socket.accept()
+	try:
+		f = client.makefile('rb')
+		try:
+			line = f.readline()
+		finally:
+			f.close()
+		if len(line) == 0:
+			return None
+
+		try:
+			doc = json.loads(loader.bytes_to_str(line))
+		except ValueError as e:
+			write_response(client, {
+				'result': 'error',
+				'message': 'JSON parse error: ' + str(e)
+			})
+			return None
+
+		if doc.get('command') == 'spawn':
+			return handle_spawn_command(client, doc)
+		else:
+			write_response(client, {
+				'result': 'error',
+				'message': 'Unknown command ' + repr(doc.get('command'))
+			})
+			return None
+	finally:
+		client.close()
+
+def handle_spawn_command(client, doc):
+	work_dir = doc['work_dir']
+	loader.record_journey_step_end('PRELOADER_PREPARATION',
+		'STEP_PERFORMED', work_dir)
+	loader.record_journey_step_begin('PRELOADER_FORK_SUBPROCESS',
+		'STEP_IN_PROGRESS', work_dir)
+
+	try:
+		pid = os.fork()
+	except OSError:
+		loader.record_journey_step_end('PRELOADER_FORK_SUBPROCESS',
+			'STEP_ERRORED', work_dir)
+		raise
+
+	if pid == 0:
+		try:
+			signal.signal(signal.SIGCHLD, signal.SIG_DFL)
+			loader.record_journey_step_end('PRELOADER_FORK_SUBPROCESS',
+				'STEP_PERFORMED', work_dir)
+			loader.record_journey_step_begin('PRELOADER_SEND_RESPONSE',
+				'STEP_IN_PROGRESS', work_dir)
+			write_response(client, { 'result': 'ok', 'pid': os.getpid() })
+			loader.record_journey_step_end('PRELOADER_SEND_RESPONSE',
+				'STEP_PERFORMED', work_dir)
+			loader.record_journey_step_end('PRELOADER_FINISH',
+				'STEP_PERFORMED', work_dir)
+			return work_dir
+		except BaseException:
+			traceback.print_exc()
+			os._exit(1)
+	else:
+		return None
+
+def freeze_loaded_objects():
+	# Improve copy-on-write friendliness. Everything that survived app
+	# loading is moved to the permanent generation, so that the collector
+	# in the forked processes never writes to (and thus copies) those pages.
+	# This only needs to happen once: objects the preloader allocates while
+	# serving spawn commands are few and short-lived.
+	gc.collect()
+	if hasattr(gc, 'freeze'):
+		gc.freeze()
+
+def run_main_loop(server_socket, socket_filename):
+	original_pid = os.getpid()
+	# Forked processes are not waited for by anyone but us, so let the
+	# kernel reap them.
+	signal.signal(signal.SIGCHLD, signal.SIG_IGN)
+	try:
+		while True:
+			result = select.select([server_socket, sys.stdin], [], [])[0]
+			if server_socket in result:
+				subprocess_work_dir = accept_and_process_next_client(server_socket)
+				if subprocess_work_dir is not None:
+					return subprocess_work_dir
+			if sys.stdin in result:
+				return None
+	finally:
+		server_socket.close()
+		if os.getpid() == original_pid:
+			try:
+				os.remove(socket_filename)
+			except OSError:
+				pass
+
+def reinitialize_std_channels(work_dir):
+	if os.path.exists(work_dir + '/stdin'):
+		fd = os.open(work_dir + '/stdin', os.O_RDONLY)
+		os.dup2(fd, 0)
+		os.close(fd)
+	if os.path.exists(work_dir + '/stdout_and_err'):
+		sys.stdout.flush()
+		sys.stderr.flush()
+		fd = os.open(work_dir + '/stdout_and_err', os.O_WRONLY)
+		os.dup2(fd, 1)
+		os.dup2(fd, 2)
+		os.close(fd)
+
+def negotiate_spawn_command(work_dir, app):
+	os.environ['PASSENGER_SPAWN_WORK_DIR'] = work_dir
+	loader.read_startup_arguments()
+	reinitialize_std_channels(work_dir)
+
+	loader.record_journey_step_begin('SUBPROCESS_PREPARE_AFTER_FORKING_FROM_PRELOADER',
+		'STEP_IN_PROGRESS')
+	loader.record_journey_step_end('SUBPROCESS_PREPARE_AFTER_FORKING_FROM_PRELOADER',
+		'STEP_PERFORMED')
+
+	loader.record_journey_step_begin('SUBPROCESS_LISTEN', 'STEP_IN_PROGRESS')
+	try:
+		socket_filename, server_socket = loader.create_server_socket()
+		handler = loader.create_request_handler(server_socket, sys.stdin, app)
+		loader.advertise_sockets(socket_filename, handler)
+	except Exception:
+		loader.record_journey_step_end('SUBPROCESS_LISTEN', 'STEP_ERRORED')
+		raise
+	else:
+		loader.record_journey_step_end('SUBPROCESS_LISTEN', 'STEP_PERFORMED')
+
+	loader.advertise_readiness()
+	return (socket_filename, handler)
+
+
+if __name__ == "__main__":
+	loader.initialize_logging()
+	loader.record_journey_step_end('SUBPROCESS_EXEC_WRAPPER', 'STEP_PERFORMED')
+	loader.record_journey_step_begin('SUBPROCESS_WRAPPER_PREPARATION', 'STEP_IN_PROGRESS')
+	try:
+		loader.read_startup_arguments()
+	except Exception:
+		loader.record_journey_step_end('SUBPROCESS_WRAPPER_PREPARATION', 'STEP_ERRORED')
+		raise
+	else:
+		loader.record_journey_step_end('SUBPROCESS_WRAPPER_PREPARATION', 'STEP_PERFORMED')
+
+
+	loader.record_journey_step_begin('SUBPROCESS_APP_LOAD_OR_EXEC', 'STEP_IN_PROGRESS')
+	try:
+		app_module = loader.load_app()
+	except Exception:
+		loader.record_journey_step_end('SUBPROCESS_APP_LOAD_OR_EXEC', 'STEP_ERRORED')
+		raise
+	else:
+		loader.record_journey_step_end('SUBPROCESS_APP_LOAD_OR_EXEC', 'STEP_PERFORMED')
+
+	freeze_loaded_objects()
+
+
+	loader.record_journey_step_begin('SUBPROCESS_LISTEN', 'STEP_IN_PROGRESS')
+	try:
+		preloader_socket_filename, preloader_socket = loader.create_server_socket(
+			'preloader', 'PsgPreloader')
+		loader.install_signal_handlers()
+		advertise_sockets(preloader_socket_filename)
+	except Exception:
+		loader.record_journey_step_end('SUBPROCESS_LISTEN', 'STEP_ERRORED')
+		raise
+	else:
+		loader.record_journey_step_end('SUBPROCESS_LISTEN', 'STEP_PERFORMED')
+
+
+	loader.advertise_readiness()
+	subprocess_work_dir = run_main_loop(preloader_socket, preloader_socket_filename)
+	if subprocess_work_dir is not None:
+		# Inside forked subprocess
+		socket_filename, handler = negotiate_spawn_command(subprocess_work_dir,
+			app_module.application)
+		handler.main_loop()
+		try:
+			os.remove(socket_filename)
+		except OSError:
+			pass
@@ -118,6 +118,14 @@
     offsetof(passenger_main_conf_t, autogenerated.socket_backlog),
     NULL
 },
+{
+    ngx_string("passenger_core_keepalive"),
+    NGX_HTTP_MAIN_CONF | NGX_CONF_TAKE1,
+    passenger_conf_set_core_keepalive,
+    NGX_HTTP_MAIN_CONF_OFFSET,
+    offsetof(passenger_main_conf_t, autogenerated.core_keepalive),
+    NULL
+},
 {
     ngx_string("passenger_core_file_descriptor_ulimit"),
     NGX_HTTP_MAIN_CONF | NGX_CONF_TAKE1,
@@ -318,6 +326,14 @@
     offsetof(passenger_loc_conf_t, autogenerated.python),
     NULL
 },
+{
+    ngx_string("passenger_python_thread_count"),
+    NGX_HTTP_MAIN_CONF | NGX_HTTP_SRV_CONF | NGX_HTTP_LOC_CONF | NGX_HTTP_LIF_CONF | NGX_CONF_TAKE1,
+    passenger_conf_set_python_thread_count,
+    NGX_HTTP_LOC_CONF_OFFSET,
+    offsetof(passenger_loc_conf_t, autogenerated.python_thread_count),
+    NULL
+},
 {
     ngx_string("passenger_nodejs"),
     NGX_HTTP_MAIN_CONF | NGX_HTTP_SRV_CONF | NGX_HTTP_LOC_CONF | NGX_HTTP_LIF_CONF | NGX_CONF_TAKE1,
@@ -518,6 +534,38 @@
     offsetof(passenger_loc_conf_t, autogenerated.force_max_concurrent_requests_per_process),
     NULL
 },
+{
+    ngx_string("passenger_spawn_concurrency"),
+    NGX_HTTP_MAIN_CONF | NGX_HTTP_SRV_CONF | NGX_HTTP_LOC_CONF | NGX_HTTP_LIF_CONF | NGX_CONF_TAKE1,
+    passenger_conf_set_spawn_concurrency,
+    NGX_HTTP_LOC_CONF_OFFSET,
+    offsetof(passenger_loc_conf_t, autogenerated.spawn_concurrency),
+    NULL
+},
+{
+    ngx_string("passenger_standby_processes"),
+    NGX_HTTP_MAIN_CONF | NGX_HTTP_SRV_CONF | NGX_HTTP_LOC_CONF | NGX_HTTP_LIF_CONF | NGX_CONF_TAKE1,
+    passenger_conf_set_standby_processes,
+    NGX_HTTP_LOC_CONF_OFFSET,
+    offsetof(passenger_loc_conf_t, autogenerated.standby_processes),
+    NULL
+},
+{
+    ngx_string("passenger_routing_method"),
+    NGX_HTTP_MAIN_CONF | NGX_HTTP_SRV_CONF | NGX_HTTP_LOC_CONF | NGX_HTTP_LIF_CONF | NGX_CONF_TAKE1,
+    passenger_conf_set_routing_method,
+    NGX_HTTP_LOC_CONF_OFFSET,
+    offsetof(passenger_loc_conf_t, autogenerated.routing_method),
+    NULL
+},
+{
+    ngx_string("passenger_max_memory"),
+    NGX_HTTP_MAIN_CONF | NGX_HTTP_SRV_CONF | NGX_HTTP_LOC_CONF | NGX_HTTP_LIF_CONF | NGX_CONF_TAKE1,
+    passenger_conf_set_max_memory,
+    NGX_HTTP_LOC_CONF_OFFSET,
+    offsetof(passenger_loc_conf_t, autogenerated.max_memory),
+    NULL
+},
 {
     ngx_string("passenger_enabled"),
     NGX_HTTP_MAIN_CONF | NGX_HTTP_SRV_CONF | NGX_HTTP_LOC_CONF | NGX_HTTP_LIF_CONF | NGX_CONF_FLAG,
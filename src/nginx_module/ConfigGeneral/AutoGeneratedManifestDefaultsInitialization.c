@@ -80,6 +80,12 @@ set_manifest_autogenerated_global_conf_defaults(manifest_gen_ctx_t *ctx) {
         sizeof("passenger_socket_backlog") - 1,
         2048);
 
+    add_manifest_options_container_static_default_uint(ctx,
+        ctx->global_config_container,
+        "passenger_core_keepalive",
+        sizeof("passenger_core_keepalive") - 1,
+        0);
+
     add_manifest_options_container_dynamic_default(ctx,
         ctx->global_config_container,
         "passenger_core_file_descriptor_ulimit",
@@ -200,6 +206,12 @@ set_manifest_autogenerated_app_conf_defaults(manifest_gen_ctx_t *ctx, PsgJsonVal
         "python",
         sizeof("python") - 1);
 
+    add_manifest_options_container_static_default_uint(ctx,
+        options_container,
+        "passenger_python_thread_count",
+        sizeof("passenger_python_thread_count") - 1,
+        1);
+
     add_manifest_options_container_static_default_str(ctx,
         options_container,
         "passenger_nodejs",
@@ -332,6 +344,31 @@ set_manifest_autogenerated_app_conf_defaults(manifest_gen_ctx_t *ctx, PsgJsonVal
         sizeof("passenger_force_max_concurrent_requests_per_process") - 1,
         -1);
 
+    add_manifest_options_container_static_default_uint(ctx,
+        options_container,
+        "passenger_spawn_concurrency",
+        sizeof("passenger_spawn_concurrency") - 1,
+        1);
+
+    add_manifest_options_container_static_default_uint(ctx,
+        options_container,
+        "passenger_standby_processes",
+        sizeof("passenger_standby_processes") - 1,
+        0);
+
+    add_manifest_options_container_static_default_str(ctx,
+        options_container,
+        "passenger_routing_method",
+        sizeof("passenger_routing_method") - 1,
+        "least_busy",
+        sizeof("least_busy") - 1);
+
+    add_manifest_options_container_static_default_uint(ctx,
+        options_container,
+        "passenger_max_memory",
+        sizeof("passenger_max_memory") - 1,
+        0);
+
     add_manifest_options_container_dynamic_default(ctx,
         options_container,
         "passenger_app_log_file",
@@ -193,6 +193,18 @@ passenger_conf_set_socket_backlog(ngx_conf_t *cf, ngx_command_t *cmd, void *conf
     return ngx_conf_set_num_slot(cf, cmd, conf);
 }
 
+static char *
+passenger_conf_set_core_keepalive(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
+    passenger_main_conf_t *passenger_conf = conf;
+
+    passenger_conf->autogenerated.core_keepalive_explicitly_set = 1;
+    record_main_conf_source_location(cf,
+        &passenger_conf->autogenerated.core_keepalive_source_file,
+        &passenger_conf->autogenerated.core_keepalive_source_line);
+
+    return ngx_conf_set_num_slot(cf, cmd, conf);
+}
+
 static char *
 passenger_conf_set_core_file_descriptor_ulimit(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
     passenger_main_conf_t *passenger_conf = conf;
@@ -493,6 +505,18 @@ passenger_conf_set_python(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
     return ngx_conf_set_str_slot(cf, cmd, conf);
 }
 
+static char *
+passenger_conf_set_python_thread_count(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
+    passenger_loc_conf_t *passenger_conf = conf;
+
+    passenger_conf->autogenerated.python_thread_count_explicitly_set = 1;
+    record_loc_conf_source_location(cf, passenger_conf,
+        &passenger_conf->autogenerated.python_thread_count_source_file,
+        &passenger_conf->autogenerated.python_thread_count_source_line);
+
+    return ngx_conf_set_num_slot(cf, cmd, conf);
+}
+
 static char *
 passenger_conf_set_nodejs(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
     passenger_loc_conf_t *passenger_conf = conf;
@@ -793,6 +817,54 @@ passenger_conf_set_force_max_concurrent_requests_per_process(ngx_conf_t *cf, ngx
     return ngx_conf_set_num_slot(cf, cmd, conf);
 }
 
+static char *
+passenger_conf_set_spawn_concurrency(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
+    passenger_loc_conf_t *passenger_conf = conf;
+
+    passenger_conf->autogenerated.spawn_concurrency_explicitly_set = 1;
+    record_loc_conf_source_location(cf, passenger_conf,
+        &passenger_conf->autogenerated.spawn_concurrency_source_file,
+        &passenger_conf->autogenerated.spawn_concurrency_source_line);
+
+    return ngx_conf_set_num_slot(cf, cmd, conf);
+}
+
+static char *
+passenger_conf_set_standby_processes(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
+    passenger_loc_conf_t *passenger_conf = conf;
+
+    passenger_conf->autogenerated.standby_processes_explicitly_set = 1;
+    record_loc_conf_source_location(cf, passenger_conf,
+        &passenger_conf->autogenerated.standby_processes_source_file,
+        &passenger_conf->autogenerated.standby_processes_source_line);
+
+    return ngx_conf_set_num_slot(cf, cmd, conf);
+}
+
+static char *
+passenger_conf_set_routing_method(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
+    passenger_loc_conf_t *passenger_conf = conf;
+
+    passenger_conf->autogenerated.routing_method_explicitly_set = 1;
+    record_loc_conf_source_location(cf, passenger_conf,
+        &passenger_conf->autogenerated.routing_method_source_file,
+        &passenger_conf->autogenerated.routing_method_source_line);
+
+    return ngx_conf_set_str_slot(cf, cmd, conf);
+}
+
+static char *
+passenger_conf_set_max_memory(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
+    passenger_loc_conf_t *passenger_conf = conf;
+
+    passenger_conf->autogenerated.max_memory_explicitly_set = 1;
+    record_loc_conf_source_location(cf, passenger_conf,
+        &passenger_conf->autogenerated.max_memory_source_file,
+        &passenger_conf->autogenerated.max_memory_source_line);
+
+    return ngx_conf_set_num_slot(cf, cmd, conf);
+}
+
 static char *
 passenger_conf_set_max_requests(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
     passenger_loc_conf_t *passenger_conf = conf;
@@ -102,11 +102,22 @@ passenger_init_main_conf(ngx_conf_t *cf, void *conf_pointer)
     passenger_main_conf_t *conf;
     struct passwd         *user_entry;
     struct group          *group_entry;
+    ngx_pool_cleanup_t    *location_configs_cleanup;
     char buf[128];
 
     conf = &passenger_main_conf;
     *conf = *((passenger_main_conf_t *) conf_pointer);
 
+    conf->location_configs = psg_json_value_new_with_type(PSG_JSON_VALUE_TYPE_ARRAY);
+    location_configs_cleanup = ngx_pool_cleanup_add(cf->pool, 0);
+    if (location_configs_cleanup == NULL) {
+        psg_json_value_free(conf->location_configs);
+        conf->location_configs = NULL;
+        return NGX_CONF_ERROR;
+    }
+    location_configs_cleanup->handler = (ngx_pool_cleanup_pt) psg_json_value_free;
+    location_configs_cleanup->data = conf->location_configs;
+
     if (conf->autogenerated.abort_on_startup_error == NGX_CONF_UNSET) {
         conf->autogenerated.abort_on_startup_error = 0;
     }
@@ -115,6 +126,10 @@ passenger_init_main_conf(ngx_conf_t *cf, void *conf_pointer)
         conf->autogenerated.show_version_in_header = 1;
     }
 
+    if (conf->autogenerated.core_keepalive == NGX_CONF_UNSET_UINT) {
+        conf->autogenerated.core_keepalive = 0;
+    }
+
     if (conf->autogenerated.default_user.len == 0) {
         conf->autogenerated.default_user.len  = sizeof(DEFAULT_WEB_APP_USER) - 1;
         conf->autogenerated.default_user.data = (u_char *) DEFAULT_WEB_APP_USER;
@@ -266,10 +281,81 @@ passenger_create_loc_conf(ngx_conf_t *cf)
     conf->options_cache.len   = 0;
     conf->env_vars_cache.data = NULL;
     conf->env_vars_cache.len  = 0;
+    conf->location_config_header.data = NULL;
+    conf->location_config_header.len  = 0;
 
     return conf;
 }
 
+static int
+str_equals(const ngx_str_t *a, const ngx_str_t *b)
+{
+    return a->len == b->len
+        && (a->len == 0 || ngx_memcmp(a->data, b->data, a->len) == 0);
+}
+
+/**
+ * Registers the serialized configuration of a location with the Core, which
+ * receives all of them through the `location_configs` option when the
+ * watchdog is started (see start_watchdog()). Requests then only carry a
+ * "!~PASSENGER_LOCATION_CONFIG_ID" header that refers to it, instead of
+ * all of the location's options.
+ *
+ * Most locations don't override any Passenger options, so they share the
+ * registration of their parent.
+ */
+static ngx_int_t
+register_location_config(ngx_conf_t *cf, passenger_loc_conf_t *conf)
+{
+    passenger_loc_conf_t *parent = conf->parent;
+    PsgJsonValue         *config;
+    ngx_uint_t            id;
+    size_t                len;
+    u_char               *buf, *pos;
+
+    if (parent != NULL
+        && parent->location_config_header.data != NULL
+        && str_equals(&parent->options_cache, &conf->options_cache)
+        && str_equals(&parent->env_vars_cache, &conf->env_vars_cache))
+    {
+        conf->location_config_header = parent->location_config_header;
+        return NGX_OK;
+    }
+
+    len = conf->options_cache.len;
+    if (conf->env_vars_cache.data != NULL) {
+        len += sizeof("!~PASSENGER_ENV_VARS: \r\n") - 1 + conf->env_vars_cache.len;
+    }
+
+    buf = pos = ngx_pnalloc(cf->temp_pool, len);
+    if (buf == NULL) {
+        return NGX_ERROR;
+    }
+    pos = ngx_copy(pos, conf->options_cache.data, conf->options_cache.len);
+    if (conf->env_vars_cache.data != NULL) {
+        pos = ngx_copy(pos, "!~PASSENGER_ENV_VARS: ",
+            sizeof("!~PASSENGER_ENV_VARS: ") - 1);
+        pos = ngx_copy(pos, conf->env_vars_cache.data, conf->env_vars_cache.len);
+        pos = ngx_copy(pos, "\r\n", sizeof("\r\n") - 1);
+    }
+
+    id = psg_json_value_size(passenger_main_conf.location_configs);
+    config = psg_json_value_new_str((const char *) buf, len);
+    psg_json_value_append_val(passenger_main_conf.location_configs, config);
+    psg_json_value_free(config);
+
+    len = sizeof("!~PASSENGER_LOCATION_CONFIG_ID: \r\n") - 1 + NGX_INT_T_LEN;
+    buf = ngx_pnalloc(cf->pool, len);
+    if (buf == NULL) {
+        return NGX_ERROR;
+    }
+    conf->location_config_header.data = buf;
+    conf->location_config_header.len = ngx_snprintf(buf, len,
+        "!~PASSENGER_LOCATION_CONFIG_ID: %ui\r\n", id) - buf;
+
+    return NGX_OK;
+}
+
 static ngx_int_t
 serialize_loc_conf_to_headers(ngx_conf_t *cf, passenger_loc_conf_t *conf)
 {
@@ -342,7 +428,7 @@ serialize_loc_conf_to_headers(ngx_conf_t *cf, passenger_loc_conf_t *conf)
         free(unencoded_buf);
     }
 
-    return NGX_OK;
+    return register_location_config(cf, conf);
 }
 
 char *
@@ -1128,6 +1214,8 @@ passenger_enabled(ngx_conf_t *cf, ngx_command_t *cmd, void *conf)
         if (passenger_conf->upstream_config.upstream == NULL) {
             return NGX_CONF_ERROR;
         }
+        passenger_conf->upstream_config.upstream->peer.init_upstream =
+            passenger_init_core_upstream;
 
         clcf = ngx_http_conf_get_module_loc_conf(cf, ngx_http_core_module);
         clcf->handler = passenger_content_handler;
@@ -38,6 +38,8 @@ struct passenger_main_conf_s {
     passenger_autogenerated_main_conf_t autogenerated;
     ngx_str_t     default_ruby;
     PsgJsonValue *manifest;
+    /** Serialized location configurations, registered with the Core at startup. */
+    PsgJsonValue *location_configs;
 };
 
 struct passenger_loc_conf_s {
@@ -63,6 +65,11 @@ struct passenger_loc_conf_s {
     /** Raw HTTP header data for this location are cached here. */
     ngx_str_t    options_cache;
     ngx_str_t    env_vars_cache;
+    /**
+     * The "!~PASSENGER_LOCATION_CONFIG_ID" header line that refers to the
+     * above data, as registered with the Core in passenger_main_conf.location_configs.
+     */
+    ngx_str_t    location_config_header;
 };
 
 #ifndef _PASSENGER_NGINX_MODULE_CONF_STRUCT_TYPEDEFS_H_
@@ -37,6 +37,14 @@
 
 #define NGX_HTTP_SCGI_PARSE_NO_HEADER  20
 
+/* Keep-alive connections to the Passenger core rely on
+ * ngx_http_upstream_t.request_body_sent to tell whether a connection
+ * can be reused, so they are only supported on newer Nginx versions.
+ */
+#if NGINX_VERSION_NUM >= 1015003
+    #define PASSENGER_CORE_KEEPALIVE_SUPPORTED
+#endif
+
 typedef enum {
     FT_ERROR,
     FT_FILE,
@@ -52,6 +60,11 @@ static ngx_int_t parse_status_line(ngx_http_request_t *r,
 static ngx_int_t process_header(ngx_http_request_t *r);
 static void abort_request(ngx_http_request_t *r);
 static void finalize_request(ngx_http_request_t *r, ngx_int_t rc);
+static ngx_int_t input_filter_init(void *data);
+static ngx_int_t copy_filter(ngx_event_pipe_t *p, ngx_buf_t *buf);
+static ngx_int_t chunked_filter(ngx_event_pipe_t *p, ngx_buf_t *buf);
+static ngx_int_t non_buffered_copy_filter(void *data, ssize_t bytes);
+static ngx_int_t non_buffered_chunked_filter(void *data, ssize_t bytes);
 
 
 static FileType
@@ -209,6 +222,353 @@ find_base_uri(ngx_http_request_t *r, const passenger_loc_conf_t *loc,
     }
 }
 
+static ngx_flag_t
+core_keepalive_enabled(void)
+{
+    #ifdef PASSENGER_CORE_KEEPALIVE_SUPPORTED
+        return passenger_main_conf.autogenerated.core_keepalive > 0;
+    #else
+        return 0;
+    #endif
+}
+
+static ngx_flag_t
+response_is_chunked(ngx_http_upstream_t *u)
+{
+    ngx_str_t *value;
+
+    if (u->headers_in.transfer_encoding == NULL) {
+        return 0;
+    }
+
+    value = &u->headers_in.transfer_encoding->value;
+    return ngx_strlcasestrn(value->data, value->data + value->len,
+        (u_char *) "chunked", sizeof("chunked") - 2) != NULL;
+}
+
+#ifdef PASSENGER_CORE_KEEPALIVE_SUPPORTED
+
+/*
+ * Idle connections to the Passenger core are cached per worker process,
+ * similar to what ngx_http_upstream_keepalive_module does for regular
+ * upstreams. All locations talk to the same Passenger core socket, so a
+ * single cache is shared by all of them. It is allocated on first use so
+ * that it is tied to the worker's cycle instead of to the configuration
+ * cycle in the master process.
+ */
+
+typedef struct core_keepalive_cache_s core_keepalive_cache_t;
+
+typedef struct {
+    ngx_queue_t              queue;
+    ngx_connection_t        *connection;
+    core_keepalive_cache_t  *cache;
+} core_keepalive_item_t;
+
+struct core_keepalive_cache_s {
+    ngx_cycle_t        *cycle;
+    ngx_queue_t         cache;
+    ngx_queue_t         free;
+};
+
+typedef struct {
+    /** Round-robin peer data that we delegate to. */
+    void                   *data;
+    ngx_http_upstream_t    *upstream;
+    ngx_event_get_peer_pt   original_get_peer;
+    ngx_event_free_peer_pt  original_free_peer;
+} core_keepalive_peer_data_t;
+
+static core_keepalive_cache_t *core_keepalive_cache = NULL;
+
+
+static core_keepalive_cache_t *
+get_core_keepalive_cache(void)
+{
+    core_keepalive_item_t *items;
+    ngx_uint_t             i, max_cached;
+
+    if (core_keepalive_cache != NULL && core_keepalive_cache->cycle == ngx_cycle) {
+        return core_keepalive_cache;
+    }
+
+    max_cached = passenger_main_conf.autogenerated.core_keepalive;
+    core_keepalive_cache = ngx_pcalloc(ngx_cycle->pool, sizeof(core_keepalive_cache_t));
+    items = ngx_pcalloc(ngx_cycle->pool, sizeof(core_keepalive_item_t) * max_cached);
+    if (core_keepalive_cache == NULL || items == NULL) {
+        core_keepalive_cache = NULL;
+        return NULL;
+    }
+
+    core_keepalive_cache->cycle = (ngx_cycle_t *) ngx_cycle;
+    ngx_queue_init(&core_keepalive_cache->cache);
+    ngx_queue_init(&core_keepalive_cache->free);
+    for (i = 0; i < max_cached; i++) {
+        items[i].cache = core_keepalive_cache;
+        ngx_queue_insert_head(&core_keepalive_cache->free, &items[i].queue);
+    }
+
+    return core_keepalive_cache;
+}
+
+static void
+close_core_keepalive_connection(ngx_connection_t *c)
+{
+    ngx_destroy_pool(c->pool);
+    ngx_close_connection(c);
+}
+
+static void
+core_keepalive_dummy_handler(ngx_event_t *ev)
+{
+    ngx_log_debug0(NGX_LOG_DEBUG_HTTP, ev->log, 0,
+                   "Passenger core keepalive dummy handler");
+}
+
+/**
+ * Called when an idle cached connection becomes readable. The Passenger
+ * core never sends anything on an idle connection, so this means that the
+ * connection was closed (or that the worker is shutting down).
+ */
+static void
+core_keepalive_close_handler(ngx_event_t *ev)
+{
+    core_keepalive_item_t *item;
+    ngx_connection_t      *c;
+    ssize_t                n;
+    char                   buf[1];
+
+    c = ev->data;
+
+    if (c->close || c->read->timedout) {
+        goto close;
+    }
+
+    n = recv(c->fd, buf, 1, MSG_PEEK);
+
+    if (n == -1 && ngx_socket_errno == NGX_EAGAIN) {
+        ev->ready = 0;
+
+        if (ngx_handle_read_event(c->read, 0) != NGX_OK) {
+            goto close;
+        }
+
+        return;
+    }
+
+close:
+
+    item = c->data;
+    close_core_keepalive_connection(c);
+    ngx_queue_remove(&item->queue);
+    ngx_queue_insert_head(&item->cache->free, &item->queue);
+}
+
+static ngx_int_t
+get_core_keepalive_peer(ngx_peer_connection_t *pc, void *data)
+{
+    core_keepalive_peer_data_t *kp = data;
+    core_keepalive_cache_t     *cache;
+    core_keepalive_item_t      *item;
+    ngx_connection_t           *c;
+    ngx_queue_t                *q;
+    ngx_int_t                   rc;
+
+    pc->cached = 0;
+    pc->connection = NULL;
+
+    rc = kp->original_get_peer(pc, kp->data);
+    if (rc != NGX_OK) {
+        return rc;
+    }
+
+    cache = get_core_keepalive_cache();
+    if (cache == NULL || ngx_queue_empty(&cache->cache)) {
+        return NGX_OK;
+    }
+
+    /* There is only one Passenger core address, so any cached
+     * connection will do.
+     */
+    q = ngx_queue_head(&cache->cache);
+    item = ngx_queue_data(q, core_keepalive_item_t, queue);
+    ngx_queue_remove(q);
+    ngx_queue_insert_head(&cache->free, q);
+
+    c = item->connection;
+    c->idle = 0;
+    c->sent = 0;
+    c->data = NULL;
+    c->log = pc->log;
+    c->read->log = pc->log;
+    c->write->log = pc->log;
+    c->pool->log = pc->log;
+
+    if (c->read->timer_set) {
+        ngx_del_timer(c->read);
+    }
+
+    ngx_log_debug1(NGX_LOG_DEBUG_HTTP, pc->log, 0,
+                   "reusing cached Passenger core connection %p", c);
+
+    pc->connection = c;
+    pc->cached = 1;
+
+    return NGX_DONE;
+}
+
+static void
+free_core_keepalive_peer(ngx_peer_connection_t *pc, void *data, ngx_uint_t state)
+{
+    core_keepalive_peer_data_t *kp = data;
+    core_keepalive_cache_t     *cache;
+    core_keepalive_item_t      *item;
+    ngx_http_upstream_t        *u;
+    ngx_connection_t           *c;
+    ngx_queue_t                *q;
+
+    u = kp->upstream;
+    c = pc->connection;
+
+    /* Only connections on which the request and the response were
+     * fully transferred can be reused.
+     */
+    if (state & NGX_PEER_FAILED
+        || c == NULL
+        || c->read->eof
+        || c->read->error
+        || c->read->timedout
+        || c->write->error
+        || c->write->timedout
+        || !u->keepalive
+        || !u->request_body_sent
+        || ngx_terminate
+        || ngx_exiting)
+    {
+        goto invalid;
+    }
+
+    cache = get_core_keepalive_cache();
+    if (cache == NULL) {
+        goto invalid;
+    }
+
+    if (ngx_handle_read_event(c->read, 0) != NGX_OK) {
+        goto invalid;
+    }
+
+    if (ngx_queue_empty(&cache->free)) {
+        /* Evict the least recently used connection. */
+        q = ngx_queue_last(&cache->cache);
+        ngx_queue_remove(q);
+        item = ngx_queue_data(q, core_keepalive_item_t, queue);
+        close_core_keepalive_connection(item->connection);
+    } else {
+        q = ngx_queue_head(&cache->free);
+        ngx_queue_remove(q);
+        item = ngx_queue_data(q, core_keepalive_item_t, queue);
+    }
+
+    ngx_queue_insert_head(&cache->cache, q);
+    item->connection = c;
+
+    ngx_log_debug1(NGX_LOG_DEBUG_HTTP, pc->log, 0,
+                   "caching Passenger core connection %p", c);
+
+    pc->connection = NULL;
+
+    /* Otherwise the proxy read timeout would close the idle connection. */
+    if (c->read->timer_set) {
+        c->read->delayed = 0;
+        ngx_del_timer(c->read);
+    }
+    if (c->write->timer_set) {
+        ngx_del_timer(c->write);
+    }
+
+    c->write->handler = core_keepalive_dummy_handler;
+    c->read->handler = core_keepalive_close_handler;
+
+    c->data = item;
+    c->idle = 1;
+    c->log = ngx_cycle->log;
+    c->read->log = ngx_cycle->log;
+    c->write->log = ngx_cycle->log;
+    c->pool->log = ngx_cycle->log;
+
+    if (c->read->ready) {
+        core_keepalive_close_handler(c->read);
+    }
+
+invalid:
+
+    kp->original_free_peer(pc, kp->data, state);
+}
+
+static ngx_int_t
+init_core_keepalive_peer(ngx_http_request_t *r, ngx_http_upstream_srv_conf_t *us)
+{
+    core_keepalive_peer_data_t *kp;
+
+    kp = ngx_palloc(r->pool, sizeof(core_keepalive_peer_data_t));
+    if (kp == NULL) {
+        return NGX_ERROR;
+    }
+
+    if (ngx_http_upstream_init_round_robin_peer(r, us) != NGX_OK) {
+        return NGX_ERROR;
+    }
+
+    kp->upstream = r->upstream;
+    kp->data = r->upstream->peer.data;
+    kp->original_get_peer = r->upstream->peer.get;
+    kp->original_free_peer = r->upstream->peer.free;
+
+    r->upstream->peer.data = kp;
+    r->upstream->peer.get = get_core_keepalive_peer;
+    r->upstream->peer.free = free_core_keepalive_peer;
+
+    return NGX_OK;
+}
+
+#endif /* PASSENGER_CORE_KEEPALIVE_SUPPORTED */
+
+/**
+ * Upstream initialization function for the placeholder Passenger core
+ * upstream. Uses the round-robin method (there is only one server) and
+ * installs the keepalive connection cache if `passenger_core_keepalive`
+ * is set.
+ */
+ngx_int_t
+passenger_init_core_upstream(ngx_conf_t *cf, ngx_http_upstream_srv_conf_t *us)
+{
+    passenger_main_conf_t *pmcf;
+
+    if (ngx_http_upstream_init_round_robin(cf, us) != NGX_OK) {
+        return NGX_ERROR;
+    }
+
+    /* passenger_init_main_conf() may not have run yet, so
+     * look at the configuration that is being parsed.
+     */
+    pmcf = ngx_http_conf_get_module_main_conf(cf, ngx_http_passenger_module);
+    if (pmcf->autogenerated.core_keepalive == NGX_CONF_UNSET_UINT
+     || pmcf->autogenerated.core_keepalive == 0)
+    {
+        return NGX_OK;
+    }
+
+    #ifdef PASSENGER_CORE_KEEPALIVE_SUPPORTED
+        us->peer.init = init_core_keepalive_peer;
+    #else
+        ngx_conf_log_error(NGX_LOG_WARN, cf, 0,
+            "\"passenger_core_keepalive\" requires Nginx 1.15.3 or later, "
+            "ignoring");
+    #endif
+
+    return NGX_OK;
+}
+
 static void
 set_upstream_server_address(ngx_http_upstream_t *upstream, ngx_http_upstream_conf_t *upstream_config) {
     ngx_http_upstream_server_t *servers = upstream_config->upstream->servers->elts;
@@ -255,13 +615,26 @@ fix_peer_address(ngx_http_request_t *r) {
     unsigned int                      peer_index;
     const char                       *core_address;
     unsigned int                      core_address_len;
+    ngx_event_get_peer_pt             get_peer;
+    void                             *peer_data;
+
+    get_peer   = r->upstream->peer.get;
+    peer_data  = r->upstream->peer.data;
+
+    #ifdef PASSENGER_CORE_KEEPALIVE_SUPPORTED
+        if (get_peer == get_core_keepalive_peer) {
+            /* Look through the keepalive connection cache. */
+            get_peer  = ((core_keepalive_peer_data_t *) peer_data)->original_get_peer;
+            peer_data = ((core_keepalive_peer_data_t *) peer_data)->data;
+        }
+    #endif
 
-    if (r->upstream->peer.get != ngx_http_upstream_get_round_robin_peer) {
+    if (get_peer != ngx_http_upstream_get_round_robin_peer) {
         /* This function only supports the round-robin upstream method. */
         return;
     }
 
-    rrp        = r->upstream->peer.data;
+    rrp        = peer_data;
     peers      = rrp->peers;
     core_address =
         psg_watchdog_launcher_get_core_address(psg_watchdog_launcher,
@@ -740,7 +1113,11 @@ construct_request_buffer(ngx_http_request_t *r, passenger_loc_conf_t *slcf,
         total_size += r->args.len + 1;
     }
 
-    PUSH_STATIC_STR(" HTTP/1.1\r\nConnection: close\r\n");
+    if (core_keepalive_enabled()) {
+        PUSH_STATIC_STR(" HTTP/1.1\r\n");
+    } else {
+        PUSH_STATIC_STR(" HTTP/1.1\r\nConnection: close\r\n");
+    }
 
     part = &r->headers_in.headers.part;
     header = part->elts;
@@ -977,28 +1354,29 @@ construct_request_buffer(ngx_http_request_t *r, passenger_loc_conf_t *slcf,
         PUSH_STATIC_STR("\r\n");
     }
 
+    /* The location's options (options_cache and env_vars_cache) were
+     * registered with the Core at startup. We only refer to them by ID.
+     */
     if (b != NULL) {
-        b->last = ngx_copy(b->last, slcf->options_cache.data, slcf->options_cache.len);
-    }
-    total_size += slcf->options_cache.len;
-
-    if (slcf->env_vars_cache.data != NULL) {
-        PUSH_STATIC_STR("!~PASSENGER_ENV_VARS: ");
-        if (b != NULL) {
-            b->last = ngx_copy(b->last, slcf->env_vars_cache.data, slcf->env_vars_cache.len);
-        }
-        total_size += slcf->env_vars_cache.len;
-        PUSH_STATIC_STR("\r\n");
+        b->last = ngx_copy(b->last, slcf->location_config_header.data,
+            slcf->location_config_header.len);
     }
+    total_size += slcf->location_config_header.len;
 
     /* D = Dechunk response
-     *     Prevent Nginx from rechunking the response.
+     *     Prevent Nginx from rechunking the response. Not set when
+     *     keeping Core connections alive: the response is then framed
+     *     with a content length or chunked encoding, which we parse.
      * B = Buffer request body
      * C = Strip 100 Continue header
      * S = SSL
      */
 
-    PUSH_STATIC_STR("!~FLAGS: CD");
+    if (core_keepalive_enabled()) {
+        PUSH_STATIC_STR("!~FLAGS: C");
+    } else {
+        PUSH_STATIC_STR("!~FLAGS: CD");
+    }
     if (slcf->autogenerated.buffer_upload) {
         PUSH_STATIC_STR("B");
     }
@@ -1147,7 +1525,15 @@ reinit_request(ngx_http_request_t *r)
     context->status_start = NULL;
     context->status_end = NULL;
 
+    context->chunked.state = 0;
+    context->chunked.size = 0;
+    context->chunked.length = 0;
+
     r->upstream->process_header = process_status_line;
+    if (core_keepalive_enabled()) {
+        r->upstream->pipe->input_filter = copy_filter;
+        r->upstream->input_filter = non_buffered_copy_filter;
+    }
     r->state = 0;
 
     return NGX_OK;
@@ -1581,12 +1967,25 @@ process_header(ngx_http_request_t *r)
 
         done:
 
+            /* Allow keeping the Core connection alive if the response
+             * has no body. This also covers r->header_only.
+             */
+            if (core_keepalive_enabled()
+             && (u->headers_in.status_n == NGX_HTTP_NO_CONTENT
+              || u->headers_in.status_n == NGX_HTTP_NOT_MODIFIED
+              || r->method == NGX_HTTP_HEAD
+              || (!response_is_chunked(u) && u->headers_in.content_length_n == 0)))
+            {
+                u->keepalive = !u->headers_in.connection_close;
+            }
+
             /* Supported since Nginx 1.3.15. */
             #ifdef NGX_HTTP_SWITCHING_PROTOCOLS
-                if (u->headers_in.status_n == NGX_HTTP_SWITCHING_PROTOCOLS
-                    && r->headers_in.upgrade)
-                {
-                    u->upgrade = 1;
+                if (u->headers_in.status_n == NGX_HTTP_SWITCHING_PROTOCOLS) {
+                    u->keepalive = 0;
+                    if (r->headers_in.upgrade) {
+                        u->upgrade = 1;
+                    }
                 }
             #endif
 
@@ -1607,6 +2006,448 @@ process_header(ngx_http_request_t *r)
 }
 
 
+/*
+ * The following input filters are only used when keeping connections to
+ * the Passenger core alive. They are modeled after the ones in
+ * ngx_http_proxy_module: they pass the response body through while
+ * keeping track of where it ends, and set u->keepalive once it has been
+ * fully read.
+ */
+
+static ngx_int_t
+input_filter_init(void *data)
+{
+    ngx_http_request_t   *r = data;
+    ngx_http_upstream_t  *u;
+
+    u = r->upstream;
+
+    if (u->headers_in.status_n == NGX_HTTP_NO_CONTENT
+        || u->headers_in.status_n == NGX_HTTP_NOT_MODIFIED
+        || r->method == NGX_HTTP_HEAD)
+    {
+        /* 204, 304 and replies to HEAD requests have no body. */
+        u->pipe->length = 0;
+        u->length = 0;
+        u->keepalive = !u->headers_in.connection_close;
+
+    } else if (response_is_chunked(u)) {
+        u->pipe->input_filter = chunked_filter;
+        u->pipe->length = 3; /* "0" LF LF */
+        u->input_filter = non_buffered_chunked_filter;
+        u->length = 1;
+
+    } else if (u->headers_in.content_length_n == 0) {
+        /* Empty body: special case as the filter won't be called. */
+        u->pipe->length = 0;
+        u->length = 0;
+        u->keepalive = !u->headers_in.connection_close;
+
+    } else {
+        /* Content length, or -1 if the body ends when the Core
+         * closes the connection. */
+        u->pipe->length = u->headers_in.content_length_n;
+        u->length = u->headers_in.content_length_n;
+    }
+
+    return NGX_OK;
+}
+
+
+static ngx_int_t
+copy_filter(ngx_event_pipe_t *p, ngx_buf_t *buf)
+{
+    ngx_buf_t           *b;
+    ngx_chain_t         *cl;
+    ngx_http_request_t  *r;
+
+    if (buf->pos == buf->last) {
+        return NGX_OK;
+    }
+
+    if (p->upstream_done) {
+        ngx_log_debug0(NGX_LOG_DEBUG_HTTP, p->log, 0,
+                       "Passenger core data after close");
+        return NGX_OK;
+    }
+
+    if (p->length == 0) {
+        r = p->input_ctx;
+        r->upstream->keepalive = 0;
+        p->upstream_done = 1;
+        ngx_log_error(NGX_LOG_WARN, p->log, 0,
+                      "upstream sent more data than specified in "
+                      "\"Content-Length\" header");
+        return NGX_OK;
+    }
+
+    cl = ngx_chain_get_free_buf(p->pool, &p->free);
+    if (cl == NULL) {
+        return NGX_ERROR;
+    }
+
+    b = cl->buf;
+
+    ngx_memcpy(b, buf, sizeof(ngx_buf_t));
+    b->shadow = buf;
+    b->tag = p->tag;
+    b->last_shadow = 1;
+    b->recycled = 1;
+    buf->shadow = b;
+
+    ngx_log_debug1(NGX_LOG_DEBUG_EVENT, p->log, 0, "input buf #%d", b->num);
+
+    if (p->in) {
+        *p->last_in = cl;
+    } else {
+        p->in = cl;
+    }
+    p->last_in = &cl->next;
+
+    if (p->length == -1) {
+        return NGX_OK;
+    }
+
+    r = p->input_ctx;
+
+    if (b->last - b->pos > p->length) {
+        ngx_log_error(NGX_LOG_WARN, p->log, 0,
+                      "upstream sent more data than specified in "
+                      "\"Content-Length\" header");
+        b->last = b->pos + p->length;
+        p->upstream_done = 1;
+        r->upstream->keepalive = 0;
+        return NGX_OK;
+    }
+
+    p->length -= b->last - b->pos;
+
+    if (p->length == 0) {
+        r->upstream->keepalive = !r->upstream->headers_in.connection_close;
+    }
+
+    return NGX_OK;
+}
+
+
+static ngx_int_t
+chunked_filter(ngx_event_pipe_t *p, ngx_buf_t *buf)
+{
+    ngx_int_t             rc;
+    ngx_buf_t            *b, **prev;
+    ngx_chain_t          *cl;
+    ngx_http_request_t   *r;
+    passenger_context_t  *context;
+
+    if (buf->pos == buf->last) {
+        return NGX_OK;
+    }
+
+    r = p->input_ctx;
+    context = ngx_http_get_module_ctx(r, ngx_http_passenger_module);
+    if (context == NULL) {
+        return NGX_ERROR;
+    }
+
+    if (p->upstream_done) {
+        ngx_log_debug0(NGX_LOG_DEBUG_HTTP, p->log, 0,
+                       "Passenger core data after close");
+        return NGX_OK;
+    }
+
+    if (p->length == 0) {
+        ngx_log_error(NGX_LOG_WARN, p->log, 0,
+                      "upstream sent data after final chunk");
+        r->upstream->keepalive = 0;
+        p->upstream_done = 1;
+        return NGX_OK;
+    }
+
+    b = NULL;
+    prev = &buf->shadow;
+
+    for ( ;; ) {
+
+        rc = ngx_http_parse_chunked(r, buf, &context->chunked);
+
+        if (rc == NGX_OK) {
+
+            /* a chunk has been parsed successfully */
+
+            cl = ngx_chain_get_free_buf(p->pool, &p->free);
+            if (cl == NULL) {
+                return NGX_ERROR;
+            }
+
+            b = cl->buf;
+
+            ngx_memzero(b, sizeof(ngx_buf_t));
+
+            b->pos = buf->pos;
+            b->start = buf->start;
+            b->end = buf->end;
+            b->tag = p->tag;
+            b->temporary = 1;
+            b->recycled = 1;
+
+            *prev = b;
+            prev = &b->shadow;
+
+            if (p->in) {
+                *p->last_in = cl;
+            } else {
+                p->in = cl;
+            }
+            p->last_in = &cl->next;
+
+            /* STUB */ b->num = buf->num;
+
+            ngx_log_debug2(NGX_LOG_DEBUG_EVENT, p->log, 0,
+                           "input buf #%d %p", b->num, b->pos);
+
+            if (buf->last - buf->pos >= context->chunked.size) {
+
+                buf->pos += (size_t) context->chunked.size;
+                b->last = buf->pos;
+                context->chunked.size = 0;
+
+                continue;
+            }
+
+            context->chunked.size -= buf->last - buf->pos;
+            buf->pos = buf->last;
+            b->last = buf->last;
+
+            continue;
+        }
+
+        if (rc == NGX_DONE) {
+
+            /* a whole response has been parsed successfully */
+
+            p->length = 0;
+            r->upstream->keepalive = !r->upstream->headers_in.connection_close;
+
+            if (buf->pos != buf->last) {
+                ngx_log_error(NGX_LOG_WARN, p->log, 0,
+                              "upstream sent data after final chunk");
+                r->upstream->keepalive = 0;
+            }
+
+            break;
+        }
+
+        if (rc == NGX_AGAIN) {
+
+            /* set p->length, minimal amount of data we want to see */
+
+            p->length = context->chunked.length;
+
+            break;
+        }
+
+        /* invalid response */
+
+        ngx_log_error(NGX_LOG_ERR, r->connection->log, 0,
+                      "upstream sent invalid chunked response");
+
+        return NGX_ERROR;
+    }
+
+    ngx_log_debug2(NGX_LOG_DEBUG_HTTP, r->connection->log, 0,
+                   "Passenger core chunked state %ui, length %O",
+                   context->chunked.state, p->length);
+
+    if (b) {
+        b->shadow = buf;
+        b->last_shadow = 1;
+
+        ngx_log_debug2(NGX_LOG_DEBUG_EVENT, p->log, 0,
+                       "input buf %p %z", b->pos, b->last - b->pos);
+
+        return NGX_OK;
+    }
+
+    /* there is no data record in the buf, add it to free chain */
+
+    if (ngx_event_pipe_add_free_buf(p, buf) != NGX_OK) {
+        return NGX_ERROR;
+    }
+
+    return NGX_OK;
+}
+
+
+static ngx_int_t
+non_buffered_copy_filter(void *data, ssize_t bytes)
+{
+    ngx_http_request_t   *r = data;
+    ngx_buf_t            *b;
+    ngx_chain_t          *cl, **ll;
+    ngx_http_upstream_t  *u;
+
+    u = r->upstream;
+
+    if (u->length == 0) {
+        ngx_log_error(NGX_LOG_WARN, r->connection->log, 0,
+                      "upstream sent more data than specified in "
+                      "\"Content-Length\" header");
+        u->keepalive = 0;
+        return NGX_OK;
+    }
+
+    for (cl = u->out_bufs, ll = &u->out_bufs; cl; cl = cl->next) {
+        ll = &cl->next;
+    }
+
+    cl = ngx_chain_get_free_buf(r->pool, &u->free_bufs);
+    if (cl == NULL) {
+        return NGX_ERROR;
+    }
+
+    *ll = cl;
+
+    cl->buf->flush = 1;
+    cl->buf->memory = 1;
+
+    b = &u->buffer;
+
+    cl->buf->pos = b->last;
+    b->last += bytes;
+    cl->buf->last = b->last;
+    cl->buf->tag = u->output.tag;
+
+    if (u->length == -1) {
+        return NGX_OK;
+    }
+
+    if (bytes > u->length) {
+        ngx_log_error(NGX_LOG_WARN, r->connection->log, 0,
+                      "upstream sent more data than specified in "
+                      "\"Content-Length\" header");
+        cl->buf->last = cl->buf->pos + u->length;
+        u->length = 0;
+        u->keepalive = 0;
+        return NGX_OK;
+    }
+
+    u->length -= bytes;
+
+    if (u->length == 0) {
+        u->keepalive = !u->headers_in.connection_close;
+    }
+
+    return NGX_OK;
+}
+
+
+static ngx_int_t
+non_buffered_chunked_filter(void *data, ssize_t bytes)
+{
+    ngx_http_request_t   *r = data;
+    ngx_int_t             rc;
+    ngx_buf_t            *b, *buf;
+    ngx_chain_t          *cl, **ll;
+    ngx_http_upstream_t  *u;
+    passenger_context_t  *context;
+
+    context = ngx_http_get_module_ctx(r, ngx_http_passenger_module);
+    if (context == NULL) {
+        return NGX_ERROR;
+    }
+
+    u = r->upstream;
+
+    if (u->length == 0) {
+        ngx_log_error(NGX_LOG_WARN, r->connection->log, 0,
+                      "upstream sent data after final chunk");
+        u->keepalive = 0;
+        return NGX_OK;
+    }
+
+    buf = &u->buffer;
+
+    buf->pos = buf->last;
+    buf->last += bytes;
+
+    for (cl = u->out_bufs, ll = &u->out_bufs; cl; cl = cl->next) {
+        ll = &cl->next;
+    }
+
+    for ( ;; ) {
+
+        rc = ngx_http_parse_chunked(r, buf, &context->chunked);
+
+        if (rc == NGX_OK) {
+
+            /* a chunk has been parsed successfully */
+
+            cl = ngx_chain_get_free_buf(r->pool, &u->free_bufs);
+            if (cl == NULL) {
+                return NGX_ERROR;
+            }
+
+            *ll = cl;
+            ll = &cl->next;
+
+            b = cl->buf;
+
+            b->flush = 1;
+            b->memory = 1;
+
+            b->pos = buf->pos;
+            b->tag = u->output.tag;
+
+            if (buf->last - buf->pos >= context->chunked.size) {
+                buf->pos += (size_t) context->chunked.size;
+                b->last = buf->pos;
+                context->chunked.size = 0;
+
+            } else {
+                context->chunked.size -= buf->last - buf->pos;
+                buf->pos = buf->last;
+                b->last = buf->last;
+            }
+
+            ngx_log_debug2(NGX_LOG_DEBUG_HTTP, r->connection->log, 0,
+                           "Passenger core out buf %p %z",
+                           b->pos, b->last - b->pos);
+
+            continue;
+        }
+
+        if (rc == NGX_DONE) {
+
+            /* a whole response has been parsed successfully */
+
+            u->keepalive = !u->headers_in.connection_close;
+            u->length = 0;
+
+            if (buf->pos != buf->last) {
+                ngx_log_error(NGX_LOG_WARN, r->connection->log, 0,
+                              "upstream sent data after final chunk");
+                u->keepalive = 0;
+            }
+
+            break;
+        }
+
+        if (rc == NGX_AGAIN) {
+            break;
+        }
+
+        /* invalid response */
+
+        ngx_log_error(NGX_LOG_ERR, r->connection->log, 0,
+                      "upstream sent invalid chunked response");
+
+        return NGX_ERROR;
+    }
+
+    return NGX_OK;
+}
+
+
 static void
 abort_request(ngx_http_request_t *r)
 {
@@ -1824,8 +2665,18 @@ passenger_content_handler(ngx_http_request_t *r)
         return NGX_HTTP_INTERNAL_SERVER_ERROR;
     }
 
-    u->pipe->input_filter = ngx_event_pipe_copy_input_filter;
     u->pipe->input_ctx = r;
+    if (core_keepalive_enabled()) {
+        /* The Core connection can only be reused after the response
+         * body has been fully read, so we need to know where it ends.
+         */
+        u->pipe->input_filter = copy_filter;
+        u->input_filter_init = input_filter_init;
+        u->input_filter = non_buffered_copy_filter;
+        u->input_filter_ctx = r;
+    } else {
+        u->pipe->input_filter = ngx_event_pipe_copy_input_filter;
+    }
 
     r->request_body_no_buffering = !slcf->upstream_config.request_buffering;
 
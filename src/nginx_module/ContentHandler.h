@@ -45,6 +45,9 @@ typedef struct {
     ngx_chain_t *busy;
     unsigned header_sent: 1;
 
+    /** Chunked response body parser state, used when keeping Core connections alive. */
+    ngx_http_chunked_t chunked;
+
     /** The application's 'public' directory. */
     ngx_str_t   public_dir;
 
@@ -57,6 +60,7 @@ typedef struct {
 
 
 ngx_int_t passenger_content_handler(ngx_http_request_t *r);
+ngx_int_t passenger_init_core_upstream(ngx_conf_t *cf, ngx_http_upstream_srv_conf_t *us);
 
 
 #endif /* _PASSENGER_NGINX_CONTENT_HANDLER_H_ */
@@ -44,6 +44,7 @@ passenger_create_autogenerated_loc_conf(passenger_autogenerated_loc_conf_t  *con
     conf->ruby.len  = 0;
     conf->python.data = NULL;
     conf->python.len  = 0;
+    conf->python_thread_count = NGX_CONF_UNSET_UINT;
     conf->nodejs.data = NULL;
     conf->nodejs.len  = 0;
     conf->meteor_app_settings.data = NULL;
@@ -83,6 +84,11 @@ passenger_create_autogenerated_loc_conf(passenger_autogenerated_loc_conf_t  *con
     conf->restart_dir.len  = 0;
     conf->abort_websockets_on_process_shutdown = NGX_CONF_UNSET;
     conf->force_max_concurrent_requests_per_process = NGX_CONF_UNSET;
+    conf->spawn_concurrency = NGX_CONF_UNSET_UINT;
+    conf->standby_processes = NGX_CONF_UNSET_UINT;
+    conf->routing_method.data = NULL;
+    conf->routing_method.len  = 0;
+    conf->max_memory = NGX_CONF_UNSET_UINT;
     conf->enabled = NGX_CONF_UNSET;
     conf->max_requests = NGX_CONF_UNSET_UINT;
     conf->base_uris = NGX_CONF_UNSET_PTR;
@@ -110,6 +116,10 @@ passenger_create_autogenerated_loc_conf(passenger_autogenerated_loc_conf_t  *con
     conf->python_source_file.len = 0;
     conf->python_source_line = 0;
     conf->python_explicitly_set = 0;
+    conf->python_thread_count_source_file.data = NULL;
+    conf->python_thread_count_source_file.len = 0;
+    conf->python_thread_count_source_line = 0;
+    conf->python_thread_count_explicitly_set = 0;
     conf->nodejs_source_file.data = NULL;
     conf->nodejs_source_file.len = 0;
     conf->nodejs_source_line = 0;
@@ -210,6 +220,22 @@ passenger_create_autogenerated_loc_conf(passenger_autogenerated_loc_conf_t  *con
     conf->force_max_concurrent_requests_per_process_source_file.len = 0;
     conf->force_max_concurrent_requests_per_process_source_line = 0;
     conf->force_max_concurrent_requests_per_process_explicitly_set = 0;
+    conf->spawn_concurrency_source_file.data = NULL;
+    conf->spawn_concurrency_source_file.len = 0;
+    conf->spawn_concurrency_source_line = 0;
+    conf->spawn_concurrency_explicitly_set = 0;
+    conf->standby_processes_source_file.data = NULL;
+    conf->standby_processes_source_file.len = 0;
+    conf->standby_processes_source_line = 0;
+    conf->standby_processes_explicitly_set = 0;
+    conf->routing_method_source_file.data = NULL;
+    conf->routing_method_source_file.len = 0;
+    conf->routing_method_source_line = 0;
+    conf->routing_method_explicitly_set = 0;
+    conf->max_memory_source_file.data = NULL;
+    conf->max_memory_source_file.len = 0;
+    conf->max_memory_source_line = 0;
+    conf->max_memory_explicitly_set = 0;
     conf->enabled_source_file.data = NULL;
     conf->enabled_source_file.len = 0;
     conf->enabled_source_line = 0;
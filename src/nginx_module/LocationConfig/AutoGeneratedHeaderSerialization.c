@@ -61,6 +61,16 @@ passenger_serialize_autogenerated_loc_conf_to_headers(ngx_conf_t *cf, passenger_
         len += sizeof("\r\n") - 1;
     }
 
+    if (conf->autogenerated.python_thread_count != NGX_CONF_UNSET_UINT) {
+        end = ngx_snprintf(int_buf,
+            sizeof(int_buf) - 1,
+            "%ui",
+            conf->autogenerated.python_thread_count);
+        len += sizeof("!~PASSENGER_PYTHON_THREAD_COUNT: ") - 1;
+        len += end - int_buf;
+        len += sizeof("\r\n") - 1;
+    }
+
     if (conf->autogenerated.nodejs.data != NULL) {
         len += sizeof("!~PASSENGER_NODEJS: ") - 1;
         len += conf->autogenerated.nodejs.len;
@@ -211,6 +221,42 @@ passenger_serialize_autogenerated_loc_conf_to_headers(ngx_conf_t *cf, passenger_
         len += sizeof("\r\n") - 1;
     }
 
+    if (conf->autogenerated.spawn_concurrency != NGX_CONF_UNSET_UINT) {
+        end = ngx_snprintf(int_buf,
+            sizeof(int_buf) - 1,
+            "%ui",
+            conf->autogenerated.spawn_concurrency);
+        len += sizeof("!~PASSENGER_SPAWN_CONCURRENCY: ") - 1;
+        len += end - int_buf;
+        len += sizeof("\r\n") - 1;
+    }
+
+    if (conf->autogenerated.standby_processes != NGX_CONF_UNSET_UINT) {
+        end = ngx_snprintf(int_buf,
+            sizeof(int_buf) - 1,
+            "%ui",
+            conf->autogenerated.standby_processes);
+        len += sizeof("!~PASSENGER_STANDBY_PROCESSES: ") - 1;
+        len += end - int_buf;
+        len += sizeof("\r\n") - 1;
+    }
+
+    if (conf->autogenerated.routing_method.data != NULL) {
+        len += sizeof("!~PASSENGER_ROUTING_METHOD: ") - 1;
+        len += conf->autogenerated.routing_method.len;
+        len += sizeof("\r\n") - 1;
+    }
+
+    if (conf->autogenerated.max_memory != NGX_CONF_UNSET_UINT) {
+        end = ngx_snprintf(int_buf,
+            sizeof(int_buf) - 1,
+            "%ui",
+            conf->autogenerated.max_memory);
+        len += sizeof("!~PASSENGER_MAX_MEMORY: ") - 1;
+        len += end - int_buf;
+        len += sizeof("\r\n") - 1;
+    }
+
     if (conf->autogenerated.max_requests != NGX_CONF_UNSET_UINT) {
         end = ngx_snprintf(int_buf,
             sizeof(int_buf) - 1,
@@ -287,6 +333,17 @@ passenger_serialize_autogenerated_loc_conf_to_headers(ngx_conf_t *cf, passenger_
             conf->autogenerated.python.len);
         pos = ngx_copy(pos, (const u_char *) "\r\n", sizeof("\r\n") - 1);
     }
+    if (conf->autogenerated.python_thread_count != NGX_CONF_UNSET_UINT) {
+        pos = ngx_copy(pos,
+            "!~PASSENGER_PYTHON_THREAD_COUNT: ",
+            sizeof("!~PASSENGER_PYTHON_THREAD_COUNT: ") - 1);
+        end = ngx_snprintf(int_buf,
+            sizeof(int_buf) - 1,
+            "%ui",
+            conf->autogenerated.python_thread_count);
+        pos = ngx_copy(pos, int_buf, end - int_buf);
+        pos = ngx_copy(pos, (const u_char *) "\r\n", sizeof("\r\n") - 1);
+    }
     if (conf->autogenerated.nodejs.data != NULL) {
         pos = ngx_copy(pos,
             "!~PASSENGER_NODEJS: ",
@@ -494,6 +551,48 @@ passenger_serialize_autogenerated_loc_conf_to_headers(ngx_conf_t *cf, passenger_
         pos = ngx_copy(pos, int_buf, end - int_buf);
         pos = ngx_copy(pos, (const u_char *) "\r\n", sizeof("\r\n") - 1);
     }
+    if (conf->autogenerated.spawn_concurrency != NGX_CONF_UNSET_UINT) {
+        pos = ngx_copy(pos,
+            "!~PASSENGER_SPAWN_CONCURRENCY: ",
+            sizeof("!~PASSENGER_SPAWN_CONCURRENCY: ") - 1);
+        end = ngx_snprintf(int_buf,
+            sizeof(int_buf) - 1,
+            "%ui",
+            conf->autogenerated.spawn_concurrency);
+        pos = ngx_copy(pos, int_buf, end - int_buf);
+        pos = ngx_copy(pos, (const u_char *) "\r\n", sizeof("\r\n") - 1);
+    }
+    if (conf->autogenerated.standby_processes != NGX_CONF_UNSET_UINT) {
+        pos = ngx_copy(pos,
+            "!~PASSENGER_STANDBY_PROCESSES: ",
+            sizeof("!~PASSENGER_STANDBY_PROCESSES: ") - 1);
+        end = ngx_snprintf(int_buf,
+            sizeof(int_buf) - 1,
+            "%ui",
+            conf->autogenerated.standby_processes);
+        pos = ngx_copy(pos, int_buf, end - int_buf);
+        pos = ngx_copy(pos, (const u_char *) "\r\n", sizeof("\r\n") - 1);
+    }
+    if (conf->autogenerated.routing_method.data != NULL) {
+        pos = ngx_copy(pos,
+            "!~PASSENGER_ROUTING_METHOD: ",
+            sizeof("!~PASSENGER_ROUTING_METHOD: ") - 1);
+        pos = ngx_copy(pos,
+            conf->autogenerated.routing_method.data,
+            conf->autogenerated.routing_method.len);
+        pos = ngx_copy(pos, (const u_char *) "\r\n", sizeof("\r\n") - 1);
+    }
+    if (conf->autogenerated.max_memory != NGX_CONF_UNSET_UINT) {
+        pos = ngx_copy(pos,
+            "!~PASSENGER_MAX_MEMORY: ",
+            sizeof("!~PASSENGER_MAX_MEMORY: ") - 1);
+        end = ngx_snprintf(int_buf,
+            sizeof(int_buf) - 1,
+            "%ui",
+            conf->autogenerated.max_memory);
+        pos = ngx_copy(pos, int_buf, end - int_buf);
+        pos = ngx_copy(pos, (const u_char *) "\r\n", sizeof("\r\n") - 1);
+    }
     if (conf->autogenerated.max_requests != NGX_CONF_UNSET_UINT) {
         pos = ngx_copy(pos,
             "!~PASSENGER_MAX_REQUESTS: ",
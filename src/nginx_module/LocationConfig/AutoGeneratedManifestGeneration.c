@@ -74,6 +74,19 @@ generate_config_manifest_for_autogenerated_loc_conf(manifest_gen_ctx_t *ctx, pas
             (const char *) plcf->autogenerated.python.data,
             plcf->autogenerated.python.len);
     }
+    if (plcf->autogenerated.python_thread_count_explicitly_set) {
+        find_or_create_manifest_app_and_loc_options_containers(ctx,
+            plcf, cscf, clcf, &app_options_container, &loc_options_container);
+        option_container = find_or_create_manifest_option_container(ctx,
+            app_options_container,
+            "passenger_python_thread_count",
+            sizeof("passenger_python_thread_count") - 1);
+        hierarchy_member = add_manifest_option_container_hierarchy_member(option_container,
+            &plcf->autogenerated.python_thread_count_source_file,
+            plcf->autogenerated.python_thread_count_source_line);
+        psg_json_value_set_uint(hierarchy_member, "value",
+            plcf->autogenerated.python_thread_count);
+    }
     if (plcf->autogenerated.nodejs_explicitly_set) {
         find_or_create_manifest_app_and_loc_options_containers(ctx,
             plcf, cscf, clcf, &app_options_container, &loc_options_container);
@@ -413,6 +426,59 @@ generate_config_manifest_for_autogenerated_loc_conf(manifest_gen_ctx_t *ctx, pas
         psg_json_value_set_int(hierarchy_member, "value",
             plcf->autogenerated.force_max_concurrent_requests_per_process);
     }
+    if (plcf->autogenerated.spawn_concurrency_explicitly_set) {
+        find_or_create_manifest_app_and_loc_options_containers(ctx,
+            plcf, cscf, clcf, &app_options_container, &loc_options_container);
+        option_container = find_or_create_manifest_option_container(ctx,
+            app_options_container,
+            "passenger_spawn_concurrency",
+            sizeof("passenger_spawn_concurrency") - 1);
+        hierarchy_member = add_manifest_option_container_hierarchy_member(option_container,
+            &plcf->autogenerated.spawn_concurrency_source_file,
+            plcf->autogenerated.spawn_concurrency_source_line);
+        psg_json_value_set_uint(hierarchy_member, "value",
+            plcf->autogenerated.spawn_concurrency);
+    }
+    if (plcf->autogenerated.standby_processes_explicitly_set) {
+        find_or_create_manifest_app_and_loc_options_containers(ctx,
+            plcf, cscf, clcf, &app_options_container, &loc_options_container);
+        option_container = find_or_create_manifest_option_container(ctx,
+            app_options_container,
+            "passenger_standby_processes",
+            sizeof("passenger_standby_processes") - 1);
+        hierarchy_member = add_manifest_option_container_hierarchy_member(option_container,
+            &plcf->autogenerated.standby_processes_source_file,
+            plcf->autogenerated.standby_processes_source_line);
+        psg_json_value_set_uint(hierarchy_member, "value",
+            plcf->autogenerated.standby_processes);
+    }
+    if (plcf->autogenerated.routing_method_explicitly_set) {
+        find_or_create_manifest_app_and_loc_options_containers(ctx,
+            plcf, cscf, clcf, &app_options_container, &loc_options_container);
+        option_container = find_or_create_manifest_option_container(ctx,
+            app_options_container,
+            "passenger_routing_method",
+            sizeof("passenger_routing_method") - 1);
+        hierarchy_member = add_manifest_option_container_hierarchy_member(option_container,
+            &plcf->autogenerated.routing_method_source_file,
+            plcf->autogenerated.routing_method_source_line);
+        psg_json_value_set_str(hierarchy_member, "value",
+            (const char *) plcf->autogenerated.routing_method.data,
+            plcf->autogenerated.routing_method.len);
+    }
+    if (plcf->autogenerated.max_memory_explicitly_set) {
+        find_or_create_manifest_app_and_loc_options_containers(ctx,
+            plcf, cscf, clcf, &app_options_container, &loc_options_container);
+        option_container = find_or_create_manifest_option_container(ctx,
+            app_options_container,
+            "passenger_max_memory",
+            sizeof("passenger_max_memory") - 1);
+        hierarchy_member = add_manifest_option_container_hierarchy_member(option_container,
+            &plcf->autogenerated.max_memory_source_file,
+            plcf->autogenerated.max_memory_source_line);
+        psg_json_value_set_uint(hierarchy_member, "value",
+            plcf->autogenerated.max_memory);
+    }
     if (plcf->autogenerated.enabled_explicitly_set) {
         find_or_create_manifest_app_and_loc_options_containers(ctx,
             plcf, cscf, clcf, &app_options_container, &loc_options_container);
@@ -49,6 +49,9 @@ passenger_merge_autogenerated_loc_conf(passenger_autogenerated_loc_conf_t *conf,
     ngx_conf_merge_str_value(conf->python,
         prev->python,
         "python");
+    ngx_conf_merge_uint_value(conf->python_thread_count,
+        prev->python_thread_count,
+        1);
     ngx_conf_merge_str_value(conf->nodejs,
         prev->nodejs,
         "node");
@@ -128,6 +131,18 @@ passenger_merge_autogenerated_loc_conf(passenger_autogenerated_loc_conf_t *conf,
     ngx_conf_merge_value(conf->force_max_concurrent_requests_per_process,
         prev->force_max_concurrent_requests_per_process,
         -1);
+    ngx_conf_merge_uint_value(conf->spawn_concurrency,
+        prev->spawn_concurrency,
+        1);
+    ngx_conf_merge_uint_value(conf->standby_processes,
+        prev->standby_processes,
+        0);
+    ngx_conf_merge_str_value(conf->routing_method,
+        prev->routing_method,
+        "least_busy");
+    ngx_conf_merge_uint_value(conf->max_memory,
+        prev->max_memory,
+        0);
     ngx_conf_merge_value(conf->enabled,
         prev->enabled,
         0);
@@ -51,12 +51,16 @@ typedef struct {
     ngx_uint_t headers_hash_max_size;
     ngx_array_t *headers_source;
     ngx_flag_t load_shell_envvars;
+    ngx_uint_t max_memory;
     ngx_int_t max_preloader_idle_time;
     ngx_uint_t max_request_queue_size;
     ngx_uint_t max_requests;
     ngx_uint_t min_instances;
     ngx_array_t *monitor_log_file;
+    ngx_uint_t python_thread_count;
     ngx_int_t request_queue_overflow_status_code;
+    ngx_uint_t spawn_concurrency;
+    ngx_uint_t standby_processes;
     ngx_uint_t start_timeout;
     ngx_flag_t sticky_sessions;
     ngx_str_t app_group_name;
@@ -73,6 +77,7 @@ typedef struct {
     ngx_str_t nodejs;
     ngx_str_t python;
     ngx_str_t restart_dir;
+    ngx_str_t routing_method;
     ngx_str_t ruby;
     ngx_str_t spawn_method;
     ngx_str_t startup_file;
@@ -103,6 +108,7 @@ typedef struct {
     ngx_str_t headers_hash_max_size_source_file;
     ngx_str_t headers_source_source_file;
     ngx_str_t load_shell_envvars_source_file;
+    ngx_str_t max_memory_source_file;
     ngx_str_t max_preloader_idle_time_source_file;
     ngx_str_t max_request_queue_size_source_file;
     ngx_str_t max_requests_source_file;
@@ -111,10 +117,14 @@ typedef struct {
     ngx_str_t monitor_log_file_source_file;
     ngx_str_t nodejs_source_file;
     ngx_str_t python_source_file;
+    ngx_str_t python_thread_count_source_file;
     ngx_str_t request_queue_overflow_status_code_source_file;
     ngx_str_t restart_dir_source_file;
+    ngx_str_t routing_method_source_file;
     ngx_str_t ruby_source_file;
+    ngx_str_t spawn_concurrency_source_file;
     ngx_str_t spawn_method_source_file;
+    ngx_str_t standby_processes_source_file;
     ngx_str_t start_timeout_source_file;
     ngx_str_t startup_file_source_file;
     ngx_str_t sticky_sessions_source_file;
@@ -156,6 +166,7 @@ typedef struct {
     ngx_uint_t headers_hash_max_size_source_line;
     ngx_uint_t headers_source_source_line;
     ngx_uint_t load_shell_envvars_source_line;
+    ngx_uint_t max_memory_source_line;
     ngx_uint_t max_preloader_idle_time_source_line;
     ngx_uint_t max_request_queue_size_source_line;
     ngx_uint_t max_requests_source_line;
@@ -164,10 +175,14 @@ typedef struct {
     ngx_uint_t monitor_log_file_source_line;
     ngx_uint_t nodejs_source_line;
     ngx_uint_t python_source_line;
+    ngx_uint_t python_thread_count_source_line;
     ngx_uint_t request_queue_overflow_status_code_source_line;
     ngx_uint_t restart_dir_source_line;
+    ngx_uint_t routing_method_source_line;
     ngx_uint_t ruby_source_line;
+    ngx_uint_t spawn_concurrency_source_line;
     ngx_uint_t spawn_method_source_line;
+    ngx_uint_t standby_processes_source_line;
     ngx_uint_t start_timeout_source_line;
     ngx_uint_t startup_file_source_line;
     ngx_uint_t sticky_sessions_source_line;
@@ -209,6 +224,7 @@ typedef struct {
     ngx_int_t headers_hash_max_size_explicitly_set;
     ngx_int_t headers_source_explicitly_set;
     ngx_int_t load_shell_envvars_explicitly_set;
+    ngx_int_t max_memory_explicitly_set;
     ngx_int_t max_preloader_idle_time_explicitly_set;
     ngx_int_t max_request_queue_size_explicitly_set;
     ngx_int_t max_requests_explicitly_set;
@@ -217,10 +233,14 @@ typedef struct {
     ngx_int_t monitor_log_file_explicitly_set;
     ngx_int_t nodejs_explicitly_set;
     ngx_int_t python_explicitly_set;
+    ngx_int_t python_thread_count_explicitly_set;
     ngx_int_t request_queue_overflow_status_code_explicitly_set;
     ngx_int_t restart_dir_explicitly_set;
+    ngx_int_t routing_method_explicitly_set;
     ngx_int_t ruby_explicitly_set;
+    ngx_int_t spawn_concurrency_explicitly_set;
     ngx_int_t spawn_method_explicitly_set;
+    ngx_int_t standby_processes_explicitly_set;
     ngx_int_t start_timeout_explicitly_set;
     ngx_int_t startup_file_explicitly_set;
     ngx_int_t sticky_sessions_explicitly_set;
@@ -159,6 +159,17 @@ generate_config_manifest_for_autogenerated_main_conf(manifest_gen_ctx_t *ctx, pa
         psg_json_value_set_uint(hierarchy_member, "value",
             conf->autogenerated.socket_backlog);
     }
+    if (conf->autogenerated.core_keepalive_explicitly_set) {
+        option_container = find_or_create_manifest_option_container(ctx,
+            ctx->global_config_container,
+            "passenger_core_keepalive",
+            sizeof("passenger_core_keepalive") - 1);
+        hierarchy_member = add_manifest_option_container_hierarchy_member(option_container,
+            &conf->autogenerated.core_keepalive_source_file,
+            conf->autogenerated.core_keepalive_source_line);
+        psg_json_value_set_uint(hierarchy_member, "value",
+            conf->autogenerated.core_keepalive);
+    }
     if (conf->autogenerated.core_file_descriptor_ulimit_explicitly_set) {
         option_container = find_or_create_manifest_option_container(ctx,
             ctx->global_config_container,
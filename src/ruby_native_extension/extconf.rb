@@ -49,6 +49,8 @@
 have_var('ruby_version')
 have_func('rb_thread_io_blocking_region', 'ruby/io.h')
 have_func('rb_thread_call_without_gvl', 'ruby/thread.h')
+have_func('rb_hash_new_capa', 'ruby.h')
+have_func('rb_interned_str', 'ruby.h')
 
 with_cflags($CFLAGS) do
 	create_makefile('passenger_native_support')
@@ -146,6 +146,159 @@ split_by_null_into_hash(VALUE self, VALUE data) {
 	return result;
 }
 
+/*
+ * The CGI variable names that the Core sends for (nearly) every request.
+ * split_by_null_into_env() uses a single frozen string for each of them,
+ * instead of allocating a new key string for every request.
+ */
+static const char *known_env_keys[] = {
+	"REQUEST_URI", "PATH_INFO", "SCRIPT_NAME", "QUERY_STRING",
+	"REQUEST_METHOD", "SERVER_NAME", "SERVER_PORT", "SERVER_PROTOCOL",
+	"SERVER_SOFTWARE", "REMOTE_ADDR", "REMOTE_PORT", "REMOTE_USER",
+	"CONTENT_TYPE", "CONTENT_LENGTH", "HTTPS", "PASSENGER_CONNECT_PASSWORD",
+	"HTTP_ACCEPT", "HTTP_ACCEPT_CHARSET", "HTTP_ACCEPT_ENCODING",
+	"HTTP_ACCEPT_LANGUAGE", "HTTP_AUTHORIZATION", "HTTP_CACHE_CONTROL",
+	"HTTP_CDN_LOOP", "HTTP_CONNECTION", "HTTP_COOKIE", "HTTP_DNT",
+	"HTTP_FORWARDED", "HTTP_HOST", "HTTP_IF_MATCH", "HTTP_IF_MODIFIED_SINCE",
+	"HTTP_IF_NONE_MATCH", "HTTP_IF_UNMODIFIED_SINCE", "HTTP_ORIGIN",
+	"HTTP_PRAGMA", "HTTP_RANGE", "HTTP_REFERER", "HTTP_SEC_FETCH_DEST",
+	"HTTP_SEC_FETCH_MODE", "HTTP_SEC_FETCH_SITE", "HTTP_SEC_FETCH_USER",
+	"HTTP_TE", "HTTP_UPGRADE", "HTTP_UPGRADE_INSECURE_REQUESTS",
+	"HTTP_USER_AGENT", "HTTP_VIA", "HTTP_X_CSRF_TOKEN", "HTTP_X_FORWARDED_FOR",
+	"HTTP_X_FORWARDED_HOST", "HTTP_X_FORWARDED_PORT", "HTTP_X_FORWARDED_PROTO",
+	"HTTP_X_FORWARDED_SSL", "HTTP_X_REAL_IP", "HTTP_X_REQUEST_ID",
+	"HTTP_X_REQUEST_START", "HTTP_X_REQUESTED_WITH", "HTTP_CONTENT_TYPE",
+	"HTTP_CONTENT_LENGTH", "HTTP_TRANSFER_ENCODING",
+	NULL
+};
+
+/* Open addressing hash table from key to frozen key string. Must be a power
+ * of 2, and comfortably larger than the number of known keys. */
+#define KNOWN_ENV_KEY_TABLE_SIZE 256
+
+typedef struct {
+	const char *name;
+	unsigned int len;
+	VALUE str;
+} KnownEnvKey;
+
+static KnownEnvKey known_env_key_table[KNOWN_ENV_KEY_TABLE_SIZE];
+
+static unsigned int
+hash_env_key(const char *data, unsigned int len) {
+	/* FNV-1a */
+	unsigned int result = 2166136261u;
+	unsigned int i;
+
+	for (i = 0; i < len; i++) {
+		result = (result ^ (unsigned char) data[i]) * 16777619u;
+	}
+	return result;
+}
+
+static void
+init_known_env_keys(void) {
+	unsigned int i, len, slot;
+	VALUE str;
+
+	for (i = 0; known_env_keys[i] != NULL; i++) {
+		len = (unsigned int) strlen(known_env_keys[i]);
+		#ifdef HAVE_RB_INTERNED_STR
+			/* Shares the string with identical frozen string literals. */
+			str = rb_interned_str(known_env_keys[i], len);
+		#else
+			str = rb_obj_freeze(rb_str_new(known_env_keys[i], len));
+		#endif
+		rb_gc_register_mark_object(str);
+
+		slot = hash_env_key(known_env_keys[i], len) & (KNOWN_ENV_KEY_TABLE_SIZE - 1);
+		while (known_env_key_table[slot].name != NULL) {
+			slot = (slot + 1) & (KNOWN_ENV_KEY_TABLE_SIZE - 1);
+		}
+		known_env_key_table[slot].name = known_env_keys[i];
+		known_env_key_table[slot].len = len;
+		known_env_key_table[slot].str = str;
+	}
+}
+
+static VALUE
+lookup_known_env_key(const char *data, unsigned int len) {
+	unsigned int slot = hash_env_key(data, len) & (KNOWN_ENV_KEY_TABLE_SIZE - 1);
+
+	while (known_env_key_table[slot].name != NULL) {
+		if (known_env_key_table[slot].len == len
+		 && memcmp(known_env_key_table[slot].name, data, len) == 0)
+		{
+			return known_env_key_table[slot].str;
+		}
+		slot = (slot + 1) & (KNOWN_ENV_KEY_TABLE_SIZE - 1);
+	}
+	return Qnil;
+}
+
+static int
+merge_base_env_entry(VALUE key, VALUE value, VALUE env) {
+	rb_hash_aset(env, key, value);
+	return ST_CONTINUE;
+}
+
+/**
+ * Like split_by_null_into_hash, but builds a request env in one pass: known CGI
+ * variable names map to shared frozen key strings, the hash is allocated with
+ * room for all entries, and the entries of +base_env+ (e.g. the constant Rack
+ * env entries) are added last, so that they take precedence over the
+ * request's headers.
+ */
+static VALUE
+split_by_null_into_env(VALUE self, VALUE data, VALUE base_env) {
+	const char *cdata   = RSTRING_PTR(data);
+	unsigned long len   = RSTRING_LEN(data);
+	const char *begin   = cdata;
+	const char *current = cdata;
+	const char *end     = cdata + len;
+	VALUE result, key, value;
+
+	Check_Type(base_env, T_HASH);
+
+	#ifdef HAVE_RB_HASH_NEW_CAPA
+	{
+		long nulls = 0;
+		for (current = cdata; current < end; current++) {
+			nulls += (*current == '\0');
+		}
+		current = cdata;
+		result = rb_hash_new_capa(nulls / 2 + RHASH_SIZE(base_env));
+	}
+	#else
+		result = rb_hash_new();
+	#endif
+
+	while (current < end) {
+		if (*current == '\0') {
+			key = lookup_known_env_key(begin, (unsigned int) (current - begin));
+			if (NIL_P(key)) {
+				key = rb_str_subseq(data, begin - cdata, current - begin);
+			}
+			begin = current = current + 1;
+			while (current < end) {
+				if (*current == '\0') {
+					value = rb_str_subseq(data, begin - cdata, current - begin);
+					begin = current = current + 1;
+					rb_hash_aset(result, key, value);
+					break;
+				} else {
+					current++;
+				}
+			}
+		} else {
+			current++;
+		}
+	}
+
+	rb_hash_foreach(base_env, merge_base_env_entry, result);
+	return result;
+}
+
 typedef struct {
 	/* The IO vectors in this group. */
 	struct iovec *io_vectors;
@@ -974,9 +1127,11 @@ Init_passenger_native_support() {
 	mNativeSupport = rb_define_module_under(mPassenger, "NativeSupport");
 
 	S_ProcessTimes = rb_struct_define("ProcessTimes", "utime", "stime", NULL);
+	init_known_env_keys();
 
 	rb_define_singleton_method(mNativeSupport, "disable_stdio_buffering", disable_stdio_buffering, 0);
 	rb_define_singleton_method(mNativeSupport, "split_by_null_into_hash", split_by_null_into_hash, 1);
+	rb_define_singleton_method(mNativeSupport, "split_by_null_into_env", split_by_null_into_env, 2);
 	rb_define_singleton_method(mNativeSupport, "writev", f_writev, 2);
 	rb_define_singleton_method(mNativeSupport, "writev2", f_writev2, 3);
 	rb_define_singleton_method(mNativeSupport, "writev3", f_writev3, 4);
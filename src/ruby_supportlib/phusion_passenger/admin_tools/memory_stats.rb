@@ -90,7 +90,7 @@ def nginx_processes
       # Phusion Passenger is not running.
       def passenger_processes
         @passenger_processes ||= list_processes(:match =>
-          /((^| )Passenger|(^| )Rails:|(^| )Rack:|wsgi-loader.py|(.*)PassengerAgent|rack-loader.rb)/)
+          /((^| )Passenger|(^| )Rails:|(^| )Rack:|wsgi-loader.py|wsgi-preloader.py|(.*)PassengerAgent|rack-loader.rb)/)
       end
 
       # Returns the sum of the memory usages of all given processes.
@@ -153,6 +153,14 @@
     :default_expr => 'DEFAULT_SOCKET_BACKLOG',
     :desc      => "The #{PROGRAM_NAME} socket backlog."
   },
+  {
+    :name      => 'PassengerCoreKeepalive',
+    :type      => :integer,
+    :context   => :global,
+    :min_value => 0,
+    :default   => 0,
+    :desc      => "The maximum number of idle connections to the #{PROGRAM_NAME} core that every Apache process keeps open for reuse."
+  },
   {
     :name      => 'PassengerFileDescriptorLogFile',
     :type      => :string,
@@ -335,6 +343,13 @@
     :default_expr => 'DEFAULT_PYTHON',
     :desc      => 'The Python interpreter to use.'
   },
+  {
+    :name      => 'PassengerPythonThreadCount',
+    :type      => :integer,
+    :min_value => 1,
+    :default   => 1,
+    :desc      => 'The number of threads with which each Python process handles requests.'
+  },
   {
     :name      => 'PassengerNodejs',
     :type      => :string,
@@ -481,6 +496,33 @@
     :desc      => "Force #{SHORT_PROGRAM_NAME} to believe that an application process " \
                  "can handle the given number of concurrent requests per process"
   },
+  {
+    :name      => 'PassengerSpawnConcurrency',
+    :type      => :integer,
+    :min_value => 1,
+    :default   => 1,
+    :desc      => 'The maximum number of processes per application that may be spawned concurrently.'
+  },
+  {
+    :name      => 'PassengerStandbyProcesses',
+    :type      => :integer,
+    :min_value => 0,
+    :default   => 0,
+    :desc      => 'The number of spare application processes to keep spawned on standby.'
+  },
+  {
+    :name      => 'PassengerRoutingMethod',
+    :type      => :string,
+    :default   => DEFAULT_ROUTING_METHOD,
+    :desc      => "How to distribute requests over application processes: 'least_busy' or 'latency'."
+  },
+  {
+    :name      => 'PassengerMaxMemory',
+    :type      => :integer,
+    :min_value => 0,
+    :default   => 0,
+    :desc      => 'The amount of memory in MB above which an application process is gracefully replaced.'
+  },
   {
     :name      => 'PassengerAppRoot',
     :type      => :string,
@@ -58,6 +58,7 @@ module SharedConstants
     DEFAULT_WEB_APP_USER = "nobody"
     DEFAULT_APP_ENV = "production"
     DEFAULT_SPAWN_METHOD = "smart"
+    DEFAULT_ROUTING_METHOD = "least_busy"
     DEFAULT_BIND_ADDRESS = "127.0.0.1"
     # Apache's unixd.h also defines DEFAULT_USER, so we avoid naming clash here.
     PASSENGER_DEFAULT_USER = "nobody"
@@ -66,8 +67,13 @@ module SharedConstants
     DEFAULT_STICKY_SESSIONS_COOKIE_ATTRIBUTES = "SameSite=Lax; Secure;"
     DEFAULT_APP_THREAD_COUNT = 1
     DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK = 1024 * 1024 * 128
+    DEFAULT_RESPONSE_COMPRESSION_LEVEL = 6
+    DEFAULT_RESPONSE_COMPRESSION_MIN_SIZE = 1024
+    DEFAULT_RESPONSE_SPLICE_MIN_SIZE = 1024 * 128
     DEFAULT_MAX_REQUEST_QUEUE_SIZE = 100
     DEFAULT_STAT_THROTTLE_RATE = 10
+    DEFAULT_TURBOCACHE_MAX_ENTRIES = 1024
+    DEFAULT_TURBOCACHE_MAX_SIZE = 1024 * 1024 * 16
     DEFAULT_ANALYTICS_LOG_USER = DEFAULT_WEB_APP_USER
     DEFAULT_ANALYTICS_LOG_GROUP = ""
     DEFAULT_ANALYTICS_LOG_PERMISSIONS = "u=rwx,g=rx,o=rx"
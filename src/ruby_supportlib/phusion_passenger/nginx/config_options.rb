@@ -185,6 +185,14 @@
     :context  => [:main],
     :struct   => "NGX_HTTP_MAIN_CONF_OFFSET"
   },
+  {
+    :name     => 'passenger_core_keepalive',
+    :scope    => :global,
+    :type     => :uinteger,
+    :default  => 0,
+    :context  => [:main],
+    :struct   => 'NGX_HTTP_MAIN_CONF_OFFSET'
+  },
   {
     :name     => 'passenger_core_file_descriptor_ulimit',
     :scope    => :global,
@@ -379,6 +387,12 @@
     :type     => :string,
     :default  => DEFAULT_PYTHON
   },
+  {
+    :name     => 'passenger_python_thread_count',
+    :scope    => :application,
+    :type     => :uinteger,
+    :default  => 1
+  },
   {
     :name     => 'passenger_nodejs',
     :scope    => :application,
@@ -531,6 +545,30 @@
     :type     => :integer,
     :default  => -1
   },
+  {
+    :name     => 'passenger_spawn_concurrency',
+    :scope    => :application,
+    :type     => :uinteger,
+    :default  => 1
+  },
+  {
+    :name     => 'passenger_standby_processes',
+    :scope    => :application,
+    :type     => :uinteger,
+    :default  => 0
+  },
+  {
+    :name     => 'passenger_routing_method',
+    :scope    => :application,
+    :type     => :string,
+    :default  => DEFAULT_ROUTING_METHOD
+  },
+  {
+    :name     => 'passenger_max_memory',
+    :scope    => :application,
+    :type     => :uinteger,
+    :default  => 0
+  },
 
   ###### Per-location/per-request configuration ######
 
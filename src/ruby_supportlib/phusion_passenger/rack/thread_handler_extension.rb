@@ -76,28 +76,35 @@ module ThreadHandlerExtension
       NAME_VALUE_SEPARATOR = ": "         # :nodoc:
       TERMINATION_CHUNK    = "0\r\n\r\n"  # :nodoc:
 
+      # The Rack env entries that don't depend on the request. ThreadHandler
+      # adds them to the env while parsing the request.
+      def base_env
+        {
+          RACK_VERSION      => RACK_VERSION_VALUE,
+          RACK_ERRORS       => STDERR,
+          RACK_MULTITHREAD  => @request_handler.concurrency > 1,
+          RACK_MULTIPROCESS => true,
+          RACK_RUN_ONCE     => false,
+          RACK_HIJACK_P     => true,
+          HTTP_VERSION      => HTTP_1_1
+        }
+      end
+
       def process_request(env, connection, socket_wrapper, full_http_response)
         rewindable_input = PhusionPassenger::Utils::TeeInput.new(connection, env)
         begin
-          env[RACK_VERSION]      = RACK_VERSION_VALUE
-          env[RACK_INPUT]        = rewindable_input
-          env[RACK_ERRORS]       = STDERR
-          env[RACK_MULTITHREAD]  = @request_handler.concurrency > 1
-          env[RACK_MULTIPROCESS] = true
-          env[RACK_RUN_ONCE]     = false
+          env[RACK_INPUT] = rewindable_input
           if env[HTTPS] == YES || env[HTTPS] == ON || env[HTTPS] == ONE
             env[RACK_URL_SCHEME] = HTTPS_DOWNCASE
           else
             env[RACK_URL_SCHEME] = HTTP
           end
-          env[RACK_HIJACK_P] = true
           env[RACK_HIJACK] = lambda do
             env[RACK_HIJACK_IO] ||= begin
               connection.stop_simulating_eof!
               connection
             end
           end
-          env[HTTP_VERSION] = HTTP_1_1
 
           # Rails somehow modifies env['REQUEST_METHOD'], so we perform the comparison
           # before the Rack application object is called.
@@ -76,6 +76,9 @@ def initialize(request_handler, options = {})
         @stats_mutex   = Mutex.new
         @interruptable = false
         @iteration     = 0
+        # The env entries that are the same for every request. Extensions
+        # provide them by implementing #base_env.
+        @base_env      = (respond_to?(:base_env, true) ? base_env : {}).freeze
 
         if @protocol == :session
           metaclass = class << self; self; end
@@ -215,7 +218,7 @@ def parse_session_request(connection, channel, buffer)
         if headers_data.nil?
           return
         end
-        headers = Utils::NativeSupportUtils.split_by_null_into_hash(headers_data)
+        headers = Utils::NativeSupportUtils.split_by_null_into_env(headers_data, @base_env)
         if @connect_password && headers[PASSENGER_CONNECT_PASSWORD] != @connect_password
           warn "*** Passenger RequestHandler warning: " <<
             "someone tried to connect with an invalid connect password."
@@ -284,6 +287,8 @@ def parse_http_request(connection, channel, buffer)
           end
         end
 
+        headers.merge!(@base_env)
+
         if @connect_password && headers["HTTP_X_PASSENGER_CONNECT_PASSWORD"] != @connect_password
           warn "*** Passenger RequestHandler warning: " <<
             "someone tried to connect with an invalid connect password."
@@ -306,6 +311,11 @@ def process_oobw(env, connection)
 
     # def process_request(env, connection, socket_wrapper, full_http_response)
     #   raise NotImplementedError, "Override with your own implementation!"
+    # end
+
+    # def base_env
+    #   # Optional. Returns a hash with the env entries that are the same
+    #   # for every request. It is merged into every request's env.
     # end
 
       def prepare_request(connection, headers)
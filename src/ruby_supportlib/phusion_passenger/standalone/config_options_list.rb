@@ -116,6 +116,19 @@ module Standalone
         :desc      => "Override size of the socket backlog.\n" \
                       "Default: #{DEFAULT_SOCKET_BACKLOG}"
       },
+      {
+        :name      => :reuse_port,
+        :type      => :boolean,
+        :desc      => "Give each #{SHORT_PROGRAM_NAME} core thread its\n" \
+                      "own SO_REUSEPORT server socket (builtin\n" \
+                      "engine only, Linux only)"
+      },
+      {
+        :name      => :cpu_affine,
+        :type      => :boolean,
+        :desc      => "Pin each #{SHORT_PROGRAM_NAME} core thread to a\n" \
+                      "CPU (builtin engine only, Linux only)"
+      },
       {
         :name      => :ssl,
         :type      => :boolean,
@@ -175,6 +188,13 @@ module Standalone
         :type      => :path,
         :desc      => 'Use the given data buffer directory'
       },
+      {
+        :name      => :data_buffer_io_uring,
+        :type      => :boolean,
+        :desc      => "Use io_uring for reading and writing data\n" \
+                      "buffer files, if supported by the kernel\n" \
+                      "(builtin engine only)"
+      },
       {
         :name      => :core_file_descriptor_ulimit,
         :type      => :integer,
@@ -206,6 +226,21 @@ module Standalone
         :type_desc => 'FILENAME',
         :desc      => 'Executable to use for Python apps'
       },
+      {
+        :name      => :python_thread_count,
+        :type      => :integer,
+        :min       => 1,
+        :desc      => "Number of threads with which each\n" \
+                      "Python process handles requests.\n" \
+                      'Default: 1'
+      },
+      {
+        :name      => :python_smart_spawning,
+        :type      => :boolean,
+        :desc      => "Spawn Python apps through a preloader\n" \
+                      "when the spawn method is 'smart'.\n" \
+                      'Default: spawn Python apps directly'
+      },
       {
         :name      => :nodejs,
         :type_desc => 'FILENAME',
@@ -367,6 +402,38 @@ module Standalone
                       "application process can handle the given\n" \
                       "number of concurrent requests per process"
       },
+      {
+        :name      => :spawn_concurrency,
+        :type      => :integer,
+        :min       => 1,
+        :desc      => "Maximum number of processes per\n" \
+                      "application that may be spawned\n" \
+                      'concurrently. Default: 1'
+      },
+      {
+        :name      => :standby_processes,
+        :type      => :integer,
+        :min       => 0,
+        :desc      => "Number of spare application processes\n" \
+                      "to keep spawned on standby. Default: 0"
+      },
+      {
+        :name      => :routing_method,
+        :type_desc => 'NAME',
+        :default   => DEFAULT_ROUTING_METHOD,
+        :desc      => "How to distribute requests over\n" \
+                      "application processes: 'least_busy'\n" \
+                      "or 'latency'. Default: #{DEFAULT_ROUTING_METHOD}"
+      },
+      {
+        :name      => :max_memory,
+        :type      => :integer,
+        :type_desc => 'MB',
+        :min       => 0,
+        :desc      => "Gracefully replace application processes\n" \
+                      "that use more memory than this.\n" \
+                      "Default: 0 (unlimited)"
+      },
       {
         :name      => :start_timeout,
         :type      => :integer,
@@ -468,6 +535,55 @@ module Standalone
           options[:turbocaching] = false
         end
       },
+      {
+        :name      => :response_compression,
+        :type      => :boolean,
+        :desc      => "Gzip-compress application responses for\n" \
+                      "clients that accept it (builtin engine\n" \
+                      "only)"
+      },
+      {
+        :name      => :response_compression_level,
+        :type      => :integer,
+        :min       => 1,
+        :desc      => "Gzip compression level, 1-9.\n" \
+                      "Default: #{DEFAULT_RESPONSE_COMPRESSION_LEVEL}"
+      },
+      {
+        :name      => :response_compression_min_size,
+        :type      => :integer,
+        :min       => 0,
+        :type_desc => 'BYTES',
+        :desc      => "Do not compress responses with a smaller\n" \
+                      "Content-Length.\n" \
+                      "Default: #{DEFAULT_RESPONSE_COMPRESSION_MIN_SIZE}"
+      },
+      {
+        :name      => :response_splice_min_size,
+        :type      => :integer,
+        :min       => 0,
+        :type_desc => 'BYTES',
+        :desc      => "Relay response bodies with at least this\n" \
+                      "many bytes left with splice() while the\n" \
+                      "client keeps up. 0 disables splicing\n" \
+                      "(builtin engine only).\n" \
+                      "Default: #{DEFAULT_RESPONSE_SPLICE_MIN_SIZE}"
+      },
+      {
+        :name      => :sendfile_roots,
+        :type      => :array,
+        :type_desc => 'PATH',
+        :cli       => '--sendfile-root',
+        :desc      => "Serve files referenced by X-Sendfile and\n" \
+                      "X-Accel-Redirect headers if they are inside\n" \
+                      "this directory. Specify multiple times for\n" \
+                      "multiple directories (builtin engine only)",
+        :default   => [],
+        :cli_parser => lambda do |options, value|
+          options[:sendfile_roots] ||= []
+          options[:sendfile_roots] << value
+        end
+      },
       {
         :name      => :unlimited_concurrency_paths,
         :type      => :array,
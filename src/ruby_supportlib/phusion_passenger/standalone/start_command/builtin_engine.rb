@@ -111,6 +111,7 @@ def build_daemon_controller_options
           add_param(command, :instance_registry_dir, "--instance-registry-dir")
           add_param(command, :spawn_dir, "--spawn-dir")
           add_param(command, :data_buffer_dir, "--data-buffer-dir")
+          add_flag_param(command, :data_buffer_io_uring, "--data-buffer-io-uring")
           add_param(command, :log_level, "--log-level")
           add_flag_param(command, :disable_log_prefix, "--disable-log-prefix")
           @options[:ctls].each do |ctl|
@@ -138,6 +139,8 @@ def build_daemon_controller_options
           command << " --listen #{listen_address(@apps[0])}"
           command << " --no-graceful-exit"
           add_param(command, :socket_backlog, "--socket-backlog")
+          add_flag_param(command, :reuse_port, "--reuse-port")
+          add_flag_param(command, :cpu_affine, "--cpu-affine")
           add_param(command, :environment, "--environment")
           add_param(command, :app_type, "--app-type")
           add_param(command, :startup_file, "--startup-file")
@@ -161,6 +164,10 @@ def build_daemon_controller_options
           add_flag_param(command, :load_shell_envvars, "--load-shell-envvars")
           add_param(command, :max_pool_size, "--max-pool-size")
           add_param(command, :min_instances, "--min-instances")
+          add_param(command, :spawn_concurrency, "--spawn-concurrency")
+          add_param(command, :standby_processes, "--standby-processes")
+          add_param(command, :routing_method, "--routing-method")
+          add_param(command, :max_memory, "--max-memory")
           add_param(command, :pool_idle_time, "--pool-idle-time")
           add_param(command, :max_preloader_idle_time, "--max-preloader-idle-time")
           add_param(command, :max_request_queue_size, "--max-request-queue-size")
@@ -174,10 +181,19 @@ def build_daemon_controller_options
           add_enterprise_flag_param(command, :debugger, "--debugger")
           add_flag_param(command, :sticky_sessions, "--sticky-sessions")
           add_param(command, :vary_turbocache_by_cookie, "--vary-turbocache-by-cookie")
+          add_flag_param(command, :response_compression, "--response-compression")
+          add_param(command, :response_compression_level, "--response-compression-level")
+          add_param(command, :response_compression_min_size, "--response-compression-min-size")
+          add_param(command, :response_splice_min_size, "--response-splice-min-size")
+          @options[:sendfile_roots].each do |root|
+            command << " --sendfile-root #{Shellwords.escape root}"
+          end
           add_param(command, :sticky_sessions_cookie_name, "--sticky-sessions-cookie-name")
           add_param(command, :sticky_sessions_cookie_attributes, "--sticky-sessions-cookie-attributes")
           add_param(command, :ruby, "--ruby")
           add_param(command, :python, "--python")
+          add_param(command, :python_thread_count, "--python-thread-count")
+          add_flag_param(command, :python_smart_spawning, "--python-smart-spawning")
           add_param(command, :nodejs, "--nodejs")
           add_param(command, :meteor_app_settings, "--meteor-app-settings")
           add_param(command, :core_file_descriptor_ulimit, "--core-file-descriptor-ulimit")
@@ -38,6 +38,12 @@ def split_by_null_into_hash(data)
           return PhusionPassenger::NativeSupport.split_by_null_into_hash(data)
         end
 
+        # Like #split_by_null_into_hash, but also adds the entries of the given
+        # base env. They take precedence over the entries in the data.
+        def split_by_null_into_env(data, base_env)
+          return PhusionPassenger::NativeSupport.split_by_null_into_env(data, base_env)
+        end
+
         # Wrapper for getrusage().
         def process_times
           return PhusionPassenger::NativeSupport.process_times
@@ -54,6 +60,10 @@ def split_by_null_into_hash(data)
           return Hash[*args]
         end
 
+        def split_by_null_into_env(data, base_env)
+          return split_by_null_into_hash(data).merge!(base_env)
+        end
+
         def process_times
           times = Process.times
           return ProcessTimes.new((times.utime * 1_000_000).to_i,
@@ -0,0 +1,91 @@
+#include <TestSupport.h>
+#include <Algorithms/LatencyHistogram.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct Algorithms_LatencyHistogramTest: public TestBase {
+		LatencyHistogram histogram;
+	};
+
+	DEFINE_TEST_GROUP(Algorithms_LatencyHistogramTest);
+
+	TEST_METHOD(1) {
+		// An empty histogram reports zeroes.
+		ensure_equals(histogram.getCount(), 0u);
+		ensure_equals(histogram.getMean(), 0u);
+		ensure_equals(histogram.getMax(), 0u);
+		ensure_equals(histogram.getPercentile(99), 0u);
+	}
+
+	TEST_METHOD(2) {
+		// Small values are counted exactly.
+		for (unsigned int i = 0; i < 8; i++) {
+			ensure_equals(LatencyHistogram::bucketIndex(i), i);
+			ensure_equals(LatencyHistogram::bucketUpperBound(i), (boost::uint64_t) i);
+		}
+	}
+
+	TEST_METHOD(3) {
+		// Every value falls into a bucket whose upper bound is at least the value,
+		// and at most 12.5% larger.
+		boost::uint64_t values[] = { 8, 9, 15, 16, 17, 100, 999, 1000, 123456,
+			1000000, 60000000, 3600000000ull };
+		for (unsigned int i = 0; i < sizeof(values) / sizeof(boost::uint64_t); i++) {
+			unsigned int index = LatencyHistogram::bucketIndex(values[i]);
+			boost::uint64_t upperBound = LatencyHistogram::bucketUpperBound(index);
+			ensure(toString(values[i]) + " <= upper bound",
+				values[i] <= upperBound);
+			ensure(toString(values[i]) + " within error",
+				upperBound - values[i] <= values[i] / 8);
+			if (index > 0) {
+				ensure(toString(values[i]) + " > previous upper bound",
+					values[i] > LatencyHistogram::bucketUpperBound(index - 1));
+			}
+		}
+	}
+
+	TEST_METHOD(4) {
+		// Values that are too large for the histogram end up in the last bucket.
+		unsigned int lastIndex = LatencyHistogram::BUCKET_COUNT - 1;
+		ensure_equals(LatencyHistogram::bucketIndex(~(boost::uint64_t) 0), lastIndex);
+		histogram.record(~(boost::uint64_t) 0);
+		ensure_equals(histogram.getPercentile(50), ~(boost::uint64_t) 0);
+	}
+
+	TEST_METHOD(5) {
+		// Test percentiles, mean and max.
+		for (unsigned int i = 1; i <= 1000; i++) {
+			histogram.record(i * 1000);
+		}
+		ensure_equals(histogram.getCount(), 1000u);
+		ensure_equals(histogram.getMean(), 500500u);
+		ensure_equals(histogram.getMax(), 1000000u);
+
+		boost::uint64_t p50 = histogram.getPercentile(50);
+		boost::uint64_t p99 = histogram.getPercentile(99);
+		ensure("p50 >= actual", p50 >= 500000);
+		ensure("p50 within error", p50 <= 500000 + 500000 / 8);
+		ensure("p99 >= actual", p99 >= 990000);
+		ensure("p99 is capped by max", p99 <= 1000000);
+		ensure_equals(histogram.getPercentile(100), 1000000u);
+	}
+
+	TEST_METHOD(6) {
+		// Test merge() and reset().
+		LatencyHistogram other;
+		histogram.record(10);
+		other.record(20);
+		other.record(30);
+		histogram.merge(other);
+		ensure_equals(histogram.getCount(), 3u);
+		ensure_equals(histogram.getSum(), 60u);
+		ensure_equals(histogram.getMean(), 20u);
+		ensure_equals(histogram.getMax(), 30u);
+
+		histogram.reset();
+		ensure_equals(histogram.getCount(), 0u);
+		ensure_equals(histogram.getPercentile(50), 0u);
+	}
+}
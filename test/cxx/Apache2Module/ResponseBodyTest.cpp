@@ -0,0 +1,330 @@
+#include <TestSupport.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <IOTools/IOUtils.h>
+#include "../../../src/apache2_module/ResponseBody.h"
+
+using namespace Passenger;
+using namespace Passenger::Apache2Module;
+using namespace std;
+
+namespace tut {
+	struct Apache2Module_ResponseBodyTest: public TestBase {
+		SocketPair sockets;
+		boost::shared_ptr<ResponseBodyState> state;
+		int errcode;
+
+		Apache2Module_ResponseBodyTest()
+			: errcode(0)
+			{ }
+
+		/**
+		 * Sets up a response whose header is `header`. `pending` is the data
+		 * that was read along with the header, and `rest` is the data that
+		 * the Passenger core sends after that.
+		 */
+		void init(const string &header, const string &pending, const string &rest,
+			bool headerOnly = false, bool closeAfterwards = false)
+		{
+			sockets = createUnixSocketPair(__FILE__, __LINE__);
+			state = boost::make_shared<ResponseBodyState>(sockets.first);
+			state->pendingData = pending;
+			determineResponseFraming(header, headerOnly, *state);
+			if (!rest.empty()) {
+				writeExact(sockets.second, rest);
+			}
+			if (closeAfterwards) {
+				sockets.second.close();
+			}
+		}
+
+		/**
+		 * Reads the entire response body, `bufsize` bytes at a time.
+		 * Returns the body, and sets `errcode` if an error occurred.
+		 */
+		string readBody(size_t bufsize = 1024) {
+			string result;
+			char buf[1024];
+			ssize_t ret;
+
+			assert(bufsize <= sizeof(buf));
+			errcode = 0;
+			while ((ret = readResponseBody(*state, buf, bufsize)) > 0) {
+				result.append(buf, ret);
+			}
+			if (ret == -1) {
+				errcode = errno;
+			}
+			return result;
+		}
+
+		/** Returns what the Passenger core has sent but we haven't read yet. */
+		string readUnconsumedData() {
+			char buf[1024];
+			ssize_t ret;
+
+			setNonBlocking(sockets.first);
+			ret = read(sockets.first, buf, sizeof(buf));
+			if (ret == -1) {
+				return string();
+			} else {
+				return string(buf, ret);
+			}
+		}
+	};
+
+	DEFINE_TEST_GROUP(Apache2Module_ResponseBodyTest);
+
+	#define CHUNKED_HEADER \
+		"HTTP/1.1 200 OK\r\n" \
+		"Content-Type: text/plain\r\n" \
+		"Transfer-Encoding: chunked\r\n\r\n"
+
+
+	/***** Content-Length *****/
+
+	TEST_METHOD(1) {
+		set_test_name("A body with a Content-Length ends after that many bytes, "
+			"and the connection can be reused");
+		init("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\n", "",
+			"hello" "HTTP/1.1 200 OK");
+
+		ensure_equals(state->bodyType, ResponseBodyState::BODY_CONTENT_LENGTH);
+		ensure_equals(readBody(), "hello");
+		ensure_equals("No error", errcode, 0);
+		ensure("The connection can be reused", state->keepAlive);
+		ensure_equals("The next response is not consumed",
+			readUnconsumedData(), "HTTP/1.1 200 OK");
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("A body with a Content-Length may be partly read along with the header");
+		init("HTTP/1.1 200 OK\r\nContent-Length: 11\r\n\r\n", "hello",
+			" world");
+
+		ensure_equals(readBody(3), "hello world");
+		ensure_equals("No error", errcode, 0);
+		ensure("The connection can be reused", state->keepAlive);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("If the header says 'Connection: close', then the connection "
+			"is not reused");
+		init("HTTP/1.1 200 OK\r\nContent-Length: 5\r\nConnection: close\r\n\r\n",
+			"", "hello");
+
+		ensure_equals(readBody(), "hello");
+		ensure("The connection cannot be reused", !state->keepAlive);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("If the connection is closed before the end of a body with a "
+			"Content-Length, then it is an error");
+		init("HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n", "",
+			"hello", false, true);
+
+		ensure_equals(readBody(), "hello");
+		ensure_equals(errcode, ECONNRESET);
+		ensure("The connection cannot be reused", !state->keepAlive);
+	}
+
+
+	/***** Responses without a body *****/
+
+	TEST_METHOD(10) {
+		set_test_name("Responses to HEAD requests have no body");
+		init("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\n", "", "", true);
+		ensure_equals(readBody(), "");
+		ensure_equals("No error", errcode, 0);
+		ensure("The connection can be reused", state->keepAlive);
+	}
+
+	TEST_METHOD(11) {
+		set_test_name("204 and 304 responses have no body");
+		init("HTTP/1.1 204 No Content\r\n\r\n", "", "");
+		ensure_equals(readBody(), "");
+		ensure("The connection can be reused after a 204", state->keepAlive);
+
+		init("HTTP/1.1 304 Not Modified\r\nTransfer-Encoding: chunked\r\n\r\n", "", "");
+		ensure_equals(readBody(), "");
+		ensure("The connection can be reused after a 304", state->keepAlive);
+	}
+
+	TEST_METHOD(12) {
+		set_test_name("A body without Content-Length or chunked encoding ends when "
+			"the connection is closed, and the connection is not reused");
+		init("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n\r\n", "hel",
+			"lo", false, true);
+
+		ensure_equals(state->bodyType, ResponseBodyState::BODY_UNTIL_EOF);
+		ensure_equals(readBody(), "hello");
+		ensure_equals("No error", errcode, 0);
+		ensure("The connection cannot be reused", !state->keepAlive);
+	}
+
+	TEST_METHOD(13) {
+		set_test_name("Connections are not reused after switching protocols");
+		init("HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\n\r\n",
+			"", "raw data", false, true);
+
+		ensure_equals(state->bodyType, ResponseBodyState::BODY_UNTIL_EOF);
+		ensure_equals(readBody(), "raw data");
+		ensure("The connection cannot be reused", !state->keepAlive);
+	}
+
+
+	/***** Chunked encoding *****/
+
+	TEST_METHOD(20) {
+		set_test_name("A chunked body is decoded, and the connection can be reused");
+		init(CHUNKED_HEADER, "",
+			"5\r\nhello\r\n" "6\r\n world\r\n" "0\r\n\r\n");
+
+		ensure_equals(state->bodyType, ResponseBodyState::BODY_CHUNKED);
+		ensure_equals(readBody(), "hello world");
+		ensure_equals("No error", errcode, 0);
+		ensure("The connection can be reused", state->keepAlive);
+	}
+
+	TEST_METHOD(21) {
+		set_test_name("Chunk sizes, chunk data and chunk terminators may be split "
+			"across reads at any point");
+		const string body = "5\r\nhello\r\n" "1a\r\nabcdefghijklmnopqrstuvwxyz\r\n"
+			"0\r\n\r\n";
+
+		for (size_t bufsize = 1; bufsize <= body.size(); bufsize++) {
+			init(CHUNKED_HEADER, "", body);
+			ensure_equals(("Body (bufsize " + toString(bufsize) + ")").c_str(),
+				readBody(bufsize), "helloabcdefghijklmnopqrstuvwxyz");
+			ensure_equals(("No error (bufsize " + toString(bufsize) + ")").c_str(),
+				errcode, 0);
+			ensure("The connection can be reused (bufsize " + toString(bufsize) + ")",
+				state->keepAlive);
+		}
+	}
+
+	TEST_METHOD(22) {
+		set_test_name("A chunked body may be split between the data read along with "
+			"the header and the connection at any point");
+		const string body = "5\r\nhello\r\n" "6\r\n world\r\n" "0\r\n\r\n";
+
+		for (size_t i = 0; i <= body.size(); i++) {
+			init(CHUNKED_HEADER, body.substr(0, i), body.substr(i));
+			ensure_equals(("Body (split at " + toString(i) + ")").c_str(),
+				readBody(4), "hello world");
+			ensure("The connection can be reused (split at " + toString(i) + ")",
+				state->keepAlive);
+		}
+	}
+
+	TEST_METHOD(23) {
+		set_test_name("Chunk extensions are ignored");
+		init(CHUNKED_HEADER, "",
+			"5;name=value\r\nhello\r\n" "0;last\r\n\r\n");
+
+		ensure_equals(readBody(), "hello");
+		ensure_equals("No error", errcode, 0);
+		ensure("The connection can be reused", state->keepAlive);
+	}
+
+	TEST_METHOD(24) {
+		set_test_name("Trailers after the last chunk are skipped, also when split "
+			"across reads");
+		const string body = "5\r\nhello\r\n" "0\r\n"
+			"X-Checksum: abc\r\n" "X-Other: def\r\n" "\r\n";
+
+		for (size_t bufsize = 1; bufsize <= body.size(); bufsize++) {
+			init(CHUNKED_HEADER, "", body);
+			ensure_equals(("Body (bufsize " + toString(bufsize) + ")").c_str(),
+				readBody(bufsize), "hello");
+			ensure_equals(("No error (bufsize " + toString(bufsize) + ")").c_str(),
+				errcode, 0);
+			ensure("The connection can be reused (bufsize " + toString(bufsize) + ")",
+				state->keepAlive);
+			ensure_equals(("Trailers consumed (bufsize " + toString(bufsize) + ")").c_str(),
+				readUnconsumedData(), "");
+		}
+	}
+
+	TEST_METHOD(25) {
+		set_test_name("If data follows the last chunk in the same read, then the "
+			"connection is not reused");
+		init(CHUNKED_HEADER, "",
+			"5\r\nhello\r\n" "0\r\n\r\n" "garbage");
+
+		ensure_equals(readBody(), "hello");
+		ensure_equals("No error", errcode, 0);
+		ensure("The connection cannot be reused", !state->keepAlive);
+	}
+
+	TEST_METHOD(26) {
+		set_test_name("If data that was read along with the header follows the "
+			"last chunk, then the connection is not reused");
+		init(CHUNKED_HEADER, "5\r\nhello\r\n" "0\r\n\r\n" "garbage", "");
+
+		ensure_equals(readBody(3), "hello");
+		ensure_equals("No error", errcode, 0);
+		ensure("The connection cannot be reused", !state->keepAlive);
+	}
+
+	TEST_METHOD(27) {
+		set_test_name("Invalid chunked encoding is an error");
+		init(CHUNKED_HEADER, "", "5\r\nhelloXX");
+		readBody();
+		ensure_equals(errcode, EBADMSG);
+		ensure("The connection cannot be reused", !state->keepAlive);
+
+		init(CHUNKED_HEADER, "", "zz\r\n");
+		readBody();
+		ensure_equals(errcode, EBADMSG);
+	}
+
+	TEST_METHOD(28) {
+		set_test_name("If the connection is closed before the last chunk, "
+			"then it is an error");
+		init(CHUNKED_HEADER, "", "5\r\nhello\r\n", false, true);
+
+		ensure_equals(readBody(), "hello");
+		ensure_equals(errcode, ECONNRESET);
+		ensure("The connection cannot be reused", !state->keepAlive);
+	}
+
+
+	/***** Connection reuse *****/
+
+	TEST_METHOD(30) {
+		set_test_name("A connection can be reused for a chunked response after a "
+			"response with a Content-Length, and the other way around");
+		// The Passenger core only sends the next response after the next
+		// request, so read no further than the end of each body here.
+		init("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\n", "",
+			"hello"
+			"5\r\nworld\r\n" "0\r\n\r\n"
+			"3\r\nabc\r\n" "0\r\nX-Trailer: 1\r\n\r\n"
+			"bye");
+		ensure_equals("First body", readBody(), "hello");
+		ensure("The connection can be reused after the first response",
+			state->keepAlive);
+
+		FileDescriptor conn = state->connection;
+
+		state = boost::make_shared<ResponseBodyState>(conn);
+		determineResponseFraming(CHUNKED_HEADER, false, *state);
+		ensure_equals("Second body", readBody(1), "world");
+		ensure("The connection can be reused after the second response",
+			state->keepAlive);
+
+		state = boost::make_shared<ResponseBodyState>(conn);
+		determineResponseFraming(CHUNKED_HEADER, false, *state);
+		ensure_equals("Third body", readBody(1), "abc");
+		ensure("The connection can be reused after the third response",
+			state->keepAlive);
+
+		state = boost::make_shared<ResponseBodyState>(conn);
+		determineResponseFraming("HTTP/1.1 200 OK\r\nContent-Length: 3\r\n\r\n",
+			false, *state);
+		ensure_equals("Fourth body", readBody(), "bye");
+		ensure("The connection can be reused after the fourth response",
+			state->keepAlive);
+	}
+}
@@ -218,9 +218,43 @@ namespace tut {
 			return options;
 		}
 
+		// Ensure that there is 1 enabled process and 1 standby process.
+		Options ensureStandbyProcess() {
+			Options options = createOptions();
+			options.standbyProcesses = 1;
+			initPoolDebugging();
+			pool->asyncGet(options, callback);
+			debug->debugger->recv("Begin spawn loop iteration 1");
+			debug->messages->send("Proceed with spawn loop iteration 1");
+			EVENTUALLY(5,
+				result = number == 1;
+			);
+			currentSession.reset();
+			debug->debugger->recv("Begin spawn loop iteration 2");
+			debug->messages->send("Proceed with spawn loop iteration 2");
+			debug->debugger->recv("Spawn loop done");
+			return options;
+		}
+
 		void disableProcess(ProcessPtr process, AtomicInt *result) {
 			*result = (int) pool->disableProcess(process->getGupid());
 		}
+
+		static void getAndCloseSessions(Pool *pool, Options options,
+			unsigned int count, AtomicInt *failures)
+		{
+			Ticket ticket;
+			for (unsigned int i = 0; i < count; i++) {
+				try {
+					SessionPtr session = pool->get(options, &ticket);
+					if (session == NULL || !session->getProcess()->isAlive()) {
+						(*failures)++;
+					}
+				} catch (const tracable_exception &) {
+					(*failures)++;
+				}
+			}
+		}
 	};
 
 	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ApplicationPool_PoolTest, 100);
@@ -240,7 +274,7 @@ namespace tut {
 		// as the new process is done spawning.
 		Options options = createOptions();
 
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("(1)", number, 0);
 		ensure("(2)", pool->getWaitlist.empty());
@@ -275,7 +309,7 @@ namespace tut {
 		ensure(!process->isTotallyBusy());
 
 		// Verify test assertion.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("callback is immediately called", number, 2);
 	}
@@ -396,7 +430,7 @@ namespace tut {
 
 		// Now open another session. It should complete immediately
 		// and should not use the first process.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("asyncGet() completed immediately", number, 2);
 		SessionPtr session2 = currentSession;
@@ -429,7 +463,7 @@ namespace tut {
 		pool->setMax(2);
 		GroupPtr group = pool->findOrCreateGroup(options);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			group->spawn();
 		}
 		EVENTUALLY(5,
@@ -548,7 +582,7 @@ namespace tut {
 		);
 
 		// The next asyncGet() should spawn a new process and the action should be queued.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		skDebugSupport.dummySpawnDelay = 5000000;
 		pool->asyncGet(options, callback, false);
 		ensure(group->spawning());
@@ -632,6 +666,76 @@ namespace tut {
 		ensure_equals(pool->getGroupCount(), 0u);
 	}
 
+	TEST_METHOD(15) {
+		// If spawnConcurrency is larger than 1, then multiple processes
+		// are spawned at the same time.
+		initPoolDebugging();
+		Options options = createOptions();
+		options.minProcesses = 3;
+		options.spawnConcurrency = 3;
+
+		pool->asyncGet(options, callback);
+		debug->debugger->recv("Begin spawn loop iteration 1");
+		debug->debugger->recv("Begin spawn loop iteration 2");
+		debug->debugger->recv("Begin spawn loop iteration 3");
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(1)", (int) group->processesBeingSpawned, 3);
+			ensure("(2)", group->spawning());
+		}
+		ensure_equals("(3)", pool->getProcessCount(), 0u);
+
+		debug->messages->send("Proceed with spawn loop iteration 1");
+		debug->messages->send("Proceed with spawn loop iteration 2");
+		debug->messages->send("Proceed with spawn loop iteration 3");
+		debug->debugger->recv("Spawn loop done");
+		debug->debugger->recv("Spawn loop done");
+		debug->debugger->recv("Spawn loop done");
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		ensure_equals("(4)", pool->getProcessCount(), 3u);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(5)", (int) group->processesBeingSpawned, 0);
+			ensure("(6)", !group->spawning());
+		}
+	}
+
+	TEST_METHOD(16) {
+		// The number of processes that are spawned concurrently
+		// is bounded by the pool capacity.
+		initPoolDebugging();
+		pool->setMax(2);
+		Options options = createOptions();
+		options.minProcesses = 4;
+		options.spawnConcurrency = 4;
+
+		pool->asyncGet(options, callback);
+		debug->debugger->recv("Begin spawn loop iteration 1");
+		debug->debugger->recv("Begin spawn loop iteration 2");
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(1)", (int) group->processesBeingSpawned, 2);
+		}
+
+		debug->messages->send("Proceed with spawn loop iteration 1");
+		debug->messages->send("Proceed with spawn loop iteration 2");
+		debug->debugger->recv("Spawn loop done");
+		debug->debugger->recv("Spawn loop done");
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		ensure_equals("(2)", pool->getProcessCount(), 2u);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(3)", (int) group->processesBeingSpawned, 0);
+			ensure("(4)", !group->spawning());
+		}
+	}
+
 	TEST_METHOD(17) {
 		// Test that restartGroupByName() spawns more processes to ensure
 		// that minProcesses and other constraints are met.
@@ -669,6 +773,109 @@ namespace tut {
 	}
 
 
+	TEST_METHOD(19) {
+		// The number of processes that are spawned concurrently
+		// is bounded by the group's maxProcesses.
+		initPoolDebugging();
+		Options options = createOptions();
+		options.minProcesses = 4;
+		options.maxProcesses = 2;
+		options.spawnConcurrency = 4;
+
+		pool->asyncGet(options, callback);
+		debug->debugger->recv("Begin spawn loop iteration 1");
+		debug->debugger->recv("Begin spawn loop iteration 2");
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(1)", (int) group->processesBeingSpawned, 2);
+		}
+
+		debug->messages->send("Proceed with spawn loop iteration 1");
+		debug->messages->send("Proceed with spawn loop iteration 2");
+		debug->debugger->recv("Spawn loop done");
+		debug->debugger->recv("Spawn loop done");
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		ensure_equals("(2)", pool->getProcessCount(), 2u);
+	}
+
+	TEST_METHOD(89) {
+		// If one of multiple concurrent spawns fails, then the get waiters
+		// keep waiting for the other spawns instead of failing right away.
+		initPoolDebugging();
+		Options options = createOptions();
+		options.minProcesses = 2;
+		options.spawnConcurrency = 2;
+
+		pool->asyncGet(options, callback);
+		debug->debugger->recv("Begin spawn loop iteration 1");
+		debug->debugger->recv("Begin spawn loop iteration 2");
+
+		if (defaultLogLevel == (LoggingKit::Level) DEFAULT_LOG_LEVEL) {
+			// If the user did not customize the test's log level,
+			// then we'll want to tone down the noise.
+			LoggingKit::setLevel(LoggingKit::CRIT);
+		}
+		debug->messages->send("Fail spawn loop iteration 1");
+		debug->debugger->recv("Spawn loop done");
+		SHOULD_NEVER_HAPPEN(100,
+			result = number > 0;
+		);
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(1)", (int) group->processesBeingSpawned, 1);
+			ensure_equals("(2)", group->getWaitlist.size(), 1u);
+		}
+
+		debug->messages->send("Proceed with spawn loop iteration 2");
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		ensure("(3)", currentException == NULL);
+		ensure("(4)", currentSession != NULL);
+
+		// The remaining loop continues spawning to satisfy minProcesses.
+		debug->debugger->recv("Begin spawn loop iteration 3");
+		debug->messages->send("Proceed with spawn loop iteration 3");
+		debug->debugger->recv("Spawn loop done");
+		ensure_equals("(5)", pool->getProcessCount(), 2u);
+	}
+
+	TEST_METHOD(90) {
+		// If all concurrent spawns fail, then the get waiters are failed
+		// once the last spawn has failed.
+		initPoolDebugging();
+		Options options = createOptions();
+		options.minProcesses = 2;
+		options.spawnConcurrency = 2;
+
+		pool->asyncGet(options, callback);
+		debug->debugger->recv("Begin spawn loop iteration 1");
+		debug->debugger->recv("Begin spawn loop iteration 2");
+
+		if (defaultLogLevel == (LoggingKit::Level) DEFAULT_LOG_LEVEL) {
+			// If the user did not customize the test's log level,
+			// then we'll want to tone down the noise.
+			LoggingKit::setLevel(LoggingKit::CRIT);
+		}
+		debug->messages->send("Fail spawn loop iteration 1");
+		debug->debugger->recv("Spawn loop done");
+		SHOULD_NEVER_HAPPEN(100,
+			result = number > 0;
+		);
+
+		debug->messages->send("Fail spawn loop iteration 2");
+		debug->debugger->recv("Spawn loop done");
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		ensure("(1)", currentException != NULL);
+		ensure_equals("(2)", pool->getProcessCount(), 0u);
+	}
+
 	/*********** Test asyncGet() behavior on multiple Groups ***********/
 
 	TEST_METHOD(20) {
@@ -849,7 +1056,7 @@ namespace tut {
 		SystemTime::force(2);
 		GroupPtr barGroup = pool->get(options2, &ticket)->getGroup()->shared_from_this();
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals("(1)", barGroup->spawn(), SR_OK);
 		}
 		debug->debugger->recv("Begin spawn loop iteration 1");
@@ -872,7 +1079,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -934,7 +1141,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -969,7 +1176,7 @@ namespace tut {
 		ProcessPtr process = currentSession->getProcess()->shared_from_this();
 		pool->detachProcess(process);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 		EVENTUALLY(5,
@@ -1000,13 +1207,13 @@ namespace tut {
 		pool->asyncGet(options, callback);
 
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
 		}
 
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test")->spawning());
 			ensure_equals(pool->groups.lookupCopy("test")->enabledCount, 0);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
@@ -1038,7 +1245,7 @@ namespace tut {
 		skDebugSupport.dummySpawnDelay = 90000;
 		pool->asyncGet(options2, callback);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->getWaitlist.size(), 1u);
 		}
 
@@ -1051,7 +1258,7 @@ namespace tut {
 		currentSession.reset();
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test2") != NULL);
 			ensure_equals(pool->getWaitlist.size(), 0u);
 		}
@@ -1072,7 +1279,7 @@ namespace tut {
 		currentSession.reset();
 		GroupPtr group = process->getGroup()->shared_from_this();
 		pool->detachProcess(process);
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure_equals(pool->groups.size(), 1u);
 		ensure(group->isAlive());
 		ensure(!group->garbageCollectable());
@@ -1089,18 +1296,18 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = !process->isAlive()
 				|| !process->osProcessExists();
 		);
 
 		session.reset();
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1120,7 +1327,7 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		EVENTUALLY(1,
@@ -1128,7 +1335,7 @@ namespace tut {
 		);
 
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->isDead()
 				|| !process->osProcessExists();
 		);
@@ -1137,7 +1344,7 @@ namespace tut {
 		g.clear();
 
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1167,7 +1374,7 @@ namespace tut {
 		pool->detachProcess(process);
 		debug->debugger->recv("About to start detached processes checker");
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 
@@ -1199,7 +1406,7 @@ namespace tut {
 		ensure_equals("Disabling succeeds",
 			pool->disableProcess(processes[0]->getGupid()), DR_SUCCESS);
 
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure(processes[0]->isAlive());
 		ensure_equals("Process is disabled",
 			processes[0]->enabled,
@@ -1279,7 +1486,7 @@ namespace tut {
 		TempThread thr2(boost::bind(&Core_ApplicationPool_PoolTest::disableProcess,
 			this, process2, &code2));
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1298,7 +1505,7 @@ namespace tut {
 			result = code2 == DR_SUCCESS;
 		);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 2);
@@ -1326,7 +1533,7 @@ namespace tut {
 			this, session2->getProcess()->shared_from_this(), &code2));
 		EVENTUALLY(2,
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1349,7 +1556,7 @@ namespace tut {
 		);
 		{
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 2);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 0);
@@ -1408,7 +1615,7 @@ namespace tut {
 		ensure_equals(result, DR_SUCCESS);
 
 		{
-			ScopedLock l(pool->syncher);
+			PoolScopedLock l(pool->syncher);
 			GroupPtr group = processes[0]->getGroup()->shared_from_this();
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
@@ -1972,7 +2179,7 @@ namespace tut {
 		}
 		ensure_equals(number, 0);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->getWaitlist.size(),
 				3u);
 		}
@@ -2068,6 +2275,406 @@ namespace tut {
 	//       when the session's connection has been released by the app.
 
 
+	/*********** Test standby processes ***********/
+
+	TEST_METHOD(80) {
+		// If standbyProcesses is set, then the spawn loop spawns that many
+		// processes on top of the enabled ones, and puts them on standby.
+		// Requests are not routed to standby processes.
+		Options options = ensureStandbyProcess();
+		ensure_equals("(1)", pool->getProcessCount(), 2u);
+
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		pid_t enabledPid;
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(2)", group->enabledCount, 1);
+			ensure_equals("(3)", group->standbyCount, 1);
+			ensure("(4)", !group->spawning());
+			enabledPid = group->enabledProcesses[0]->getPid();
+		}
+
+		SessionPtr session = pool->get(options, &ticket);
+		ensure_equals("(5)", session->getPid(), enabledPid);
+	}
+
+	TEST_METHOD(81) {
+		// If a request cannot be routed to any of the enabled processes,
+		// then a standby process is promoted and handles it right away,
+		// after which a new standby process is spawned.
+		Options options = ensureStandbyProcess();
+
+		SessionPtr session1 = pool->get(options, &ticket);
+		pool->asyncGet(options, callback);
+		EVENTUALLY(5,
+			result = number == 2;
+		);
+		ensure("(1)", currentSession != NULL);
+		ensure("(2)", currentSession->getPid() != session1->getPid());
+
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(3)", group->enabledCount, 2);
+			ensure_equals("(4)", group->standbyCount, 0);
+			ensure("(5)", group->spawning());
+		}
+
+		session1.reset();
+		currentSession.reset();
+		debug->debugger->recv("Begin spawn loop iteration 3");
+		debug->messages->send("Proceed with spawn loop iteration 3");
+		debug->debugger->recv("Spawn loop done");
+		PoolLockGuard l(pool->syncher);
+		ensure_equals("(6)", group->enabledCount, 2);
+		ensure_equals("(7)", group->standbyCount, 1);
+	}
+
+	TEST_METHOD(82) {
+		// Standby processes are not garbage collected while the
+		// group still has enabled processes.
+		pool->setMaxIdleTime(50000);
+		ensureStandbyProcess();
+		SHOULD_NEVER_HAPPEN(200,
+			result = pool->getProcessCount() < 2;
+		);
+	}
+
+	TEST_METHOD(83) {
+		// When the pool is at full capacity, standby processes are
+		// the first to be shut down in order to free capacity.
+		pool->setMax(2);
+		ensureStandbyProcess();
+		debug->spawning = false;
+
+		Options options2 = createOptions();
+		options2.appGroupName = "test2";
+		pool->asyncGet(options2, callback);
+		EVENTUALLY(5,
+			result = number == 2;
+		);
+		ensure("(1)", currentSession != NULL);
+
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		PoolLockGuard l(pool->syncher);
+		ensure_equals("(2)", group->enabledCount, 1);
+		ensure_equals("(3)", group->standbyCount, 0);
+	}
+
+
+	/*********** Test routing methods ***********/
+
+	TEST_METHOD(84) {
+		// With the 'latency' routing method, requests are routed to the
+		// process with the lowest latency, as long as it isn't totally busy.
+		Options options = createOptions();
+		options.routingMethod = "latency";
+		options.minProcesses = 2;
+		pool->asyncGet(options, callback);
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 2;
+		);
+		currentSession.reset();
+
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		pid_t fastPid;
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(1)", group->routingMethod, Group::RM_LATENCY);
+			unsigned long long now = SystemTime::getUsec();
+			group->enabledProcesses[0]->latency.update(10000000, now);
+			group->enabledProcesses[1]->latency.update(1000, now);
+			fastPid = group->enabledProcesses[1]->getPid();
+		}
+
+		for (int i = 0; i < 5; i++) {
+			SessionPtr session1 = pool->get(options, &ticket);
+			ensure_equals("(2)", session1->getPid(), fastPid);
+			SessionPtr session2 = pool->get(options, &ticket);
+			ensure("(3)", session2->getPid() != fastPid);
+		}
+	}
+
+
+	/*********** Test max memory ***********/
+
+	TEST_METHOD(87) {
+		// Processes that use more memory than maxMemory allows are
+		// detached and replaced by new processes.
+		Options options = ensureMinProcesses(2);
+		options.maxMemory = 100;
+		pool->get(options, &ticket).reset();
+
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		boost::container::vector<Callback> actions;
+		pid_t bloatedPid, healthyPid;
+		{
+			PoolScopedLock l(pool->syncher);
+			ensure_equals("(1)", group->enabledCount, 2);
+			ProcessPtr bloated = group->enabledProcesses[0];
+			ProcessPtr healthy = group->enabledProcesses[1];
+			bloatedPid = bloated->getPid();
+			healthyPid = healthy->getPid();
+			bloated->metrics.pid = bloatedPid;
+			bloated->metrics.privateDirty = 200 * 1024;
+			healthy->metrics.pid = healthyPid;
+			healthy->metrics.privateDirty = 50 * 1024;
+			group->recycleProcessesExceedingMaxMemory(actions);
+			ensure_equals("(2)", group->enabledCount, 1);
+			ensure_equals("(3)", group->enabledProcesses[0]->getPid(), healthyPid);
+		}
+		Group::runAllActions(actions);
+
+		EVENTUALLY(5,
+			PoolLockGuard l(pool->syncher);
+			result = group->enabledCount == 2;
+		);
+		PoolLockGuard l(pool->syncher);
+		ensure("(4)", group->enabledProcesses[0]->getPid() != bloatedPid);
+		ensure("(5)", group->enabledProcesses[1]->getPid() != bloatedPid);
+	}
+
+	TEST_METHOD(88) {
+		// At most a quarter of a group's processes is recycled at the same
+		// time. Busy processes are disabled first, and are only detached
+		// once they have finished their requests.
+		Options options = ensureMinProcesses(4);
+		options.maxMemory = 100;
+		pool->setMax(4);
+
+		vector<SessionPtr> sessions;
+		for (int i = 0; i < 4; i++) {
+			sessions.push_back(pool->get(options, &ticket));
+		}
+
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		boost::container::vector<Callback> actions;
+		{
+			PoolScopedLock l(pool->syncher);
+			ensure_equals("(1)", group->enabledCount, 4);
+			foreach (const ProcessPtr &process, group->enabledProcesses) {
+				process->metrics.pid = process->getPid();
+				process->metrics.privateDirty = 200 * 1024;
+			}
+			group->recycleProcessesExceedingMaxMemory(actions);
+			ensure_equals("(2)", group->enabledCount, 3);
+			ensure_equals("(3)", group->disablingCount, 1);
+
+			// Recycling is not started for more processes until
+			// the current one is done.
+			group->recycleProcessesExceedingMaxMemory(actions);
+			ensure_equals("(4)", group->enabledCount, 3);
+			ensure_equals("(5)", group->disablingCount, 1);
+		}
+		Group::runAllActions(actions);
+
+		pid_t recycledPid;
+		{
+			PoolLockGuard l(pool->syncher);
+			recycledPid = group->disablingProcesses[0]->getPid();
+		}
+		for (unsigned int i = 0; i < sessions.size(); i++) {
+			if (sessions[i]->getPid() == recycledPid) {
+				sessions[i].reset();
+			}
+		}
+
+		EVENTUALLY(5,
+			PoolLockGuard l(pool->syncher);
+			result = group->disablingCount == 0
+				&& group->disabledCount == 0
+				&& group->enabledCount == 4;
+		);
+		PoolLockGuard l(pool->syncher);
+		foreach (const ProcessPtr &process, group->enabledProcesses) {
+			ensure("(6)", process->getPid() != recycledPid);
+		}
+	}
+
+
+	TEST_METHOD(91) {
+		// Processes that exceed maxMemory are recycled in waves. A process
+		// counts as being recycled until it has shut down and its
+		// replacement has been spawned.
+		Options options = ensureMinProcesses(4);
+		options.maxMemory = 100;
+		pool->get(options, &ticket).reset();
+
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		boost::container::vector<Callback> actions;
+		{
+			PoolScopedLock l(pool->syncher);
+			ensure_equals("(1)", group->enabledCount, 4);
+			foreach (const ProcessPtr &process, group->enabledProcesses) {
+				process->metrics.pid = process->getPid();
+				process->metrics.privateDirty = 200 * 1024;
+			}
+			group->recycleProcessesExceedingMaxMemory(actions);
+			ensure_equals("(2)", group->enabledCount, 3);
+			ensure_equals("(3)", group->detachedProcesses.size(), 1u);
+			ensure_equals("(4)", (int) group->processesBeingSpawned, 1);
+
+			// The first process was idle, so it was detached right away.
+			// But its replacement is still being spawned.
+			group->recycleProcessesExceedingMaxMemory(actions);
+			ensure_equals("(5)", group->enabledCount, 3);
+		}
+		Group::runAllActions(actions);
+		actions.clear();
+
+		EVENTUALLY(5,
+			PoolLockGuard l(pool->syncher);
+			result = group->enabledCount == 4
+				&& group->processesBeingSpawned == 0
+				&& group->detachedProcesses.empty();
+		);
+		{
+			PoolScopedLock l(pool->syncher);
+			group->recycleProcessesExceedingMaxMemory(actions);
+			ensure_equals("(6)", group->enabledCount, 3);
+			ensure_equals("(7)", group->detachedProcesses.size(), 1u);
+		}
+		Group::runAllActions(actions);
+	}
+
+	/*********** Test checking out and closing sessions without locking the pool exclusively ***********/
+
+	TEST_METHOD(92) {
+		// Multiple threads can concurrently check out and close sessions on
+		// multiple Groups without corrupting the Groups' bookkeeping.
+		skDebugSupport.dummyConcurrency = 2;
+		Options options1 = createOptions();
+		options1.appGroupName = "test1";
+		options1.minProcesses = 2;
+		Options options2 = createOptions();
+		options2.appGroupName = "test2";
+		options2.minProcesses = 2;
+		pool->get(options1, &ticket).reset();
+		pool->get(options2, &ticket).reset();
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 4u;
+		);
+
+		AtomicInt failures = 0;
+		TempThread thr1(boost::bind(getAndCloseSessions, pool.get(), options1, 1000u, &failures));
+		TempThread thr2(boost::bind(getAndCloseSessions, pool.get(), options1, 1000u, &failures));
+		TempThread thr3(boost::bind(getAndCloseSessions, pool.get(), options2, 1000u, &failures));
+		TempThread thr4(boost::bind(getAndCloseSessions, pool.get(), options2, 1000u, &failures));
+		thr1.join();
+		thr2.join();
+		thr3.join();
+		thr4.join();
+		ensure_equals("(1)", failures, 0);
+
+		PoolLockGuard l(pool->syncher);
+		pool->fullVerifyInvariants();
+		const char *names[] = { "test1", "test2" };
+		for (unsigned int i = 0; i < 2; i++) {
+			GroupPtr group = pool->groups.lookupCopy(names[i]);
+			unsigned int processed = 0;
+			ensure_equals("(2)", group->enabledCount, 2);
+			ensure("(3)", group->getWaitlist.empty());
+			ensure_equals("(4)", group->nEnabledProcessesTotallyBusy, 0);
+			foreach (const ProcessPtr &process, group->enabledProcesses) {
+				ensure_equals("(5)", process->sessions, 0);
+				ensure_equals("(6)", group->enabledProcessBusynessLevels[process->getIndex()], 0);
+				processed += process->processed;
+			}
+			// The initial get() plus 2 threads times 1000 sessions.
+			ensure_equals("(7)", processed, 2001u);
+		}
+	}
+
+	TEST_METHOD(93) {
+		// If all processes are totally busy, then the fast path gives up and
+		// asyncGet() puts the request on the wait list. Closing a session while
+		// the Group has get waiters goes through the exclusive path, which
+		// assigns the freed capacity to the waiter.
+		Options options = createOptions();
+		pool->setMax(1);
+		SessionPtr session1 = pool->get(options, &ticket);
+		ProcessPtr process = session1->getProcess()->shared_from_this();
+		ensure("(1)", process->isTotallyBusy());
+		ensure("(2)", pool->getFromExistingGroupQuickly(options) == NULL);
+
+		pool->asyncGet(options, callback);
+		ensure_equals("(3)", number, 0);
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(4)", group->getWaitlist.size(), 1u);
+		}
+
+		// The spawn thread may briefly hold on to the first session, so the
+		// session is not necessarily closed right away.
+		session1.reset();
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		ensure("(5)", currentSession != NULL);
+		ensure_equals("(6)", currentSession->getProcess(), process.get());
+		PoolLockGuard l(pool->syncher);
+		ensure("(7)", group->getWaitlist.empty());
+	}
+
+	TEST_METHOD(94) {
+		// The fast path doesn't check out sessions from a Group that is
+		// restarting. asyncGet() then falls back to the exclusive path,
+		// which makes the request wait until the restart is done.
+		initPoolDebugging();
+		debug->spawning = false;
+		Options options = ensureMinProcesses(1);
+
+		ensure("(1)", pool->restartGroupByName("stub/rack"));
+		debug->debugger->recv("About to end restarting");
+		ensure("(2)", pool->getFromExistingGroupQuickly(options) == NULL);
+
+		pool->asyncGet(options, callback);
+		SHOULD_NEVER_HAPPEN(100,
+			result = number > 1;
+		);
+		debug->messages->send("Finish restarting");
+		EVENTUALLY(5,
+			result = number == 2;
+		);
+		ensure("(3)", currentSession != NULL);
+		ensure("(4)", currentException == NULL);
+	}
+
+	TEST_METHOD(95) {
+		// The fast path never checks out sessions from a process that is
+		// being disabled. Closing the last session of such a process goes
+		// through the exclusive path, which finishes disabling it.
+		Options options = ensureMinProcesses(2);
+		SessionPtr session1 = pool->get(options, &ticket);
+		ProcessPtr process1 = session1->getProcess()->shared_from_this();
+
+		AtomicInt code = -1;
+		TempThread thr(boost::bind(&Core_ApplicationPool_PoolTest::disableProcess,
+			this, process1, &code));
+		EVENTUALLY(5,
+			PoolLockGuard l(pool->syncher);
+			result = process1->enabled == Process::DISABLING;
+		);
+
+		SessionPtr session2 = pool->getFromExistingGroupQuickly(options);
+		ensure("(1)", session2 != NULL);
+		ensure("(2)", session2->getProcess() != process1.get());
+		session2.reset();
+		ensure_equals("(3)", (int) code, -1);
+
+		session1.reset();
+		EVENTUALLY(5,
+			result = code == (int) DR_SUCCESS;
+		);
+		PoolLockGuard l(pool->syncher);
+		ensure_equals("(4)", process1->enabled, Process::DISABLED);
+		ensure_equals("(5)", process1->sessions, 0);
+	}
+
 	/*********** Test previously discovered bugs ***********/
 
 	TEST_METHOD(85) {
@@ -2089,5 +2696,27 @@ namespace tut {
 	}
 
 
+	/*********** Test state inspection ***********/
+
+	TEST_METHOD(86) {
+		// snapshotMetrics() reports per-group and per-process numbers.
+		Options options = createOptions();
+		pool->get(options, &ticket).reset();
+		SessionPtr session1 = pool->get(options, &ticket);
+
+		vector<Pool::GroupMetricsSnapshot> groups = pool->snapshotMetrics();
+		ensure_equals("(1)", groups.size(), 1u);
+		ensure_equals("(2)", groups[0].name, "stub/rack");
+		ensure_equals("(3)", groups[0].queueLength, 0u);
+		ensure_equals("(4)", groups[0].processes.size(), 1u);
+
+		const Pool::ProcessMetricsSnapshot &process = groups[0].processes[0];
+		ensure_equals("(5)", process.pid, session1->getPid());
+		ensure_equals("(6)", process.sessions, 1);
+		ensure_equals("(7)", process.processed, 1u);
+		ensure("(8)", process.enabled);
+	}
+
+
 	/*****************************/
 }
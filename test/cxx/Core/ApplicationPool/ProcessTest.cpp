@@ -80,6 +80,8 @@ namespace tut {
 		}
 
 		~Core_ApplicationPool_ProcessTest() {
+			SystemTime::releaseAll();
+
 			Json::Value config;
 			vector<ConfigKit::Error> errors;
 			LoggingKit::ConfigChangeRequest req;
@@ -238,4 +240,30 @@ namespace tut {
 				&& contents.find("stdout and err 4\n") != string::npos;
 		);
 	}
+
+	TEST_METHOD(6) {
+		set_test_name("sessionClosed() updates the latency moving average, "
+			"which reacts immediately to peaks and slowly to improvements");
+		ProcessPtr process = createProcess();
+		ensure(!process->latency.available());
+
+		SystemTime::forceUsec(1000000);
+		SessionPtr session = process->newSession();
+		SystemTime::forceUsec(1010000);
+		process->sessionClosed(session.get());
+		ensure(process->latency.available());
+		ensure_equals(process->latency.average(), 10000.0);
+
+		session = process->newSession();
+		SystemTime::forceUsec(1110000);
+		process->sessionClosed(session.get());
+		ensure_equals(process->latency.average(), 100000.0);
+
+		session = process->newSession();
+		SystemTime::forceUsec(1120000);
+		process->sessionClosed(session.get());
+		ensure(process->latency.average() < 100000.0);
+		ensure(process->latency.average() > 90000.0);
+		ensure(process->latency.average(1120000 + 20000000) < 1.0);
+	}
 }
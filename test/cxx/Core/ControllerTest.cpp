@@ -1,5 +1,6 @@
 #include <TestSupport.h>
 #include <limits>
+#include <zlib.h>
 #include <Constants.h>
 #include <IOTools/IOUtils.h>
 #include <IOTools/BufferedIO.h>
@@ -19,13 +20,19 @@ namespace tut {
 			virtual void asyncGetFromApplicationPool(Request *req,
 				ApplicationPool2::GetCallback callback)
 			{
-				callback(sessionToReturn, exceptionToReturn);
-				sessionToReturn.reset();
+				ApplicationPool2::AbstractSessionPtr session = sessionToReturn;
+				checkouts++;
+				if (!keepSessionToReturn) {
+					sessionToReturn.reset();
+				}
+				callback(session, exceptionToReturn);
 			}
 
 		public:
 			ApplicationPool2::AbstractSessionPtr sessionToReturn;
 			ApplicationPool2::ExceptionPtr exceptionToReturn;
+			bool keepSessionToReturn;
+			unsigned int checkouts;
 
 			MyController(ServerKit::Context *context,
 				const Core::ControllerSchema &schema,
@@ -33,10 +40,26 @@ namespace tut {
 				const Core::ControllerSingleAppModeSchema &singleAppModeSchema,
 				const Json::Value &singleAppModeConfig)
 				: Core::Controller(context, schema, initialConfig, ConfigKit::DummyTranslator(),
-					&singleAppModeSchema, &singleAppModeConfig, ConfigKit::DummyTranslator())
+					&singleAppModeSchema, &singleAppModeConfig, ConfigKit::DummyTranslator()),
+				  keepSessionToReturn(false),
+				  checkouts(0)
 				{ }
 		};
 
+		// A session whose connection is established asynchronously, but
+		// which fails with an exception that is not a SystemException.
+		class AsyncFailingTestSession: public TestSession {
+		public:
+			virtual bool initiateNonBlocking() {
+				initiate(false);
+				return false;
+			}
+
+			virtual bool continueInitiate() {
+				throw RuntimeException("Simulated connection failure");
+			}
+		};
+
 		BackgroundEventLoop bg;
 		ServerKit::Schema skSchema;
 		ServerKit::Context context;
@@ -52,6 +75,7 @@ namespace tut {
 		Json::Value config, singleAppModeConfig;
 		int serverSocket;
 		TestSession testSession;
+		AsyncFailingTestSession asyncFailingTestSession;
 		FileDescriptor clientConnection;
 		BufferedIO clientConnectionIO;
 		string peerRequestHeader;
@@ -165,6 +189,15 @@ namespace tut {
 			controller->sessionToReturn.reset(&testSession, false);
 		}
 
+		void _setAsyncFailingTestSessionObject() {
+			controller->sessionToReturn.reset(&asyncFailingTestSession, false);
+			controller->keepSessionToReturn = true;
+		}
+
+		void _setExceptionToReturn(const ApplicationPool2::ExceptionPtr &e) {
+			controller->exceptionToReturn = e;
+		}
+
 		MyController::State getServerState() {
 			Controller::State result;
 			bg.safe->runSync(boost::bind(&Core_ControllerTest::_getServerState,
@@ -198,6 +231,10 @@ namespace tut {
 			*result = controller->totalBytesConsumed;
 		}
 
+		void _getCheckouts(unsigned int *result) {
+			*result = controller->checkouts;
+		}
+
 		string readPeerRequestHeader(string *peerRequestHeader = NULL) {
 			if (peerRequestHeader == NULL) {
 				peerRequestHeader = &this->peerRequestHeader;
@@ -294,9 +331,108 @@ namespace tut {
 		string readResponseBody() {
 			return clientConnectionIO.readAll();
 		}
+
+		string dechunk(const string &data) {
+			string result;
+			string::size_type pos = 0;
+			while (true) {
+				string::size_type lineEnd = data.find("\r\n", pos);
+				ensure("Valid chunk size line", lineEnd != string::npos);
+				unsigned int size = hexToUint(data.substr(pos, lineEnd - pos));
+				if (size == 0) {
+					return result;
+				}
+				result.append(data, lineEnd + 2, size);
+				pos = lineEnd + 2 + size + 2;
+			}
+		}
+
+		string gunzip(const string &data) {
+			z_stream stream;
+			char buf[1024];
+			string result;
+			int ret;
+
+			memset(&stream, 0, sizeof(stream));
+			ensure_equals(inflateInit2(&stream, 15 + 16), Z_OK);
+			stream.next_in = (Bytef *) data.data();
+			stream.avail_in = data.size();
+			do {
+				stream.next_out = (Bytef *) buf;
+				stream.avail_out = sizeof(buf);
+				ret = inflate(&stream, Z_NO_FLUSH);
+				result.append(buf, sizeof(buf) - stream.avail_out);
+			} while (ret == Z_OK);
+			inflateEnd(&stream);
+			ensure_equals("The gzip stream is complete", ret, Z_STREAM_END);
+			return result;
+		}
+
+		string sendCompressibleResponse(const string &request, const string &contentType,
+			const string &body)
+		{
+			connectToServer();
+			sendRequest(request);
+			waitUntilSessionInitiated();
+
+			readPeerRequestHeader();
+			sendPeerResponse(
+				"HTTP/1.1 200 OK\r\n"
+				"Connection: close\r\n"
+				"Content-Type: " + contentType + "\r\n"
+				"Content-Length: " + toString(body.size()) + "\r\n\r\n"
+				+ body);
+			return readResponseHeader();
+		}
+
+		string createLargeBody() {
+			string body;
+			for (unsigned int i = 0; i < 300000; i++) {
+				body.append(toString(i));
+			}
+			return body;
+		}
+
+		boost::uint64_t getSplicedBytes() {
+			return ControllerMetrics::get(controller->getMetrics().splicedBytes);
+		}
+
+		string sendSendfileResponse(const string &request, const string &path) {
+			connectToServer();
+			sendRequest(request);
+			waitUntilSessionInitiated();
+
+			readPeerRequestHeader();
+			sendPeerResponse(
+				"HTTP/1.1 200 OK\r\n"
+				"Connection: close\r\n"
+				"Content-Type: text/plain\r\n"
+				"X-Sendfile: " + path + "\r\n"
+				"Content-Length: 0\r\n\r\n");
+			return readResponseHeader();
+		}
+
+		// Like sendSendfileResponse(), but the app sends a body along with
+		// the X-Sendfile header and keeps its connection open, as if it
+		// wanted the connection to be reused.
+		string sendSendfileResponseWithBody(const string &request, const string &path,
+			const string &framingHeaderAndBody)
+		{
+			connectToServer();
+			sendRequest(request);
+			waitUntilSessionInitiated();
+
+			readPeerRequestHeader();
+			writeExact(testSession.peerFd(),
+				"HTTP/1.1 200 OK\r\n"
+				"Content-Type: text/plain\r\n"
+				"X-Sendfile: " + path + "\r\n"
+				+ framingHeaderAndBody);
+			return readResponseHeader();
+		}
 	};
 
-	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ControllerTest, 80);
+	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ControllerTest, 90);
 
 
 	/***** Passing request information to the app *****/
@@ -340,6 +476,37 @@ namespace tut {
 			"GET /hello?foo=bar HTTP/1.1\r\n"));
 	}
 
+	TEST_METHOD(3) {
+		set_test_name("Session protocol: request headers are passed as CGI variables, "
+			"except those whose names contain characters other than alphanumerics and dashes");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"X-Some-Rather-Long-Header-Name-2: foo\r\n"
+			"X-Some-Rather-Long-Header_Name-3: bar\r\n"
+			"X.Dotted: baz\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		ensure(containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("HTTP_HOST\0localhost\0")));
+		ensure(containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("HTTP_ACCEPT_ENCODING\0gzip\0")));
+		ensure(containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("HTTP_X_SOME_RATHER_LONG_HEADER_NAME_2\0foo\0")));
+		ensure(!containsSubstring(peerRequestHeader, "HEADER_NAME_3"));
+		ensure(!containsSubstring(peerRequestHeader, "bar"));
+		ensure(!containsSubstring(peerRequestHeader, "DOTTED"));
+	}
+
 
 	/***** Passing request body to the app *****/
 
@@ -1118,4 +1285,603 @@ namespace tut {
 		string header = readResponseHeader();
 		ensure(containsSubstring(header, "HTTP/1.1 502"));
 	}
+
+
+	/***** Response compression *****/
+
+	TEST_METHOD(60) {
+		set_test_name("It compresses responses for clients that accept gzip");
+
+		config["response_compression"] = true;
+		init();
+		useTestSessionObject();
+
+		string body(4000, 'x');
+		string header = sendCompressibleResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Accept-Encoding: deflate, gzip\r\n"
+			"\r\n",
+			"text/html; charset=utf-8", body);
+		ensure("(1)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(2)", containsSubstring(header, "Vary: Accept-Encoding\r\n"));
+		ensure("(3)", containsSubstring(header, "Transfer-Encoding: chunked\r\n"));
+		ensure("(4)", !containsSubstring(header, "Content-Length"));
+
+		string compressed = dechunk(readResponseBody());
+		ensure("(5)", compressed.size() < body.size());
+		ensure_equals("(6)", gunzip(compressed), body);
+	}
+
+	TEST_METHOD(61) {
+		set_test_name("It does not compress responses for clients that don't accept gzip");
+
+		config["response_compression"] = true;
+		init();
+		useTestSessionObject();
+
+		string body(4000, 'x');
+		string header = sendCompressibleResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Accept-Encoding: gzip;q=0, *\r\n"
+			"\r\n",
+			"text/html", body);
+		ensure("(1)", !containsSubstring(header, "Content-Encoding"));
+		ensure("(2)", containsSubstring(header, "Content-Length: 4000\r\n"));
+		ensure_equals("(3)", readResponseBody(), body);
+	}
+
+	TEST_METHOD(62) {
+		set_test_name("It does not compress responses that are too small");
+
+		config["response_compression"] = true;
+		init();
+		useTestSessionObject();
+
+		string header = sendCompressibleResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"\r\n",
+			"text/html", "hello");
+		ensure("(1)", !containsSubstring(header, "Content-Encoding"));
+		ensure_equals("(2)", readResponseBody(), "hello");
+	}
+
+	TEST_METHOD(63) {
+		set_test_name("It does not compress responses with a content type "
+			"that is not in the allowlist");
+
+		config["response_compression"] = true;
+		init();
+		useTestSessionObject();
+
+		string body(4000, 'x');
+		string header = sendCompressibleResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"\r\n",
+			"image/png", body);
+		ensure("(1)", !containsSubstring(header, "Content-Encoding"));
+		ensure_equals("(2)", readResponseBody(), body);
+	}
+
+	TEST_METHOD(64) {
+		set_test_name("It does not use chunked encoding for compressed responses to HTTP/1.0 clients");
+
+		config["response_compression"] = true;
+		init();
+		useTestSessionObject();
+
+		string body(4000, 'x');
+		string header = sendCompressibleResponse(
+			"GET /hello HTTP/1.0\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"\r\n",
+			"text/plain", body);
+		ensure("(1)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(2)", !containsSubstring(header, "Transfer-Encoding"));
+		ensure_equals("(3)", gunzip(readResponseBody()), body);
+	}
+
+
+	/***** Session checkout failures *****/
+
+	TEST_METHOD(79) {
+		set_test_name("It responds with an error page if checking out a session fails");
+
+		init();
+		bg.safe->runSync(boost::bind(&Core_ControllerTest::_setExceptionToReturn, this,
+			boost::make_shared<RuntimeException>("Simulated checkout failure")));
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 500 Internal Server Error\r\n"));
+		ensure("(2)", containsSubstring(readResponseBody(), "Internal server error"));
+	}
+
+	TEST_METHOD(80) {
+		set_test_name("It retries and then disconnects the client if connecting to the"
+			" application asynchronously fails with an exception");
+
+		init();
+		bg.safe->runSync(boost::bind(&Core_ControllerTest::_setAsyncFailingTestSessionObject, this));
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		unsigned long long timeout = 5000000;
+		ensure("(1)", waitUntilReadable(clientConnection, &timeout));
+		ensure_equals("(2)", readResponseBody(), "");
+
+		unsigned int checkouts;
+		bg.safe->runSync(boost::bind(&Core_ControllerTest::_getCheckouts, this, &checkouts));
+		// Controller::MAX_SESSION_CHECKOUT_TRY
+		ensure_equals("(3)", checkouts, 10u);
+	}
+
+
+	/***** Request latency statistics *****/
+
+	TEST_METHOD(65) {
+		set_test_name("It records request latency per phase, per thread and per app group");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 2\r\n\r\n"
+			"ok");
+		readResponseHeader();
+		ensure_equals("(1)", readResponseBody(), "ok");
+
+		Json::Value latency;
+		EVENTUALLY(5,
+			latency = inspectStateAsJson()["request_latency"];
+			result = latency["all"]["response"]["count"].asUInt() == 1;
+		);
+		const char *phases[] = { "header", "queue", "checkout", "app_ttfb", "response" };
+		for (unsigned int i = 0; i < sizeof(phases) / sizeof(const char *); i++) {
+			ensure_equals((string("(2) ") + phases[i]).c_str(),
+				latency["all"][phases[i]]["count"].asUInt(), 1u);
+		}
+
+		ensure_equals("(3)", latency["groups"].size(), 1u);
+		Json::Value group = latency["groups"][latency["groups"].getMemberNames()[0]];
+		ensure_equals("(4)", group["app_ttfb"]["count"].asUInt(), 1u);
+	}
+
+	TEST_METHOD(76) {
+		set_test_name("It forgets the request latency of groups that have been detached");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 2\r\n\r\n"
+			"ok");
+		readResponseHeader();
+		readResponseBody();
+
+		RequestLatencySnapshot snapshot;
+		EVENTUALLY(5,
+			snapshot = RequestLatencySnapshot();
+			bg.safe->runSync(boost::bind(&MyController::snapshotRequestLatency,
+				controller, boost::ref(snapshot)));
+			result = snapshot.all.get(RP_RESPONSE).getCount() == 1;
+		);
+		ensure_equals("(1)", snapshot.groups.size(), 1u);
+		string groupName = snapshot.groups.begin()->first;
+		ensure_equals("(2)", snapshot.groups[groupName].get(RP_QUEUE).getCount(), 1u);
+
+		bg.safe->runSync(boost::bind(&MyController::forgetGroupLatencyStats,
+			controller, HashedStaticString(groupName)));
+		snapshot = RequestLatencySnapshot();
+		bg.safe->runSync(boost::bind(&MyController::snapshotRequestLatency,
+			controller, boost::ref(snapshot)));
+		ensure_equals("(3)", snapshot.groups.size(), 0u);
+		ensure_equals("(4)", snapshot.all.get(RP_RESPONSE).getCount(), 1u);
+	}
+
+
+	/***** X-Sendfile *****/
+
+	TEST_METHOD(66) {
+		set_test_name("It sends files referenced by X-Sendfile if they are inside a sendfile root");
+
+		TempDir tempDir("tmp.sendfile");
+		string body;
+		for (unsigned int i = 0; i < 200000; i++) {
+			body.append(toString(i));
+		}
+		createFile("tmp.sendfile/file", body);
+		config["sendfile_roots"].append("tmp.sendfile");
+		init();
+		useTestSessionObject();
+
+		string header = sendSendfileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			absolutizePath("tmp.sendfile/file"));
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Length: " + toString(body.size()) + "\r\n"));
+		ensure("(3)", containsSubstring(header, "Accept-Ranges: bytes\r\n"));
+		ensure("(4)", !containsSubstring(header, "X-Sendfile"));
+		ensure_equals("(5)", readResponseBody(), body);
+		waitUntilSessionClosed();
+	}
+
+	TEST_METHOD(67) {
+		set_test_name("It supports byte ranges when sending files referenced by X-Sendfile");
+
+		TempDir tempDir("tmp.sendfile");
+		createFile("tmp.sendfile/file", "0123456789");
+		config["sendfile_roots"].append("tmp.sendfile");
+		init();
+		useTestSessionObject();
+
+		string header = sendSendfileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Range: bytes=2-5\r\n"
+			"\r\n",
+			absolutizePath("tmp.sendfile/file"));
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 206 Partial Content\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Range: bytes 2-5/10\r\n"));
+		ensure("(3)", containsSubstring(header, "Content-Length: 4\r\n"));
+		ensure_equals("(4)", readResponseBody(), "2345");
+	}
+
+	TEST_METHOD(68) {
+		set_test_name("It responds with 416 if the requested range of a file referenced "
+			"by X-Sendfile is not satisfiable");
+
+		TempDir tempDir("tmp.sendfile");
+		createFile("tmp.sendfile/file", "0123456789");
+		config["sendfile_roots"].append("tmp.sendfile");
+		init();
+		useTestSessionObject();
+
+		string header = sendSendfileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Range: bytes=10-\r\n"
+			"\r\n",
+			absolutizePath("tmp.sendfile/file"));
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 416 Requested Range Not Satisfiable\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Range: bytes */10\r\n"));
+	}
+
+	TEST_METHOD(69) {
+		set_test_name("It forwards X-Sendfile responses as-is if the file is not inside a sendfile root");
+
+		TempDir tempDir("tmp.sendfile");
+		TempDir tempDir2("tmp.sendfile2");
+		createFile("tmp.sendfile/secret", "secret");
+		symlink("../tmp.sendfile/secret", "tmp.sendfile2/link");
+		config["sendfile_roots"].append("tmp.sendfile2");
+		init();
+		useTestSessionObject();
+
+		string header = sendSendfileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			absolutizePath("tmp.sendfile2/link"));
+		ensure("(1)", containsSubstring(header, "X-Sendfile: "));
+		ensure("(2)", !containsSubstring(readResponseBody(), "secret"));
+	}
+
+	TEST_METHOD(70) {
+		set_test_name("It responds with 404 if a file referenced by X-Sendfile "
+			"does not exist inside a sendfile root");
+
+		TempDir tempDir("tmp.sendfile");
+		config["sendfile_roots"].append("tmp.sendfile");
+		init();
+		useTestSessionObject();
+
+		string header = sendSendfileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			absolutizePath("tmp.sendfile/nonexistant"));
+		ensure(containsSubstring(header, "HTTP/1.1 404 Not Found\r\n"));
+	}
+
+
+	TEST_METHOD(77) {
+		set_test_name("It discards the application's fixed-length body when sending a file"
+			" referenced by X-Sendfile, and does not reuse the application connection");
+
+		TempDir tempDir("tmp.sendfile");
+		createFile("tmp.sendfile/file", "file contents");
+		config["sendfile_roots"].append("tmp.sendfile");
+		init();
+		useTestSessionObject();
+
+		string header = sendSendfileResponseWithBody(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			absolutizePath("tmp.sendfile/file"),
+			"Content-Length: 16\r\n\r\n"
+			"application body");
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Length: 13\r\n"));
+		ensure_equals("(3)", readResponseBody(), "file contents");
+		waitUntilSessionClosed();
+		ensure("(4)", testSession.isSuccessful());
+		ensure("(5)", !testSession.wantsKeepAlive());
+	}
+
+	TEST_METHOD(78) {
+		set_test_name("It discards the application's chunked body when sending a file"
+			" referenced by X-Sendfile, and does not reuse the application connection");
+
+		TempDir tempDir("tmp.sendfile");
+		createFile("tmp.sendfile/file", "file contents");
+		config["sendfile_roots"].append("tmp.sendfile");
+		init();
+		useTestSessionObject();
+
+		string header = sendSendfileResponseWithBody(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			absolutizePath("tmp.sendfile/file"),
+			"Transfer-Encoding: chunked\r\n\r\n"
+			"b\r\napplication\r\n5\r\n body\r\n0\r\n\r\n");
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Length: 13\r\n"));
+		ensure("(3)", !containsSubstring(header, "Transfer-Encoding"));
+		ensure_equals("(4)", readResponseBody(), "file contents");
+		waitUntilSessionClosed();
+		ensure("(5)", testSession.isSuccessful());
+		ensure("(6)", !testSession.wantsKeepAlive());
+	}
+
+
+	/***** Response splicing *****/
+
+	TEST_METHOD(71) {
+		set_test_name("It relays large response bodies with splice() while the client keeps up");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+
+		string body = createLargeBody();
+		string response =
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n"
+			+ body;
+		TempThread thr(boost::bind(&Core_ControllerTest::sendPeerResponse,
+			this, StaticString(response)));
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Length: " + toString(body.size()) + "\r\n"));
+		ensure_equals("(3)", readResponseBody(), body);
+		thr.join();
+		ensure("(4)", getSplicedBytes() > 0);
+		waitUntilSessionClosed();
+	}
+
+	TEST_METHOD(72) {
+		set_test_name("It buffers the rest of the response body if the client "
+			"does not keep up, so that the application does not have to wait");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+
+		// We don't read anything until the application has sent everything.
+		string body = createLargeBody();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n"
+			+ body);
+		waitUntilSessionClosed();
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("(2)", readResponseBody(), body);
+	}
+
+	TEST_METHOD(73) {
+		set_test_name("It does not splice if response_splice_min_size is 0");
+
+		config["response_splice_min_size"] = 0;
+		init();
+		useTestSessionObject();
+
+		string body = createLargeBody();
+		string header = sendCompressibleResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"text/plain", body);
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("(2)", readResponseBody(), body);
+		ensure_equals("(3)", getSplicedBytes(), 0u);
+	}
+
+	/***** Location configs *****/
+
+	TEST_METHOD(74) {
+		set_test_name("It takes the options of a request from the location config"
+			" that the request refers to, unless the request overrides them");
+
+		config["multi_app"] = true;
+		config["location_configs"].append(
+			"!~PASSENGER_APP_GROUP_NAME: other\r\n");
+		config["location_configs"].append(
+			"!~PASSENGER_APP_GROUP_NAME: foo\r\n"
+			"!~PASSENGER_APP_ROOT: stub/rack\r\n"
+			"!~PASSENGER_APP_TYPE: rack\r\n"
+			"!~SCRIPT_NAME: /foo\r\n"
+			"!~PASSENGER_ENV_VARS: Rk9PAGJhcgA=\r\n");
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /bar/hello HTTP/1.1\r\n"
+			"!~: \r\n"
+			"!~PASSENGER_LOCATION_CONFIG_ID: 1\r\n"
+			"!~SCRIPT_NAME: /bar\r\n"
+			"!~: \r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		string header = readPeerRequestHeader();
+		// Sent with the request, so it overrides the location config
+		ensure("(1)", containsSubstring(header,
+			P_STATIC_STRING("SCRIPT_NAME\000/bar\000")));
+		ensure("(2)", !containsSubstring(header,
+			P_STATIC_STRING("SCRIPT_NAME\000/foo\000")));
+		// Only set in the location config
+		ensure("(3)", containsSubstring(header,
+			P_STATIC_STRING("FOO\000bar\000")));
+	}
+
+	TEST_METHOD(75) {
+		set_test_name("It disconnects the client if the request refers to"
+			" an unknown location config");
+
+		config["multi_app"] = true;
+		config["location_configs"].append(
+			"!~PASSENGER_APP_GROUP_NAME: foo\r\n"
+			"!~PASSENGER_APP_ROOT: stub/rack\r\n"
+			"!~PASSENGER_APP_TYPE: rack\r\n");
+		init();
+		useTestSessionObject();
+		LoggingKit::setLevel(LoggingKit::CRIT);
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"!~: \r\n"
+			"!~PASSENGER_LOCATION_CONFIG_ID: 1\r\n"
+			"!~: \r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+
+		string response;
+		try {
+			response = readResponseHeader();
+		} catch (const SystemException &) {
+			// The connection may have been reset.
+		}
+		ensure_equals(response, "");
+		ensure_equals(testSession.fd(), -1);
+	}
+
+	TEST_METHOD(81) {
+		set_test_name("It uses the location config with the ID that the request"
+			" refers to, and not any other location config");
+
+		config["multi_app"] = true;
+		config["location_configs"].append(
+			"!~PASSENGER_APP_GROUP_NAME: zero\r\n"
+			"!~PASSENGER_APP_ROOT: stub/rack\r\n"
+			"!~PASSENGER_APP_TYPE: rack\r\n"
+			"!~SCRIPT_NAME: /zero\r\n"
+			"!~PASSENGER_ENV_VARS: Rk9PAHplcm8A\r\n");
+		config["location_configs"].append(
+			"!~PASSENGER_APP_GROUP_NAME: one\r\n"
+			"!~PASSENGER_APP_ROOT: stub/rack\r\n"
+			"!~PASSENGER_APP_TYPE: rack\r\n"
+			"!~SCRIPT_NAME: /one\r\n"
+			"!~PASSENGER_ENV_VARS: Rk9PAG9uZQA=\r\n");
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /zero/hello HTTP/1.1\r\n"
+			"!~: \r\n"
+			"!~PASSENGER_LOCATION_CONFIG_ID: 0\r\n"
+			"!~: \r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		string header = readPeerRequestHeader();
+		ensure("(1)", containsSubstring(header,
+			P_STATIC_STRING("SCRIPT_NAME\000/zero\000")));
+		ensure("(2)", containsSubstring(header,
+			P_STATIC_STRING("FOO\000zero\000")));
+		ensure("(3)", !containsSubstring(header,
+			P_STATIC_STRING("SCRIPT_NAME\000/one\000")));
+		ensure("(4)", !containsSubstring(header,
+			P_STATIC_STRING("FOO\000one\000")));
+	}
 }
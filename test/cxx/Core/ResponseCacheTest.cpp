@@ -69,12 +69,15 @@ namespace tut {
 			req.appResponseInitialized = false;
 			req.strip100ContinueHeader = false;
 			req.hasPragmaHeader = false;
+			req.acceptsGzip = false;
+			req.compressResponse = false;
 			req.host = createHostString();
 			req.bodyBytesBuffered = 0;
 			req.cacheKey = HashedStaticString();
 			req.cacheControl = NULL;
 			req.varyCookie = NULL;
 			req.envvars = NULL;
+			req.locationConfig = NULL;
 
 			req.appResponse.headers.clear();
 			req.appResponse.secureHeaders.clear();
@@ -152,6 +155,33 @@ namespace tut {
 			req.appResponse.bodyType = AppResponse::RBT_CONTENT_LENGTH;
 			req.appResponse.aux.bodyInfo.contentLength = body.size();
 		}
+
+		void setPath(const StaticString &path) {
+			psg_lstr_init(&req.path);
+			psg_lstr_append(&req.path, req.pool, path.data(), path.size());
+		}
+
+		ResponseCacheType::Entry storeResponse(const StaticString &path,
+			unsigned int headerSize = 10, unsigned int bodySize = 10,
+			bool gzip = false)
+		{
+			reset();
+			setPath(path);
+			req.acceptsGzip = gzip;
+			initCacheableResponse();
+			ensure(responseCache.prepareRequest(this, &req));
+			ensure(responseCache.requestAllowsStoring(&req));
+			ensure(responseCache.prepareRequestForStoring(&req));
+			return responseCache.store(&req, time(NULL), headerSize, bodySize);
+		}
+
+		bool isCached(const StaticString &path, bool gzip = false) {
+			reset();
+			setPath(path);
+			req.acceptsGzip = gzip;
+			ensure(responseCache.prepareRequest(this, &req));
+			return responseCache.fetch(&req, time(NULL)).valid();
+		}
 	};
 
 	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ResponseCacheTest, 100);
@@ -226,7 +256,7 @@ namespace tut {
 		ensure("(12)", entry2.valid());
 		ensure_equals("(13)", entry2.index, 0u);
 		ensure_equals<int>("(14)", entry2.body->httpHeaderSize, responseHeadersStr.size());
-		ensure_equals<int>("(15)", entry2.body->httpBodySize, responseBodyStr.size());
+		ensure_equals<unsigned int>("(15)", entry2.body->httpBodySize, responseBodyStr.size());
 	}
 
 	TEST_METHOD(11) {
@@ -571,4 +601,136 @@ namespace tut {
 		ResponseCacheType::Entry entry2(responseCache.fetch(&req, time(NULL)));
 		ensure("(22)", !entry2.valid());
 	}
+
+
+	/***** Capacity and eviction *****/
+
+	TEST_METHOD(70) {
+		set_test_name("It can store more entries than the old fixed limit of 8");
+		for (unsigned int i = 0; i < 100; i++) {
+			ensure(storeResponse("/" + toString(i)).valid());
+		}
+		ensure_equals(responseCache.getEntryCount(), 100u);
+		for (unsigned int i = 0; i < 100; i++) {
+			ensure("Entry " + toString(i) + " is cached", isCached("/" + toString(i)));
+		}
+	}
+
+	TEST_METHOD(71) {
+		set_test_name("Storing an existing key replaces the entry");
+		ensure(storeResponse("/", 10, 10).valid());
+		ensure(storeResponse("/", 20, 30).valid());
+		ensure_equals(responseCache.getEntryCount(), 1u);
+
+		reset();
+		ensure(responseCache.prepareRequest(this, &req));
+		ResponseCacheType::Entry entry(responseCache.fetch(&req, time(NULL)));
+		ensure(entry.valid());
+		ensure_equals<int>(entry.body->httpHeaderSize, 20);
+		ensure_equals<unsigned int>(entry.body->httpBodySize, 30);
+		ensure_equals(responseCache.getTotalSize(), req.cacheKey.size() + 50);
+	}
+
+	TEST_METHOD(72) {
+		set_test_name("It evicts entries when the maximum number of entries is reached");
+		responseCache.configure(3, 1024 * 1024);
+		ensure(storeResponse("/1").valid());
+		ensure(storeResponse("/2").valid());
+		ensure(storeResponse("/3").valid());
+		ensure(storeResponse("/4").valid());
+		ensure_equals(responseCache.getEntryCount(), 3u);
+		ensure_equals(responseCache.getEvictions(), 1u);
+		ensure("(1)", !isCached("/1"));
+		ensure("(2)", isCached("/4"));
+	}
+
+	TEST_METHOD(73) {
+		set_test_name("It evicts entries when the maximum size is reached");
+		responseCache.configure(100, 4000);
+		for (unsigned int i = 0; i < 10; i++) {
+			ensure(storeResponse("/" + toString(i), 100, 900).valid());
+		}
+		ensure(responseCache.getTotalSize() <= 4000u);
+		ensure_equals(responseCache.getEntryCount(), 3u);
+		ensure("(1)", !isCached("/0"));
+		ensure("(2)", isCached("/9"));
+	}
+
+	TEST_METHOD(74) {
+		set_test_name("Recently fetched entries get a second chance before being evicted");
+		responseCache.configure(3, 1024 * 1024);
+		ensure(storeResponse("/1").valid());
+		ensure(storeResponse("/2").valid());
+		ensure(storeResponse("/3").valid());
+		ensure(isCached("/1"));
+		ensure(storeResponse("/4").valid());
+		ensure("(1)", isCached("/1"));
+		ensure("(2)", !isCached("/2"));
+		ensure("(3)", isCached("/3"));
+		ensure("(4)", isCached("/4"));
+	}
+
+	TEST_METHOD(75) {
+		set_test_name("It refuses to store bodies larger than the maximum body size");
+		responseCache.configure(100, 4000);
+		ensure_equals(responseCache.getMaxBodySize(), 1000u);
+		ensure("(1)", !storeResponse("/", 10, 1001).valid());
+		ensure("(2)", storeResponse("/", 10, 1000).valid());
+	}
+
+	TEST_METHOD(76) {
+		set_test_name("Invalidated entries are removed from the index");
+		responseCache.configure(100, 1024 * 1024);
+		for (unsigned int i = 0; i < 50; i++) {
+			ensure(storeResponse("/" + toString(i)).valid());
+		}
+		for (unsigned int i = 0; i < 50; i += 2) {
+			reset();
+			setPath("/" + toString(i));
+			req.method = HTTP_POST;
+			ensure(responseCache.prepareRequest(this, &req));
+			responseCache.invalidate(&req);
+		}
+		ensure_equals(responseCache.getEntryCount(), 25u);
+		for (unsigned int i = 0; i < 50; i++) {
+			ensure("Entry " + toString(i), isCached("/" + toString(i)) == (i % 2 == 1));
+		}
+	}
+
+	TEST_METHOD(77) {
+		set_test_name("clear() removes all entries");
+		for (unsigned int i = 0; i < 10; i++) {
+			ensure(storeResponse("/" + toString(i)).valid());
+		}
+		responseCache.clear();
+		ensure_equals(responseCache.getEntryCount(), 0u);
+		ensure_equals(responseCache.getTotalSize(), (size_t) 0);
+		ensure(!isCached("/0"));
+		ensure(storeResponse("/0").valid());
+		ensure(isCached("/0"));
+	}
+
+	TEST_METHOD(78) {
+		set_test_name("Responses for clients that accept gzip are cached separately");
+		ensure(storeResponse("/", 10, 10, true).valid());
+		ensure("(1)", isCached("/", true));
+		ensure("(2)", !isCached("/", false));
+		ensure(storeResponse("/", 10, 20, false).valid());
+		ensure_equals(responseCache.getEntryCount(), 2u);
+	}
+
+	TEST_METHOD(79) {
+		set_test_name("Invalidation removes both the gzip and the identity variant");
+		ensure(storeResponse("/", 10, 10, true).valid());
+		ensure(storeResponse("/", 10, 10, false).valid());
+
+		reset();
+		req.method = HTTP_POST;
+		ensure(responseCache.prepareRequest(this, &req));
+		responseCache.invalidate(&req);
+
+		ensure_equals(responseCache.getEntryCount(), 0u);
+		ensure("(1)", !isCached("/", true));
+		ensure("(2)", !isCached("/", false));
+	}
 }
@@ -2,10 +2,13 @@
 #include <jsoncpp/json.h>
 #include <Core/ApplicationPool/Options.h>
 #include <Core/SpawningKit/SmartSpawner.h>
+#include <Core/SpawningKit/Factory.h>
 #include <LoggingKit/LoggingKit.h>
 #include <LoggingKit/Context.h>
 #include <FileDescriptor.h>
 #include <IOTools/IOUtils.h>
+#include <IOTools/MessageSerialization.h>
+#include <SystemTools/SystemTime.h>
 #include <unistd.h>
 #include <climits>
 #include <signal.h>
@@ -76,6 +79,12 @@ namespace tut {
 				options);
 		}
 
+		static void spawnInto(SmartSpawner *spawner, const SpawningKit::AppPoolOptions *options,
+			SpawningKit::Result *result)
+		{
+			*result = spawner->spawn(*options);
+		}
+
 		SpawningKit::AppPoolOptions createOptions() {
 			SpawningKit::AppPoolOptions options;
 			options.appType     = "directly-through-start-command";
@@ -83,6 +92,35 @@ namespace tut {
 			options.loadShellEnvvars = false;
 			return options;
 		}
+
+		static pid_t forkChildThatExitsAfter(unsigned int msec) {
+			pid_t pid = fork();
+			if (pid == 0) {
+				usleep(msec * 1000);
+				_exit(3);
+			} else if (pid == -1) {
+				int e = errno;
+				throw SystemException("Cannot fork", e);
+			}
+			return pid;
+		}
+
+		static void testTimedWaitpid(int (*waitFunc)(pid_t, int *, unsigned long long)) {
+			pid_t pid = forkChildThatExitsAfter(300);
+			int status = 0;
+			ensure_equals("(1) times out while the process is running",
+				waitFunc(pid, &status, 50), 0);
+
+			unsigned long long start = SystemTime::getMonotonicUsec();
+			ensure_equals("(2) returns the PID once the process exits",
+				waitFunc(pid, &status, 5000), pid);
+			ensure("(3) waits until the process exits",
+				SystemTime::getMonotonicUsec() - start >= 200000);
+			ensure("(4) notices the exit quickly",
+				SystemTime::getMonotonicUsec() - start < 3000000);
+			ensure("(5)", WIFEXITED(status));
+			ensure_equals("(6)", WEXITSTATUS(status), 3);
+		}
 	};
 
 	DEFINE_TEST_GROUP(Core_SpawningKit_SmartSpawnerTest);
@@ -248,4 +286,122 @@ namespace tut {
 			ensure(containsSubstring(e.getSubprocessEnvvars(), "PASSENGER_FOO=foo\n"));
 		}
 	}
+
+	TEST_METHOD(15) {
+		set_test_name("The WSGI preloader forks app processes that speak the session protocol");
+
+		SpawningKit::AppPoolOptions options = createOptions();
+		options.appRoot     = "stub/wsgi";
+		options.appType     = "wsgi";
+		options.startupFile = "passenger_wsgi.py";
+
+		vector<string> preloaderCommand;
+		preloaderCommand.push_back("python");
+		preloaderCommand.push_back(resourceLocator->getHelperScriptsDir() + "/wsgi-preloader.py");
+		SmartSpawner spawner(&context, preloaderCommand, options);
+
+		result = spawner.spawn(options);
+		SpawningKit::Result result2 = spawner.spawn(options);
+		ensure(result.pid != spawner.getPreloaderPid());
+		ensure(result2.pid != spawner.getPreloaderPid());
+		ensure(result.pid != result2.pid);
+		ensure_equals(result.sockets.size(), 1u);
+		ensure_equals(result.sockets[0].protocol, "session");
+
+		const char header[] = "REQUEST_METHOD\0ping\0";
+		char sizeBuf[4];
+		Uint32Message::generate(sizeBuf, sizeof(header) - 1);
+		FileDescriptor fd(connectToServer(result.sockets[0].address,
+			__FILE__, __LINE__), NULL, 0);
+		writeExact(fd, StaticString(sizeBuf, sizeof(sizeBuf)));
+		writeExact(fd, StaticString(header, sizeof(header) - 1));
+		ensure_equals(readAll(fd, 1024).first, "pong");
+	}
+
+	TEST_METHOD(16) {
+		set_test_name("WSGI app processes advertise python_thread_count as their concurrency");
+
+		SpawningKit::AppPoolOptions options = createOptions();
+		options.appRoot     = "stub/wsgi";
+		options.appType     = "wsgi";
+		options.startupFile = "passenger_wsgi.py";
+		options.pythonThreadCount = 4;
+
+		vector<string> preloaderCommand;
+		preloaderCommand.push_back("python");
+		preloaderCommand.push_back(resourceLocator->getHelperScriptsDir() + "/wsgi-preloader.py");
+		SmartSpawner spawner(&context, preloaderCommand, options);
+
+		result = spawner.spawn(options);
+		ensure_equals(result.sockets.size(), 1u);
+		ensure_equals(result.sockets[0].concurrency, 4);
+	}
+
+	TEST_METHOD(17) {
+		set_test_name("The handshakes of concurrent spawns run in parallel");
+
+		SpawningKit::AppPoolOptions options = createOptions();
+		options.appRoot      = "stub/rack";
+		options.appStartCommand = "sleep 2; exec ruby start.rb";
+		options.startupFile  = "start.rb";
+		boost::shared_ptr<SmartSpawner> spawner = createSpawner(options);
+
+		// Start the preloader first, so that only the forked processes are timed.
+		result = spawner->spawn(options);
+
+		SpawningKit::Result result2, result3;
+		MonotonicTimeUsec startTime = SystemTime::getMonotonicUsec();
+		TempThread thr1(boost::bind(spawnInto, spawner.get(), &options, &result2));
+		TempThread thr2(boost::bind(spawnInto, spawner.get(), &options, &result3));
+		thr1.join();
+		thr2.join();
+		MonotonicTimeUsec elapsed = SystemTime::getMonotonicUsec() - startTime;
+
+		ensure("(1)", result2.pid > 0);
+		ensure("(2)", result3.pid > 0);
+		ensure("(3)", result2.pid != result3.pid);
+		// Each process takes at least 2 seconds to finish its handshake,
+		// so serialized handshakes take at least 4 seconds.
+		ensure("(4) handshakes overlap", elapsed < 3500000);
+	}
+
+	TEST_METHOD(18) {
+		set_test_name("The factory only uses the WSGI preloader when Python smart spawning is enabled");
+
+		SpawningKit::AppPoolOptions options = createOptions();
+		options.appRoot     = "stub/wsgi";
+		options.appType     = "wsgi";
+		options.startupFile = "passenger_wsgi.py";
+		options.spawnMethod = "smart";
+		Factory factory(&context);
+
+		ensure("(1) Python apps are spawned directly by default",
+			boost::dynamic_pointer_cast<DirectSpawner>(factory.create(options)) != NULL);
+
+		options.pythonSmartSpawning = true;
+		ensure("(2)", boost::dynamic_pointer_cast<SmartSpawner>(factory.create(options)) != NULL);
+
+		options.spawnMethod = "direct";
+		ensure("(3)", boost::dynamic_pointer_cast<DirectSpawner>(factory.create(options)) != NULL);
+	}
+
+	TEST_METHOD(19) {
+		set_test_name("timedWaitpid() waits until the process exits or the timeout expires");
+		testTimedWaitpid(SmartSpawner::timedWaitpid);
+
+		// A process that has already exited, but hasn't been reaped yet,
+		// is reaped immediately.
+		pid_t pid = forkChildThatExitsAfter(0);
+		usleep(100000);
+		ensure_equals("(7)", SmartSpawner::timedWaitpid(pid, NULL, 5000), pid);
+
+		// There is nothing to wait for if the process has already been reaped.
+		ensure_equals("(8)", SmartSpawner::timedWaitpid(pid, NULL, 50), -1);
+	}
+
+	TEST_METHOD(20) {
+		set_test_name("pollingTimedWaitpid(), the fallback for systems without pidfds, "
+			"waits until the process exits or the timeout expires");
+		testTimedWaitpid(SmartSpawner::pollingTimedWaitpid);
+	}
 }
@@ -917,4 +917,63 @@ namespace tut {
 		ensure_equals(result.first, "hello");
 		ensure(!result.second);
 	}
+
+
+	/***** Test finishConnectingToServer() *****/
+
+	TEST_METHOD(90) {
+		set_test_name("finishConnectingToServer() on a TCP server that accepts connections");
+		FileDescriptor server(createTcpServer("127.0.0.1", 0, 0, __FILE__, __LINE__),
+			NULL, 0);
+		struct sockaddr_in addr;
+		socklen_t len = sizeof(addr);
+		getsockname(server, (struct sockaddr *) &addr, &len);
+		string address = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
+
+		NConnect_State state;
+		setupNonBlockingSocket(state, address, __FILE__, __LINE__);
+		if (!connectToServer(state)) {
+			unsigned long long timeout = 1000000;
+			ensure("Socket becomes writable", waitUntilWritable(state.s_tcp.fd, &timeout));
+		}
+		ensure(finishConnectingToServer(state.s_tcp.fd, address));
+	}
+
+	TEST_METHOD(91) {
+		set_test_name("finishConnectingToServer() on a TCP port that refuses connections");
+		FileDescriptor server(createTcpServer("127.0.0.1", 0, 0, __FILE__, __LINE__),
+			NULL, 0);
+		struct sockaddr_in addr;
+		socklen_t len = sizeof(addr);
+		getsockname(server, (struct sockaddr *) &addr, &len);
+		string address = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
+		server.close();
+
+		NConnect_State state;
+		setupNonBlockingSocket(state, address, __FILE__, __LINE__);
+		try {
+			if (!connectToServer(state)) {
+				unsigned long long timeout = 1000000;
+				ensure("Socket becomes writable", waitUntilWritable(state.s_tcp.fd, &timeout));
+				finishConnectingToServer(state.s_tcp.fd, address);
+			}
+			fail("SystemException expected");
+		} catch (const SystemException &e) {
+			ensure_equals(e.code(), ECONNREFUSED);
+		}
+	}
+
+	TEST_METHOD(92) {
+		set_test_name("finishConnectingToServer() on a Unix domain socket server");
+		string filename = "tmp.socket";
+		FileDescriptor server(createUnixServer(filename, 0, true, __FILE__, __LINE__),
+			NULL, 0);
+		string address = "unix:" + filename;
+
+		NConnect_State state;
+		setupNonBlockingSocket(state, address, __FILE__, __LINE__);
+		ensure(connectToServer(state));
+		ensure(finishConnectingToServer(state.s_unix.fd, address));
+		unlink(filename.c_str());
+	}
 }
@@ -64,6 +64,32 @@ namespace tut {
 			}
 		}
 
+		/**
+		 * Returns whether this system supports io_uring. If it does, then
+		 * ensures that the context has created an io_uring instance, so
+		 * that the io_uring tests can't silently fall back to libuv.
+		 * Must be called before the event loop is started.
+		 */
+		bool ioUringAvailable() {
+			if (!IoUring::isSupported()) {
+				return false;
+			}
+
+			try {
+				IoUring probe(bg.safe->getLoop());
+			} catch (const SystemException &e) {
+				// Not implemented by this kernel, or disabled by a
+				// seccomp policy or by the kernel.io_uring_disabled sysctl.
+				if (e.code() == ENOSYS || e.code() == EPERM) {
+					return false;
+				}
+				throw;
+			}
+
+			ensure("The context has an io_uring instance", context.getIoUring() != NULL);
+			return true;
+		}
+
 		static Channel::Result dataCallback(Channel *_channel, const mbuf &buffer, int errcode)
 		{
 			FileBufferedChannel *channel = reinterpret_cast<FileBufferedChannel *>(_channel);
@@ -1079,4 +1105,106 @@ namespace tut {
 			ensure_equals(counter, 2u);
 		}
 	}
+
+
+	/***** io_uring *****/
+
+	static string extractLoggedData(const string &log) {
+		string result;
+		string::size_type pos = 0;
+
+		while (pos < log.size()) {
+			string::size_type end = log.find('\n', pos);
+			if (log.compare(pos, sizeof("Data: ") - 1, "Data: ") == 0) {
+				result.append(log, pos + sizeof("Data: ") - 1,
+					end - pos - (sizeof("Data: ") - 1));
+			}
+			pos = end + 1;
+		}
+		return result;
+	}
+
+	TEST_METHOD(50) {
+		set_test_name("When io_uring is enabled, it moves memory buffers to disk and "
+			"reads them back in order");
+
+		Json::Value config;
+		vector<ConfigKit::Error> errors;
+		config["file_buffered_channel_threshold"] = 1;
+		config["file_buffered_channel_io_uring"] = true;
+		ensure(context.configure(config, errors));
+		if (!ioUringAvailable()) {
+			return;
+		}
+
+		toConsume = -1;
+		startLoop();
+
+		feedChannel("hello");
+		feedChannel("world!");
+		feedChannel("bye");
+		EVENTUALLY(5,
+			result = getChannelMode() == FileBufferedChannel::IN_FILE_MODE;
+		);
+		EVENTUALLY(5,
+			result = getChannelWriterState() == FileBufferedChannel::WS_INACTIVE;
+		);
+		ensure_equals(getChannelBytesBuffered(), 0u);
+
+		{
+			LOCK();
+			toConsume = CONSUME_FULLY;
+		}
+		channelConsumed(sizeof("hello") - 1, false);
+		EVENTUALLY(5,
+			LOCK();
+			result = extractLoggedData(log) == "helloworld!bye";
+		);
+		EVENTUALLY(5,
+			result = getChannelMode() == FileBufferedChannel::IN_MEMORY_MODE;
+		);
+	}
+
+	TEST_METHOD(51) {
+		set_test_name("When io_uring is enabled, data that is fed while the reader "
+			"is reading from the file is passed to the callback after the data on disk");
+
+		Json::Value config;
+		vector<ConfigKit::Error> errors;
+		config["file_buffered_channel_threshold"] = 1;
+		config["file_buffered_channel_io_uring"] = true;
+		ensure(context.configure(config, errors));
+		if (!ioUringAvailable()) {
+			return;
+		}
+
+		toConsume = -1;
+		startLoop();
+
+		feedChannel("hello");
+		feedChannel("world!");
+		EVENTUALLY(5,
+			result = getChannelWriterState() == FileBufferedChannel::WS_INACTIVE
+				&& getChannelBytesBuffered() == 0;
+		);
+
+		channelConsumed(sizeof("hello") - 1, false);
+		EVENTUALLY(5,
+			LOCK();
+			result = counter == 2
+				&& getChannelState() == Channel::WAITING_FOR_CALLBACK;
+		);
+		feedChannel("abc");
+		feedChannel("def");
+
+		{
+			LOCK();
+			toConsume = CONSUME_FULLY;
+		}
+		channelConsumed(sizeof("world!") - 1, false);
+		EVENTUALLY(5,
+			LOCK();
+			result = extractLoggedData(log) == "helloworld!abcdef";
+		);
+	}
 }
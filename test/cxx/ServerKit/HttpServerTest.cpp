@@ -634,6 +634,29 @@ namespace tut {
 		ensure(containsSubstring(response, "Contiguous: 1"));
 	}
 
+	TEST_METHOD(6) {
+		set_test_name("Long header names and values, with unusual characters, "
+			"are parsed correctly");
+
+		connectToServer();
+		sendRequestAndWait(
+			"GET / HTTP/1.1\r\n"
+			"Connection: close\r\n"
+			"X-A-Rather-Long-Header-Name_With.Unusual~Characters-01234567: "
+				"a value: with colons,\tt");
+		sendRequestAndWait(
+			"abs and 'quotes' that spans more than sixteen bytes\r\n"
+			"X-Another-Rather-Long-Heade");
+		sendRequest(
+			"r-Name: x\r\n"
+			"FOO: Some Value That Is Longer Than Sixteen Bytes; q=0.9\r\n"
+			"\r\n");
+
+		string response = readAll(fd, 1024).first;
+		ensure(containsSubstring(response,
+			"Foo: Some Value That Is Longer Than Sixteen Bytes; q=0.9"));
+	}
+
 
 	/***** Invalid HTTP header parsing *****/
 
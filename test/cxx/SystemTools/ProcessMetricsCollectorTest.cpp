@@ -113,4 +113,70 @@ namespace tut {
 			ensure(swap < 10000 || swap == -1);
 		#endif
 	}
+
+	#ifdef __linux__
+		TEST_METHOD(4) {
+			// On Linux, it collects the metrics from /proc.
+			vector<pid_t> pids;
+			pids.push_back(getpid());
+			ensure(collector.usesNativeCollection());
+			ProcessMetricMap result = collector.collect(pids);
+
+			ensure_equals(result.size(), 1u);
+			const ProcessMetrics &metrics = result[getpid()];
+			ensure_equals(metrics.pid, getpid());
+			ensure_equals(metrics.ppid, getppid());
+			ensure_equals(metrics.processGroupId, getpgrp());
+			ensure_equals(metrics.uid, geteuid());
+			ensure("RSS is set", metrics.rss > 0);
+			ensure("VM size is set", metrics.vmsize >= metrics.rss);
+			ensure("Command is set", !metrics.command.empty());
+		}
+
+		TEST_METHOD(5) {
+			// The metrics collected from /proc are consistent with the ones
+			// collected through 'ps'.
+			child = spawnChild(50);
+			usleep(500000);
+			vector<pid_t> pids;
+			pids.push_back(child);
+
+			ProcessMetricMap nativeResult = collector.collect(pids);
+			ProcessMetricsCollector psCollector;
+			psCollector.setNativeCollectionEnabled(false);
+			ensure(!psCollector.usesNativeCollection());
+			ProcessMetricMap psResult = psCollector.collect(pids);
+
+			ensure_equals(nativeResult.size(), 1u);
+			ensure_equals(psResult.size(), 1u);
+			const ProcessMetrics &native = nativeResult[child];
+			const ProcessMetrics &ps = psResult[child];
+			ensure_equals(native.ppid, ps.ppid);
+			ensure_equals(native.processGroupId, ps.processGroupId);
+			ensure_equals(native.uid, ps.uid);
+			ensure_equals(native.command, ps.command);
+			ensure("RSS is correct", native.rss > 50000 && native.rss < 60000);
+			ensure("VM size is consistent", native.vmsize > 50000
+				&& native.vmsize >= ps.vmsize - 1024 && native.vmsize <= ps.vmsize + 1024);
+			ensure("PSS is correct", (native.pss > 50000 && native.pss < 60000) || native.pss == -1);
+			ensure("Private dirty is correct", native.privateDirty > 50000 && native.privateDirty < 60000);
+			ensure("Swap is correct", native.swap < 10000);
+		}
+
+		TEST_METHOD(6) {
+			// On Linux, it does not collect the metrics for PIDs that don't exist.
+			child = spawnChild(1);
+			kill(child, SIGKILL);
+			waitpid(child, NULL, 0);
+			vector<pid_t> pids;
+			pids.push_back(getpid());
+			pids.push_back(child);
+			child = -1;
+
+			ProcessMetricMap result = collector.collect(pids);
+			ensure_equals(result.size(), 1u);
+			ensure(result.find(getpid()) != result.end());
+			ensure(result.find(pids[1]) == result.end());
+		}
+	#endif
 }
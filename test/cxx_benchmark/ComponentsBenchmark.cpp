@@ -0,0 +1,770 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures the components that the Core uses for every request, so that
+ * regressions in them can be spotted by comparing the results of two commits:
+ *
+ *  - http_parser:         http_parser_execute() on a request header, without
+ *                         any of the HttpHeaderParser bookkeeping.
+ *  - header_table:        inserting and looking up the headers of a request.
+ *  - string_key_table:    inserting and looking up the same header names.
+ *  - mbuf:                getting an mbuf from the pool and releasing it.
+ *  - palloc:              allocating from a memory pool, and creating a pool.
+ *  - response_cache:      preparing a request for the turbocache, and
+ *                         fetching (hit and miss) and storing an entry.
+ *  - session_protocol_header: constructing the session protocol header of a
+ *                         browser request, as parsed by the Controller.
+ *  - controller/round_trip: a keep-alive request from a client through the
+ *                         Controller to a fake application and back, over
+ *                         Unix domain sockets.
+ *
+ * Benchmark names start with the component name, so --filter can select a
+ * single component. See BenchmarkSupport.h for how the numbers are obtained.
+ * Pass --json to save the results, and --compare with the JSON file of an
+ * earlier run to see the differences. Must be run from the source root.
+ *
+ * Usage: ComponentsBenchmark [--warmup N] [--iterations N] [--filter SUBSTRING]
+ *                            [--json FILE] [--compare FILE]
+ */
+
+#include <oxt/initialize.hpp>
+#include <oxt/system_calls.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <climits>
+#include <unistd.h>
+
+#include <BackgroundEventLoop.cpp>
+#include <LoggingKit/Context.h>
+#include <ResourceLocator.h>
+#include <FileDescriptor.h>
+#include <IOTools/IOUtils.h>
+#include <IOTools/MessageIO.h>
+#include <MemoryKit/mbuf.h>
+#include <MemoryKit/palloc.h>
+#include <DataStructures/LString.h>
+#include <DataStructures/HashedStaticString.h>
+#include <DataStructures/StringKeyTable.h>
+#include <ServerKit/Context.h>
+#include <ServerKit/HeaderTable.h>
+#include <ServerKit/http_parser.h>
+#include <StrIntTools/StrIntUtils.h>
+#include <Core/ApplicationPool/TestSession.h>
+#include <Core/Controller.h>
+#include <Core/ResponseCache.h>
+#include "BenchmarkSupport.h"
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::Core;
+using namespace Passenger::ApplicationPool2;
+
+static const char APP_RESPONSE[] =
+	"HTTP/1.1 200 OK\r\n"
+	"Content-Type: text/plain\r\n"
+	"Content-Length: 2\r\n"
+	"\r\n"
+	"ok";
+
+struct PoolResetter {
+	psg_pool_t *pool;
+
+	void operator()() const {
+		psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE);
+	}
+};
+
+
+/****** http_parser ******/
+
+static int
+onHttpParserData(http_parser *parser, const char *data, size_t size) {
+	return 0;
+}
+
+static int
+onHttpParserEvent(http_parser *parser) {
+	return 0;
+}
+
+struct HttpParserOp {
+	const http_parser_settings *settings;
+	StaticString data;
+
+	size_t parse() const {
+		http_parser parser;
+		http_parser_init(&parser, HTTP_REQUEST);
+		size_t size = http_parser_execute(&parser, settings, data.data(), data.size());
+		if (HTTP_PARSER_ERRNO(&parser) != HPE_OK) {
+			return 0;
+		}
+		return size;
+	}
+
+	void operator()() const {
+		size_t size = parse();
+		DO_NOT_OPTIMIZE(size);
+	}
+};
+
+static void
+benchmarkHttpParser(BenchmarkSuite &suite) {
+	http_parser_settings settings;
+	settings.on_message_begin = onHttpParserEvent;
+	settings.on_url = onHttpParserData;
+	settings.on_status = onHttpParserData;
+	settings.on_header_field = onHttpParserData;
+	settings.on_header_value = onHttpParserData;
+	settings.on_headers_complete = onHttpParserEvent;
+	settings.on_body = onHttpParserData;
+	settings.on_message_complete = onHttpParserEvent;
+
+	HttpParserOp browser = { &settings, P_STATIC_STRING(BROWSER_REQUEST) };
+	HttpParserOp api = { &settings, P_STATIC_STRING(API_REQUEST) };
+	if (browser.parse() != browser.data.size() || api.parse() != api.data.size()) {
+		fprintf(stderr, "http_parser cannot parse the benchmark requests\n");
+		exit(1);
+	}
+
+	suite.run("http_parser/browser", 1000, browser);
+	suite.run("http_parser/api", 1000, api);
+}
+
+
+/****** HeaderTable and StringKeyTable ******/
+
+struct HeaderTableInsertOp {
+	ServerKit::HeaderTable *table;
+	const vector<ServerKit::Header *> *headers;
+	psg_pool_t *pool;
+
+	void operator()() const {
+		table->clear();
+		for (unsigned int i = 0; i < headers->size(); i++) {
+			// insert() takes over the pointer by setting it to NULL.
+			ServerKit::Header *header = (*headers)[i];
+			table->insert(&header, pool);
+		}
+	}
+};
+
+struct HeaderTableLookupOp {
+	const ServerKit::HeaderTable *table;
+	const vector<HashedStaticString> *names;
+
+	void operator()() const {
+		for (unsigned int i = 0; i < names->size(); i++) {
+			const LString *value = table->lookup((*names)[i]);
+			DO_NOT_OPTIMIZE(value);
+		}
+	}
+};
+
+struct StringKeyTableInsertOp {
+	StringKeyTable<unsigned int> *table;
+	const vector<HashedStaticString> *names;
+
+	void operator()() const {
+		table->clear();
+		for (unsigned int i = 0; i < names->size(); i++) {
+			table->insert((*names)[i], i);
+		}
+	}
+};
+
+struct StringKeyTableLookupOp {
+	StringKeyTable<unsigned int> *table;
+	const vector<HashedStaticString> *names;
+
+	void operator()() const {
+		for (unsigned int i = 0; i < names->size(); i++) {
+			unsigned int *value;
+			bool found = table->lookup((*names)[i], &value);
+			DO_NOT_OPTIMIZE(found);
+		}
+	}
+};
+
+static void
+benchmarkTables(BenchmarkSuite &suite) {
+	psg_pool_t *pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+	vector<ServerKit::Header *> headers = createRequestHeaders(pool,
+		P_STATIC_STRING(BROWSER_REQUEST));
+	vector<HashedStaticString> names;
+
+	for (unsigned int i = 0; i < headers.size(); i++) {
+		names.push_back(HashedStaticString(headers[i]->key.start->data,
+			headers[i]->key.size));
+	}
+
+	ServerKit::HeaderTable headerTable;
+	HeaderTableInsertOp headerTableInsert = { &headerTable, &headers, pool };
+	HeaderTableLookupOp headerTableLookup = { &headerTable, &names };
+	suite.run("header_table/insert", 1000, headerTableInsert);
+	headerTableInsert();
+	suite.run("header_table/lookup", 1000, headerTableLookup);
+
+	StringKeyTable<unsigned int> stringKeyTable;
+	StringKeyTableInsertOp stringKeyTableInsert = { &stringKeyTable, &names };
+	StringKeyTableLookupOp stringKeyTableLookup = { &stringKeyTable, &names };
+	suite.run("string_key_table/insert", 1000, stringKeyTableInsert);
+	stringKeyTableInsert();
+	suite.run("string_key_table/lookup", 1000, stringKeyTableLookup);
+
+	headerTable.clear();
+	psg_destroy_pool(pool);
+}
+
+
+/****** mbuf and palloc ******/
+
+struct MbufGetOp {
+	MemoryKit::mbuf_pool *pool;
+
+	void operator()() const {
+		MemoryKit::mbuf buffer(MemoryKit::mbuf_get(pool));
+		DO_NOT_OPTIMIZE(buffer.start);
+	}
+};
+
+struct PallocOp {
+	psg_pool_t *pool;
+	size_t size;
+
+	void operator()() const {
+		void *data = psg_pnalloc(pool, size);
+		DO_NOT_OPTIMIZE(data);
+	}
+};
+
+struct PoolCreateOp {
+	void operator()() const {
+		psg_pool_t *pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+		DO_NOT_OPTIMIZE(pool);
+		psg_destroy_pool(pool);
+	}
+};
+
+static void
+benchmarkMemory(BenchmarkSuite &suite, ServerKit::Context &context) {
+	MbufGetOp mbufGet = { &context.mbuf_pool };
+	suite.run("mbuf/get_release", 1000, mbufGet);
+
+	psg_pool_t *pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+	PallocOp smallAlloc = { pool, 32 };
+	PallocOp largeAlloc = { pool, 8192 };
+	PoolResetter resetter = { pool };
+	suite.run("palloc/alloc_32", 1000, smallAlloc, resetter);
+	suite.run("palloc/alloc_8192", 100, largeAlloc, resetter);
+	suite.run("palloc/create_destroy", 1000, PoolCreateOp());
+	psg_destroy_pool(pool);
+}
+
+
+/****** ResponseCache ******/
+
+/*
+ * A GET request for which a cacheable response is stored, set up like in
+ * ResponseCacheTest. Everything that the cache operations allocate comes
+ * from `req.pool`, which is reset between samples. The request headers
+ * live in `pool`.
+ */
+struct ResponseCacheFixture {
+	typedef ResponseCache<Request> ResponseCacheType;
+
+	ResponseCacheType cache;
+	Request req;
+	ControllerSchema schema;
+	ConfigKit::Store config;
+	psg_pool_t *pool;
+
+	ResponseCacheFixture()
+		: config(schema)
+	{
+		pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+		req.pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+		config["multi_app"] = false;
+		config["default_server_name"] = "localhost";
+		config["default_server_port"] = "80";
+
+		req.config.reset(new ControllerRequestConfig(config));
+		req.httpMajor = 1;
+		req.httpMinor = 1;
+		req.httpState = Request::COMPLETE;
+		req.bodyType  = Request::RBT_NO_BODY;
+		req.method    = HTTP_GET;
+		req.wantKeepAlive = false;
+		req.detectingNextRequestEarlyReadError = false;
+		req.responseBegun = false;
+		req.client    = NULL;
+		req.hooks.impl     = NULL;
+		req.hooks.userData = NULL;
+		psg_lstr_init(&req.path);
+		psg_lstr_append(&req.path, pool, "/dashboard/projects/42");
+		req.bodyAlreadyRead = 0;
+		req.lastDataReceiveTime = 0;
+		req.lastDataSendTime = 0;
+		req.queryStringIndex = -1;
+		req.bodyError = 0;
+		req.nextRequestEarlyReadError = 0;
+
+		req.startedAt = 0;
+		req.state     = Request::ANALYZING_REQUEST;
+		req.dechunkResponse = false;
+		req.requestBodyBuffering = false;
+		req.https     = false;
+		req.stickySession = false;
+		req.sessionCheckoutTry = 0;
+		req.halfClosePolicy = Request::HALF_CLOSE_POLICY_UNINITIALIZED;
+		req.appResponseInitialized = false;
+		req.strip100ContinueHeader = false;
+		req.hasPragmaHeader = false;
+		req.acceptsGzip = true;
+		req.compressResponse = false;
+		req.bodyBytesBuffered = 0;
+		req.cacheKey = HashedStaticString();
+		req.cacheControl = NULL;
+		req.varyCookie = NULL;
+		req.envvars = NULL;
+		req.locationConfig = NULL;
+
+		LString *host = (LString *) psg_palloc(pool, sizeof(LString));
+		psg_lstr_init(host);
+		psg_lstr_append(host, pool, "www.example.com");
+		req.host = host;
+		vector<ServerKit::Header *> headers = createRequestHeaders(pool,
+			P_STATIC_STRING(BROWSER_REQUEST));
+		for (unsigned int i = 0; i < headers.size(); i++) {
+			// Requests with a Cache-Control header are never served
+			// from the cache.
+			if (headers[i]->hash != HashedStaticString("cache-control").hash()) {
+				req.headers.insert(&headers[i], pool);
+			}
+		}
+
+		req.appResponse.httpMajor  = 1;
+		req.appResponse.httpMinor  = 1;
+		req.appResponse.httpState  = AppResponse::COMPLETE;
+		req.appResponse.wantKeepAlive = false;
+		req.appResponse.oneHundredContinueSent = false;
+		req.appResponse.bodyType   = AppResponse::RBT_CONTENT_LENGTH;
+		req.appResponse.aux.bodyInfo.contentLength = 1024;
+		req.appResponse.statusCode = 200;
+		req.appResponse.bodyAlreadyRead = 0;
+		req.appResponse.setCookie  = NULL;
+		req.appResponse.cacheControl  = NULL;
+		req.appResponse.expiresHeader = NULL;
+		req.appResponse.lastModifiedHeader = NULL;
+		req.appResponse.headerCacheBuffers = NULL;
+		req.appResponse.nHeaderCacheBuffers = 0;
+		psg_lstr_init(&req.appResponse.bodyCacheBuffer);
+
+		// LString does not copy the data, so the date must outlive the fixture.
+		char *date = (char *) psg_pnalloc(pool, 64);
+		time_t now = time(NULL);
+		struct tm tm;
+		gmtime_r(&now, &tm);
+		size_t dateSize = strftime(date, 64, "%a, %d %b %Y %H:%M:%S GMT", &tm);
+		ServerKit::Header *header = createHeader(pool, "date",
+			StaticString(date, dateSize));
+		req.appResponse.date = &header->val;
+		req.appResponse.headers.insert(&header, pool);
+		header = createHeader(pool, "cache-control", "public,max-age=99999");
+		req.appResponse.headers.insert(&header, pool);
+	}
+
+	~ResponseCacheFixture() {
+		req.headers.clear();
+		req.appResponse.headers.clear();
+		psg_destroy_pool(req.pool);
+		req.pool = NULL;
+		psg_destroy_pool(pool);
+	}
+
+	void setPath(const StaticString &path) {
+		psg_lstr_init(&req.path);
+		psg_lstr_append(&req.path, pool, path.data(), path.size());
+	}
+
+	bool prepare() {
+		req.cacheKey = HashedStaticString();
+		req.cacheControl = NULL;
+		req.hasPragmaHeader = false;
+		return cache.prepareRequest(this, &req);
+	}
+
+	bool fetch() {
+		return prepare()
+			&& cache.requestAllowsFetching(&req)
+			&& cache.fetch(&req, time(NULL)).valid();
+	}
+
+	bool store() {
+		return prepare()
+			&& cache.requestAllowsStoring(&req)
+			&& cache.prepareRequestForStoring(&req)
+			&& cache.store(&req, time(NULL), 256, 1024).valid();
+	}
+};
+
+struct ResponseCacheFetchOp {
+	ResponseCacheFixture *fixture;
+
+	void operator()() const {
+		bool hit = fixture->fetch();
+		DO_NOT_OPTIMIZE(hit);
+	}
+};
+
+struct ResponseCacheStoreOp {
+	ResponseCacheFixture *fixture;
+
+	void operator()() const {
+		bool stored = fixture->store();
+		DO_NOT_OPTIMIZE(stored);
+	}
+};
+
+static void
+benchmarkResponseCache(BenchmarkSuite &suite) {
+	ResponseCacheFixture fixture;
+	ResponseCacheFetchOp fetch = { &fixture };
+	ResponseCacheStoreOp store = { &fixture };
+	PoolResetter resetter = { fixture.req.pool };
+
+	if (!fixture.store() || !fixture.fetch()) {
+		fprintf(stderr, "The response cache does not cache the benchmark response\n");
+		exit(1);
+	}
+	resetter();
+
+	suite.run("response_cache/fetch_hit", 1000, fetch, resetter);
+	suite.run("response_cache/store", 1000, store, resetter);
+	fixture.setPath("/not/cached");
+	suite.run("response_cache/fetch_miss", 1000, fetch, resetter);
+}
+
+
+/****** Controller ******/
+
+/*
+ * A fake application that serves the session protocol: for every
+ * connection that it is handed, it reads the request header, responds
+ * with APP_RESPONSE and closes the connection.
+ */
+class FakeApp {
+private:
+	boost::mutex syncher;
+	boost::condition_variable cond;
+	deque<int> fds;
+	boost::thread *thread;
+
+	void threadMain() {
+		while (true) {
+			int fd;
+			{
+				boost::unique_lock<boost::mutex> l(syncher);
+				while (fds.empty()) {
+					cond.wait(l);
+				}
+				fd = fds.front();
+				fds.pop_front();
+			}
+			if (fd == -1) {
+				return;
+			}
+
+			FileDescriptor guard(fd, __FILE__, __LINE__);
+			try {
+				readScalarMessage(fd);
+				writeExact(fd, P_STATIC_STRING(APP_RESPONSE));
+			} catch (const SystemException &e) {
+				fprintf(stderr, "The fake application cannot serve a request: %s\n",
+					e.what());
+			}
+		}
+	}
+
+public:
+	FakeApp() {
+		thread = new boost::thread(boost::bind(&FakeApp::threadMain, this));
+	}
+
+	~FakeApp() {
+		serve(-1);
+		thread->join();
+		delete thread;
+	}
+
+	/** Takes over ownership of `fd`. */
+	void serve(int fd) {
+		boost::lock_guard<boost::mutex> l(syncher);
+		fds.push_back(fd);
+		cond.notify_one();
+	}
+};
+
+/*
+ * A TestSession that hands its application side to a FakeApp, and that
+ * deletes itself once the Controller is done with it.
+ */
+class LoopbackSession: public TestSession {
+private:
+	mutable boost::atomic<unsigned int> refcount;
+	FakeApp *app;
+
+public:
+	LoopbackSession(FakeApp *_app)
+		: refcount(1),
+		  app(_app)
+		{ }
+
+	virtual void ref() const {
+		refcount.fetch_add(1, boost::memory_order_relaxed);
+	}
+
+	virtual void unref() const {
+		if (refcount.fetch_sub(1, boost::memory_order_acq_rel) == 1) {
+			delete this;
+		}
+	}
+
+	virtual void initiate(bool blocking = true) {
+		TestSession::initiate(blocking);
+		app->serve(dup(peerFd()));
+	}
+};
+
+class BenchmarkController: public Core::Controller {
+private:
+	struct SessionProtocolHeaderOp {
+		BenchmarkController *controller;
+		Request *req;
+
+		void operator()() const {
+			MemoryKit::mbuf buffer(controller->constructSessionProtocolHeader(req));
+			DO_NOT_OPTIMIZE(buffer.start);
+		}
+	};
+
+protected:
+	virtual void asyncGetFromApplicationPool(Request *req,
+		ApplicationPool2::GetCallback callback)
+	{
+		AbstractSessionPtr session(new LoopbackSession(app), false);
+
+		if (headerBenchmarkPending) {
+			// Runs on the event loop, on a request that the Controller
+			// has fully analyzed.
+			SessionProtocolHeaderOp op = { this, req };
+			headerBenchmarkPending = false;
+			req->session = session;
+			suite->run("session_protocol_header", 1000, op);
+			req->session.reset();
+		}
+
+		callback(session, ExceptionPtr());
+	}
+
+public:
+	FakeApp *app;
+	BenchmarkSuite *suite;
+	bool headerBenchmarkPending;
+
+	BenchmarkController(ServerKit::Context *context,
+		const ControllerSchema &schema,
+		const Json::Value &initialConfig,
+		const ControllerSingleAppModeSchema &singleAppModeSchema,
+		const Json::Value &singleAppModeConfig,
+		FakeApp *_app, BenchmarkSuite *_suite)
+		: Core::Controller(context, schema, initialConfig, ConfigKit::DummyTranslator(),
+			&singleAppModeSchema, &singleAppModeConfig, ConfigKit::DummyTranslator()),
+		  app(_app),
+		  suite(_suite),
+		  headerBenchmarkPending(true)
+		{ }
+};
+
+struct RoundTripOp {
+	int fd;
+	StaticString request;
+
+	void operator()() const {
+		string response;
+		string::size_type headerEnd = string::npos;
+		char buffer[1024 * 4];
+
+		writeExact(fd, request);
+		// The body of APP_RESPONSE is 2 bytes.
+		while (headerEnd == string::npos || response.size() < headerEnd + 4 + 2) {
+			ssize_t ret = oxt::syscalls::read(fd, buffer, sizeof(buffer));
+			if (ret <= 0) {
+				fprintf(stderr, "The Controller closed the connection unexpectedly\n");
+				exit(1);
+			}
+			response.append(buffer, ret);
+			if (headerEnd == string::npos) {
+				headerEnd = response.find("\r\n\r\n");
+			}
+		}
+		if (!startsWith(response, P_STATIC_STRING("HTTP/1.1 200 "))) {
+			fprintf(stderr, "Unexpected response from the Controller:\n%s\n",
+				response.c_str());
+			exit(1);
+		}
+	}
+};
+
+static void
+getServerState(BenchmarkController *controller, BenchmarkController::State *state) {
+	*state = controller->serverState;
+}
+
+static void
+destroyController(BenchmarkController *controller) {
+	delete controller;
+}
+
+static void
+benchmarkController(BenchmarkSuite &suite, BackgroundEventLoop &bg,
+	ServerKit::Context &context)
+{
+	if (!suite.enabled("session_protocol_header") && !suite.enabled("controller/round_trip")) {
+		return;
+	}
+
+	char cwd[PATH_MAX];
+	if (getcwd(cwd, sizeof(cwd)) == NULL) {
+		int e = errno;
+		throw SystemException("Cannot determine the current working directory", e);
+	}
+	string root = cwd;
+	string socketFilename = "/tmp/passenger-benchmark." + toString(getpid());
+
+	ResourceLocator resourceLocator(root);
+	WrapperRegistry::Registry wrapperRegistry;
+	wrapperRegistry.finalize();
+
+	SpawningKit::Context::Schema skContextSchema;
+	SpawningKit::Context skContext(skContextSchema);
+	skContext.resourceLocator = &resourceLocator;
+	skContext.wrapperRegistry = &wrapperRegistry;
+	skContext.integrationMode = "standalone";
+	skContext.finalize();
+
+	ApplicationPool2::Context apContext;
+	apContext.spawningKitFactory = boost::make_shared<SpawningKit::Factory>(&skContext);
+	apContext.finalize();
+	PoolPtr appPool = boost::make_shared<Pool>(&apContext);
+	appPool->initialize();
+
+	ControllerSchema schema;
+	ControllerSingleAppModeSchema singleAppModeSchema(&wrapperRegistry);
+	Json::Value config, singleAppModeConfig;
+	config["thread_number"] = 1;
+	config["multi_app"] = false;
+	config["default_server_name"] = "localhost";
+	config["default_server_port"] = 80;
+	config["user_switching"] = false;
+	singleAppModeConfig["app_root"] = root + "/test/stub/rack";
+	singleAppModeConfig["app_type"] = "rack";
+	singleAppModeConfig["startup_file"] = "none";
+
+	FakeApp app;
+	int serverSocket = createUnixServer(socketFilename);
+	BenchmarkController *controller = new BenchmarkController(&context, schema,
+		config, singleAppModeSchema, singleAppModeConfig, &app, &suite);
+	controller->resourceLocator = &resourceLocator;
+	controller->wrapperRegistry = &wrapperRegistry;
+	controller->appPool = appPool;
+	controller->initialize();
+	controller->listen(serverSocket);
+	bg.start();
+
+	{
+		FileDescriptor connection(connectToUnixServer(socketFilename,
+			__FILE__, __LINE__), NULL, 0);
+		RoundTripOp roundTrip = { connection, P_STATIC_STRING(BROWSER_REQUEST) };
+
+		// The first request also runs the session_protocol_header benchmark.
+		roundTrip();
+		suite.run("controller/round_trip", 1, roundTrip);
+	}
+
+	// Silence the disconnection message of the client during shutdown.
+	LoggingKit::setLevel(LoggingKit::CRIT);
+	bg.safe->runSync(boost::bind(&BenchmarkController::shutdown, controller, true));
+	BenchmarkController::State state;
+	do {
+		oxt::syscalls::usleep(10000);
+		bg.safe->runSync(boost::bind(getServerState, controller, &state));
+	} while (state != BenchmarkController::FINISHED_SHUTDOWN);
+	bg.safe->runSync(boost::bind(destroyController, controller));
+	bg.stop();
+
+	appPool->destroy();
+	close(serverSocket);
+	unlink(socketFilename.c_str());
+}
+
+
+int
+main(int argc, char *argv[]) {
+	BenchmarkSuite suite;
+	if (!suite.parseOptions(argc, argv)) {
+		return 1;
+	}
+
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	LoggingKit::initialize();
+	LoggingKit::setLevel(LoggingKit::WARN);
+
+	BackgroundEventLoop bg(false, true);
+	ServerKit::Schema skSchema;
+	ServerKit::Context context(skSchema);
+	context.libev = bg.safe;
+	context.libuv = bg.libuv_loop;
+	context.initialize();
+
+	benchmarkHttpParser(suite);
+	benchmarkTables(suite);
+	benchmarkMemory(suite, context);
+	benchmarkResponseCache(suite);
+	benchmarkController(suite, bg, context);
+
+	return suite.finish() ? 0 : 1;
+}
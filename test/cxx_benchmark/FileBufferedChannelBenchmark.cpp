@@ -0,0 +1,271 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Simulates many slow clients that download large responses: a producer feeds
+ * data into a FileBufferedChannel per client faster than the client consumes
+ * it, so that most of the data is spooled to disk and read back later. This
+ * is what happens in the Core when many slow clients download large responses
+ * from a fast application.
+ *
+ * The simulation is run once with the libuv thread pool backend, and once
+ * with the io_uring backend (if supported by the kernel). Because the clients
+ * are slow, the wall clock time mostly depends on CONSUME_DELAY; the CPU time
+ * (which includes the libuv thread pool threads) is the interesting number.
+ *
+ * Usage: FileBufferedChannelBenchmark [READERS] [CHUNKS] [CONSUME_DELAY_MSEC]
+ */
+
+#include <oxt/initialize.hpp>
+#include <oxt/system_calls.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind/bind.hpp>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <BackgroundEventLoop.cpp>
+#include <LoggingKit/Context.h>
+#include <ServerKit/Context.h>
+#include <ServerKit/FileBufferedChannel.h>
+#include <SystemTools/SystemTime.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+
+// Interval, in milliseconds, at which the producer feeds a chunk into every channel.
+static const unsigned int FEED_INTERVAL = 1;
+
+class Simulation;
+
+struct Reader {
+	Simulation *simulation;
+	FileBufferedChannel channel;
+	Hooks hooks;
+	unsigned int chunksReceived;
+
+	Reader(Simulation *_simulation, Context *context)
+		: simulation(_simulation),
+		  channel(context),
+		  chunksReceived(0)
+	{
+		hooks.impl = NULL;
+		hooks.userData = this;
+	}
+};
+
+class Simulation {
+private:
+	BackgroundEventLoop bg;
+	Schema schema;
+	Context *context;
+	vector<Reader *> readers;
+	unsigned int chunks;
+	unsigned int consumeDelay;
+	unsigned int chunksFed;
+	string payload;
+	boost::atomic<unsigned int> finished;
+
+	static Channel::Result onData(Channel *channel, const MemoryKit::mbuf &buffer,
+		int errcode)
+	{
+		FileBufferedChannel *fbc = reinterpret_cast<FileBufferedChannel *>(channel);
+		Reader *reader = static_cast<Reader *>(fbc->getHooks()->userData);
+		Simulation *self = reader->simulation;
+
+		if (errcode != 0) {
+			fprintf(stderr, "Channel error: %s\n", strerror(errcode));
+			abort();
+		}
+
+		// Simulate a slow client by consuming the data later.
+		self->bg.safe->runAfter(self->consumeDelay,
+			boost::bind(&Simulation::consume, self, reader, (unsigned int) buffer.size()));
+		return Channel::Result(-1, false);
+	}
+
+	void consume(Reader *reader, unsigned int size) {
+		reader->chunksReceived++;
+		reader->channel.consumed(size, false);
+		if (reader->chunksReceived == chunks) {
+			finished++;
+		}
+	}
+
+	void produce() {
+		for (unsigned int i = 0; i < readers.size(); i++) {
+			MemoryKit::mbuf buffer = MemoryKit::mbuf_get(&context->mbuf_pool);
+			memcpy(buffer.start, payload.data(), payload.size());
+			readers[i]->channel.feed(MemoryKit::mbuf(buffer, 0, payload.size()));
+		}
+		chunksFed++;
+		if (chunksFed < chunks) {
+			bg.safe->runAfter(FEED_INTERVAL, boost::bind(&Simulation::produce, this));
+		}
+	}
+
+	void start(bool *ioUringAvailable) {
+		*ioUringAvailable = !context->config.fileBufferedChannelConfig.ioUring
+			|| context->getIoUring() != NULL;
+		if (*ioUringAvailable) {
+			produce();
+		}
+	}
+
+	void deinitializeReaders() {
+		for (unsigned int i = 0; i < readers.size(); i++) {
+			readers[i]->channel.deinitialize();
+		}
+	}
+
+public:
+	Simulation(bool ioUring, unsigned int nreaders, unsigned int _chunks,
+		unsigned int _consumeDelay)
+		: bg(true, true),
+		  chunks(_chunks),
+		  consumeDelay(_consumeDelay),
+		  chunksFed(0),
+		  finished(0)
+	{
+		Json::Value config;
+		config["file_buffered_channel_threshold"] = 1;
+		config["file_buffered_channel_io_uring"] = ioUring;
+
+		context = new Context(schema, config);
+		context->libev = bg.safe;
+		context->libuv = bg.libuv_loop;
+		context->initialize();
+		payload.assign(MemoryKit::mbuf_pool_data_size(&context->mbuf_pool), 'x');
+
+		for (unsigned int i = 0; i < nreaders; i++) {
+			Reader *reader = new Reader(this, context);
+			reader->channel.setHooks(&reader->hooks);
+			reader->channel.setDataCallback(onData);
+			readers.push_back(reader);
+		}
+	}
+
+	~Simulation() {
+		bg.safe->runSync(boost::bind(&Simulation::deinitializeReaders, this));
+		bg.stop();
+		for (unsigned int i = 0; i < readers.size(); i++) {
+			delete readers[i];
+		}
+		delete context;
+	}
+
+	/**
+	 * Returns false if the requested backend is not available.
+	 */
+	bool run() {
+		bool ioUringAvailable;
+
+		bg.start();
+		bg.safe->runSync(boost::bind(&Simulation::start, this, &ioUringAvailable));
+		if (!ioUringAvailable) {
+			return false;
+		}
+		while (finished.load() < readers.size()) {
+			usleep(1000);
+		}
+		return true;
+	}
+
+	boost::uint64_t getBytesBufferedToDisk() const {
+		return context->bytesBufferedToDisk.load();
+	}
+
+	boost::uint64_t getTotalBytes() const {
+		return (boost::uint64_t) readers.size() * chunks * payload.size();
+	}
+};
+
+static double
+getCpuTime() {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1000000.0
+		+ usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1000000.0;
+}
+
+static void
+benchmark(const char *name, bool ioUring, unsigned int readers, unsigned int chunks,
+	unsigned int consumeDelay)
+{
+	Simulation simulation(ioUring, readers, chunks, consumeDelay);
+	unsigned long long beginTime = SystemTime::getMonotonicUsec();
+	double beginCpuTime = getCpuTime();
+
+	if (!simulation.run()) {
+		printf("%-8s not supported on this system\n", name);
+		return;
+	}
+
+	double wallTime = (SystemTime::getMonotonicUsec() - beginTime) / 1000000.0;
+	double cpuTime = getCpuTime() - beginCpuTime;
+	printf("%-8s readers=%-5u total=%7.1fMB spooled=%7.1fMB wall=%7.3fs "
+		"cpu=%7.3fs throughput=%8.1fMB/cpu-s\n",
+		name,
+		readers,
+		simulation.getTotalBytes() / 1024.0 / 1024.0,
+		simulation.getBytesBufferedToDisk() / 1024.0 / 1024.0,
+		wallTime,
+		cpuTime,
+		simulation.getBytesBufferedToDisk() / 1024.0 / 1024.0 / cpuTime);
+}
+
+int
+main(int argc, char *argv[]) {
+	unsigned int readers = 300;
+	unsigned int chunks = 64;
+	unsigned int consumeDelay = 5;
+
+	if (argc >= 2) {
+		readers = atoi(argv[1]);
+	}
+	if (argc >= 3) {
+		chunks = atoi(argv[2]);
+	}
+	if (argc >= 4) {
+		consumeDelay = atoi(argv[3]);
+	}
+	if (readers == 0 || chunks == 0) {
+		fprintf(stderr, "Usage: %s [READERS] [CHUNKS] [CONSUME_DELAY_MSEC]\n", argv[0]);
+		return 1;
+	}
+
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	LoggingKit::initialize();
+	benchmark("libuv", false, readers, chunks, consumeDelay);
+	benchmark("io_uring", true, readers, chunks, consumeDelay);
+	return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how long ServerKit::HttpHeaderParser takes to parse a request
+ * header, for the requests in the corpus of BenchmarkSupport.h: a browser
+ * request, a request with secure headers as forwarded by the Nginx module,
+ * and an API request. The reported times are per parse.
+ *
+ * Usage: HttpHeaderParserBenchmark [--warmup N] [--iterations N]
+ *                                  [--filter SUBSTRING] [--json FILE]
+ *                                  [--compare FILE]
+ */
+
+#include <oxt/initialize.hpp>
+#include <oxt/system_calls.hpp>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <BackgroundEventLoop.cpp>
+#include <LoggingKit/Context.h>
+#include <ServerKit/Context.h>
+#include <ServerKit/HttpRequest.h>
+#include <ServerKit/HttpHeaderParser.h>
+#include "BenchmarkSupport.h"
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+
+static void
+deinitializeRequest(BaseHttpRequest *req) {
+	HeaderTable::Iterator it(req->headers);
+	while (*it != NULL) {
+		psg_lstr_deinit(&it->header->key);
+		psg_lstr_deinit(&it->header->origKey);
+		psg_lstr_deinit(&it->header->val);
+		it.next();
+	}
+
+	it = HeaderTable::Iterator(req->secureHeaders);
+	while (*it != NULL) {
+		psg_lstr_deinit(&it->header->key);
+		psg_lstr_deinit(&it->header->origKey);
+		psg_lstr_deinit(&it->header->val);
+		it.next();
+	}
+
+	psg_lstr_deinit(&req->path);
+	psg_reset_pool(req->pool, PSG_DEFAULT_POOL_SIZE);
+	req->headers.clear();
+	req->secureHeaders.clear();
+}
+
+static bool
+parse(Context *context, BaseHttpRequest *req, HttpHeaderParserState *state,
+	const MemoryKit::mbuf &buffer)
+{
+	req->httpState = BaseHttpRequest::PARSING_HEADERS;
+	req->bodyType = BaseHttpRequest::RBT_NO_BODY;
+	req->parserState.headerParser = state;
+	psg_lstr_init(&req->path);
+
+	HttpHeaderParser<BaseHttpRequest> parser(context, state, req, req->pool);
+	parser.initialize();
+	parser.feed(buffer);
+
+	bool result = req->httpState != BaseHttpRequest::PARSING_HEADERS
+		&& req->httpState != BaseHttpRequest::ERROR;
+	deinitializeRequest(req);
+	return result;
+}
+
+struct ParseOp {
+	Context *context;
+	BaseHttpRequest *req;
+	HttpHeaderParserState *state;
+	MemoryKit::mbuf *buffer;
+
+	void operator()() const {
+		bool result = parse(context, req, state, *buffer);
+		DO_NOT_OPTIMIZE(result);
+	}
+};
+
+static void
+benchmark(BenchmarkSuite &suite, Context *context, const BenchmarkRequest &request) {
+	BaseHttpRequest req;
+	HttpHeaderParserState state;
+	MemoryKit::mbuf buffer = MemoryKit::mbuf_get_with_size(&context->mbuf_pool,
+		request.data.size());
+
+	memcpy(buffer.start, request.data.data(), request.data.size());
+	req.pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+
+	if (!parse(context, &req, &state, buffer)) {
+		fprintf(stderr, "Cannot parse the '%s' request\n", request.name);
+		exit(1);
+	}
+
+	ParseOp op = { context, &req, &state, &buffer };
+	suite.run(string("http_header_parser/") + request.name, 1000, op);
+
+	psg_destroy_pool(req.pool);
+	req.pool = NULL;
+}
+
+int
+main(int argc, char *argv[]) {
+	BenchmarkSuite suite;
+	if (!suite.parseOptions(argc, argv)) {
+		return 1;
+	}
+
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	LoggingKit::initialize();
+
+	BackgroundEventLoop bg(false, true);
+	Schema schema;
+	Context context(schema);
+	context.libev = bg.safe;
+	context.libuv = bg.libuv_loop;
+	context.initialize();
+
+	for (unsigned int i = 0; i < BENCHMARK_REQUESTS_COUNT; i++) {
+		benchmark(suite, &context, BENCHMARK_REQUESTS[i]);
+	}
+	return suite.finish() ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Compares the cost of collecting process metrics through 'ps' with the cost
+ * of reading them directly from /proc (Linux only), for a configurable number
+ * of processes. This simulates Pool::collectAnalytics() on a server with many
+ * application processes. Every sample is a single collection.
+ *
+ * Usage: ProcessMetricsCollectorBenchmark [--processes N] [--warmup N]
+ *          [--iterations N] [--filter SUBSTRING] [--json FILE] [--compare FILE]
+ */
+
+#include <oxt/initialize.hpp>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <signal.h>
+
+#include <SystemTools/ProcessMetricsCollector.h>
+#include "BenchmarkSupport.h"
+
+using namespace std;
+using namespace Passenger;
+
+static void
+spawnProcesses(unsigned int count, vector<pid_t> &pids) {
+	for (unsigned int i = 0; i < count; i++) {
+		pid_t pid = fork();
+		if (pid == 0) {
+			while (true) {
+				pause();
+			}
+		} else if (pid == -1) {
+			perror("fork()");
+			exit(1);
+		} else {
+			pids.push_back(pid);
+		}
+	}
+}
+
+static void
+killProcesses(const vector<pid_t> &pids) {
+	vector<pid_t>::const_iterator it;
+
+	for (it = pids.begin(); it != pids.end(); it++) {
+		kill(*it, SIGKILL);
+	}
+	for (it = pids.begin(); it != pids.end(); it++) {
+		waitpid(*it, NULL, 0);
+	}
+}
+
+struct CollectOp {
+	ProcessMetricsCollector *collector;
+	const vector<pid_t> *pids;
+
+	void operator()() const {
+		ProcessMetricMap result = collector->collect(*pids);
+		DO_NOT_OPTIMIZE(result.size());
+	}
+};
+
+static void
+benchmark(BenchmarkSuite &suite, const char *name, ProcessMetricsCollector &collector,
+	const vector<pid_t> &pids)
+{
+	size_t collected = collector.collect(pids).size();
+	if (collected != pids.size()) {
+		fprintf(stderr, "%s only collected the metrics of %u out of %u processes\n",
+			name, (unsigned int) collected, (unsigned int) pids.size());
+	}
+
+	CollectOp op = { &collector, &pids };
+	suite.run(string("process_metrics/") + name, 1, op);
+}
+
+int
+main(int argc, char *argv[]) {
+	BenchmarkSuite suite(1, 50);
+	unsigned int processes = 200;
+	vector<pid_t> pids;
+
+	suite.addOption("--processes", "N", &processes);
+	if (!suite.parseOptions(argc, argv)) {
+		return 1;
+	}
+	if (processes == 0) {
+		fprintf(stderr, "--processes must be at least 1\n");
+		return 1;
+	}
+
+	oxt::initialize();
+	spawnProcesses(processes, pids);
+	printf("processes=%u\n", processes);
+
+	ProcessMetricsCollector psCollector;
+	psCollector.setNativeCollectionEnabled(false);
+	benchmark(suite, "ps", psCollector, pids);
+
+	ProcessMetricsCollector nativeCollector;
+	if (nativeCollector.usesNativeCollection()) {
+		benchmark(suite, "native", nativeCollector, pids);
+	} else {
+		printf("process_metrics/native not supported on this platform\n");
+	}
+
+	killProcesses(pids);
+	return suite.finish() ? 0 : 1;
+}
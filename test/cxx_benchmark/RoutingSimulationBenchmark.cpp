@@ -0,0 +1,397 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Simulates a Group with multithreaded application processes that occasionally
+ * become slow (e.g. because of garbage collection pauses or noisy neighbors),
+ * and compares the request latency distribution of the 'least_busy' and the
+ * 'latency' routing methods.
+ *
+ * Requests are routed by a real ApplicationPool Pool, so the simulation
+ * exercises Group::route() and Group::findEnabledProcessByLatency(), the
+ * processes' latency bookkeeping and the Group's get wait list, exactly as
+ * Passenger Core does. The processes are spawned with the dummy spawn method,
+ * so they don't run anything: the simulation decides how long every session
+ * takes and closes it when it's done.
+ *
+ * This is a discrete event simulation in virtual time, so the results do not
+ * depend on the speed of the machine. The pool reads the time through
+ * SystemTime, which is forced to the virtual time of the current event.
+ *
+ * By default, every process is 3 times slower than normal for 5 seconds
+ * every 20 seconds or so, which resembles a noisy neighbor. Every process has
+ * its own random slowdown schedule, which is the same for both routing methods,
+ * so that differences between the results are caused by routing only. Pass
+ * --slow-phase (in seconds) and --slowdown to simulate other scenarios.
+ *
+ * The reported numbers are the simulated request latencies, so --warmup and
+ * --iterations have no effect.
+ *
+ * Usage: RoutingSimulationBenchmark [--processes N] [--concurrency N]
+ *          [--requests N] [--load FRACTION] [--slow-phase SECONDS]
+ *          [--slowdown FACTOR] [--filter SUBSTRING] [--json FILE]
+ *          [--compare FILE]
+ */
+
+#include <oxt/initialize.hpp>
+#include <oxt/system_calls.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/make_shared.hpp>
+#include <map>
+#include <queue>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include <LoggingKit/Context.h>
+#include <ResourceLocator.h>
+#include <Exceptions.h>
+#include <SystemTools/SystemTime.h>
+#include <Core/ApplicationPool/Pool.h>
+#include "BenchmarkSupport.h"
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+
+// All times are in microseconds of virtual time.
+static const double MEAN_SERVICE_TIME = 20000;
+static double meanNormalPhase = 20000000;
+static double meanSlowPhase = 5000000;
+static double slowdownFactor = 3;
+
+class Random {
+private:
+	boost::uint64_t state;
+
+public:
+	Random(boost::uint64_t seed)
+		: state(seed)
+		{ }
+
+	boost::uint64_t next() {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+
+	double uniform() {
+		return (next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	double exponential(double mean) {
+		return -mean * log(1 - uniform());
+	}
+};
+
+// Every process has its own random number generator for its slow phases, so
+// that the processes are slow at the same times regardless of the routing method.
+struct ProcessPhase {
+	Random random;
+	bool slow;
+	MonotonicTimeUsec nextPhaseChange;
+
+	ProcessPhase(boost::uint64_t seed, MonotonicTimeUsec now)
+		: random(seed),
+		  slow(false)
+	{
+		nextPhaseChange = now + 1 + (MonotonicTimeUsec) random.exponential(meanNormalPhase);
+	}
+
+	void update(MonotonicTimeUsec now) {
+		while (nextPhaseChange <= now) {
+			slow = !slow;
+			nextPhaseChange += (MonotonicTimeUsec) random.exponential(
+				slow ? meanSlowPhase : meanNormalPhase) + 1;
+		}
+	}
+};
+
+class Simulation;
+
+struct Request {
+	Simulation *simulation;
+	MonotonicTimeUsec arrivalTime;
+	SessionPtr session;
+};
+
+struct Event {
+	MonotonicTimeUsec time;
+	// NULL for an arrival, otherwise the request that completed.
+	Request *request;
+
+	bool operator>(const Event &other) const {
+		return time > other.time;
+	}
+};
+
+class Simulation {
+private:
+	ApplicationPool2::Context *context;
+	PoolPtr pool;
+	string appRoot;
+	Options options;
+	map<const Process *, ProcessPhase> phases;
+	priority_queue< Event, vector<Event>, greater<Event> > events;
+	Random random;
+	unsigned int failures;
+
+	static void onSessionCheckedOut(const AbstractSessionPtr &session,
+		const ExceptionPtr &e, void *userData)
+	{
+		Request *req = (Request *) userData;
+		req->simulation->startRequest(req, static_pointer_cast<Session>(session), e);
+	}
+
+	// Advances the virtual clock. This also makes the pool measure the latency
+	// of the processes in virtual time.
+	static void setTime(MonotonicTimeUsec time) {
+		SystemTime::forceAll(time);
+	}
+
+	void startRequest(Request *req, const SessionPtr &session, const ExceptionPtr &e) {
+		if (session == NULL) {
+			fprintf(stderr, "Cannot check out a session: %s\n", e->what());
+			failures++;
+			delete req;
+			return;
+		}
+
+		MonotonicTimeUsec now = SystemTime::getMonotonicUsec();
+		ProcessPhase &phase = phases.find(session->getProcess())->second;
+		phase.update(now);
+		double serviceTime = random.exponential(MEAN_SERVICE_TIME);
+		if (phase.slow) {
+			serviceTime *= slowdownFactor;
+		}
+		req->session = session;
+
+		Event event;
+		event.time = now + (MonotonicTimeUsec) serviceTime + 1;
+		event.request = req;
+		events.push(event);
+	}
+
+	void arrive() {
+		Request *req = new Request();
+		req->simulation = this;
+		req->arrivalTime = SystemTime::getMonotonicUsec();
+
+		GetCallback callback;
+		callback.func = onSessionCheckedOut;
+		callback.userData = req;
+		options.currentTime = SystemTime::getUsec();
+		pool->asyncGet(options, callback);
+	}
+
+	void complete(Request *req) {
+		SessionPtr session;
+		session.swap(req->session);
+		latencies.push_back((SystemTime::getMonotonicUsec() - req->arrivalTime) * 1000.0);
+		delete req;
+		// Closing the session updates the process's latency, and may check
+		// out a session for a request on the Group's get wait list.
+		session.reset();
+	}
+
+public:
+	// In nanoseconds, for BenchmarkSuite::record().
+	vector<double> latencies;
+
+	Simulation(ApplicationPool2::Context *_context, const string &root,
+		const char *routingMethod, unsigned int nprocesses)
+		: context(_context),
+		  appRoot(root + "/test/stub/rack"),
+		  random(0x9E3779B97F4A7C15ULL),
+		  failures(0)
+	{
+		options.spawnMethod = "dummy";
+		options.appRoot = appRoot;
+		options.appType = "ruby";
+		options.startupFile = "config.ru";
+		options.loadShellEnvvars = false;
+		options.userSwitching = false;
+		options.routingMethod = routingMethod;
+		options.minProcesses = nprocesses;
+		options.maxProcesses = nprocesses;
+		// Requests that wait for a process are part of the simulation.
+		options.maxRequestQueueSize = 0;
+
+		pool = boost::make_shared<Pool>(context);
+		pool->setMax(nprocesses);
+	}
+
+	~Simulation() {
+		SystemTime::releaseAll();
+		pool->destroy();
+	}
+
+	void spawnProcesses(unsigned int nprocesses) {
+		Ticket ticket;
+		pool->get(options, &ticket).reset();
+		while (pool->getProcessCount() < nprocesses || pool->isSpawning()) {
+			oxt::syscalls::usleep(1000);
+		}
+	}
+
+	bool run(unsigned int nrequests, double arrivalRate) {
+		Random arrivalRandom(0x2545F4914F6CDD1DULL);
+		MonotonicTimeUsec now = SystemTime::getUsec();
+		unsigned int arrived = 0;
+
+		vector<ProcessPtr> processes = pool->getProcesses();
+		for (unsigned int i = 0; i < processes.size(); i++) {
+			phases.insert(make_pair(processes[i].get(),
+				ProcessPhase(0x9E3779B97F4A7C15ULL * (i + 1), now)));
+		}
+
+		Event arrival;
+		arrival.time = now;
+		arrival.request = NULL;
+		events.push(arrival);
+		latencies.reserve(nrequests);
+
+		while (!events.empty()) {
+			Event event = events.top();
+			events.pop();
+			setTime(event.time);
+
+			if (event.request == NULL) {
+				arrive();
+				arrived++;
+				if (arrived < nrequests) {
+					arrival.time = event.time + 1 + (MonotonicTimeUsec)
+						arrivalRandom.exponential(1 / arrivalRate);
+					events.push(arrival);
+				}
+			} else {
+				complete(event.request);
+			}
+		}
+
+		SystemTime::releaseAll();
+		return failures == 0 && latencies.size() == nrequests;
+	}
+};
+
+static bool
+simulate(BenchmarkSuite &suite, const char *name, const char *routingMethod,
+	ApplicationPool2::Context *context, const string &root, unsigned int nprocesses,
+	unsigned int nrequests, double arrivalRate)
+{
+	if (!suite.enabled(name)) {
+		return true;
+	}
+
+	Simulation simulation(context, root, routingMethod, nprocesses);
+	simulation.spawnProcesses(nprocesses);
+	if (!simulation.run(nrequests, arrivalRate)) {
+		fprintf(stderr, "%s: not all requests were handled\n", name);
+		return false;
+	}
+	suite.record(name, simulation.latencies);
+	return true;
+}
+
+int
+main(int argc, char *argv[]) {
+	BenchmarkSuite suite;
+	unsigned int nprocesses = 8;
+	unsigned int concurrency = 4;
+	unsigned int nrequests = 1000000;
+	double load = 0.7;
+	double slowPhase = meanSlowPhase / 1000000;
+
+	suite.addOption("--processes", "N", &nprocesses);
+	suite.addOption("--concurrency", "N", &concurrency);
+	suite.addOption("--requests", "N", &nrequests);
+	suite.addOption("--load", "FRACTION", &load);
+	suite.addOption("--slow-phase", "SECONDS", &slowPhase);
+	suite.addOption("--slowdown", "FACTOR", &slowdownFactor);
+	if (!suite.parseOptions(argc, argv)) {
+		return 1;
+	}
+	if (nprocesses == 0 || concurrency == 0 || nrequests == 0 || load <= 0
+	 || slowPhase <= 0 || slowdownFactor < 1)
+	{
+		fprintf(stderr, "--processes, --concurrency, --requests, --load and "
+			"--slow-phase must be positive, and --slowdown must be at least 1\n");
+		return 1;
+	}
+	meanSlowPhase = slowPhase * 1000000;
+	meanNormalPhase = 4 * meanSlowPhase;
+
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	LoggingKit::initialize();
+	LoggingKit::setLevel(LoggingKit::WARN);
+
+	char cwd[PATH_MAX];
+	if (getcwd(cwd, sizeof(cwd)) == NULL) {
+		int e = errno;
+		throw SystemException("Cannot determine the current working directory", e);
+	}
+	string root = cwd;
+
+	ResourceLocator resourceLocator(root);
+	WrapperRegistry::Registry wrapperRegistry;
+	wrapperRegistry.finalize();
+
+	SpawningKit::Context::Schema skContextSchema;
+	SpawningKit::Context::DebugSupport skDebugSupport;
+	SpawningKit::Context skContext(skContextSchema);
+	skDebugSupport.dummyConcurrency = concurrency;
+	skContext.resourceLocator = &resourceLocator;
+	skContext.wrapperRegistry = &wrapperRegistry;
+	skContext.integrationMode = "standalone";
+	skContext.debugSupport = &skDebugSupport;
+	skContext.finalize();
+
+	ApplicationPool2::Context apContext;
+	apContext.spawningKitFactory = boost::make_shared<SpawningKit::Factory>(&skContext);
+	apContext.finalize();
+
+	// 'load' is relative to the capacity of the group when no process is slow.
+	double arrivalRate = load * nprocesses * concurrency / MEAN_SERVICE_TIME;
+	printf("processes=%u concurrency=%u load=%.2f slow_phase=%.2fs slowdown=%.1f\n",
+		nprocesses, concurrency, load, slowPhase, slowdownFactor);
+
+	if (!simulate(suite, "routing/least_busy", "least_busy", &apContext, root,
+		nprocesses, nrequests, arrivalRate)
+	 || !simulate(suite, "routing/latency", "latency", &apContext, root,
+		nprocesses, nrequests, arrivalRate))
+	{
+		return 1;
+	}
+
+	return suite.finish() ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2021 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how long the Core takes to convert the header names of a request
+ * to CGI variable names (e.g. "accept-encoding" to "HTTP_ACCEPT_ENCODING")
+ * when it sends the request to a Ruby, Python or Node.js application over
+ * the session protocol. Compares:
+ *
+ *  - bytewise: the previous implementation, which checks every name for
+ *              invalid characters and then converts it byte by byte.
+ *  - current:  Core::ScgiHeaderNames for common names, and the single-pass
+ *              Core::appendScgiHeaderName() for the other ones.
+ *
+ * The header names are taken from the requests in the corpus of
+ * BenchmarkSupport.h. The reported times are per request.
+ *
+ * Usage: ScgiHeaderNamesBenchmark [--warmup N] [--iterations N]
+ *                                 [--filter SUBSTRING] [--json FILE]
+ *                                 [--compare FILE]
+ */
+
+#include <boost/cstdint.hpp>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <MemoryKit/palloc.h>
+#include <DataStructures/LString.h>
+#include <DataStructures/HashedStaticString.h>
+#include <ServerKit/HeaderTable.h>
+#include <StrIntTools/StrIntUtils.h>
+#include <Core/Controller/ScgiHeaderNames.h>
+#include "BenchmarkSupport.h"
+
+using namespace std;
+using namespace Passenger;
+
+struct Corpus {
+	const char *name;
+	vector<ServerKit::Header *> headers;
+};
+
+
+/****** The previous implementation ******/
+
+static boost::uint8_t toUpperMap[256];
+
+static void
+initializeToUpperMap() {
+	for (unsigned int i = 0; i < 256; i++) {
+		if (i >= 'a' && i <= 'z') {
+			toUpperMap[i] = i - 'a' + 'A';
+		} else if (i == '-') {
+			toUpperMap[i] = '_';
+		} else {
+			toUpperMap[i] = i;
+		}
+	}
+}
+
+static bool
+isAlphaNum(char ch) {
+	return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+}
+
+static bool
+containsNonAlphaNumDash(const LString &s) {
+	const LString::Part *part = s.start;
+	while (part != NULL) {
+		for (unsigned int i = 0; i < part->size; i++) {
+			const char start = part->data[i];
+			if (start != '-' && !isAlphaNum(start)) {
+				return true;
+			}
+		}
+		part = part->next;
+	}
+	return false;
+}
+
+static void
+httpHeaderToScgiUpperCase(unsigned char *data, unsigned int size) {
+	const unsigned char *buf = data;
+	const size_t imax = size / 8;
+	const size_t leftover = size % 8;
+	size_t i;
+
+	for (i = 0; i < imax; i++, data += 8) {
+		data[0] = (unsigned char) toUpperMap[data[0]];
+		data[1] = (unsigned char) toUpperMap[data[1]];
+		data[2] = (unsigned char) toUpperMap[data[2]];
+		data[3] = (unsigned char) toUpperMap[data[3]];
+		data[4] = (unsigned char) toUpperMap[data[4]];
+		data[5] = (unsigned char) toUpperMap[data[5]];
+		data[6] = (unsigned char) toUpperMap[data[6]];
+		data[7] = (unsigned char) toUpperMap[data[7]];
+	}
+
+	i = imax * 8;
+	switch (leftover) {
+	case 7: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
+	case 6: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
+	case 5: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
+	case 4: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
+	case 3: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
+	case 2: *data++ = (unsigned char) toUpperMap[buf[i++]]; /* Falls through. */
+	case 1: *data++ = (unsigned char) toUpperMap[buf[i]]; /* Falls through. */
+	case 0: break;
+	}
+}
+
+static char *
+convertBytewise(const Corpus &corpus, char *pos, const char *end) {
+	for (unsigned int i = 0; i < corpus.headers.size(); i++) {
+		const ServerKit::Header *header = corpus.headers[i];
+		if (containsNonAlphaNumDash(header->key)) {
+			continue;
+		}
+
+		pos = appendData(pos, end, P_STATIC_STRING("HTTP_"));
+		const LString::Part *part = header->key.start;
+		while (part != NULL) {
+			char *start = pos;
+			pos = appendData(pos, end, part->data, part->size);
+			httpHeaderToScgiUpperCase((unsigned char *) start, pos - start);
+			part = part->next;
+		}
+		pos = appendData(pos, end, "", 1);
+	}
+	return pos;
+}
+
+
+/****** The current implementation ******/
+
+static char *
+convertCurrent(const Core::ScgiHeaderNames &names, const Corpus &corpus,
+	char *pos, const char *end)
+{
+	for (unsigned int i = 0; i < corpus.headers.size(); i++) {
+		const ServerKit::Header *header = corpus.headers[i];
+		const StaticString *scgiName = names.lookup(header);
+		if (scgiName != NULL) {
+			pos = appendData(pos, end, *scgiName);
+		} else {
+			char *newPos = Core::appendScgiHeaderName(pos, end, &header->key);
+			if (newPos != NULL) {
+				pos = newPos;
+			}
+		}
+	}
+	return pos;
+}
+
+
+struct BytewiseOp {
+	const Corpus *corpus;
+	char *buffer;
+	const char *end;
+
+	void operator()() const {
+		char *pos = convertBytewise(*corpus, buffer, end);
+		DO_NOT_OPTIMIZE(pos);
+	}
+};
+
+struct CurrentOp {
+	const Core::ScgiHeaderNames *names;
+	const Corpus *corpus;
+	char *buffer;
+	const char *end;
+
+	void operator()() const {
+		char *pos = convertCurrent(*names, *corpus, buffer, end);
+		DO_NOT_OPTIMIZE(pos);
+	}
+};
+
+static void
+benchmark(BenchmarkSuite &suite, const Core::ScgiHeaderNames &names,
+	const Corpus &corpus)
+{
+	char buffer[4096], expected[4096];
+	const char *end = buffer + sizeof(buffer);
+	size_t expectedSize = convertBytewise(corpus, expected,
+		expected + sizeof(expected)) - expected;
+	size_t size = convertCurrent(names, corpus, buffer, end) - buffer;
+
+	if (size != expectedSize || memcmp(buffer, expected, size) != 0) {
+		fprintf(stderr, "The implementations disagree on the '%s' request\n",
+			corpus.name);
+		exit(1);
+	}
+
+	BytewiseOp bytewise = { &corpus, buffer, end };
+	CurrentOp current = { &names, &corpus, buffer, end };
+	suite.run(string("scgi_header_names/bytewise/") + corpus.name, 10000, bytewise);
+	suite.run(string("scgi_header_names/current/") + corpus.name, 10000, current);
+}
+
+int
+main(int argc, char *argv[]) {
+	BenchmarkSuite suite;
+	if (!suite.parseOptions(argc, argv)) {
+		return 1;
+	}
+
+	initializeToUpperMap();
+	psg_pool_t *pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+	Core::ScgiHeaderNames names;
+
+	for (unsigned int i = 0; i < BENCHMARK_REQUESTS_COUNT; i++) {
+		Corpus corpus;
+		corpus.name = BENCHMARK_REQUESTS[i].name;
+		corpus.headers = createRequestHeaders(pool, BENCHMARK_REQUESTS[i].data);
+		benchmark(suite, names, corpus);
+	}
+
+	psg_destroy_pool(pool);
+	return suite.finish() ? 0 : 1;
+}
@@ -587,18 +587,6 @@ def rename_entrypoint_file
       @stub.reset
     end
 
-    def get_newest_instance
-      # Because Apache reloads once during startup, we want to select
-      # the newest Passenger instance.
-      instances = AdminTools::InstanceRegistry.new.list
-      instances.sort! do |a, b|
-        x = a.properties['instance_dir']['created_at_monotonic_usec']
-        y = b.properties['instance_dir']['created_at_monotonic_usec']
-        x <=> y
-      end
-      instances.last
-    end
-
     it "is restarted if it crashes" do
       # Make sure that all Apache worker processes have connected to
       # the Passenger core.
@@ -647,8 +635,125 @@ def get_newest_instance
     end
   end
 
+  describe "keepalive connections to the Passenger core" do
+    before :all do
+      create_apache2_controller
+      @server = "http://1.passenger.test:#{@apache2.port}"
+      @stub = RackStub.new('rack')
+      @apache2 << "PassengerMaxPoolSize 1"
+      @apache2 << "PassengerCoreKeepalive 4"
+      @apache2.set_vhost("1.passenger.test", "#{@stub.full_app_root}/public")
+      @apache2.start
+    end
+
+    after :all do
+      @stub.destroy
+      @apache2.stop if @apache2
+    end
+
+    before :each do
+      @stub.reset
+    end
+
+    # Returns the number of connections that the Passenger core has
+    # accepted from Apache, over all its threads.
+    def core_clients_accepted
+      instance = get_newest_instance
+      request = Net::HTTP::Get.new("/server.json")
+      request.basic_auth("ro_admin", instance.read_only_admin_password)
+      response = instance.http_request("agents.s/core_api", request)
+      if response.code.to_i / 100 != 2
+        raise response.body
+      end
+
+      doc = JSON.parse(response.body)
+      (1..doc['threads']).inject(0) do |sum, i|
+        sum + doc["thread#{i}"]['total_clients_accepted']
+      end
+    end
+
+    it_should_behave_like "an example web app"
+
+    it "reuses connections after responses with a Content-Length, chunked responses and responses without a body" do
+      get('/').should == "front page"
+      accepted_before = core_clients_accepted
+
+      uri = URI.parse(@server)
+      10.times do
+        get('/').should == "front page"
+        get('/chunked').should == "chunk1\nchunk2\nchunk3\n"
+        Net::HTTP.start(uri.host, uri.port) do |http|
+          response = http.head('/')
+          response.code.should == "200"
+          response.body.should be_nil
+        end
+      end
+
+      # Every Apache process has its own connection pool, so a handful of
+      # new connections is fine. Without keepalive this would be 30.
+      (core_clients_accepted - accepted_before).should <= 4
+    end
+
+    it "does not reuse a connection whose response was aborted by the client" do
+      File.write("#{@stub.app_root}/config.ru", %q{
+        require File.expand_path(File.dirname(__FILE__) + "/library")
+
+        class SlowBody
+          def each
+            200.times do
+              yield "x" * 65536
+              sleep 0.01
+            end
+          end
+        end
+
+        app = lambda do |env|
+          if env['PATH_INFO'] == '/stream'
+            [200, { "Content-Type" => "text/plain" }, SlowBody.new]
+          else
+            text_response("front page")
+          end
+        end
+        run app
+      })
+      File.touch("#{@stub.app_root}/tmp/restart.txt", 1 + rand(100000))
+      get('/').should == "front page"
+
+      uri = URI.parse(@server)
+      3.times do
+        socket = TCPSocket.new(uri.host, uri.port)
+        begin
+          socket.write("GET /stream HTTP/1.1\r\n")
+          socket.write("Host: #{uri.host}:#{uri.port}\r\n")
+          socket.write("\r\n")
+          socket.readpartial(1024).should =~ /\AHTTP\/1\.1 200 OK/
+        ensure
+          socket.close
+        end
+      end
+
+      # The aborted responses were only partially read from the Passenger
+      # core, so these requests must not be sent over their connections.
+      20.times do
+        get('/').should == "front page"
+      end
+    end
+  end
+
   ##### Helper methods #####
 
+  def get_newest_instance
+    # Because Apache reloads once during startup, we want to select
+    # the newest Passenger instance.
+    instances = AdminTools::InstanceRegistry.new.list
+    instances.sort! do |a, b|
+      x = a.properties['instance_dir']['created_at_monotonic_usec']
+      y = b.properties['instance_dir']['created_at_monotonic_usec']
+      x <=> y
+    end
+    instances.last
+  end
+
   def start_web_server_if_necessary
     if !@apache2.running?
       @apache2.start
@@ -2,6 +2,10 @@
 require 'support/nginx_controller'
 require 'fileutils'
 require 'tmpdir'
+require 'socket'
+require 'net/http'
+PhusionPassenger.require_passenger_lib 'admin_tools'
+PhusionPassenger.require_passenger_lib 'admin_tools/instance_registry'
 
 WEB_SERVER_DECHUNKS_REQUESTS = true
 
@@ -319,6 +323,17 @@ def rename_entrypoint_file
             passenger_enabled on;
             passenger_friendly_error_pages off;
           }
+          location /env_location {
+            passenger_enabled on;
+            passenger_env_var LOCATION_VAR inner;
+            location /env_location/nested {
+              passenger_enabled on;
+            }
+          }
+          location /env_location_other {
+            passenger_enabled on;
+            passenger_env_var LOCATION_VAR other;
+          }
         }
       end
       @nginx.add_server do |server|
@@ -393,6 +408,18 @@ def rename_entrypoint_file
       data.should_not =~ /my error/
     end
 
+    it "applies the options of the location that a request matches" do
+      get('/env_location').should include("LOCATION_VAR = inner\n")
+      get('/env').should_not include("LOCATION_VAR")
+    end
+
+    it "refers every request to the location config of the location that it matches" do
+      get('/env_location_other').should include("LOCATION_VAR = other\n")
+      get('/env_location').should include("LOCATION_VAR = inner\n")
+      get('/env_location/nested').should include("LOCATION_VAR = inner\n")
+      get('/env_location_other').should_not include("LOCATION_VAR = inner\n")
+    end
+
     it "appends an X-Powered-By header containing the Phusion Passenger version number" do
       response = get_response('/')
       response["X-Powered-By"].should include("Phusion Passenger")
@@ -464,6 +491,126 @@ def rename_entrypoint_file
     end
   end
 
+  describe "keepalive connections to the Passenger core" do
+    before :all do
+      create_nginx_controller
+      @server = "http://1.passenger.test:#{@nginx.port}"
+      @stub = RackStub.new('rack')
+      @nginx.set(:core_keepalive => 8)
+      @nginx.add_server do |server|
+        server[:server_name] = "1.passenger.test"
+        server[:root]        = "#{@stub.full_app_root}/public"
+      end
+      @nginx.start
+    end
+
+    after :all do
+      @stub.destroy
+      @nginx.stop if @nginx
+    end
+
+    before :each do
+      @stub.reset
+    end
+
+    def keepalive_supported?
+      Gem::Version.new(@nginx.version) >= Gem::Version.new('1.15.3')
+    end
+
+    def get_newest_instance
+      instances = AdminTools::InstanceRegistry.new.list
+      instances.sort! do |a, b|
+        x = a.properties['instance_dir']['created_at_monotonic_usec']
+        y = b.properties['instance_dir']['created_at_monotonic_usec']
+        x <=> y
+      end
+      instances.last
+    end
+
+    # Returns the number of connections that the Passenger core has
+    # accepted from Nginx, over all its threads.
+    def core_clients_accepted
+      instance = get_newest_instance
+      request = Net::HTTP::Get.new("/server.json")
+      request.basic_auth("ro_admin", instance.read_only_admin_password)
+      response = instance.http_request("agents.s/core_api", request)
+      if response.code.to_i / 100 != 2
+        raise response.body
+      end
+
+      doc = JSON.parse(response.body)
+      (1..doc['threads']).inject(0) do |sum, i|
+        sum + doc["thread#{i}"]['total_clients_accepted']
+      end
+    end
+
+    it_should_behave_like "an example web app"
+
+    it "reuses connections for responses with a Content-Length and chunked responses" do
+      if keepalive_supported?
+        get('/').should == "front page"
+        accepted_before = core_clients_accepted
+
+        10.times do
+          get('/').should == "front page"
+          get('/chunked').should == "chunk1\nchunk2\nchunk3\n"
+          post('/parameters', :first => 'one', :second => 'two').should ==
+            "Method: POST\nFirst: one\nSecond: two\n"
+        end
+
+        # Nginx runs 2 worker processes, each with its own connection
+        # cache, so a handful of new connections is fine. Without
+        # keepalive this would be 30.
+        (core_clients_accepted - accepted_before).should <= 4
+      end
+    end
+
+    it "does not reuse a connection whose response was aborted by the client" do
+      File.write("#{@stub.app_root}/config.ru", %q{
+        require File.expand_path(File.dirname(__FILE__) + "/library")
+
+        class SlowBody
+          def each
+            200.times do
+              yield "x" * 65536
+              sleep 0.01
+            end
+          end
+        end
+
+        app = lambda do |env|
+          if env['PATH_INFO'] == '/stream'
+            [200, { "Content-Type" => "text/plain" }, SlowBody.new]
+          else
+            text_response("front page")
+          end
+        end
+        run app
+      })
+      File.touch("#{@stub.app_root}/tmp/restart.txt", 1 + rand(100000))
+      get('/').should == "front page"
+
+      @uri = URI.parse(@server)
+      3.times do
+        socket = TCPSocket.new(@uri.host, @uri.port)
+        begin
+          socket.write("GET /stream HTTP/1.1\r\n")
+          socket.write("Host: #{@uri.host}:#{@uri.port}\r\n")
+          socket.write("\r\n")
+          socket.readpartial(1024).should =~ /\AHTTP\/1\.1 200 OK/
+        ensure
+          socket.close
+        end
+      end
+
+      # The aborted responses were only partially read from the Passenger
+      # core, so these requests must not be sent over their connections.
+      20.times do
+        get('/').should == "front page"
+      end
+    end
+  end
+
   describe "oob work" do
     before :all do
       create_nginx_controller
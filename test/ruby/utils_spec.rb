@@ -23,6 +23,22 @@ module PhusionPassenger
     expect(split_by_null_into_hash("\0\0")).to eq("" => "")
   end
 
+  specify "#split_by_null_into_env works" do
+    base_env = { "rack.run_once" => false, "HTTP_VERSION" => "HTTP/1.1" }
+    expect(split_by_null_into_env("", base_env)).to eq(base_env)
+    expect(split_by_null_into_env("REQUEST_METHOD\0GET\0X_FOO\0bar\0", {})).to eq(
+      "REQUEST_METHOD" => "GET", "X_FOO" => "bar")
+    expect(split_by_null_into_env("HTTP_HOST\0foo.com\0HTTP_VERSION\0evil\0", base_env)).to eq(
+      "HTTP_HOST" => "foo.com", "rack.run_once" => false, "HTTP_VERSION" => "HTTP/1.1")
+  end
+
+  specify "#split_by_null_into_env returns values that the application may modify" do
+    env = split_by_null_into_env("PATH_INFO\0/foo\0", {})
+    env["PATH_INFO"] << "/bar"
+    expect(env["PATH_INFO"]).to eq("/foo/bar")
+    expect(env.keys.first).to be_frozen
+  end
+
   ######################
 end
 
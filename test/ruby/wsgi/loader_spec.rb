@@ -0,0 +1,70 @@
+require File.expand_path(File.dirname(__FILE__) + '/../spec_helper')
+require 'ruby/shared/loader_sharedspec'
+require 'tmpdir'
+
+module PhusionPassenger
+
+describe "WSGI loader" do
+  include LoaderSpecHelper
+
+  before :each do
+    @stub = register_stub(PythonStub.new("wsgi"))
+  end
+
+  def start(options = {})
+    @loader = Loader.new(["python", "#{PhusionPassenger.helper_scripts_dir}/wsgi-loader.py"],
+      @stub.app_root)
+    @process = @loader.spawn(options)
+  end
+
+  it_should_behave_like "a loader"
+
+  it "handles one request at a time by default" do
+    start
+    expect(@process.find_socket_accepting_http_requests['concurrency']).to eq(1)
+    headers, body = perform_request(
+      "REQUEST_METHOD" => "GET",
+      "PATH_INFO" => "/env"
+    )
+    expect(body).to include("wsgi.multithread = False\n")
+  end
+
+  it "handles requests concurrently if python_thread_count is larger than 1" do
+    start(:python_thread_count => 4)
+    expect(@process.find_socket_accepting_http_requests['concurrency']).to eq(4)
+
+    # Every request marks that it started, then waits until all of them
+    # have started. This only finishes if they are handled concurrently.
+    tmpdir = Dir.mktmpdir
+    begin
+      threads = 4.times.map do |i|
+        Thread.new do
+          perform_request(
+            "REQUEST_METHOD" => "GET",
+            "PATH_INFO" => "/",
+            "HTTP_X_CREATE_FILE" => "#{tmpdir}/started.#{i}",
+            "HTTP_X_WAIT_FOR_FILE" => "#{tmpdir}/all_started"
+          )
+        end
+      end
+      eventually(30) do
+        4.times.all? { |i| File.exist?("#{tmpdir}/started.#{i}") }
+      end
+      File.open("#{tmpdir}/all_started", "w").close
+      threads.each do |thread|
+        headers, body = thread.value
+        expect(body).to eq("front page")
+      end
+    ensure
+      FileUtils.rm_rf(tmpdir)
+    end
+
+    headers, body = perform_request(
+      "REQUEST_METHOD" => "GET",
+      "PATH_INFO" => "/env"
+    )
+    expect(body).to include("wsgi.multithread = True\n")
+  end
+end
+
+end # module PhusionPassenger
@@ -0,0 +1,50 @@
+require File.expand_path(File.dirname(__FILE__) + '/../spec_helper')
+require 'ruby/shared/loader_sharedspec'
+
+module PhusionPassenger
+
+describe "WSGI preloader" do
+  include LoaderSpecHelper
+
+  before :each do
+    @stub = register_stub(PythonStub.new("wsgi"))
+  end
+
+  def start(options = {})
+    @preloader = Preloader.new(["python", "#{PhusionPassenger.helper_scripts_dir}/wsgi-preloader.py"],
+      @stub.app_root)
+    begin
+      @preloader.start(options)
+    rescue SpawnError => e
+      @process = e
+    else
+      @process = @preloader.spawn(options)
+    end
+  end
+
+  it_should_behave_like "a loader"
+
+  it "loads the app only once and forks the app processes off the preloader" do
+    File.prepend(@stub.startup_file, %q{
+with open("history.txt", "a") as f:
+	f.write("app loaded\n")
+})
+    start
+    expect(@process).to be_an_instance_of(AppProcess)
+    second_process = @preloader.spawn
+    begin
+      expect(second_process.pid).not_to eq(@process.pid)
+      expect(File.read("#{@stub.app_root}/history.txt")).to eq("app loaded\n")
+
+      headers, body = perform_request(
+        "REQUEST_METHOD" => "GET",
+        "PATH_INFO" => "/pid"
+      )
+      expect(body).to eq(@process.pid.to_s)
+    ensure
+      second_process.close
+    end
+  end
+end
+
+end # module PhusionPassenger
@@ -39,6 +39,10 @@ def application(env, start_response):
 		start_response(status, [('Content-Type', 'text/html')])
 		return [str('oobw ok')]
 
+	filename = env.get('HTTP_X_CREATE_FILE')
+	if filename is not None:
+		open(filename, 'w').close()
+
 	filename = env.get('HTTP_X_WAIT_FOR_FILE')
 	if filename is not None:
 		while not file_exist(filename):